@@ -182,6 +182,7 @@ LDLIBS		=	\
 			${TIBRV_LIBS}	\
 			${OTHER_LIBS}	\
 			${BOOST_LIBS}	\
+			-lz		\
 			-lm		\
 			-lrt		\
 			$(OTHER_LIBS)	\
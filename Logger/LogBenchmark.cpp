@@ -0,0 +1,579 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Program File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogBenchmark.cpp
+
+   File Description  :  Measures the latency and throughput of the log
+                        handlers.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogManager.hpp>
+#include <Logger/LogHandlerConsole.hpp>
+#include <Logger/LogHandlerFile.hpp>
+#include <Logger/LogHandlerFileMMap.hpp>
+#include <Logger/LogHandlerURingFile.hpp>
+#include <Logger/LogTestSupport.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+LogManagerMacroDeclaration(MB_LIB_LOCAL)
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+using BenchClock = std::chrono::steady_clock;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+enum BenchHandler {
+	BenchHandler_Console,
+	BenchHandler_File,
+	BenchHandler_XFile,
+	BenchHandler_FileMMap,
+	BenchHandler_URingFile,
+	BenchHandler_Count
+};
+
+const char *BenchHandlerNameList[BenchHandler_Count] = {
+	"Console",
+	"File",
+	"XFile",
+	"FileMMap",
+	"URingFile"
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The 'Filtered' cases log at LogLevel_Debug, which is below the minimum
+	level configured for both the console and the persistent store. They
+	measure the cost of a statement which emits nothing.
+*/
+enum BenchCase {
+	BenchCase_Stream,
+	BenchCase_Deferred,
+	BenchCase_FilteredStream,
+	BenchCase_FilteredGuarded,
+	BenchCase_FilteredDeferred,
+	BenchCase_Count
+};
+
+const char *BenchCaseNameList[BenchCase_Count] = {
+	"Stream",
+	"Deferred",
+	"FilteredStream",
+	"FilteredGuarded",
+	"FilteredDeferred"
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+struct BenchOptions {
+	BenchOptions()
+		:max_threads_(4)
+		,line_count_(100000)
+		,line_length_(100)
+		,json_flag_(false)
+		,dir_name_(".")
+		,out_file_name_()
+	{
+		std::fill(handler_flag_list_, handler_flag_list_ + BenchHandler_Count,
+			true);
+		std::fill(case_flag_list_, case_flag_list_ + BenchCase_Count, true);
+	}
+
+	unsigned int max_threads_;
+	std::size_t  line_count_;
+	std::size_t  line_length_;
+	bool         json_flag_;
+	std::string  dir_name_;
+	std::string  out_file_name_;
+	bool         handler_flag_list_[BenchHandler_Count];
+	bool         case_flag_list_[BenchCase_Count];
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+struct BenchResult {
+	BenchResult()
+		:handler_(BenchHandler_Console)
+		,case_(BenchCase_Stream)
+		,thread_count_(0)
+		,line_count_(0)
+		,elapsed_seconds_(0.0)
+		,lines_per_second_(0.0)
+		,mean_ns_(0.0)
+		,p50_ns_(0)
+		,p99_ns_(0)
+		,p999_ns_(0)
+		,max_ns_(0)
+	{
+	}
+
+	BenchHandler  handler_;
+	BenchCase     case_;
+	unsigned int  thread_count_;
+	std::size_t   line_count_;
+	double        elapsed_seconds_;
+	double        lines_per_second_;
+	double        mean_ns_;
+	std::uint64_t p50_ns_;
+	std::uint64_t p99_ns_;
+	std::uint64_t p999_ns_;
+	std::uint64_t max_ns_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MLB::Utility::LogHandlerPtr CreateHandler(BenchHandler handler_type,
+	const std::string &file_name)
+{
+	using namespace MLB::Utility;
+
+	LogHandlerFileBase::LogHandlerFileBaseFlag flags =
+		static_cast<LogHandlerFileBase::LogHandlerFileBaseFlag>(
+		LogHandlerFileBase::DoNotAppend | LogHandlerFileBase::NoConsoleOutput);
+
+	switch (handler_type) {
+		case BenchHandler_Console	:
+			return(LogHandlerPtr(new LogHandlerConsole));
+		case BenchHandler_File		:
+			return(LogHandlerPtr(new LogHandlerFile(file_name,
+				static_cast<LogHandlerFile::LogHandlerFileFlag>(flags))));
+		case BenchHandler_XFile		:
+			return(LogHandlerPtr(new LogHandlerXFile(file_name, flags)));
+		case BenchHandler_FileMMap	:
+			return(LogHandlerPtr(new LogHandlerFileMMap(file_name, flags)));
+		case BenchHandler_URingFile	:
+			return(LogHandlerPtr(new LogHandlerURingFile(file_name, flags)));
+		default							:
+			break;
+	}
+
+	throw std::invalid_argument("Invalid benchmark handler type (" +
+		std::to_string(static_cast<int>(handler_type)) + ").");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Each statement is timed individually, so the figures include the cost
+	of two clock reads (typically some tens of nanoseconds).
+*/
+void BenchThreadProc(BenchCase bench_case, std::size_t line_count,
+	const std::string &line_text, std::atomic<unsigned int> &ready_count,
+	const std::atomic<bool> &start_flag, std::vector<std::uint64_t> &latency_list)
+{
+	latency_list.resize(line_count);
+
+	++ready_count;
+
+	while (!start_flag.load(std::memory_order_acquire))
+		std::this_thread::yield();
+
+	for (std::size_t count_1 = 0; count_1 < line_count; ++count_1) {
+		BenchClock::time_point start_time(BenchClock::now());
+		switch (bench_case) {
+			case BenchCase_Stream				:
+				LogInfo << line_text << " " << count_1 << std::endl;
+				break;
+			case BenchCase_Deferred				:
+				LogDeferred(MLB::Utility::LogLevel_Info, LogInfo, "{} {}",
+					line_text, count_1);
+				break;
+			case BenchCase_FilteredStream		:
+				LogDebug << line_text << " " << count_1 << std::endl;
+				break;
+			case BenchCase_FilteredGuarded	:
+				LogIfDebug << line_text << " " << count_1 << std::endl;
+				break;
+			case BenchCase_FilteredDeferred	:
+				LogDeferred(MLB::Utility::LogLevel_Debug, LogDebug, "{} {}",
+					line_text, count_1);
+				break;
+			default									:
+				break;
+		}
+		latency_list[count_1] = static_cast<std::uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(
+			BenchClock::now() - start_time).count());
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t GetPercentile(const std::vector<std::uint64_t> &sorted_list,
+	double percentile)
+{
+	if (sorted_list.empty())
+		return(0);
+
+	std::size_t index = static_cast<std::size_t>(
+		(percentile / 100.0) * static_cast<double>(sorted_list.size()));
+
+	return(sorted_list[std::min(index, sorted_list.size() - 1)]);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The elapsed time runs from the release of the producer threads until the
+	handler has been flushed, so handlers which buffer or defer output are
+	charged for doing so.
+*/
+BenchResult RunBench(const BenchOptions &options, BenchHandler handler_type,
+	BenchCase bench_case, unsigned int thread_count)
+{
+	using namespace MLB::Utility;
+
+	std::string   file_name(options.dir_name_ + "/" +
+		TEST_GetLogFileName(std::string("LogBenchmark.") +
+		BenchHandlerNameList[handler_type]));
+	LogHandlerPtr handler_ptr(CreateHandler(handler_type, file_name));
+
+	MyLogManager.SetLogLevelConsole(LogLevel_Info);
+	MyLogManager.SetLogLevelFile(LogLevel_Info);
+	MyLogManager.HandlerInstall(handler_ptr);
+
+	std::string                             line_text(options.line_length_, 'X');
+	std::size_t                             per_thread = std::max<std::size_t>(1,
+		options.line_count_ / thread_count);
+	std::atomic<unsigned int>               ready_count(0);
+	std::atomic<bool>                       start_flag(false);
+	std::vector<std::vector<std::uint64_t>> latency_lists(thread_count);
+	std::vector<std::thread>                thread_list;
+
+	for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1)
+		thread_list.emplace_back(BenchThreadProc, bench_case, per_thread,
+			std::cref(line_text), std::ref(ready_count), std::cref(start_flag),
+			std::ref(latency_lists[count_1]));
+
+	while (ready_count.load() < thread_count)
+		std::this_thread::yield();
+
+	BenchClock::time_point start_time(BenchClock::now());
+
+	start_flag.store(true, std::memory_order_release);
+
+	for (auto &this_thread : thread_list)
+		this_thread.join();
+
+	handler_ptr->Flush();
+
+	BenchClock::time_point end_time(BenchClock::now());
+
+	MyLogManager.HandlerRemove();
+	handler_ptr.reset();
+
+	if (handler_type != BenchHandler_Console)
+		::remove(file_name.c_str());
+
+	std::vector<std::uint64_t> sorted_list;
+
+	sorted_list.reserve(per_thread * thread_count);
+
+	for (const auto &this_list : latency_lists)
+		sorted_list.insert(sorted_list.end(), this_list.begin(), this_list.end());
+
+	std::sort(sorted_list.begin(), sorted_list.end());
+
+	BenchResult result;
+	double      total_ns = 0.0;
+
+	for (const auto &this_ns : sorted_list)
+		total_ns += static_cast<double>(this_ns);
+
+	result.handler_          = handler_type;
+	result.case_             = bench_case;
+	result.thread_count_     = thread_count;
+	result.line_count_       = sorted_list.size();
+	result.elapsed_seconds_  = std::chrono::duration<double>(
+		end_time - start_time).count();
+	result.lines_per_second_ = (result.elapsed_seconds_ > 0.0) ?
+		(static_cast<double>(result.line_count_) / result.elapsed_seconds_) : 0.0;
+	result.mean_ns_          = (sorted_list.empty()) ? 0.0 :
+		(total_ns / static_cast<double>(sorted_list.size()));
+	result.p50_ns_           = GetPercentile(sorted_list, 50.0);
+	result.p99_ns_           = GetPercentile(sorted_list, 99.0);
+	result.p999_ns_          = GetPercentile(sorted_list, 99.9);
+	result.max_ns_           = (sorted_list.empty()) ? 0 : sorted_list.back();
+
+	return(result);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void EmitHeader(std::ostream &o_str, const BenchOptions &options)
+{
+	if (!options.json_flag_)
+		o_str << "handler,case,threads,lines,seconds,lines_per_sec,mean_ns,"
+			"p50_ns,p99_ns,p999_ns,max_ns" << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	JSON output is one object per line, which is easily appended to a
+	history file and compared with earlier runs.
+*/
+void EmitResult(std::ostream &o_str, const BenchOptions &options,
+	const BenchResult &result)
+{
+	const char *handler_name = BenchHandlerNameList[result.handler_];
+	const char *case_name    = BenchCaseNameList[result.case_];
+
+	o_str << std::fixed;
+
+	if (options.json_flag_)
+		o_str <<
+			"{\"handler\":\""        << handler_name                       <<
+			"\",\"case\":\""         << case_name                          <<
+			"\",\"threads\":"        << result.thread_count_               <<
+			",\"lines\":"            << result.line_count_                 <<
+			",\"seconds\":"          << std::setprecision(6) <<
+				result.elapsed_seconds_                                     <<
+			",\"lines_per_sec\":"    << std::setprecision(0) <<
+				result.lines_per_second_                                    <<
+			",\"mean_ns\":"          << std::setprecision(1) <<
+				result.mean_ns_                                             <<
+			",\"p50_ns\":"           << result.p50_ns_                     <<
+			",\"p99_ns\":"           << result.p99_ns_                     <<
+			",\"p999_ns\":"          << result.p999_ns_                    <<
+			",\"max_ns\":"           << result.max_ns_                     <<
+			"}" << std::endl;
+	else
+		o_str <<
+			handler_name                                     << "," <<
+			case_name                                        << "," <<
+			result.thread_count_                             << "," <<
+			result.line_count_                               << "," <<
+			std::setprecision(6) << result.elapsed_seconds_  << "," <<
+			std::setprecision(0) << result.lines_per_second_ << "," <<
+			std::setprecision(1) << result.mean_ns_          << "," <<
+			result.p50_ns_                                   << "," <<
+			result.p99_ns_                                   << "," <<
+			result.p999_ns_                                  << "," <<
+			result.max_ns_                                   << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t ParseCount(const char *arg_name, const char *arg_value)
+{
+	char          *end_ptr;
+	unsigned long  value = ::strtoul(arg_value, &end_ptr, 10);
+
+	if ((!*arg_value) || *end_ptr || (!value))
+		throw std::invalid_argument("Invalid value for parameter '" +
+			std::string(arg_name) + "' ('" + arg_value + "').");
+
+	return(static_cast<std::size_t>(value));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+template <std::size_t NameCount>
+	void ParseNameList(const char *arg_name, const char *arg_value,
+		const char *(&name_list)[NameCount], bool (&flag_list)[NameCount])
+{
+	std::fill(flag_list, flag_list + NameCount, false);
+
+	std::string            value(arg_value);
+	std::string::size_type start_pos = 0;
+
+	for ( ; ; ) {
+		std::string::size_type comma_pos = value.find(',', start_pos);
+		std::string            this_name(value.substr(start_pos,
+			(comma_pos == std::string::npos) ? std::string::npos :
+			(comma_pos - start_pos)));
+		std::size_t            count_1;
+		for (count_1 = 0; count_1 < NameCount; ++count_1) {
+			if (!::strcasecmp(this_name.c_str(), name_list[count_1]))
+				break;
+		}
+		if (count_1 == NameCount)
+			throw std::invalid_argument("Invalid name in parameter '" +
+				std::string(arg_name) + "' ('" + this_name + "').");
+		flag_list[count_1] = true;
+		if (comma_pos == std::string::npos)
+			break;
+		start_pos = comma_pos + 1;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const char *GetArgValue(int argc, char **argv, int &count_1)
+{
+	if ((count_1 + 1) >= argc)
+		throw std::invalid_argument("Expected a value after parameter '" +
+			std::string(argv[count_1]) + "'.");
+
+	return(argv[++count_1]);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Usage: LogBenchmark [ -threads <max-threads> ] [ -lines <lines-per-run> ]
+		[ -length <line-length> ] [ -handlers <name>[,<name> ... ] ]
+		[ -cases <name>[,<name> ... ] ] [ -format { csv | json } ]
+		[ -clock { realtime | coarse | tsc } ] [ -dir <log-directory> ]
+		[ -out <result-file> ]
+
+	Each selected handler and case is run with 1, 2, 4 ... producer threads
+	up to the maximum specified. The number of lines in each run is divided
+	among the producer threads. Results are written to the standard output
+	unless a result file is specified. Console handler output is discarded.
+*/
+int main(int argc, char **argv)
+{
+	using namespace MLB::Utility;
+
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		BenchOptions options;
+		for (int count_1 = 1; count_1 < argc; ++count_1) {
+			if (!::strcmp(argv[count_1], "-threads"))
+				options.max_threads_ = static_cast<unsigned int>(ParseCount(
+					argv[count_1], GetArgValue(argc, argv, count_1)));
+			else if (!::strcmp(argv[count_1], "-lines"))
+				options.line_count_ = ParseCount(argv[count_1],
+					GetArgValue(argc, argv, count_1));
+			else if (!::strcmp(argv[count_1], "-length"))
+				options.line_length_ = ParseCount(argv[count_1],
+					GetArgValue(argc, argv, count_1));
+			else if (!::strcmp(argv[count_1], "-handlers"))
+				ParseNameList(argv[count_1], GetArgValue(argc, argv, count_1),
+					BenchHandlerNameList, options.handler_flag_list_);
+			else if (!::strcmp(argv[count_1], "-cases"))
+				ParseNameList(argv[count_1], GetArgValue(argc, argv, count_1),
+					BenchCaseNameList, options.case_flag_list_);
+			else if (!::strcmp(argv[count_1], "-format")) {
+				const char *format_name = GetArgValue(argc, argv, count_1);
+				if (!::strcasecmp(format_name, "json"))
+					options.json_flag_ = true;
+				else if (!::strcasecmp(format_name, "csv"))
+					options.json_flag_ = false;
+				else
+					throw std::invalid_argument("Invalid output format ('" +
+						std::string(format_name) + "').");
+			}
+			else if (!::strcmp(argv[count_1], "-clock")) {
+				const char *clock_name = GetArgValue(argc, argv, count_1);
+				if (!::strcasecmp(clock_name, "realtime"))
+					LogClockSetType(LogClock_Realtime);
+				else if (!::strcasecmp(clock_name, "coarse"))
+					LogClockSetType(LogClock_RealtimeCoarse);
+				else if (!::strcasecmp(clock_name, "tsc"))
+					LogClockSetType(LogClock_TSC);
+				else
+					throw std::invalid_argument("Invalid log clock name ('" +
+						std::string(clock_name) + "').");
+			}
+			else if (!::strcmp(argv[count_1], "-dir"))
+				options.dir_name_ = GetArgValue(argc, argv, count_1);
+			else if (!::strcmp(argv[count_1], "-out"))
+				options.out_file_name_ = GetArgValue(argc, argv, count_1);
+			else if ((!::strcmp(argv[count_1], "-h")) ||
+				(!::strcmp(argv[count_1], "-help"))) {
+				std::cout << "Usage: " << argv[0] <<
+					" [ -threads <max-threads> ] [ -lines <lines-per-run> ] "
+					"[ -length <line-length> ] [ -handlers <name>[,<name> ... ] ] "
+					"[ -cases <name>[,<name> ... ] ] [ -format { csv | json } ] "
+					"[ -clock { realtime | coarse | tsc } ] [ -dir <log-directory> ] "
+					"[ -out <result-file> ]" << std::endl;
+				return(EXIT_SUCCESS);
+			}
+			else
+				throw std::invalid_argument("Invalid parameter ('" +
+					std::string(argv[count_1]) + "').");
+		}
+		std::ofstream out_file;
+		if (!options.out_file_name_.empty()) {
+			out_file.open(options.out_file_name_.c_str());
+			if (!out_file)
+				throw std::runtime_error("Unable to open benchmark result file '" +
+					options.out_file_name_ + "'.");
+		}
+		std::ostream &o_str = (out_file.is_open()) ? out_file : std::cout;
+		//	Console handler output goes to the bit bucket, but through a real
+		//	file descriptor so that the cost of the write is included...
+		std::ofstream null_file("/dev/null");
+		if (!null_file)
+			throw std::runtime_error("Unable to open '/dev/null'.");
+		EmitHeader(o_str, options);
+		for (int count_1 = 0; count_1 < BenchHandler_Count; ++count_1) {
+			if (!options.handler_flag_list_[count_1])
+				continue;
+			for (int count_2 = 0; count_2 < BenchCase_Count; ++count_2) {
+				if (!options.case_flag_list_[count_2])
+					continue;
+				for (unsigned int thread_count = 1; ; ) {
+					std::streambuf *old_buf = NULL;
+					if (count_1 == BenchHandler_Console) {
+						o_str.flush();
+						old_buf = std::cout.rdbuf(null_file.rdbuf());
+					}
+					BenchResult result;
+					try {
+						result = RunBench(options, static_cast<BenchHandler>(count_1),
+							static_cast<BenchCase>(count_2), thread_count);
+					}
+					catch (const std::exception &) {
+						if (old_buf != NULL)
+							std::cout.rdbuf(old_buf);
+						throw;
+					}
+					if (old_buf != NULL)
+						std::cout.rdbuf(old_buf);
+					EmitResult(o_str, options, result);
+					if (thread_count >= options.max_threads_)
+						break;
+					thread_count = std::min(thread_count * 2, options.max_threads_);
+				}
+			}
+		}
+		o_str.flush();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
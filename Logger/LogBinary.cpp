@@ -0,0 +1,588 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogBinary.cpp
+
+   File Description  :  Implementation of the binary deferred-formatting log
+                        record support functions.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogEvent.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The formats are held in fixed-size chunks which are never moved or
+	freed while the registry exists, so that a format, once published by
+	the release store of the format count, may be read without a lock.
+	Registration is the only writer and is serialized by the lock.
+*/
+struct LogBinaryFormatRegistry {
+	static const std::size_t ChunkSize     = 1024;
+	static const std::size_t MaxChunkCount = 4096;
+
+	LogBinaryFormatRegistry()
+		:the_lock_()
+		,format_count_(0)
+	{
+		for (std::size_t count_1 = 0; count_1 < MaxChunkCount; ++count_1)
+			chunk_list_[count_1].store(NULL, std::memory_order_relaxed);
+
+		LogBinaryFormat text_format  = { LogBinaryFormatId_Text,  "", 0, "{}" };
+		LogBinaryFormat event_format = { LogBinaryFormatId_Event, "", 0, "" };
+
+		Append(text_format);
+		Append(event_format);
+	}
+
+	~LogBinaryFormatRegistry()
+	{
+		for (std::size_t count_1 = 0; count_1 < MaxChunkCount; ++count_1)
+			delete [] chunk_list_[count_1].load(std::memory_order_relaxed);
+	}
+
+	//	Called with the lock held (or from the constructor).
+	void Append(const LogBinaryFormat &format)
+	{
+		std::size_t format_count = format_count_.load(std::memory_order_relaxed);
+
+		if (format_count >= (ChunkSize * MaxChunkCount))
+			throw std::runtime_error("The maximum number of deferred log "
+				"formats (" + std::to_string(ChunkSize * MaxChunkCount) +
+				") has been registered.");
+
+		std::atomic<LogBinaryFormat *> &chunk_entry =
+			chunk_list_[format_count / ChunkSize];
+		LogBinaryFormat                *chunk_ptr   =
+			chunk_entry.load(std::memory_order_relaxed);
+
+		if (chunk_ptr == NULL) {
+			chunk_ptr = new LogBinaryFormat[ChunkSize];
+			chunk_entry.store(chunk_ptr, std::memory_order_release);
+		}
+
+		chunk_ptr[format_count % ChunkSize] = format;
+
+		format_count_.store(format_count + 1, std::memory_order_release);
+	}
+
+	bool Get(LogBinaryFormatId format_id, LogBinaryFormat &format) const
+	{
+		if (format_id >= format_count_.load(std::memory_order_acquire))
+			return(false);
+
+		format = chunk_list_[format_id / ChunkSize].load(
+			std::memory_order_acquire)[format_id % ChunkSize];
+
+		return(true);
+	}
+
+	std::mutex                     the_lock_;
+	std::atomic<std::size_t>       format_count_;
+	std::atomic<LogBinaryFormat *> chunk_list_[MaxChunkCount];
+
+private:
+	LogBinaryFormatRegistry(const LogBinaryFormatRegistry &) = delete;
+	LogBinaryFormatRegistry & operator = (const LogBinaryFormatRegistry &) =
+		delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogBinaryFormatRegistry &GetFormatRegistry()
+{
+	static LogBinaryFormatRegistry format_registry;
+
+	return(format_registry);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Returns NULL if the data is too short to contain the datum.
+template <typename DatumType>
+	const char *TryExtractDatum(const char *arg_ptr, const char *end_ptr,
+		DatumType &datum)
+{
+	if (static_cast<std::size_t>(end_ptr - arg_ptr) < sizeof(datum))
+		return(NULL);
+
+	::memcpy(&datum, arg_ptr, sizeof(datum));
+
+	return(arg_ptr + sizeof(datum));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+template <typename DatumType>
+	const char *ExtractDatum(const char *arg_ptr, const char *end_ptr,
+		DatumType &datum)
+{
+	if (static_cast<std::size_t>(end_ptr - arg_ptr) < sizeof(datum))
+		throw std::runtime_error("Binary log record argument data is "
+			"truncated.");
+
+	::memcpy(&datum, arg_ptr, sizeof(datum));
+
+	return(arg_ptr + sizeof(datum));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+template <typename DatumType>
+	void AppendNumber(std::string &out_string, DatumType datum)
+{
+	char                 tmp_buffer[64];
+	std::to_chars_result result =
+		std::to_chars(tmp_buffer, tmp_buffer + sizeof(tmp_buffer), datum);
+
+	out_string.append(tmp_buffer, result.ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Returns the pointer to the next encoded argument.
+const char *RenderArg(const char *arg_ptr, const char *end_ptr,
+	std::string &out_string)
+{
+	LogBinaryArg this_arg;
+
+	arg_ptr = LogBinaryExtractArg(arg_ptr, end_ptr, this_arg);
+
+	LogBinaryAppendArg(this_arg, out_string);
+
+	return(arg_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool ReadExact(std::istream &in_stream, void *data_ptr, std::size_t data_length)
+{
+	in_stream.read(static_cast<char *>(data_ptr),
+		static_cast<std::streamsize>(data_length));
+
+	if (static_cast<std::size_t>(in_stream.gcount()) == data_length)
+		return(true);
+	else if (!in_stream.gcount())
+		return(false);
+
+	throw std::runtime_error("Binary log file is truncated: expected " +
+		std::to_string(data_length) + " bytes but only " +
+		std::to_string(in_stream.gcount()) + " could be read.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Reads the data of a record. The buffer is grown as the data is read
+	rather than all at once, so that a corrupt length in a truncated file
+	can't cause an allocation much larger than the file.
+*/
+void ReadRecordData(std::istream &in_stream, std::uint32_t data_length,
+	std::vector<char> &data_buffer)
+{
+	const std::size_t read_chunk_size = 1 << 20;
+
+	if (data_length > LogBinaryMaxDataLength)
+		throw std::runtime_error("Invalid binary log record data length (" +
+			std::to_string(data_length) + ").");
+
+	data_buffer.clear();
+
+	while (data_buffer.size() < data_length) {
+		std::size_t read_offset = data_buffer.size();
+		std::size_t read_length = std::min(read_chunk_size,
+			data_length - read_offset);
+		data_buffer.resize(read_offset + read_length);
+		if (!ReadExact(in_stream, data_buffer.data() + read_offset,
+			read_length))
+			throw std::runtime_error("Binary log file is truncated.");
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Called once for each deferred log statement (through the initialization
+	of a function-local static in the LogDeferred() macro).
+*/
+LogBinaryFormatId LogBinaryFormatRegister(const char *file_name,
+	unsigned int line_number, const char *format_string)
+{
+	LogBinaryFormatRegistry          &format_registry = GetFormatRegistry();
+	std::lock_guard<std::mutex>       my_lock(format_registry.the_lock_);
+	LogBinaryFormat                   new_format;
+
+	new_format.format_id_     = static_cast<LogBinaryFormatId>(
+		format_registry.format_count_.load(std::memory_order_relaxed));
+	new_format.file_name_     = (file_name     == NULL) ? "" : file_name;
+	new_format.line_number_   = line_number;
+	new_format.format_string_ = (format_string == NULL) ? "" : format_string;
+
+	format_registry.Append(new_format);
+
+	return(new_format.format_id_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Takes no lock, so that rendering threads don't serialize upon it.
+bool LogBinaryFormatGet(LogBinaryFormatId format_id, LogBinaryFormat &format)
+{
+	return(GetFormatRegistry().Get(format_id, format));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Decodes the argument at 'arg_ptr' and returns the pointer to the next
+	encoded argument, or NULL if the argument is invalid. Neither throws nor
+	allocates, so that it may be used to check record data from within a
+	signal handler.
+*/
+const char *LogBinaryTryExtractArg(const char *arg_ptr, const char *end_ptr,
+	LogBinaryArg &arg)
+{
+	if (arg_ptr >= end_ptr)
+		return(NULL);
+
+	arg.arg_type_      =
+		static_cast<LogBinaryArgType>(static_cast<unsigned char>(*arg_ptr++));
+	arg.int_value_     = 0;
+	arg.uint_value_    = 0;
+	arg.double_value_  = 0.0;
+	arg.string_ptr_    = NULL;
+	arg.string_length_ = 0;
+
+	switch (arg.arg_type_) {
+		case LogBinaryArgType_Bool		:
+			{
+				std::uint8_t datum = 0;
+				arg_ptr        = TryExtractDatum(arg_ptr, end_ptr, datum);
+				arg.int_value_ = (datum) ? 1 : 0;
+			}
+			break;
+		case LogBinaryArgType_Char		:
+			{
+				char datum = '\0';
+				arg_ptr        = TryExtractDatum(arg_ptr, end_ptr, datum);
+				arg.int_value_ = datum;
+			}
+			break;
+		case LogBinaryArgType_Int		:
+			arg_ptr = TryExtractDatum(arg_ptr, end_ptr, arg.int_value_);
+			break;
+		case LogBinaryArgType_UInt		:
+		case LogBinaryArgType_Pointer	:
+			arg_ptr = TryExtractDatum(arg_ptr, end_ptr, arg.uint_value_);
+			break;
+		case LogBinaryArgType_Double	:
+			arg_ptr = TryExtractDatum(arg_ptr, end_ptr, arg.double_value_);
+			break;
+		case LogBinaryArgType_String	:
+			{
+				std::uint32_t datum_length = 0;
+				arg_ptr = TryExtractDatum(arg_ptr, end_ptr, datum_length);
+				if ((arg_ptr == NULL) ||
+					(static_cast<std::size_t>(end_ptr - arg_ptr) < datum_length))
+					return(NULL);
+				arg.string_ptr_    = arg_ptr;
+				arg.string_length_ = datum_length;
+				arg_ptr           += datum_length;
+			}
+			break;
+		default								:
+			return(NULL);
+	}
+
+	return(arg_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	As LogBinaryTryExtractArg(), but throws if the argument is invalid.
+const char *LogBinaryExtractArg(const char *arg_ptr, const char *end_ptr,
+	LogBinaryArg &arg)
+{
+	const char *next_ptr = LogBinaryTryExtractArg(arg_ptr, end_ptr, arg);
+
+	if (next_ptr != NULL)
+		return(next_ptr);
+	else if (arg_ptr >= end_ptr)
+		throw std::runtime_error("Binary log record argument data is "
+			"truncated.");
+	else if ((arg.arg_type_ < LogBinaryArgType_Bool) ||
+		(arg.arg_type_ > LogBinaryArgType_Pointer))
+		throw std::runtime_error("Invalid binary log argument type (" +
+			std::to_string(static_cast<int>(arg.arg_type_)) + ").");
+	else if (arg.arg_type_ == LogBinaryArgType_String)
+		throw std::runtime_error("Binary log record string argument is "
+			"truncated.");
+
+	throw std::runtime_error("Binary log record argument data is truncated.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogBinaryCheckArgs(const char *arg_ptr, std::size_t arg_length)
+{
+	const char   *end_ptr = arg_ptr + arg_length;
+	LogBinaryArg  this_arg;
+
+	while (arg_ptr < end_ptr) {
+		if ((arg_ptr = LogBinaryTryExtractArg(arg_ptr, end_ptr, this_arg)) ==
+			NULL)
+			return(false);
+	}
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string &LogBinaryAppendArg(const LogBinaryArg &arg,
+	std::string &out_string)
+{
+	switch (arg.arg_type_) {
+		case LogBinaryArgType_Bool		:
+			out_string.append((arg.int_value_) ? "true" : "false");
+			break;
+		case LogBinaryArgType_Char		:
+			out_string.push_back(static_cast<char>(arg.int_value_));
+			break;
+		case LogBinaryArgType_Int		:
+			AppendNumber(out_string, arg.int_value_);
+			break;
+		case LogBinaryArgType_UInt		:
+			AppendNumber(out_string, arg.uint_value_);
+			break;
+		case LogBinaryArgType_Double	:
+			AppendNumber(out_string, arg.double_value_);
+			break;
+		case LogBinaryArgType_String	:
+			out_string.append(arg.string_ptr_, arg.string_length_);
+			break;
+		case LogBinaryArgType_Pointer	:
+			{
+				char                 tmp_buffer[32];
+				std::to_chars_result result = std::to_chars(tmp_buffer,
+					tmp_buffer + sizeof(tmp_buffer), arg.uint_value_, 16);
+				out_string.append("0x");
+				out_string.append(tmp_buffer, result.ptr);
+			}
+			break;
+		default								:
+			break;
+	}
+
+	return(out_string);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Arguments in excess of the number of placeholders are appended separated
+	by spaces so that no logged data is lost.
+*/
+std::string &LogBinaryRender(const char *format_string, const char *arg_ptr,
+	std::size_t arg_length, std::string &out_string)
+{
+	const char *end_ptr = arg_ptr + arg_length;
+
+	out_string.clear();
+
+	format_string = (format_string == NULL) ? "" : format_string;
+
+	while (*format_string) {
+		if ((*format_string == '{') && (format_string[1] == '}') &&
+			(arg_ptr < end_ptr)) {
+			arg_ptr        = RenderArg(arg_ptr, end_ptr, out_string);
+			format_string += 2;
+		}
+		else if (((*format_string == '{') && (format_string[1] == '{')) ||
+			((*format_string == '}') && (format_string[1] == '}'))) {
+			out_string.push_back(*format_string);
+			format_string += 2;
+		}
+		else
+			out_string.push_back(*format_string++);
+	}
+
+	while (arg_ptr < end_ptr) {
+		out_string.push_back(' ');
+		arg_ptr = RenderArg(arg_ptr, end_ptr, out_string);
+	}
+
+	return(out_string);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string &LogBinaryRender(LogBinaryFormatId format_id, const char *arg_ptr,
+	std::size_t arg_length, std::string &out_string)
+{
+	LogBinaryFormat this_format;
+
+	if (format_id == LogBinaryFormatId_Event)
+		return(LogEventRenderText(arg_ptr, arg_length, out_string));
+
+	if (!LogBinaryFormatGet(format_id, this_format))
+		throw std::invalid_argument("Unknown binary log format id (" +
+			std::to_string(format_id) + ").");
+
+	return(LogBinaryRender(this_format.format_string_, arg_ptr, arg_length,
+		out_string));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The buffer into which a deferred log statement encodes its arguments.
+	Re-used by each such statement in the thread, so no allocation is needed
+	once it has grown to the largest argument set.
+*/
+std::string &LogBinaryGetThreadBuffer()
+{
+	thread_local std::string thread_buffer;
+
+	return(thread_buffer);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Renders a binary log file in the text format written by the text file
+	handlers. Returns the number of line and literal records rendered.
+*/
+std::size_t LogBinaryDecode(std::istream &in_stream, std::ostream &out_stream,
+	LogFlag log_flags)
+{
+	LogBinaryFileHeader                      file_header;
+	std::map<LogBinaryFormatId, std::string> format_map;
+	std::vector<char>                        data_buffer;
+	std::string                              line_buffer;
+	char                                     line_leader[LogLineLeaderLength + 1];
+	std::size_t                              record_count = 0;
+
+	if (!ReadExact(in_stream, &file_header, sizeof(file_header)))
+		return(0);
+
+	if (::memcmp(file_header.magic_, LogBinaryFileMagic,
+		sizeof(LogBinaryFileMagic)))
+		throw std::runtime_error("Not a binary log file: the file magic "
+			"number is invalid.");
+	else if (file_header.byte_order_ != LogBinaryFileByteOrder)
+		throw std::runtime_error("The binary log file was written by a host "
+			"with a different byte order.");
+	else if (file_header.version_ != LogBinaryFileVersion)
+		throw std::runtime_error("Unsupported binary log file version (" +
+			std::to_string(file_header.version_) + ").");
+	else if (file_header.header_length_ < sizeof(file_header))
+		throw std::runtime_error("Invalid binary log file header length (" +
+			std::to_string(file_header.header_length_) + ").");
+
+	in_stream.ignore(static_cast<std::streamsize>(file_header.header_length_ -
+		sizeof(file_header)));
+
+	format_map[LogBinaryFormatId_Text] = "{}";
+
+	LogBinaryRecordHeader record_header;
+
+	while (ReadExact(in_stream, &record_header, sizeof(record_header))) {
+		if (record_header.record_length_ !=
+			(sizeof(record_header) + record_header.data_length_))
+			throw std::runtime_error("Invalid binary log record length (" +
+				std::to_string(record_header.record_length_) + ").");
+		ReadRecordData(in_stream, record_header.data_length_, data_buffer);
+		if (record_header.record_type_ == LogBinaryRecordType_Format) {
+			std::uint32_t line_number;
+			std::uint32_t file_name_length;
+			const char   *data_ptr = data_buffer.data();
+			const char   *end_ptr  = data_ptr + data_buffer.size();
+			data_ptr = ExtractDatum(data_ptr, end_ptr, line_number);
+			data_ptr = ExtractDatum(data_ptr, end_ptr, file_name_length);
+			if (static_cast<std::size_t>(end_ptr - data_ptr) < file_name_length)
+				throw std::runtime_error("Binary log format record is "
+					"truncated.");
+			format_map[record_header.format_id_].assign(
+				data_ptr + file_name_length, end_ptr);
+		}
+		else if (record_header.record_type_ == LogBinaryRecordType_Line) {
+			std::map<LogBinaryFormatId, std::string>::const_iterator iter_f(
+				format_map.find(record_header.format_id_));
+			if (record_header.format_id_ == LogBinaryFormatId_Event)
+				LogEventRenderText(data_buffer.data(), data_buffer.size(),
+					line_buffer);
+			else if (iter_f == format_map.end())
+				LogBinaryRender(("<unknown format id " +
+					std::to_string(record_header.format_id_) + ">").c_str(),
+					data_buffer.data(), data_buffer.size(), line_buffer);
+			else
+				LogBinaryRender(iter_f->second.c_str(), data_buffer.data(),
+					data_buffer.size(), line_buffer);
+			LogEmitControl::FormatLeader(line_leader,
+				TimeSpec(static_cast<time_t>(record_header.time_secs_),
+				static_cast<long>(record_header.time_nsecs_)),
+				CheckLogLevel(static_cast<LogLevel>(record_header.log_level_)),
+				record_header.thread_id_, log_flags);
+			out_stream.write(line_leader, LogLineLeaderLength);
+			out_stream.write(line_buffer.data(),
+				static_cast<std::streamsize>(line_buffer.size()));
+			out_stream.put('\n');
+			++record_count;
+		}
+		else if (record_header.record_type_ == LogBinaryRecordType_Literal) {
+			out_stream.write(data_buffer.data(),
+				static_cast<std::streamsize>(data_buffer.size()));
+			out_stream.put('\n');
+			++record_count;
+		}
+		else
+			throw std::runtime_error("Invalid binary log record type (" +
+				std::to_string(static_cast<int>(record_header.record_type_)) +
+				").");
+	}
+
+	return(record_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
@@ -0,0 +1,94 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Program File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogBinaryDecode.cpp
+
+   File Description  :  Renders binary log files as text.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogBinary.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Usage: LogBinaryDecode [ -local ] <binary-log-file> [ ... ]
+
+	A file name of '-' reads the binary log from the standard input. The
+	decoded text is written to the standard output in the same layout as
+	that produced by the text log handlers.
+*/
+int main(int argc, char **argv)
+{
+	using namespace MLB::Utility;
+
+	int     return_code = EXIT_SUCCESS;
+	LogFlag log_flags   = Default;
+	int     file_count  = 0;
+
+	try {
+		for (int count_1 = 1; count_1 < argc; ++count_1) {
+			if (!::strcmp(argv[count_1], "-local"))
+				log_flags = static_cast<LogFlag>(log_flags | LogLocalTime);
+			else if ((!::strcmp(argv[count_1], "-h")) ||
+				(!::strcmp(argv[count_1], "-help"))) {
+				std::cout << "Usage: " << argv[0] <<
+					" [ -local ] <binary-log-file> [ ... ]" << std::endl;
+				return(EXIT_SUCCESS);
+			}
+			else if (!::strcmp(argv[count_1], "-")) {
+				LogBinaryDecode(std::cin, std::cout, log_flags);
+				++file_count;
+			}
+			else {
+				std::ifstream in_file(argv[count_1],
+					std::ios_base::in | std::ios_base::binary);
+				if (!in_file)
+					throw std::runtime_error("Unable to open binary log file '" +
+						std::string(argv[count_1]) + "'.");
+				try {
+					LogBinaryDecode(in_file, std::cout, log_flags);
+				}
+				catch (const std::exception &except) {
+					throw std::runtime_error("Unable to decode binary log file '" +
+						std::string(argv[count_1]) + "': " + except.what());
+				}
+				++file_count;
+			}
+		}
+		if (!file_count)
+			throw std::invalid_argument("No binary log files were specified "
+				"(use '-' to read from the standard input).");
+		std::cout.flush();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
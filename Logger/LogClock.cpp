@@ -0,0 +1,477 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogClock.cpp
+
+   File Description  :  Implementation of the clock used to time log lines.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogClock.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+# define MLB_LOGGER_HAS_TSC_CLOCK 1
+#endif // #if defined(__x86_64__) || defined(__i386__)
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+const std::uint64_t NanosecondsPerSecond = 1000000000ULL;
+//	Duration of the measurement of the TSC rate.
+const std::uint64_t CalibrateNanoseconds = 20000000ULL;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+struct TSCCalibration {
+	std::uint64_t base_ticks_;
+	std::uint64_t base_nanoseconds_;
+	//	Nanoseconds per tick as an unsigned 32.32 fixed-point value.
+	std::uint64_t tick_multiplier_;
+	double        ticks_per_second_;
+};
+
+/*
+	The current calibration is published under a sequence lock, so that
+	re-selecting the TSC clock replaces it in place rather than retaining
+	each superseded calibration for the threads which may still be using
+	it. The sequence is odd while the calibration is being updated.
+*/
+struct TSCCalibrationSlot {
+	std::atomic<std::uint64_t> sequence_;
+	std::atomic<std::uint64_t> base_ticks_;
+	std::atomic<std::uint64_t> base_nanoseconds_;
+	std::atomic<std::uint64_t> tick_multiplier_;
+	std::atomic<double>        ticks_per_second_;
+};
+
+std::atomic<int>   ClockType(LogClock_Default);
+TSCCalibrationSlot ClockCalibration = { {0}, {0}, {0}, {0}, {0.0} };
+std::mutex         ClockLock;
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef MLB_LOGGER_HAS_TSC_CLOCK
+// ////////////////////////////////////////////////////////////////////////////
+//	Only called with the ClockLock held.
+void StoreCalibration(const TSCCalibration &calibration)
+{
+	std::uint64_t sequence =
+		ClockCalibration.sequence_.load(std::memory_order_relaxed);
+
+	ClockCalibration.sequence_.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	ClockCalibration.base_ticks_.store(calibration.base_ticks_,
+		std::memory_order_relaxed);
+	ClockCalibration.base_nanoseconds_.store(calibration.base_nanoseconds_,
+		std::memory_order_relaxed);
+	ClockCalibration.tick_multiplier_.store(calibration.tick_multiplier_,
+		std::memory_order_relaxed);
+	ClockCalibration.ticks_per_second_.store(calibration.ticks_per_second_,
+		std::memory_order_relaxed);
+
+	ClockCalibration.sequence_.store(sequence + 2, std::memory_order_release);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+TSCCalibration LoadCalibration()
+{
+	TSCCalibration calibration;
+	std::uint64_t  sequence;
+
+	do {
+		while ((sequence = ClockCalibration.sequence_.load(
+			std::memory_order_acquire)) & 1)
+			;
+		calibration.base_ticks_       =
+			ClockCalibration.base_ticks_.load(std::memory_order_relaxed);
+		calibration.base_nanoseconds_ =
+			ClockCalibration.base_nanoseconds_.load(std::memory_order_relaxed);
+		calibration.tick_multiplier_  =
+			ClockCalibration.tick_multiplier_.load(std::memory_order_relaxed);
+		calibration.ticks_per_second_ =
+			ClockCalibration.ticks_per_second_.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+	} while (ClockCalibration.sequence_.load(std::memory_order_relaxed) !=
+		sequence);
+
+	return(calibration);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef MLB_LOGGER_HAS_TSC_CLOCK
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t GetClockNanoseconds(clockid_t clock_id)
+{
+	struct timespec tmp_time;
+
+	::clock_gettime(clock_id, &tmp_time);
+
+	return((static_cast<std::uint64_t>(tmp_time.tv_sec) *
+		NanosecondsPerSecond) + static_cast<std::uint64_t>(tmp_time.tv_nsec));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+TimeSpec GetClockTime(clockid_t clock_id)
+{
+	struct timespec tmp_time;
+
+	::clock_gettime(clock_id, &tmp_time);
+
+	return(TimeSpec(tmp_time));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef MLB_LOGGER_HAS_TSC_CLOCK
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Reads the TSC and the specified clock together. Of several attempts, the
+	one with the fewest ticks between the two counter reads is used, which
+	discards those interrupted or pre-empted between reads.
+*/
+void ReadTSCAndClock(clockid_t clock_id, std::uint64_t &ticks,
+	std::uint64_t &nanoseconds)
+{
+	std::uint64_t best_spread = ~static_cast<std::uint64_t>(0);
+
+	ticks       = 0;
+	nanoseconds = 0;
+
+	for (unsigned int count_1 = 0; count_1 < 16; ++count_1) {
+		std::uint64_t tick_1 = __rdtsc();
+		std::uint64_t nsecs  = GetClockNanoseconds(clock_id);
+		std::uint64_t tick_2 = __rdtsc();
+		if ((tick_2 - tick_1) < best_spread) {
+			best_spread = tick_2 - tick_1;
+			ticks       = tick_1 + ((tick_2 - tick_1) / 2);
+			nanoseconds = nsecs;
+		}
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The rate is measured against CLOCK_MONOTONIC_RAW, which isn't subject to
+	NTP slewing during the measurement. The anchor is to CLOCK_REALTIME.
+*/
+TSCCalibration CalibrateTSC()
+{
+	std::uint64_t start_ticks = 0;
+	std::uint64_t start_nsecs = 0;
+	std::uint64_t end_ticks   = 0;
+	std::uint64_t end_nsecs   = 0;
+
+	ReadTSCAndClock(CLOCK_MONOTONIC_RAW, start_ticks, start_nsecs);
+
+	do {
+		ReadTSCAndClock(CLOCK_MONOTONIC_RAW, end_ticks, end_nsecs);
+	} while ((end_nsecs - start_nsecs) < CalibrateNanoseconds);
+
+	if (end_ticks <= start_ticks)
+		throw std::runtime_error("Unable to calibrate the TSC log clock: the "
+			"time stamp counter did not advance.");
+
+	TSCCalibration calibration;
+
+	calibration.ticks_per_second_ = (static_cast<double>(end_ticks -
+		start_ticks) * static_cast<double>(NanosecondsPerSecond)) /
+		static_cast<double>(end_nsecs - start_nsecs);
+	calibration.tick_multiplier_  = static_cast<std::uint64_t>(
+		(static_cast<double>(NanosecondsPerSecond) * 4294967296.0) /
+		calibration.ticks_per_second_);
+
+	ReadTSCAndClock(CLOCK_REALTIME, calibration.base_ticks_,
+		calibration.base_nanoseconds_);
+
+	return(calibration);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Returns the upper 64 bits of the 96-bit product of the ticks and the
+	32.32 fixed-point multiplier (that is, the product shifted right by 32)
+	without resort to a 128-bit integer type.
+*/
+std::uint64_t ScaleTicks(std::uint64_t ticks, std::uint64_t multiplier)
+{
+	std::uint64_t ticks_hi      = ticks >> 32;
+	std::uint64_t ticks_lo      = ticks & 0xFFFFFFFFULL;
+	std::uint64_t multiplier_hi = multiplier >> 32;
+	std::uint64_t multiplier_lo = multiplier & 0xFFFFFFFFULL;
+
+	return((ticks_hi * multiplier) + (ticks_lo * multiplier_hi) +
+		((ticks_lo * multiplier_lo) >> 32));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The counters of different cores may differ slightly, so a thread can read
+	a value below the base taken at calibration. The elapsed ticks are then
+	clamped to zero rather than allowed to wrap to a time far in the future.
+*/
+TimeSpec GetTSCTime(const TSCCalibration &calibration)
+{
+	std::uint64_t now_ticks = __rdtsc();
+	std::uint64_t ticks     = (now_ticks > calibration.base_ticks_) ?
+		(now_ticks - calibration.base_ticks_) : 0;
+	std::uint64_t nsecs     = calibration.base_nanoseconds_ +
+		ScaleTicks(ticks, calibration.tick_multiplier_);
+
+	return(TimeSpec(static_cast<time_t>(nsecs / NanosecondsPerSecond),
+		static_cast<long>(nsecs % NanosecondsPerSecond)));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The kernel reports 'constant_tsc' and 'nonstop_tsc' where the TSC runs
+	at a fixed rate regardless of frequency scaling and processor sleep
+	states.
+*/
+bool HasInvariantTSC()
+{
+	std::ifstream cpuinfo_file("/proc/cpuinfo");
+	std::string   this_line;
+
+	while (std::getline(cpuinfo_file, this_line)) {
+		if (!this_line.compare(0, 5, "flags"))
+			return((this_line.find(" constant_tsc") != std::string::npos) &&
+				(this_line.find(" nonstop_tsc") != std::string::npos));
+	}
+
+	return(false);
+}
+// ////////////////////////////////////////////////////////////////////////////
+#endif // #ifdef MLB_LOGGER_HAS_TSC_CLOCK
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+TimeSpec LogClockNow()
+{
+	switch (ClockType.load(std::memory_order_acquire)) {
+		case LogClock_RealtimeCoarse	:
+			return(GetClockTime(CLOCK_REALTIME_COARSE));
+#ifdef MLB_LOGGER_HAS_TSC_CLOCK
+		case LogClock_TSC					:
+			return(GetTSCTime(LoadCalibration()));
+#endif // #ifdef MLB_LOGGER_HAS_TSC_CLOCK
+		default								:
+			break;
+	}
+
+	return(GetClockTime(CLOCK_REALTIME));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogClockType LogClockGetType()
+{
+	return(static_cast<LogClockType>(ClockType.load(std::memory_order_acquire)));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Selecting the TSC clock (even if already selected) measures the TSC rate
+	anew and re-anchors it to CLOCK_REALTIME. This takes some 20
+	milliseconds. The new calibration replaces the old, so re-selecting the
+	clock periodically doesn't consume memory.
+*/
+LogClockType LogClockSetType(LogClockType clock_type)
+{
+	if ((clock_type != LogClock_Realtime) &&
+		(clock_type != LogClock_RealtimeCoarse) && (clock_type != LogClock_TSC))
+		throw std::invalid_argument("Invalid log clock type (" +
+			std::to_string(static_cast<int>(clock_type)) + ").");
+
+	if (!LogClockIsAvailable(clock_type))
+		throw std::invalid_argument("The TSC log clock is not available on "
+			"this host.");
+
+	std::lock_guard<std::mutex> my_lock(ClockLock);
+
+#ifdef MLB_LOGGER_HAS_TSC_CLOCK
+	if (clock_type == LogClock_TSC)
+		StoreCalibration(CalibrateTSC());
+#endif // #ifdef MLB_LOGGER_HAS_TSC_CLOCK
+
+	return(static_cast<LogClockType>(ClockType.exchange(clock_type,
+		std::memory_order_acq_rel)));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogClockIsAvailable(LogClockType clock_type)
+{
+	if (clock_type != LogClock_TSC)
+		return(true);
+
+#ifdef MLB_LOGGER_HAS_TSC_CLOCK
+	static const bool TSCIsAvailable = HasInvariantTSC();
+
+	return(TSCIsAvailable);
+#else
+	return(false);
+#endif // #ifdef MLB_LOGGER_HAS_TSC_CLOCK
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Returns zero if the TSC clock has not been selected.
+*/
+double LogClockGetTSCTicksPerSecond()
+{
+	return(ClockCalibration.ticks_per_second_.load(std::memory_order_acquire));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+const char *TEST_ClockNameList[] = {
+	"Realtime",
+	"RealtimeCoarse",
+	"TSC"
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Checks that the clock agrees with CLOCK_REALTIME to within the resolution
+	of the clock and reports the cost of a reading.
+*/
+void TEST_Clock(MLB::Utility::LogClockType clock_type,
+	double tolerance_seconds)
+{
+	using namespace MLB::Utility;
+
+	const char *clock_name = TEST_ClockNameList[clock_type];
+
+	if (!LogClockIsAvailable(clock_type)) {
+		std::cout << std::left << std::setw(16) << clock_name << std::right <<
+			": not available on this host." << std::endl;
+		return;
+	}
+
+	LogClockSetType(clock_type);
+
+	double max_error = 0.0;
+
+	for (unsigned int count_1 = 0; count_1 < 1000; ++count_1) {
+		TimeSpec real_time(GetClockTime(CLOCK_REALTIME));
+		TimeSpec clock_time(LogClockNow());
+		double   this_error = clock_time.GetDifference(real_time).GetDouble();
+		max_error = std::max(max_error,
+			(this_error < 0.0) ? -this_error : this_error);
+	}
+
+	if (max_error > tolerance_seconds)
+		throw std::logic_error("The " + std::string(clock_name) + " log clock "
+			"differs from CLOCK_REALTIME by " + std::to_string(max_error) +
+			" seconds (tolerance is " + std::to_string(tolerance_seconds) +
+			" seconds).");
+
+	const unsigned int iteration_count = 1000000;
+	long               check_sum       = 0;
+	auto               start_time      = std::chrono::steady_clock::now();
+
+	for (unsigned int count_1 = 0; count_1 < iteration_count; ++count_1)
+		check_sum += LogClockNow().tv_nsec;
+
+	double elapsed_ns = std::chrono::duration<double, std::nano>(
+		std::chrono::steady_clock::now() - start_time).count();
+
+	std::cout << std::left << std::setw(16) << clock_name << std::right <<
+		": " << std::fixed << std::setprecision(1) << std::setw(6) <<
+		(elapsed_ns / iteration_count) << " ns per reading, maximum error " <<
+		std::setprecision(9) << max_error << " seconds" <<
+		((check_sum < 0) ? "." : "") << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	using namespace MLB::Utility;
+
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_Clock(LogClock_Realtime,       0.001);
+		TEST_Clock(LogClock_RealtimeCoarse, 0.020);
+		TEST_Clock(LogClock_TSC,            0.001);
+		if (LogClockGetTSCTicksPerSecond() > 0.0)
+			std::cout << "TSC rate        : " << std::fixed <<
+				std::setprecision(0) << LogClockGetTSCTicksPerSecond() <<
+				" ticks per second" << std::endl;
+		LogClockSetType(LogClock_Default);
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
@@ -11,8 +11,14 @@
                            Michael L. Brock
                         2023-01-05 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- Leader time and thread id text cached
+                                       per thread.
+                           Michael L. Brock
+                        2026-10-16 --- Leader time taken from the line start
+                                       time.
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 1998 - 2023.
+      Copyright Michael L. Brock 1998 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -26,8 +32,11 @@
 // ////////////////////////////////////////////////////////////////////////////
 
 #include <Logger/LogEmitControl.hpp>
+#include <Logger/LogClock.hpp>
 
-#include <Utility/ThreadId.hpp>
+#include <charconv>
+
+#include <pthread.h>
 
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -35,6 +44,168 @@ namespace MLB {
 
 namespace Utility {
 
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Length of the "YYYY-MM-DD hh:mm:ss." portion of the leader time.
+const std::size_t LeaderSecondsLength = Length_TimeSpec - 9;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void FormatThreadIdText(char *tid_text, ThreadId thread_id)
+{
+	char                 tmp_buffer[16];
+	std::to_chars_result result = std::to_chars(tmp_buffer,
+		tmp_buffer + sizeof(tmp_buffer), thread_id % 0xFFFFFFFF);
+	std::size_t          tid_length =
+		static_cast<std::size_t>(result.ptr - tmp_buffer);
+
+	//	Maximum length of a thread id is coerced to 10 characters...
+	if (tid_length > 10) {
+		::memcpy(tid_text, tmp_buffer, 9);
+		tid_text[9] = '>';
+	}
+	else {
+		::memset(tid_text, ' ', 10 - tid_length);
+		::memcpy(tid_text + (10 - tid_length), tmp_buffer, tid_length);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void FormatNanoseconds(char *nsecs_text, long tv_nsec)
+{
+	unsigned long nsecs = static_cast<unsigned long>(tv_nsec) % 1000000000L;
+
+	for (int count_1 = 8; count_1 >= 0; --count_1, nsecs /= 10)
+		nsecs_text[count_1] = static_cast<char>('0' + (nsecs % 10));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The parts of the leader which seldom change are cached for each thread.
+	The date and time to the second are formatted only when the second (or
+	the choice of UTC versus local time) changes; otherwise only the nine
+	nanosecond digits are formatted. The padded thread id text is formatted
+	once.
+
+	Being trivial, the cache is zero-initialized without any dynamic thread
+	local initialization overhead.
+*/
+struct LeaderCache {
+	bool     thread_id_valid_;
+	ThreadId thread_id_;
+	bool     tid_text_valid_;
+	ThreadId tid_text_id_;
+	char     tid_text_[10];
+	bool     time_valid_;
+	bool     time_is_local_;
+	time_t   time_secs_;
+	char     time_text_[Length_TimeSpec + 1];
+};
+
+thread_local LeaderCache ThreadLeaderCache;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The thread which calls fork() is the only thread in the child, but its
+	thread id is different there.
+*/
+void ResetThreadIdInChild()
+{
+	ThreadLeaderCache.thread_id_valid_ = false;
+}
+
+struct LeaderCacheForkHandler {
+	LeaderCacheForkHandler()
+	{
+		::pthread_atfork(NULL, NULL, ResetThreadIdInChild);
+	}
+};
+
+const LeaderCacheForkHandler MyLeaderCacheForkHandler;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+ThreadId GetLeaderThreadId()
+{
+	LeaderCache &cache_ref(ThreadLeaderCache);
+
+	if (!cache_ref.thread_id_valid_) {
+		cache_ref.thread_id_       = CurrentThreadId();
+		cache_ref.thread_id_valid_ = true;
+	}
+
+	return(cache_ref.thread_id_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void CopyThreadIdText(char *tid_text, ThreadId thread_id)
+{
+	LeaderCache &cache_ref(ThreadLeaderCache);
+
+	if ((!cache_ref.tid_text_valid_) || (cache_ref.tid_text_id_ != thread_id)) {
+		FormatThreadIdText(cache_ref.tid_text_, thread_id);
+		cache_ref.tid_text_id_    = thread_id;
+		cache_ref.tid_text_valid_ = true;
+	}
+
+	::memcpy(tid_text, cache_ref.tid_text_, 10);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void CopyTimeText(char *time_text, const TimeSpec &line_time, bool is_local)
+{
+	LeaderCache &cache_ref(ThreadLeaderCache);
+
+	if ((!cache_ref.time_valid_) || (cache_ref.time_secs_ != line_time.tv_sec) ||
+		(cache_ref.time_is_local_ != is_local)) {
+		if (is_local)
+			line_time.ToStringLocal(cache_ref.time_text_);
+		else
+			line_time.ToString(cache_ref.time_text_);
+		cache_ref.time_secs_     = line_time.tv_sec;
+		cache_ref.time_is_local_ = is_local;
+		cache_ref.time_valid_    = true;
+	}
+
+	::memcpy(time_text, cache_ref.time_text_, LeaderSecondsLength);
+	FormatNanoseconds(time_text + LeaderSecondsLength, line_time.tv_nsec);
+}
+// ////////////////////////////////////////////////////////////////////////////
+#else
+// ////////////////////////////////////////////////////////////////////////////
+ThreadId GetLeaderThreadId()
+{
+	return(CurrentThreadId());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void CopyThreadIdText(char *tid_text, ThreadId thread_id)
+{
+	FormatThreadIdText(tid_text, thread_id);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void CopyTimeText(char *time_text, const TimeSpec &line_time, bool is_local)
+{
+	if (is_local)
+		line_time.ToStringLocal(time_text);
+	else
+		line_time.ToString(time_text);
+}
+// ////////////////////////////////////////////////////////////////////////////
+#endif // #ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+
+} // Anonymous namespace
+
 // ////////////////////////////////////////////////////////////////////////////
 LogEmitControl::LogEmitControl(LogFlag log_flags, LogLevelFlag log_level_screen,
 	LogLevelFlag log_level_persistent, const TimeSpec &line_start_time,
@@ -46,34 +217,15 @@ LogEmitControl::LogEmitControl(LogFlag log_flags, LogLevelFlag log_level_screen,
 	,line_start_time_(line_start_time)
 	,log_level_(log_level)
 	,log_level_flag_(log_level_flag)
+	,thread_id_(GetLeaderThreadId())
 	,line_buffer_empty_()
 	,line_buffer_(line_buffer)
 	,this_line_offset_(0)
+	,leader_is_fixed_(false)
+	,field_ptr_(NULL)
+	,field_length_(0)
 {
-	memcpy(line_leader_ + Length_TimeSpec + 1,
-		 ConvertLogLevelToTextRaw(log_level), LogLevelTextMaxLength);
-	line_leader_[Length_TimeSpec + 1 + LogLevelTextMaxLength] = ' ';
-	//	Maximum length of a thread id is coerced to 10 characters...
-	{
-#if 0
-		char tid_string[IntToString_MaxLen_Unsigned_10 + 1];
-		IntToString(tid_string,
-			static_cast<Native_UInt32>(CurrentThreadId() % 0xFFFFFFFF), 10, " ");
-		memcpy(line_leader_ + Length_TimeSpec + 1 + LogLevelTextMaxLength + 1,
-			tid_string + (IntToString_MaxLen_Unsigned_10 - 10), 10);
-#else
-		std::string tid(std::to_string(CurrentThreadId() % 0xFFFFFFFF));
-		if (tid.size() > 10)
-			tid = tid.substr(0, 9) + ">";
-		else if (tid.size() < 10)
-			tid = std::string(10 - tid.size(), ' ') + tid;
-		memcpy(line_leader_ + Length_TimeSpec + 1 + LogLevelTextMaxLength + 1,
-			tid.c_str(), 10);
-#endif // #if 0
-	}
-	line_leader_[Length_TimeSpec + 1 + LogLevelTextMaxLength + 1 + 10] = ':';
-	line_leader_[Length_TimeSpec + 1 + LogLevelTextMaxLength + 1 + 11] = ' ';
-	line_leader_[Length_TimeSpec + 1 + LogLevelTextMaxLength + 1 + 12] = '\0';
+	FormatLeaderLevelAndThread(line_leader_, log_level, thread_id_);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -87,14 +239,48 @@ LogEmitControl::LogEmitControl(LogFlag log_flags, LogLevelFlag log_level_screen,
 	,line_start_time_(0, 0)
 	,log_level_(log_level)
 	,log_level_flag_(log_level_flag)
+	,thread_id_(GetLeaderThreadId())
 	,line_buffer_empty_()
 	,line_buffer_(line_buffer_empty_)
 	,this_line_offset_(0)
+	,leader_is_fixed_(false)
+	,field_ptr_(NULL)
+	,field_length_(0)
 {
 	line_leader_[0] = '\0';
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Used where the leader was formatted (by a call to UpdateTime()) in the
+	thread which originated the line, but the line is emitted by another
+	thread. Subsequent calls to UpdateTime() leave the leader unchanged.
+*/
+LogEmitControl::LogEmitControl(LogFlag log_flags, LogLevelFlag log_level_screen,
+	LogLevelFlag log_level_persistent, const TimeSpec &line_start_time,
+	LogLevel log_level, LogLevelFlag log_level_flag,
+	const std::string &line_buffer, ThreadId thread_id,
+	const char *line_leader)
+	:log_flags_(log_flags)
+	,log_level_screen_(log_level_screen)
+	,log_level_persistent_(log_level_persistent)
+	,line_start_time_(line_start_time)
+	,log_level_(log_level)
+	,log_level_flag_(log_level_flag)
+	,thread_id_(thread_id)
+	,line_buffer_empty_()
+	,line_buffer_(line_buffer)
+	,this_line_offset_(0)
+	,leader_is_fixed_(true)
+	,field_ptr_(NULL)
+	,field_length_(0)
+{
+	::memcpy(line_leader_, line_leader, LogLineLeaderLength);
+	line_leader_[LogLineLeaderLength] = '\0';
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 // ////////////////////////////////////////////////////////////////////////////
 unsigned int LogEmitControl::GetLeaderLength() const
 {
@@ -149,18 +335,65 @@ void LogEmitControl::ResetLines() const
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
+/*
+	Formats the leader time from the time at which the line was started.
+	Controls constructed without a start time use the current time.
+*/
 void LogEmitControl::UpdateTime() const
 {
-	if (log_flags_ & LogZeroTime)
-		::memcpy(line_leader_, "0000-00-00 00:00:00.000000000",
+	if (leader_is_fixed_)
+		return;
+
+	FormatLeaderTime(line_leader_,
+		(line_start_time_.tv_sec || line_start_time_.tv_nsec) ?
+		line_start_time_ : LogClockNow(), log_flags_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Writes the complete leader (including the terminating ASCII NUL) for a
+	line which was started at the specified time in the specified thread.
+	The leader_buffer parameter must point to at least
+	LogLineLeaderLength + 1 characters.
+*/
+char *LogEmitControl::FormatLeader(char *leader_buffer,
+	const TimeSpec &line_time, LogLevel log_level, ThreadId thread_id,
+	LogFlag log_flags)
+{
+	FormatLeaderLevelAndThread(leader_buffer, log_level, thread_id);
+	FormatLeaderTime(leader_buffer, line_time, log_flags);
+
+	return(leader_buffer);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogEmitControl::FormatLeaderLevelAndThread(char *leader_buffer,
+	LogLevel log_level, ThreadId thread_id)
+{
+	memcpy(leader_buffer + Length_TimeSpec + 1,
+		 ConvertLogLevelToTextRaw(log_level), LogLevelTextMaxLength);
+	leader_buffer[Length_TimeSpec + 1 + LogLevelTextMaxLength] = ' ';
+	CopyThreadIdText(leader_buffer + Length_TimeSpec + 1 +
+		LogLevelTextMaxLength + 1, thread_id);
+	leader_buffer[Length_TimeSpec + 1 + LogLevelTextMaxLength + 1 + 10] = ':';
+	leader_buffer[Length_TimeSpec + 1 + LogLevelTextMaxLength + 1 + 11] = ' ';
+	leader_buffer[Length_TimeSpec + 1 + LogLevelTextMaxLength + 1 + 12] = '\0';
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogEmitControl::FormatLeaderTime(char *leader_buffer,
+	const TimeSpec &line_time, LogFlag log_flags)
+{
+	if (log_flags & LogZeroTime)
+		::memcpy(leader_buffer, "0000-00-00 00:00:00.000000000",
 			Length_TimeSpec);
-	else {
-		if (log_flags_ & LogLocalTime)
-			TimeSpec().ToStringLocal(line_leader_);
-		else
-			TimeSpec().ToString(line_leader_);
-		line_leader_[Length_TimeSpec] = ' ';
-	}
+	else
+		CopyTimeText(leader_buffer, line_time, (log_flags & LogLocalTime) != 0);
+
+	leader_buffer[Length_TimeSpec] = ' ';
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -199,6 +432,13 @@ LogLevel LogEmitControl::GetLogLevel() const
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+ThreadId LogEmitControl::GetThreadId() const
+{
+	return(thread_id_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 // ////////////////////////////////////////////////////////////////////////////
 const std::string &LogEmitControl::GetLogMessage() const
 {
@@ -206,7 +446,210 @@ const std::string &LogEmitControl::GetLogMessage() const
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+bool LogEmitControl::HasFields() const
+{
+	return(field_ptr_ != NULL);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 } // namespace Utility
 
 } // namespace MLB
 
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogHandlerFile.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+const std::size_t TEST_IterationCount = 1000000;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	The leader formatting logic as it was prior to the per-thread cache.
+char *TEST_FormatLeaderUncached(char *leader_buffer,
+	const MLB::Utility::TimeSpec &line_time, MLB::Utility::LogLevel log_level,
+	MLB::Utility::ThreadId thread_id, MLB::Utility::LogFlag log_flags)
+{
+	using namespace MLB::Utility;
+
+	memcpy(leader_buffer + Length_TimeSpec + 1,
+		 ConvertLogLevelToTextRaw(log_level), LogLevelTextMaxLength);
+	leader_buffer[Length_TimeSpec + 1 + LogLevelTextMaxLength] = ' ';
+	std::string tid(std::to_string(thread_id % 0xFFFFFFFF));
+	if (tid.size() > 10)
+		tid = tid.substr(0, 9) + ">";
+	else if (tid.size() < 10)
+		tid = std::string(10 - tid.size(), ' ') + tid;
+	memcpy(leader_buffer + Length_TimeSpec + 1 + LogLevelTextMaxLength + 1,
+		tid.c_str(), 10);
+	leader_buffer[Length_TimeSpec + 1 + LogLevelTextMaxLength + 1 + 10] = ':';
+	leader_buffer[Length_TimeSpec + 1 + LogLevelTextMaxLength + 1 + 11] = ' ';
+	leader_buffer[Length_TimeSpec + 1 + LogLevelTextMaxLength + 1 + 12] = '\0';
+
+	if (log_flags & LogLocalTime)
+		line_time.ToStringLocal(leader_buffer);
+	else
+		line_time.ToString(leader_buffer);
+	leader_buffer[Length_TimeSpec] = ' ';
+
+	return(leader_buffer);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_CompareLeaders()
+{
+	using namespace MLB::Utility;
+
+	const long     nsecs_list[] = { 0, 1, 999, 123456789, 999999999 };
+	const ThreadId tid_list[]   = { 0, 1, 12345, 0xFFFFFFFE, 0xFFFFFFFF };
+	char           leader_1[LogLineLeaderLength + 1];
+	char           leader_2[LogLineLeaderLength + 1];
+	std::size_t    compare_count = 0;
+
+	for (int count_1 = 0; count_1 < 2; ++count_1) {
+		LogFlag log_flags = (count_1) ? LogLocalTime : Default;
+		for (time_t secs = 1700000000; secs < 1700000003; ++secs) {
+			for (long nsecs : nsecs_list) {
+				for (ThreadId tid : tid_list) {
+					TimeSpec line_time(secs, nsecs);
+					LogEmitControl::FormatLeader(leader_1, line_time,
+						LogLevel_Warning, tid, log_flags);
+					TEST_FormatLeaderUncached(leader_2, line_time,
+						LogLevel_Warning, tid, log_flags);
+					if (::memcmp(leader_1, leader_2, LogLineLeaderLength + 1))
+						throw std::logic_error("Cached leader '" +
+							std::string(leader_1) + "' differs from the uncached "
+							"leader '" + std::string(leader_2) + "'.");
+					++compare_count;
+				}
+			}
+		}
+	}
+
+	std::cout << "Compared " << compare_count << " cached and uncached "
+		"leaders: all identical." << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+double TEST_ElapsedSeconds(std::chrono::steady_clock::time_point start_time)
+{
+	return(std::chrono::duration<double>(std::chrono::steady_clock::now() -
+		start_time).count());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_EmitResult(const char *test_name, double elapsed_secs)
+{
+	std::cout << std::left << std::setw(40) << test_name << std::right <<
+		": " << std::setw(12) << std::fixed << std::setprecision(0) <<
+		(static_cast<double>(TEST_IterationCount) / elapsed_secs) <<
+		" per second (" << std::setprecision(1) <<
+		((elapsed_secs * 1.0e9) / static_cast<double>(TEST_IterationCount)) <<
+		" ns each)" << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Benchmark()
+{
+	using namespace MLB::Utility;
+
+	char        line_leader[LogLineLeaderLength + 1];
+	std::string line_buffer("A log line of a typical length: order 12345678 "
+		"acknowledged at 101.25 for 500 shares.");
+
+	{
+		std::chrono::steady_clock::time_point start_time =
+			std::chrono::steady_clock::now();
+		for (std::size_t count_1 = 0; count_1 < TEST_IterationCount; ++count_1)
+			TEST_FormatLeaderUncached(line_leader, TimeSpec(), LogLevel_Info,
+				CurrentThreadId(), Default);
+		TEST_EmitResult("Leader format (uncached)",
+			TEST_ElapsedSeconds(start_time));
+	}
+
+	{
+		std::chrono::steady_clock::time_point start_time =
+			std::chrono::steady_clock::now();
+		for (std::size_t count_1 = 0; count_1 < TEST_IterationCount; ++count_1) {
+			LogEmitControl emit_control(Default, LogFlag_Mask, LogFlag_Mask,
+				TimeSpec(), LogLevel_Info, LogFlag_Info, line_buffer);
+			emit_control.UpdateTime();
+		}
+		TEST_EmitResult("Leader format (cached)",
+			TEST_ElapsedSeconds(start_time));
+	}
+
+	LogHandlerFile null_handler("/dev/null", LogHandlerFile::NoConsoleOutput);
+
+	{
+		//	The leader is formatted as before and passed as fixed...
+		std::chrono::steady_clock::time_point start_time =
+			std::chrono::steady_clock::now();
+		for (std::size_t count_1 = 0; count_1 < TEST_IterationCount; ++count_1) {
+			TimeSpec       line_time;
+			ThreadId       thread_id = CurrentThreadId();
+			LogEmitControl emit_control(Default, LogFlag_Mask, LogFlag_Mask,
+				line_time, LogLevel_Info, LogFlag_Info, line_buffer, thread_id,
+				TEST_FormatLeaderUncached(line_leader, line_time, LogLevel_Info,
+				thread_id, Default));
+			null_handler.EmitLine(emit_control);
+		}
+		TEST_EmitResult("LogHandlerFile to /dev/null (uncached)",
+			TEST_ElapsedSeconds(start_time));
+	}
+
+	{
+		std::chrono::steady_clock::time_point start_time =
+			std::chrono::steady_clock::now();
+		for (std::size_t count_1 = 0; count_1 < TEST_IterationCount; ++count_1) {
+			LogEmitControl emit_control(Default, LogFlag_Mask, LogFlag_Mask,
+				TimeSpec(), LogLevel_Info, LogFlag_Info, line_buffer);
+			null_handler.EmitLine(emit_control);
+		}
+		TEST_EmitResult("LogHandlerFile to /dev/null (cached)",
+			TEST_ElapsedSeconds(start_time));
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_CompareLeaders();
+		TEST_Benchmark();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
@@ -0,0 +1,415 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogEvent.cpp
+
+   File Description  :  Implementation of structured key/value log events.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogEvent.hpp>
+
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+const char *ExtractEventName(const char *field_ptr, const char *end_ptr,
+	LogBinaryArg &name_arg)
+{
+	field_ptr = LogBinaryExtractArg(field_ptr, end_ptr, name_arg);
+
+	if (name_arg.arg_type_ != LogBinaryArgType_String)
+		throw std::runtime_error("Invalid structured log event: the event "
+			"name is not a string.");
+
+	return(field_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool TextNeedsQuotes(const char *text_ptr, std::size_t text_length)
+{
+	if (!text_length)
+		return(true);
+
+	for (std::size_t count_1 = 0; count_1 < text_length; ++count_1) {
+		char this_char = text_ptr[count_1];
+		if ((this_char == ' ') || (this_char == '"') || (this_char == '=') ||
+			(this_char == '\t') || (this_char == '\n'))
+			return(true);
+	}
+
+	return(false);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void AppendTextValue(const LogBinaryArg &arg, std::string &out_string)
+{
+	if ((arg.arg_type_ != LogBinaryArgType_String) ||
+		(!TextNeedsQuotes(arg.string_ptr_, arg.string_length_))) {
+		LogBinaryAppendArg(arg, out_string);
+		return;
+	}
+
+	out_string.push_back('"');
+
+	for (std::size_t count_1 = 0; count_1 < arg.string_length_; ++count_1) {
+		char this_char = arg.string_ptr_[count_1];
+		if ((this_char == '"') || (this_char == '\\'))
+			out_string.push_back('\\');
+		out_string.push_back(this_char);
+	}
+
+	out_string.push_back('"');
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void AppendJsonString(const char *text_ptr, std::size_t text_length,
+	std::string &out_string)
+{
+	static const char HexDigitList[] = "0123456789abcdef";
+
+	out_string.push_back('"');
+
+	for (std::size_t count_1 = 0; count_1 < text_length; ++count_1) {
+		unsigned char this_char = static_cast<unsigned char>(text_ptr[count_1]);
+		switch (this_char) {
+			case '"'		:
+				out_string.append("\\\"");
+				break;
+			case '\\'	:
+				out_string.append("\\\\");
+				break;
+			case '\n'	:
+				out_string.append("\\n");
+				break;
+			case '\r'	:
+				out_string.append("\\r");
+				break;
+			case '\t'	:
+				out_string.append("\\t");
+				break;
+			default		:
+				if (this_char < 0x20) {
+					out_string.append("\\u00");
+					out_string.push_back(HexDigitList[this_char >> 4]);
+					out_string.push_back(HexDigitList[this_char & 0x0F]);
+				}
+				else
+					out_string.push_back(static_cast<char>(this_char));
+				break;
+		}
+	}
+
+	out_string.push_back('"');
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	JSON has no representation for non-finite numbers, so they're rendered
+	as null.
+*/
+void AppendJsonValue(const LogBinaryArg &arg, std::string &out_string)
+{
+	switch (arg.arg_type_) {
+		case LogBinaryArgType_Char		:
+			{
+				char datum = static_cast<char>(arg.int_value_);
+				AppendJsonString(&datum, 1, out_string);
+			}
+			break;
+		case LogBinaryArgType_Double	:
+			if (!std::isfinite(arg.double_value_))
+				out_string.append("null");
+			else
+				LogBinaryAppendArg(arg, out_string);
+			break;
+		case LogBinaryArgType_String	:
+			AppendJsonString(arg.string_ptr_, arg.string_length_, out_string);
+			break;
+		case LogBinaryArgType_Pointer	:
+			{
+				std::string tmp_string;
+				LogBinaryAppendArg(arg, tmp_string);
+				AppendJsonString(tmp_string.data(), tmp_string.size(), out_string);
+			}
+			break;
+		default								:
+			LogBinaryAppendArg(arg, out_string);
+			break;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogEventCheckFields(const char *field_ptr, std::size_t field_length)
+{
+	const char   *end_ptr = field_ptr + field_length;
+	LogBinaryArg  this_arg;
+
+	if (((field_ptr = LogBinaryTryExtractArg(field_ptr, end_ptr, this_arg)) ==
+		NULL) || (this_arg.arg_type_ != LogBinaryArgType_String))
+		return(false);
+
+	while (field_ptr < end_ptr) {
+		if (((field_ptr = LogBinaryTryExtractArg(field_ptr, end_ptr,
+			this_arg)) == NULL) || (field_ptr >= end_ptr) ||
+			((field_ptr = LogBinaryTryExtractArg(field_ptr, end_ptr,
+			this_arg)) == NULL))
+			return(false);
+	}
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string &LogEventRenderText(const char *field_ptr,
+	std::size_t field_length, std::string &out_string)
+{
+	const char   *end_ptr = field_ptr + field_length;
+	LogBinaryArg  this_arg;
+
+	out_string.clear();
+
+	field_ptr = ExtractEventName(field_ptr, end_ptr, this_arg);
+
+	out_string.append(this_arg.string_ptr_, this_arg.string_length_);
+
+	while (field_ptr < end_ptr) {
+		out_string.push_back(' ');
+		field_ptr = LogBinaryExtractArg(field_ptr, end_ptr, this_arg);
+		LogBinaryAppendArg(this_arg, out_string);
+		out_string.push_back('=');
+		if (field_ptr >= end_ptr)
+			throw std::runtime_error("Invalid structured log event: a field "
+				"has no value.");
+		field_ptr = LogBinaryExtractArg(field_ptr, end_ptr, this_arg);
+		AppendTextValue(this_arg, out_string);
+	}
+
+	return(out_string);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string &LogEventRenderJson(const LogEmitControl &emit_control,
+	std::string &out_string)
+{
+	const char   *field_ptr = emit_control.field_ptr_;
+	const char   *end_ptr   = field_ptr + emit_control.field_length_;
+	char          time_text[Length_TimeSpec + 1];
+	const char   *level_text = ConvertLogLevelToTextRaw(emit_control.log_level_);
+	std::size_t   level_length = LogLevelTextMaxLength;
+	LogBinaryArg  this_arg;
+
+	if (field_ptr == NULL)
+		throw std::invalid_argument("Unable to render a log record which is "
+			"not a structured event as JSON.");
+
+	if (emit_control.log_flags_ & LogZeroTime)
+		::memcpy(time_text, "0000-00-00 00:00:00.000000000",
+			Length_TimeSpec + 1);
+	else if (emit_control.log_flags_ & LogLocalTime)
+		emit_control.line_start_time_.ToStringLocal(time_text);
+	else
+		emit_control.line_start_time_.ToString(time_text);
+
+	while (level_length && (level_text[level_length - 1] == ' '))
+		--level_length;
+
+	out_string.assign("{\"time\":\"");
+	out_string.append(time_text, Length_TimeSpec);
+	out_string.append("\",\"level\":\"");
+	out_string.append(level_text, level_length);
+	out_string.append("\",\"tid\":");
+	LogBinaryArg tid_arg = { LogBinaryArgType_UInt, 0,
+		(emit_control.log_flags_ & LogZeroTid) ? 0 :
+		static_cast<std::uint64_t>(emit_control.thread_id_), 0.0, NULL, 0 };
+	LogBinaryAppendArg(tid_arg, out_string);
+	out_string.append(",\"event\":");
+
+	field_ptr = ExtractEventName(field_ptr, end_ptr, this_arg);
+
+	AppendJsonString(this_arg.string_ptr_, this_arg.string_length_,
+		out_string);
+
+	while (field_ptr < end_ptr) {
+		out_string.push_back(',');
+		field_ptr = LogBinaryExtractArg(field_ptr, end_ptr, this_arg);
+		if (this_arg.arg_type_ == LogBinaryArgType_String)
+			AppendJsonString(this_arg.string_ptr_, this_arg.string_length_,
+				out_string);
+		else {
+			std::string tmp_string;
+			LogBinaryAppendArg(this_arg, tmp_string);
+			AppendJsonString(tmp_string.data(), tmp_string.size(), out_string);
+		}
+		out_string.push_back(':');
+		if (field_ptr >= end_ptr)
+			throw std::runtime_error("Invalid structured log event: a field "
+				"has no value.");
+		field_ptr = LogBinaryExtractArg(field_ptr, end_ptr, this_arg);
+		AppendJsonValue(this_arg, out_string);
+	}
+
+	out_string.push_back('}');
+
+	return(out_string);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogManager.hpp>
+#include <Logger/LogTestSupport.hpp>
+
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Check(const std::string &actual, const std::string &expected)
+{
+	if (actual != expected)
+		throw std::logic_error("Structured log event rendered as '" + actual +
+			"', expected '" + expected + "'.");
+
+	std::cout << actual << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Render()
+{
+	using namespace MLB::Utility;
+
+	std::string   field_buffer;
+	std::string   out_string;
+	std::string   venue("NYSE ARCA");
+	std::uint64_t order_id = 12345678901ULL;
+
+	LogEventEncode(field_buffer, "order_ack", LogKV("id", order_id),
+		LogKV("px", 101.25), LogKV("qty", -300), LogKV("venue", venue),
+		LogKV("ok", true), LogKV("side", 'B'), LogKV("note", "say \"hi\""),
+		LogKV("empty", ""), LogKV("nan",
+		std::numeric_limits<double>::quiet_NaN()));
+
+	TEST_Check(LogEventRenderText(field_buffer.data(), field_buffer.size(),
+		out_string), "order_ack id=12345678901 px=101.25 qty=-300 "
+		"venue=\"NYSE ARCA\" ok=true side=B note=\"say \\\"hi\\\"\" "
+		"empty=\"\" nan=nan");
+
+	LogEmitControl emit_control(static_cast<LogFlag>(LogZeroTime | LogZeroTid),
+		LogFlag_Mask, LogFlag_Mask, LogLevel_Info, LogFlag_Info);
+	emit_control.field_ptr_    = field_buffer.data();
+	emit_control.field_length_ = field_buffer.size();
+
+	TEST_Check(LogEventRenderJson(emit_control, out_string),
+		"{\"time\":\"0000-00-00 00:00:00.000000000\",\"level\":\"INFO\","
+		"\"tid\":0,\"event\":\"order_ack\",\"id\":12345678901,\"px\":101.25,"
+		"\"qty\":-300,\"venue\":\"NYSE ARCA\",\"ok\":true,\"side\":\"B\","
+		"\"note\":\"say \\\"hi\\\"\",\"empty\":\"\",\"nan\":null}");
+
+	LogEventEncode(field_buffer, "heartbeat");
+
+	TEST_Check(LogEventRenderText(field_buffer.data(), field_buffer.size(),
+		out_string), "heartbeat");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Emit(MLB::Utility::LogFlag log_flags, const std::string &expected)
+{
+	using namespace MLB::Utility;
+
+	LogSPtr<LogHandlerCapture> capture_ptr(new LogHandlerCapture);
+	LogManager                 log_manager(capture_ptr, log_flags);
+	LogStream                  log_info(log_manager, LogLevel_Info);
+	LogStream                  log_debug(log_manager, LogLevel_Debug);
+
+	log_manager.SetLogLevelConsole(LogLevel_Info);
+	log_manager.SetLogLevelFile(LogLevel_Info);
+
+	log_debug.Event("filtered", LogKV("id", 1));
+	log_info.Event("session_up", LogKV("host", "nats-1"), LogKV("port", 4222));
+
+	std::vector<std::string> message_list(TEST_GetCapturedMessages(
+		*capture_ptr));
+
+	TEST_ExpectCount("Structured log events emitted", message_list.size(), 1);
+	TEST_Check(message_list[0], expected);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	using namespace MLB::Utility;
+
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_Render();
+		TEST_Emit(Default, "session_up host=nats-1 port=4222");
+		TEST_Emit(static_cast<LogFlag>(LogJsonEvent | LogZeroTime | LogZeroTid),
+			"{\"time\":\"0000-00-00 00:00:00.000000000\",\"level\":\"INFO\","
+			"\"tid\":0,\"event\":\"session_up\",\"host\":\"nats-1\","
+			"\"port\":4222}");
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
@@ -0,0 +1,367 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogFileRotator.cpp
+
+   File Description  :  Implementation of log file rotation support.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogFileRotator.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <zlib.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+LogFileRotationSpec::LogFileRotationSpec(std::uint64_t max_file_size,
+	unsigned int interval_seconds, Compression compression)
+	:max_file_size_(max_file_size)
+	,interval_seconds_(interval_seconds)
+	,compression_(compression)
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogFileRotationSpec::IsEnabled() const
+{
+	return((max_file_size_ != 0) || (interval_seconds_ != 0));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogFileRotator::LogFileRotator(const LogFileRotationSpec &rotation_spec)
+	:rotation_spec_(rotation_spec)
+	,file_size_(0)
+	,deferred_size_(0)
+	,next_rotation_time_(0)
+	,rotation_count_(0)
+	,compression_failure_count_(0)
+	,compress_queue_()
+	,compress_busy_(false)
+	,compress_stop_(false)
+	,compress_thread_()
+	,compress_lock_()
+	,compress_cond_()
+{
+	SetNextRotationTime(::time(NULL));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Segments already queued are compressed before the destructor returns.
+*/
+LogFileRotator::~LogFileRotator()
+{
+	{
+		LogLockScoped my_lock(compress_lock_);
+		compress_stop_ = true;
+	}
+
+	compress_cond_.notify_all();
+
+	if (compress_thread_.joinable())
+		compress_thread_.join();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const LogFileRotationSpec &LogFileRotator::GetRotationSpec() const
+{
+	return(rotation_spec_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFileRotator::SetRotationSpec(const LogFileRotationSpec &rotation_spec)
+{
+	rotation_spec_ = rotation_spec;
+
+	SetNextRotationTime(::time(NULL));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFileRotator::FileOpened(std::uint64_t file_size)
+{
+	file_size_     = file_size;
+	deferred_size_ = 0;
+
+	SetNextRotationTime(::time(NULL));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Called by the handler instead of rotating an empty file, or when the
+	active file couldn't be renamed. The size of the file is retained, and
+	rotation is next due after the maximum size has again been written or at
+	the next interval boundary.
+*/
+void LogFileRotator::DeferRotation()
+{
+	deferred_size_ = file_size_;
+
+	SetNextRotationTime(::time(NULL));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	An empty file is never rotated on the basis of size, so a single line
+	longer than the maximum size is written intact.
+*/
+bool LogFileRotator::CheckRotate(std::size_t pending_length) const
+{
+	std::uint64_t check_size = file_size_ - deferred_size_;
+
+	if (rotation_spec_.max_file_size_ && check_size &&
+		((check_size + pending_length) > rotation_spec_.max_file_size_))
+		return(true);
+
+	return(rotation_spec_.interval_seconds_ &&
+		(::time(NULL) >= next_rotation_time_));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFileRotator::AddBytes(std::size_t written_length)
+{
+	file_size_ += written_length;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogFileRotator::GetFileSize() const
+{
+	return(file_size_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Called by the handler after it has closed the active file. Returns the
+	name of the segment or an empty string if the rename failed, in which
+	case the handler re-opens and continues to append to the active file.
+*/
+std::string LogFileRotator::RenameToSegment(const std::string &file_name)
+{
+	std::string segment_name(MakeSegmentName(file_name, TimeSpec()));
+
+	if (::rename(file_name.c_str(), segment_name.c_str()))
+		segment_name.clear();
+	else
+		++rotation_count_;
+
+	return(segment_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFileRotator::SegmentCompleted(const std::string &segment_name)
+{
+	if (segment_name.empty() ||
+		(rotation_spec_.compression_ == LogFileRotationSpec::Compression_None))
+		return;
+
+	{
+		LogLockScoped my_lock(compress_lock_);
+		compress_queue_.push_back(segment_name);
+		if (!compress_thread_.joinable())
+			compress_thread_ =
+				std::thread(&LogFileRotator::CompressThreadProc, this);
+	}
+
+	compress_cond_.notify_all();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFileRotator::WaitForCompression()
+{
+	std::unique_lock<LogLock> my_lock(compress_lock_);
+
+	compress_cond_.wait(my_lock, [this]() {
+		return(compress_queue_.empty() && (!compress_busy_));
+	});
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogFileRotator::GetRotationCount() const
+{
+	return(rotation_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogFileRotator::GetCompressionFailureCount() const
+{
+	LogLockScoped my_lock(compress_lock_);
+
+	return(compression_failure_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string LogFileRotator::MakeSegmentName(const std::string &file_name,
+	const TimeSpec &rotation_time)
+{
+/*
+YYYY-MM-DD hh:mm:ss.nnnnnnnnn
+012345678901234567890123456789
+          1         2
+*/
+	std::string            dt(rotation_time.ToString());
+	std::string::size_type slash_pos = file_name.find_last_of("/\\");
+	std::string::size_type dot_pos   = file_name.find_last_of('.');
+
+	if ((dot_pos == std::string::npos) || (!dot_pos) ||
+		((slash_pos != std::string::npos) && (dot_pos <= (slash_pos + 1))))
+		dot_pos = file_name.size();
+
+	std::string stem_name(file_name.substr(0, dot_pos) + "." +
+		dt.substr( 0, 4) + dt.substr( 5, 2) + dt.substr( 8, 2) + "_" +
+		dt.substr(11, 2) + dt.substr(14, 2) + dt.substr(17, 2) + "_" +
+		dt.substr(20));
+	std::string extension(file_name.substr(dot_pos));
+	std::string segment_name(stem_name + extension);
+	struct stat stat_data;
+
+	//	Two rotations within the same nanosecond are unlikely, but...
+	for (unsigned int count_1 = 1;
+		(!::stat(segment_name.c_str(), &stat_data)) ||
+		(!::stat((segment_name + ".gz").c_str(), &stat_data)); ++count_1)
+		segment_name = stem_name + "." + std::to_string(count_1) + extension;
+
+	return(segment_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The compressed file is written under a temporary name and renamed when
+	complete, so a partially-compressed file is never mistaken for a
+	complete one.
+*/
+void LogFileRotator::CompressFile(const std::string &src_file_name,
+	const std::string &dst_file_name)
+{
+	std::ifstream src_file(src_file_name.c_str(),
+		std::ios_base::in | std::ios_base::binary);
+
+	if (!src_file)
+		throw std::runtime_error("Unable to open log file segment '" +
+			src_file_name + "' for compression.");
+
+	std::string tmp_file_name(dst_file_name + ".tmp");
+	gzFile      dst_file = ::gzopen(tmp_file_name.c_str(), "wb");
+
+	if (dst_file == NULL)
+		throw std::runtime_error("Unable to open compressed log file segment '" +
+			tmp_file_name + "' for writing.");
+
+	std::vector<char> buffer(1 << 16);
+	bool              write_ok = true;
+
+	while (write_ok && src_file) {
+		src_file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		if (src_file.gcount() > 0)
+			write_ok = ::gzwrite(dst_file, buffer.data(),
+				static_cast<unsigned int>(src_file.gcount())) ==
+				static_cast<int>(src_file.gcount());
+	}
+
+	if ((::gzclose(dst_file) != Z_OK) || (!write_ok) || src_file.bad()) {
+		::remove(tmp_file_name.c_str());
+		throw std::runtime_error("Attempt to compress log file segment '" +
+			src_file_name + "' to '" + dst_file_name + "' failed.");
+	}
+
+	if (::rename(tmp_file_name.c_str(), dst_file_name.c_str())) {
+		::remove(tmp_file_name.c_str());
+		throw std::runtime_error("Unable to rename compressed log file "
+			"segment '" + tmp_file_name + "' to '" + dst_file_name + "'.");
+	}
+
+	::remove(src_file_name.c_str());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFileRotator::SetNextRotationTime(time_t current_time)
+{
+	if (rotation_spec_.interval_seconds_) {
+		time_t interval = static_cast<time_t>(rotation_spec_.interval_seconds_);
+		next_rotation_time_ = ((current_time / interval) + 1) * interval;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Failures leave the uncompressed segment in place. They can't be logged
+	here, as doing so could recurse into the handler being rotated.
+*/
+void LogFileRotator::CompressThreadProc()
+{
+	std::unique_lock<LogLock> my_lock(compress_lock_);
+
+	for ( ; ; ) {
+		compress_cond_.wait(my_lock, [this]() {
+			return(compress_stop_ || (!compress_queue_.empty()));
+		});
+		if (compress_queue_.empty())
+			break;
+		std::string segment_name(compress_queue_.front());
+		compress_queue_.pop_front();
+		compress_busy_ = true;
+		my_lock.unlock();
+		bool compress_ok = true;
+		try {
+			CompressFile(segment_name, segment_name + ".gz");
+		}
+		catch (const std::exception &) {
+			compress_ok = false;
+		}
+		my_lock.lock();
+		compress_busy_ = false;
+		if (!compress_ok)
+			++compression_failure_count_;
+		compress_cond_.notify_all();
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
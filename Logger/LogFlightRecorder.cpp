@@ -0,0 +1,1416 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogFlightRecorder.cpp
+
+   File Description  :  Implementation of the crash-safe log flight recorder.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogFlightRecorder.hpp>
+#include <Logger/LogEvent.hpp>
+#include <Logger/LogHandler.hpp>
+
+#include <Utility/ThreadId.hpp>
+#include <Utility/ThrowErrno.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The file begins with this header, followed by 'ring_count_' rings. Each
+	ring is a RingHeader followed by 'record_count_' records of
+	'record_size_' bytes, each a RecordHeader followed by the record data.
+
+	The rings are followed by the format area of 'format_size_' bytes (at
+	'format_offset_'): a FormatHeader followed by FormatEntry instances,
+	each followed by its format string padded to a multiple of 8 bytes.
+*/
+struct LogFlightRecorder::FileHeader {
+	char          magic_[8];
+	std::uint32_t header_size_;
+	std::uint32_t ring_count_;
+	std::uint32_t record_count_;
+	std::uint32_t record_size_;
+	std::uint64_t ring_size_;
+	std::int64_t  process_id_;
+	std::uint64_t format_offset_;
+	std::uint32_t format_size_;
+	char          reserved_[12];
+};
+
+struct LogFlightRecorder::RingHeader {
+	//	The index of the next record to be written.
+	std::atomic<std::uint64_t> next_index_;
+	std::atomic<std::uint32_t> owned_flag_;
+	char                       reserved_[52];
+};
+
+/*
+	'sequence_' is the index of the record within its ring. It's set to
+	'NoSequence' while the record is being written so that a reader can
+	detect a record which changed while it was being read.
+
+	The data of a record with a 'format_id_' of LogBinaryFormatId_Text is
+	the text of the line. Otherwise it's the encoded arguments of a deferred
+	log statement or the encoded fields of a structured event.
+*/
+struct LogFlightRecorder::RecordHeader {
+	std::atomic<std::uint64_t> sequence_;
+	std::int64_t               time_secs_;
+	std::uint32_t              time_nsecs_;
+	std::uint32_t              thread_id_;
+	std::uint16_t              log_level_;
+	std::uint16_t              line_length_;
+	std::uint32_t              format_id_;
+};
+
+struct LogFlightRecorder::FormatHeader {
+	std::atomic<std::uint64_t> used_size_;
+	char                       reserved_[56];
+};
+
+/*
+	'format_id_' is one greater than the format id. It's stored after the
+	format string so that a reader can skip an entry which is incomplete.
+*/
+struct LogFlightRecorder::FormatEntry {
+	std::atomic<std::uint32_t> format_id_;
+	std::uint32_t              format_length_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+const char          FileMagic[8] = { 'M', 'L', 'B', 'F', 'L', 'T', 'R', '1' };
+const std::uint64_t NoSequence   = ~static_cast<std::uint64_t>(0);
+const std::size_t   MinDumpSize  = 64 * 1024;
+const char          InvalidRecordText[] = "[invalid record data]";
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The slots in which a recorder notes the formats it has copied to the
+	format area. Each holds the format id plus one, shifted left by two, and
+	one of the states below in the low bits.
+*/
+const std::size_t   FormatSlotCount   = 1024;
+const std::uint64_t FormatSlotPending = 1;
+const std::uint64_t FormatSlotWritten = 2;
+const std::uint64_t FormatSlotFailed  = 3;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Deferred statements which can't be recorded as-is are rendered here.
+thread_local std::string RecordRenderBuffer;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	A copy of the contents of a RecordHeader taken by the reader.
+struct RecordData {
+	std::int64_t  time_secs_;
+	std::uint32_t time_nsecs_;
+	std::uint32_t thread_id_;
+	std::uint16_t log_level_;
+	std::uint16_t line_length_;
+	std::uint32_t format_id_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Returns the format string of a deferred log statement, or NULL if it
+	isn't known.
+*/
+typedef const char *(*FormatLookupFunc)(const void *lookup_context,
+	LogBinaryFormatId format_id);
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The buffers used by DumpRings(). The cursor list must have room for two
+	entries per ring, the buffer for at least two maximum-length lines, the
+	format buffer for a maximum-length line and its terminator and the
+	render string must have the capacity given by GetRenderSize().
+*/
+struct DumpBuffers {
+	std::uint64_t    *cursor_list_;
+	char             *buffer_ptr_;
+	std::size_t       buffer_size_;
+	char             *format_ptr_;
+	std::string      *render_ptr_;
+	FormatLookupFunc  lookup_func_;
+	const void       *lookup_context_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The live recorders, by serial number. A thread which exits releases its
+	ring only if the recorder which owns it still exists.
+*/
+LogLock                                       RecorderListLock;
+std::map<std::uint64_t, LogFlightRecorder *>  RecorderList;
+std::uint64_t                                 RecorderSerialNext = 1;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	These are trivially-initialized so that they may safely be examined after
+	the thread's instance of ThreadRingReleaser has been destroyed (lines may
+	be emitted by the destructors of other thread-local objects).
+*/
+thread_local std::uint64_t                   ThreadRingSerial = 0;
+thread_local LogFlightRecorder::RingHeader  *ThreadRingPtr    = NULL;
+thread_local bool                            ThreadRingGone   = false;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void ReleaseThreadRing()
+{
+	if (ThreadRingPtr != NULL) {
+		LogLockScoped my_lock(RecorderListLock);
+		if (RecorderList.find(ThreadRingSerial) != RecorderList.end())
+			ThreadRingPtr->owned_flag_.store(0, std::memory_order_release);
+	}
+
+	ThreadRingSerial = 0;
+	ThreadRingPtr    = NULL;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+class ThreadRingReleaser {
+public:
+	ThreadRingReleaser()
+	{
+	}
+
+	~ThreadRingReleaser()
+	{
+		ReleaseThreadRing();
+		ThreadRingGone = true;
+	}
+
+	void Touch()
+	{
+	}
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+thread_local ThreadRingReleaser ThreadReleaser;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::atomic<const LogFlightRecorder *> FatalRecorderPtr(nullptr);
+char                                   FatalDumpFileName[4096] = { '\0' };
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Only async-signal-safe operations from here through DumpRings().
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool WriteAll(int out_fd, const char *data_ptr, std::size_t data_length)
+{
+	while (data_length) {
+		ssize_t write_count = ::write(out_fd, data_ptr, data_length);
+		if (write_count < 0) {
+			if (errno == EINTR)
+				continue;
+			return(false);
+		}
+		data_ptr    += write_count;
+		data_length -= static_cast<std::size_t>(write_count);
+	}
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+char *PutUInt(char *out_ptr, std::uint64_t value, unsigned int min_width,
+	char pad_char = '0')
+{
+	char         digit_list[24];
+	unsigned int digit_count = 0;
+
+	do {
+		digit_list[digit_count++] = static_cast<char>('0' + (value % 10));
+		value /= 10;
+	} while (value);
+
+	while (min_width-- > digit_count)
+		*out_ptr++ = pad_char;
+
+	while (digit_count)
+		*out_ptr++ = digit_list[--digit_count];
+
+	return(out_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+char *PutText(char *out_ptr, const char *text_ptr)
+{
+	while (*text_ptr)
+		*out_ptr++ = *text_ptr++;
+
+	return(out_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Formats the time as 'YYYY-MM-DD HH:MM:SS.nnnnnnnnn' (UTC) without the
+	assistance of gmtime(), which isn't async-signal-safe.
+*/
+char *PutTime(char *out_ptr, std::int64_t time_secs, std::uint32_t time_nsecs)
+{
+	std::int64_t day_count  = time_secs / 86400;
+	std::int64_t day_secs   = time_secs % 86400;
+
+	if (day_secs < 0) {
+		day_secs += 86400;
+		--day_count;
+	}
+
+	std::int64_t  z_value     = day_count + 719468;
+	std::int64_t  era         = ((z_value >= 0) ? z_value : (z_value - 146096)) /
+		146097;
+	std::uint64_t day_of_era  = static_cast<std::uint64_t>(z_value -
+		(era * 146097));
+	std::uint64_t year_of_era = (day_of_era - (day_of_era / 1460) +
+		(day_of_era / 36524) - (day_of_era / 146096)) / 365;
+	std::uint64_t day_of_year = day_of_era - ((365 * year_of_era) +
+		(year_of_era / 4) - (year_of_era / 100));
+	std::uint64_t month_index = ((5 * day_of_year) + 2) / 153;
+	std::uint64_t day         = day_of_year - (((153 * month_index) + 2) / 5) +
+		1;
+	std::uint64_t month       = (month_index < 10) ? (month_index + 3) :
+		(month_index - 9);
+	std::int64_t  year        = static_cast<std::int64_t>(year_of_era) +
+		(era * 400) + ((month <= 2) ? 1 : 0);
+
+	out_ptr    = PutUInt(out_ptr, static_cast<std::uint64_t>(
+		std::max<std::int64_t>(year, 0)), 4);
+	*out_ptr++ = '-';
+	out_ptr    = PutUInt(out_ptr, month, 2);
+	*out_ptr++ = '-';
+	out_ptr    = PutUInt(out_ptr, day, 2);
+	*out_ptr++ = ' ';
+	out_ptr    = PutUInt(out_ptr, static_cast<std::uint64_t>(day_secs / 3600),
+		2);
+	*out_ptr++ = ':';
+	out_ptr    = PutUInt(out_ptr,
+		static_cast<std::uint64_t>((day_secs % 3600) / 60), 2);
+	*out_ptr++ = ':';
+	out_ptr    = PutUInt(out_ptr, static_cast<std::uint64_t>(day_secs % 60),
+		2);
+	*out_ptr++ = '.';
+
+	return(PutUInt(out_ptr, time_nsecs, 9));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Copies the record with the specified index into 'record_data' and
+	'text_ptr' (which must have room for the maximum line length). Returns
+	false if the record doesn't hold that index or was changed while it was
+	being copied.
+*/
+bool ReadRecord(const char *record_ptr, std::uint64_t record_index,
+	std::size_t max_length, RecordData &record_data,
+	char *text_ptr)
+{
+	const LogFlightRecorder::RecordHeader *header_ptr =
+		reinterpret_cast<const LogFlightRecorder::RecordHeader *>(record_ptr);
+
+	if (header_ptr->sequence_.load(std::memory_order_acquire) != record_index)
+		return(false);
+
+	record_data.time_secs_   = header_ptr->time_secs_;
+	record_data.time_nsecs_  = header_ptr->time_nsecs_;
+	record_data.thread_id_   = header_ptr->thread_id_;
+	record_data.log_level_   = header_ptr->log_level_;
+	record_data.line_length_ = static_cast<std::uint16_t>(
+		std::min<std::size_t>(header_ptr->line_length_, max_length));
+	record_data.format_id_   = header_ptr->format_id_;
+
+	if (text_ptr != NULL)
+		::memcpy(text_ptr, record_ptr + sizeof(*header_ptr),
+			record_data.line_length_);
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	return(header_ptr->sequence_.load(std::memory_order_relaxed) ==
+		record_index);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The rendered text is no longer than the format string (which is limited
+	to the maximum line length) plus six times the length of the encoded
+	data (the longest expansion is that of a control character in an event
+	value), so rendering into a string of this capacity doesn't allocate.
+*/
+std::size_t GetRenderSize(std::size_t max_length)
+{
+	return((max_length * 7) + 64);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Renders the record data of a deferred log statement or structured event
+	into the render string. The arguments of a statement whose format isn't
+	known are rendered after its format id.
+
+	Returns false if the record data is invalid. The data is checked before
+	it is rendered, as the rendering functions throw on invalid data and
+	exceptions aren't async-signal-safe.
+*/
+bool RenderRecord(const RecordData &record_data, const char *data_ptr,
+	std::size_t max_length, const DumpBuffers &dump_buffers)
+{
+	std::string &out_string = *dump_buffers.render_ptr_;
+
+	if (record_data.format_id_ == LogBinaryFormatId_Event) {
+		if (!LogEventCheckFields(data_ptr, record_data.line_length_))
+			return(false);
+		LogEventRenderText(data_ptr, record_data.line_length_, out_string);
+		return(true);
+	}
+
+	if (!LogBinaryCheckArgs(data_ptr, record_data.line_length_))
+		return(false);
+
+	const char *format_string = dump_buffers.lookup_func_(
+		dump_buffers.lookup_context_, record_data.format_id_);
+
+	if (format_string == NULL) {
+		char  prefix_buffer[32];
+		char *prefix_ptr = PutText(prefix_buffer, "[format ");
+		prefix_ptr       = PutUInt(prefix_ptr, record_data.format_id_, 1);
+		*prefix_ptr++    = ']';
+		LogBinaryRender("", data_ptr, record_data.line_length_, out_string);
+		out_string.insert(0, prefix_buffer,
+			static_cast<std::size_t>(prefix_ptr - prefix_buffer));
+	}
+	else {
+		std::size_t format_length = 0;
+		while (format_string[format_length] && (format_length < max_length))
+			++format_length;
+		if (format_string[format_length]) {
+			::memcpy(dump_buffers.format_ptr_, format_string, format_length);
+			dump_buffers.format_ptr_[format_length] = '\0';
+			format_string = dump_buffers.format_ptr_;
+		}
+		LogBinaryRender(format_string, data_ptr, record_data.line_length_,
+			out_string);
+	}
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Merges the rings in time order.
+std::size_t DumpRings(const char *map_ptr, int out_fd,
+	const DumpBuffers &dump_buffers)
+{
+	std::uint64_t *cursor_list = dump_buffers.cursor_list_;
+	char          *buffer_ptr  = dump_buffers.buffer_ptr_;
+	std::size_t    buffer_size = dump_buffers.buffer_size_;
+
+	const LogFlightRecorder::FileHeader *file_header_ptr =
+		reinterpret_cast<const LogFlightRecorder::FileHeader *>(map_ptr);
+	std::size_t  ring_count   = file_header_ptr->ring_count_;
+	std::size_t  record_count = file_header_ptr->record_count_;
+	std::size_t  record_size  = file_header_ptr->record_size_;
+	std::size_t  ring_size    = file_header_ptr->ring_size_;
+	std::size_t  max_length   = record_size -
+		sizeof(LogFlightRecorder::RecordHeader);
+	const char  *rings_ptr    = map_ptr + file_header_ptr->header_size_;
+
+	for (std::size_t count_1 = 0; count_1 < ring_count; ++count_1) {
+		const LogFlightRecorder::RingHeader *ring_ptr =
+			reinterpret_cast<const LogFlightRecorder::RingHeader *>(rings_ptr +
+			(count_1 * ring_size));
+		std::uint64_t next_index =
+			ring_ptr->next_index_.load(std::memory_order_acquire);
+		cursor_list[(count_1 * 2)]     = (next_index > record_count) ?
+			(next_index - record_count) : 0;
+		cursor_list[(count_1 * 2) + 1] = next_index;
+	}
+
+	char        *text_ptr   = buffer_ptr;
+	char        *out_start  = buffer_ptr + max_length;
+	char        *out_ptr    = out_start;
+	char        *out_end    = buffer_ptr + buffer_size;
+	std::size_t  line_count = 0;
+
+	for ( ; ; ) {
+		std::size_t                     best_ring = ring_count;
+		RecordData                      best_header;
+		for (std::size_t count_1 = 0; count_1 < ring_count; ++count_1) {
+			std::uint64_t &cursor = cursor_list[count_1 * 2];
+			const char    *ring_ptr = rings_ptr + (count_1 * ring_size);
+			while (cursor < cursor_list[(count_1 * 2) + 1]) {
+				RecordData this_header;
+				if (ReadRecord(ring_ptr + sizeof(LogFlightRecorder::RingHeader) +
+					((cursor % record_count) * record_size), cursor, max_length,
+					this_header, NULL)) {
+					if ((best_ring == ring_count) ||
+						(this_header.time_secs_ < best_header.time_secs_) ||
+						((this_header.time_secs_ == best_header.time_secs_) &&
+						(this_header.time_nsecs_ < best_header.time_nsecs_))) {
+						best_ring   = count_1;
+						best_header = this_header;
+					}
+					break;
+				}
+				++cursor;
+			}
+		}
+		if (best_ring == ring_count)
+			break;
+		std::uint64_t &cursor = cursor_list[best_ring * 2];
+		const char    *record_ptr = rings_ptr + (best_ring * ring_size) +
+			sizeof(LogFlightRecorder::RingHeader) +
+			((cursor % record_count) * record_size);
+		bool           valid_flag = ReadRecord(record_ptr, cursor, max_length,
+			best_header, text_ptr);
+		++cursor;
+		if (!valid_flag)
+			continue;
+		const char  *line_ptr    = text_ptr;
+		std::size_t  line_length = best_header.line_length_;
+		if (best_header.format_id_ != LogBinaryFormatId_Text) {
+			if (RenderRecord(best_header, text_ptr, max_length, dump_buffers)) {
+				line_ptr    = dump_buffers.render_ptr_->data();
+				line_length = std::min(dump_buffers.render_ptr_->size(),
+					max_length);
+			}
+			else {
+				line_ptr    = InvalidRecordText;
+				line_length = std::min(sizeof(InvalidRecordText) - 1,
+					max_length);
+			}
+		}
+		if (static_cast<std::size_t>(out_end - out_ptr) < (max_length + 128)) {
+			if (!WriteAll(out_fd, out_start,
+				static_cast<std::size_t>(out_ptr - out_start)))
+				return(line_count);
+			out_ptr = out_start;
+		}
+		out_ptr    = PutTime(out_ptr, best_header.time_secs_,
+			best_header.time_nsecs_);
+		*out_ptr++ = ' ';
+		out_ptr    = PutText(out_ptr, ConvertLogLevelToTextRaw(
+			static_cast<LogLevel>(best_header.log_level_)));
+		*out_ptr++ = ' ';
+		out_ptr    = PutUInt(out_ptr, best_header.thread_id_, 10, ' ');
+		*out_ptr++ = ':';
+		*out_ptr++ = ' ';
+		::memcpy(out_ptr, line_ptr, line_length);
+		out_ptr   += line_length;
+		*out_ptr++ = '\n';
+		++line_count;
+	}
+
+	WriteAll(out_fd, out_start, static_cast<std::size_t>(out_ptr - out_start));
+
+	return(line_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t GetDumpBufferSize(std::size_t record_size)
+{
+	return(std::max(MinDumpSize, (record_size * 3) + 256));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const char *GetRegisteredFormat(const void *, LogBinaryFormatId format_id)
+{
+	LogBinaryFormat format;
+
+	return((LogBinaryFormatGet(format_id, format)) ?
+		format.format_string_ : NULL);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+typedef std::map<LogBinaryFormatId, std::string> FileFormatMap;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const char *GetFileFormat(const void *lookup_context,
+	LogBinaryFormatId format_id)
+{
+	const FileFormatMap           &format_map =
+		*static_cast<const FileFormatMap *>(lookup_context);
+	FileFormatMap::const_iterator  iter_f     = format_map.find(format_id);
+
+	return((iter_f == format_map.end()) ? NULL : iter_f->second.c_str());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Reads the format strings copied to the format area of a file.
+FileFormatMap ReadFormatArea(const char *map_ptr)
+{
+	const LogFlightRecorder::FileHeader *file_header_ptr =
+		reinterpret_cast<const LogFlightRecorder::FileHeader *>(map_ptr);
+	FileFormatMap                        format_map;
+
+	if (!file_header_ptr->format_size_)
+		return(format_map);
+
+	const char *area_ptr  = map_ptr + file_header_ptr->format_offset_;
+	const char *entry_ptr = area_ptr + sizeof(LogFlightRecorder::FormatHeader);
+	const char *end_ptr   = entry_ptr + std::min<std::uint64_t>(
+		reinterpret_cast<const LogFlightRecorder::FormatHeader *>(area_ptr)->
+		used_size_.load(std::memory_order_acquire),
+		file_header_ptr->format_size_ - sizeof(LogFlightRecorder::FormatHeader));
+
+	while (static_cast<std::size_t>(end_ptr - entry_ptr) >=
+		sizeof(LogFlightRecorder::FormatEntry)) {
+		const LogFlightRecorder::FormatEntry *this_entry =
+			reinterpret_cast<const LogFlightRecorder::FormatEntry *>(entry_ptr);
+		std::uint32_t format_id     =
+			this_entry->format_id_.load(std::memory_order_acquire);
+		std::size_t   format_length = this_entry->format_length_;
+		//	An entry whose length was never written can't be skipped...
+		if ((!format_id) && (!format_length))
+			break;
+		entry_ptr += sizeof(*this_entry);
+		if (static_cast<std::size_t>(end_ptr - entry_ptr) < format_length)
+			break;
+		if (format_id)
+			format_map[format_id - 1].assign(entry_ptr, format_length);
+		entry_ptr += (format_length + 7) & ~static_cast<std::size_t>(7);
+	}
+
+	return(format_map);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	If the file holds the rings of an earlier recorder (perhaps that of a
+	process which crashed), renames it to '<file_name>.<pid>', where pid is
+	that of the process which created it, rather than let it be truncated.
+	Returns the new name, or an empty string if there was no such file.
+*/
+std::string PreservePreviousFile(const std::string &file_name)
+{
+	int in_fd = ::open(file_name.c_str(), O_RDONLY);
+
+	if (in_fd < 0)
+		return(std::string());
+
+	LogFlightRecorder::FileHeader file_header;
+	ssize_t                       read_count =
+		::pread(in_fd, &file_header, sizeof(file_header), 0);
+
+	::close(in_fd);
+
+	if ((read_count != static_cast<ssize_t>(sizeof(file_header))) ||
+		::memcmp(file_header.magic_, FileMagic, sizeof(FileMagic)))
+		return(std::string());
+
+	std::string previous_file_name(file_name + "." +
+		std::to_string(file_header.process_id_));
+
+	if (::rename(file_name.c_str(), previous_file_name.c_str()))
+		ThrowErrno("Attempt to rename the existing flight recorder file '" +
+			file_name + "' to '" + previous_file_name + "' failed");
+
+	return(previous_file_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+LogFlightRecorder::LogFlightRecorder(const std::string &file_name,
+	unsigned int ring_count, unsigned int record_count,
+	unsigned int record_size, unsigned int format_size)
+	:file_name_(file_name)
+	,previous_file_name_()
+	,serial_(0)
+	,ring_count_(ring_count)
+	,record_count_(record_count)
+	,record_size_(record_size)
+	,format_size_(format_size)
+	,ring_size_(0)
+	,format_offset_(0)
+	,map_size_(0)
+	,file_fd_(-1)
+	,map_ptr_(NULL)
+	,drop_count_(0)
+	,format_slot_list_(FormatSlotCount)
+	,dump_cursor_list_()
+	,dump_buffer_()
+	,dump_format_()
+	,dump_render_()
+{
+	static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes.");
+	static_assert(sizeof(RingHeader) == 64, "RingHeader must be 64 bytes.");
+	static_assert(sizeof(RecordHeader) == 32,
+		"RecordHeader must be 32 bytes.");
+	static_assert(sizeof(FormatHeader) == 64,
+		"FormatHeader must be 64 bytes.");
+
+	if ((!ring_count) || (!record_count))
+		throw std::invalid_argument("The flight recorder ring count (" +
+			std::to_string(ring_count) + ") and record count (" +
+			std::to_string(record_count) + ") must be greater than zero.");
+
+	if ((record_size < (sizeof(RecordHeader) + 16)) || (record_size % 8) ||
+		((record_size - sizeof(RecordHeader)) > 0xFFFF))
+		throw std::invalid_argument("The flight recorder record size (" +
+			std::to_string(record_size) + ") must be a multiple of 8 in the "
+			"range " + std::to_string(sizeof(RecordHeader) + 16) + " to " +
+			std::to_string(sizeof(RecordHeader) + 0xFFF8) + ", inclusive.");
+
+	if ((format_size % 8) || (format_size &&
+		(format_size < (sizeof(FormatHeader) + 64))))
+		throw std::invalid_argument("The flight recorder format area size (" +
+			std::to_string(format_size) + ") must be zero or a multiple of 8 "
+			"which is at least " + std::to_string(sizeof(FormatHeader) + 64) +
+			".");
+
+	ring_size_     = sizeof(RingHeader) +
+		(static_cast<std::size_t>(record_count_) * record_size_);
+	format_offset_ = sizeof(FileHeader) + (ring_count_ * ring_size_);
+	map_size_      = format_offset_ + format_size_;
+
+	dump_cursor_list_.resize(static_cast<std::size_t>(ring_count_) * 2);
+	dump_buffer_.resize(GetDumpBufferSize(record_size_));
+	dump_format_.resize(record_size_ - sizeof(RecordHeader) + 1);
+	dump_render_.reserve(GetRenderSize(record_size_ - sizeof(RecordHeader)));
+
+	previous_file_name_ = PreservePreviousFile(file_name_);
+
+	file_fd_ = ::open(file_name_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+	if (file_fd_ < 0)
+		ThrowErrno("Attempt to open the flight recorder file '" + file_name_ +
+			"' failed");
+
+	try {
+		if (::ftruncate(file_fd_, static_cast<off_t>(map_size_)))
+			ThrowErrno("Attempt to size the flight recorder file '" +
+				file_name_ + "' to " + std::to_string(map_size_) +
+				" bytes failed");
+		void *map_ptr = ::mmap(NULL, map_size_, PROT_READ | PROT_WRITE,
+			MAP_SHARED, file_fd_, 0);
+		if (map_ptr == MAP_FAILED)
+			ThrowErrno("Attempt to map the flight recorder file '" + file_name_ +
+				"' failed");
+		map_ptr_ = static_cast<char *>(map_ptr);
+	}
+	catch (const std::exception &) {
+		::close(file_fd_);
+		throw;
+	}
+
+	//	The file was created empty, so the rings and formats are zeroed...
+	FileHeader *file_header_ptr = reinterpret_cast<FileHeader *>(map_ptr_);
+
+	::memcpy(file_header_ptr->magic_, FileMagic, sizeof(FileMagic));
+	file_header_ptr->header_size_   = sizeof(FileHeader);
+	file_header_ptr->ring_count_    = ring_count_;
+	file_header_ptr->record_count_  = record_count_;
+	file_header_ptr->record_size_   = record_size_;
+	file_header_ptr->ring_size_     = ring_size_;
+	file_header_ptr->process_id_    = static_cast<std::int64_t>(::getpid());
+	file_header_ptr->format_offset_ = format_offset_;
+	file_header_ptr->format_size_   = format_size_;
+
+	LogLockScoped my_lock(RecorderListLock);
+
+	serial_ = RecorderSerialNext++;
+	RecorderList[serial_] = this;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogFlightRecorder::~LogFlightRecorder()
+{
+	const LogFlightRecorder *this_ptr = this;
+
+	FatalRecorderPtr.compare_exchange_strong(this_ptr, nullptr);
+
+	{
+		LogLockScoped my_lock(RecorderListLock);
+		RecorderList.erase(serial_);
+	}
+
+	::munmap(map_ptr_, map_size_);
+	::close(file_fd_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFlightRecorder::Record(const TimeSpec &line_time, LogLevel log_level,
+	const char *line_ptr, std::size_t line_length)
+{
+	WriteRecord(line_time, log_level, LogBinaryFormatId_Text, line_ptr,
+		line_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The encoded data is recorded as-is provided that it fits in a record and
+	that the format string is in the format area. Otherwise it's rendered
+	now and recorded, truncated if need be, as a line.
+*/
+void LogFlightRecorder::RecordBinary(const TimeSpec &line_time,
+	LogLevel log_level, LogBinaryFormatId format_id, const char *arg_ptr,
+	std::size_t arg_length)
+{
+	if ((format_id != LogBinaryFormatId_Text) &&
+		(arg_length <= (record_size_ - sizeof(RecordHeader))) &&
+		((format_id == LogBinaryFormatId_Event) || CopyFormat(format_id)))
+		WriteRecord(line_time, log_level, format_id, arg_ptr, arg_length);
+	else {
+		LogBinaryRender(format_id, arg_ptr, arg_length, RecordRenderBuffer);
+		WriteRecord(line_time, log_level, LogBinaryFormatId_Text,
+			RecordRenderBuffer.data(), RecordRenderBuffer.size());
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFlightRecorder::WriteRecord(const TimeSpec &line_time,
+	LogLevel log_level, LogBinaryFormatId format_id, const char *data_ptr,
+	std::size_t data_length)
+{
+	RingHeader *ring_ptr = GetThreadRing();
+
+	if (ring_ptr == NULL) {
+		drop_count_.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	std::uint64_t  record_index =
+		ring_ptr->next_index_.load(std::memory_order_relaxed);
+	char          *record_ptr   = reinterpret_cast<char *>(ring_ptr + 1) +
+		((record_index % record_count_) * record_size_);
+	RecordHeader  *header_ptr   = reinterpret_cast<RecordHeader *>(record_ptr);
+
+	data_length = std::min<std::size_t>(data_length,
+		record_size_ - sizeof(RecordHeader));
+
+	header_ptr->sequence_.store(NoSequence, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	header_ptr->time_secs_   = static_cast<std::int64_t>(line_time.tv_sec);
+	header_ptr->time_nsecs_  = static_cast<std::uint32_t>(line_time.tv_nsec);
+	header_ptr->thread_id_   = static_cast<std::uint32_t>(CurrentThreadId());
+	header_ptr->log_level_   = static_cast<std::uint16_t>(log_level);
+	header_ptr->line_length_ = static_cast<std::uint16_t>(data_length);
+	header_ptr->format_id_   = format_id;
+	::memcpy(record_ptr + sizeof(RecordHeader), data_ptr, data_length);
+
+	header_ptr->sequence_.store(record_index, std::memory_order_release);
+	ring_ptr->next_index_.store(record_index + 1, std::memory_order_release);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogFlightRecorder::Dump(int out_fd) const
+{
+	DumpBuffers dump_buffers = { dump_cursor_list_.data(),
+		dump_buffer_.data(), dump_buffer_.size(), dump_format_.data(),
+		&dump_render_, GetRegisteredFormat, NULL };
+
+	return(DumpRings(map_ptr_, out_fd, dump_buffers));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogFlightRecorder::Dump(const char *out_file_name) const
+{
+	int out_fd = ::open(out_file_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if (out_fd < 0)
+		return(0);
+
+	std::size_t line_count = Dump(out_fd);
+
+	::close(out_fd);
+
+	return(line_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const std::string &LogFlightRecorder::GetFileName() const
+{
+	return(file_name_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const std::string &LogFlightRecorder::GetPreviousFileName() const
+{
+	return(previous_file_name_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogFlightRecorder::GetDropCount() const
+{
+	return(drop_count_.load(std::memory_order_relaxed));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogFlightRecorder::DumpFile(const std::string &file_name,
+	int out_fd)
+{
+	int in_fd = ::open(file_name.c_str(), O_RDONLY);
+
+	if (in_fd < 0)
+		ThrowErrno("Attempt to open the flight recorder file '" + file_name +
+			"' failed");
+
+	void        *map_ptr  = MAP_FAILED;
+	std::size_t  map_size = 0;
+
+	try {
+		struct stat stat_data;
+		if (::fstat(in_fd, &stat_data))
+			ThrowErrno("Attempt to determine the size of the flight recorder "
+				"file '" + file_name + "' failed");
+		map_size = static_cast<std::size_t>(stat_data.st_size);
+		if (map_size < sizeof(FileHeader))
+			throw std::runtime_error("The flight recorder file '" + file_name +
+				"' is too small (" + std::to_string(map_size) + " bytes) to be "
+				"valid.");
+		map_ptr = ::mmap(NULL, map_size, PROT_READ, MAP_SHARED, in_fd, 0);
+		if (map_ptr == MAP_FAILED)
+			ThrowErrno("Attempt to map the flight recorder file '" + file_name +
+				"' failed");
+		const FileHeader *file_header_ptr =
+			static_cast<const FileHeader *>(map_ptr);
+		if (::memcmp(file_header_ptr->magic_, FileMagic, sizeof(FileMagic)) ||
+			(file_header_ptr->header_size_ != sizeof(FileHeader)) ||
+			(file_header_ptr->record_size_ < (sizeof(RecordHeader) + 16)) ||
+			(file_header_ptr->ring_size_ != (sizeof(RingHeader) +
+			(static_cast<std::uint64_t>(file_header_ptr->record_count_) *
+			file_header_ptr->record_size_))) ||
+			((sizeof(FileHeader) + (file_header_ptr->ring_count_ *
+			file_header_ptr->ring_size_)) > map_size) ||
+			(file_header_ptr->format_size_ &&
+			((file_header_ptr->format_size_ < sizeof(FormatHeader)) ||
+			(file_header_ptr->format_offset_ < (sizeof(FileHeader) +
+			(file_header_ptr->ring_count_ * file_header_ptr->ring_size_))) ||
+			((file_header_ptr->format_offset_ + file_header_ptr->format_size_) >
+			map_size))))
+			throw std::runtime_error("The file '" + file_name + "' is not a "
+				"valid flight recorder file.");
+		std::size_t                max_length     =
+			file_header_ptr->record_size_ - sizeof(RecordHeader);
+		FileFormatMap              format_map(
+			ReadFormatArea(static_cast<const char *>(map_ptr)));
+		std::vector<std::uint64_t> cursor_list(
+			static_cast<std::size_t>(file_header_ptr->ring_count_) * 2);
+		std::vector<char>          dump_buffer(
+			GetDumpBufferSize(file_header_ptr->record_size_));
+		std::vector<char>          format_buffer(max_length + 1);
+		std::string                render_buffer;
+		render_buffer.reserve(GetRenderSize(max_length));
+		DumpBuffers                dump_buffers = { cursor_list.data(),
+			dump_buffer.data(), dump_buffer.size(), format_buffer.data(),
+			&render_buffer, GetFileFormat, &format_map };
+		std::size_t line_count = DumpRings(static_cast<const char *>(map_ptr),
+			out_fd, dump_buffers);
+		::munmap(map_ptr, map_size);
+		::close(in_fd);
+		return(line_count);
+	}
+	catch (const std::exception &) {
+		if (map_ptr != MAP_FAILED)
+			::munmap(map_ptr, map_size);
+		::close(in_fd);
+		throw;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFlightRecorder::SetFatalDump(const LogFlightRecorder *recorder_ptr,
+	const char *out_file_name)
+{
+	if (recorder_ptr == NULL) {
+		FatalRecorderPtr = nullptr;
+		return;
+	}
+
+	if ((out_file_name == NULL) || (!(*out_file_name)))
+		throw std::invalid_argument("No flight recorder dump file name was "
+			"specified.");
+
+	if (::strlen(out_file_name) >= sizeof(FatalDumpFileName))
+		throw std::invalid_argument("The flight recorder dump file name length "
+			"(" + std::to_string(::strlen(out_file_name)) + ") exceeds the "
+			"maximum of " + std::to_string(sizeof(FatalDumpFileName) - 1) + ".");
+
+	FatalRecorderPtr = nullptr;
+	::strcpy(FatalDumpFileName, out_file_name);
+	FatalRecorderPtr = recorder_ptr;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogFlightRecorder::FatalSignalDump(int signal_number)
+{
+	const LogFlightRecorder *recorder_ptr = FatalRecorderPtr.exchange(nullptr);
+
+	if (recorder_ptr == NULL)
+		return;
+
+	int out_fd = ::open(FatalDumpFileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if (out_fd < 0)
+		return;
+
+	char  text_buffer[128];
+	char *out_ptr = PutText(text_buffer, "Fatal signal ");
+
+	out_ptr    = PutUInt(out_ptr, static_cast<std::uint64_t>(signal_number), 1);
+	out_ptr    = PutText(out_ptr, " received by process ");
+	out_ptr    = PutUInt(out_ptr, static_cast<std::uint64_t>(::getpid()), 1);
+	out_ptr    = PutText(out_ptr, ". Flight recorder contents follow.");
+	*out_ptr++ = '\n';
+
+	WriteAll(out_fd, text_buffer, static_cast<std::size_t>(out_ptr -
+		text_buffer));
+
+	recorder_ptr->Dump(out_fd);
+
+	::close(out_fd);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Returns true if the format string is (or is being) copied to the format
+	area. Each format is copied once, by the first thread to claim a slot
+	for it.
+*/
+bool LogFlightRecorder::CopyFormat(LogBinaryFormatId format_id)
+{
+	std::uint64_t format_key = (static_cast<std::uint64_t>(format_id) + 1) << 2;
+	std::size_t   slot_index = static_cast<std::size_t>(format_id) * 2654435761U;
+
+	if (!format_size_)
+		return(false);
+
+	for (std::size_t count_1 = 0; count_1 < FormatSlotCount; ++count_1) {
+		std::atomic<std::uint64_t> &this_slot =
+			format_slot_list_[(slot_index + count_1) % FormatSlotCount];
+		std::uint64_t               slot_value =
+			this_slot.load(std::memory_order_acquire);
+		if ((!slot_value) && this_slot.compare_exchange_strong(slot_value,
+			format_key | FormatSlotPending, std::memory_order_acq_rel)) {
+			bool written_flag = WriteFormatEntry(format_id);
+			this_slot.store(format_key | ((written_flag) ? FormatSlotWritten :
+				FormatSlotFailed), std::memory_order_release);
+			return(written_flag);
+		}
+		if ((slot_value & ~static_cast<std::uint64_t>(3)) == format_key)
+			return((slot_value & 3) != FormatSlotFailed);
+	}
+
+	return(false);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Space for the entry is claimed with a compare-and-swap, so no lock is
+	taken. Returns false if the format area is full.
+*/
+bool LogFlightRecorder::WriteFormatEntry(LogBinaryFormatId format_id)
+{
+	LogBinaryFormat format;
+
+	if (!LogBinaryFormatGet(format_id, format))
+		return(false);
+
+	char          *area_ptr      = map_ptr_ + format_offset_;
+	FormatHeader  *header_ptr    = reinterpret_cast<FormatHeader *>(area_ptr);
+	std::size_t    format_length = ::strlen(format.format_string_);
+	std::size_t    entry_size    = sizeof(FormatEntry) +
+		((format_length + 7) & ~static_cast<std::size_t>(7));
+	std::size_t    area_size     = format_size_ - sizeof(FormatHeader);
+	std::uint64_t  used_size     =
+		header_ptr->used_size_.load(std::memory_order_relaxed);
+
+	do {
+		if ((used_size + entry_size) > area_size)
+			return(false);
+	} while (!header_ptr->used_size_.compare_exchange_weak(used_size,
+		used_size + entry_size, std::memory_order_relaxed));
+
+	char        *entry_ptr  = area_ptr + sizeof(FormatHeader) + used_size;
+	FormatEntry *this_entry = reinterpret_cast<FormatEntry *>(entry_ptr);
+
+	this_entry->format_length_ = static_cast<std::uint32_t>(format_length);
+	::memcpy(entry_ptr + sizeof(FormatEntry), format.format_string_,
+		format_length);
+	this_entry->format_id_.store(format_id + 1, std::memory_order_release);
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogFlightRecorder::RingHeader *LogFlightRecorder::GetThreadRing()
+{
+	if ((ThreadRingSerial == serial_) && (ThreadRingPtr != NULL))
+		return(ThreadRingPtr);
+
+	if (ThreadRingGone)
+		return(NULL);
+
+	ThreadReleaser.Touch();
+
+	if (ThreadRingSerial != serial_)
+		ReleaseThreadRing();
+
+	ThreadRingSerial = serial_;
+	ThreadRingPtr    = ClaimRing();
+
+	return(ThreadRingPtr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Rings which have never been used are preferred so that the lines of
+	threads which have exited are retained for as long as possible.
+*/
+LogFlightRecorder::RingHeader *LogFlightRecorder::ClaimRing()
+{
+	char *rings_ptr = map_ptr_ + sizeof(FileHeader);
+
+	for (int pass_count = 0; pass_count < 2; ++pass_count) {
+		for (unsigned int count_1 = 0; count_1 < ring_count_; ++count_1) {
+			RingHeader    *ring_ptr   = reinterpret_cast<RingHeader *>(rings_ptr +
+				(count_1 * ring_size_));
+			std::uint32_t  owned_flag = 0;
+			if ((!pass_count) &&
+				ring_ptr->next_index_.load(std::memory_order_relaxed))
+				continue;
+			if ((!ring_ptr->owned_flag_.load(std::memory_order_relaxed)) &&
+				ring_ptr->owned_flag_.compare_exchange_strong(owned_flag, 1,
+				std::memory_order_acquire))
+				return(ring_ptr);
+		}
+	}
+
+	return(NULL);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogManager.hpp>
+#include <Logger/LogTestSupport.hpp>
+
+#include <Utility/CriticalEventHandler.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <sys/wait.h>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string TEST_ReadFile(const std::string &file_name)
+{
+	std::ifstream      in_file(file_name.c_str(),
+		std::ios_base::in | std::ios_base::binary);
+	std::ostringstream file_data;
+
+	file_data << in_file.rdbuf();
+
+	return(file_data.str());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Expect(bool condition, const std::string &error_text)
+{
+	if (!condition)
+		throw std::logic_error(error_text);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Records lines at levels filtered out of the handler, then dumps them.
+*/
+void TEST_RecordAndDump()
+{
+	using namespace MLB::Utility;
+
+	std::string          ring_file(TEST_GetLogFileName("LogFlightRecorder.ring"));
+	std::string          dump_file(TEST_GetLogFileName("LogFlightRecorder.dump"));
+	LogFlightRecorderPtr recorder_ptr(new LogFlightRecorder(ring_file, 4, 16,
+		64));
+	LogManager           log_manager(LogHandlerPtr(), Default);
+	LogStream            log_spam(log_manager, LogLevel_Spam);
+	LogStream            log_info(log_manager, LogLevel_Info);
+
+	log_manager.SetLogLevelConsole(LogLevel_Info);
+	log_manager.SetLogLevelFile(LogLevel_Info);
+
+	TEST_Expect(!log_spam.IsEnabled(), "Spam enabled before the flight "
+		"recorder was installed.");
+
+	log_manager.FlightRecorderInstall(recorder_ptr);
+
+	TEST_Expect(log_spam.IsEnabled(), "Spam not enabled after the flight "
+		"recorder was installed.");
+
+	for (int count_1 = 0; count_1 < 40; ++count_1)
+		log_spam << "Spam line " << count_1 << std::endl;
+
+	std::thread([&log_info]() {
+		log_info << "Line from another thread which is long enough to be "
+			"truncated by the record size." << std::endl;
+	}).join();
+
+	std::size_t line_count = recorder_ptr->Dump(dump_file.c_str());
+	std::string dump_data(TEST_ReadFile(dump_file));
+
+	//	The last 16 spam lines, plus the one from the other thread...
+	TEST_Expect(line_count == 17, "Expected 17 lines in the flight recorder "
+		"dump, but found " + std::to_string(line_count) + ".");
+	TEST_Expect(dump_data.find("Spam line 23\n") == std::string::npos,
+		"Overwritten line found in the flight recorder dump.");
+	TEST_Expect(dump_data.find("SPAM     ") != std::string::npos,
+		"Spam level not found in the flight recorder dump.");
+	TEST_Expect(dump_data.find("Spam line 39\n") != std::string::npos,
+		"Last line not found in the flight recorder dump.");
+	TEST_Expect(dump_data.find(": Line from another thread which i\n")
+		!= std::string::npos, "Truncated line not found in the flight "
+		"recorder dump.");
+
+	std::cout << dump_data;
+
+	//	The contents must be readable from the file alone...
+	int out_fd = ::open(dump_file.c_str(), O_WRONLY | O_TRUNC);
+	TEST_Expect(LogFlightRecorder::DumpFile(ring_file, out_fd) == 17,
+		"Post-mortem dump of the flight recorder file failed.");
+	::close(out_fd);
+	TEST_Expect(TEST_ReadFile(dump_file) == dump_data, "Post-mortem dump "
+		"differs from the live dump.");
+
+	log_manager.FlightRecorderRemove();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Deferred statements and events whose encoded data is corrupt are dumped
+	as invalid without the dump throwing.
+*/
+void TEST_DumpInvalidRecords()
+{
+	using namespace MLB::Utility;
+
+	std::string       ring_file(TEST_GetLogFileName("LogFlightRecorder.invalid"));
+	std::string       dump_file(TEST_GetLogFileName(
+		"LogFlightRecorder.invalid.dump"));
+	LogFlightRecorder recorder(ring_file, 1, 16, 128);
+	LogBinaryFormatId format_id = LogBinaryFormatRegister(__FILE__, __LINE__,
+		"Valid value {}");
+	std::string       arg_buffer;
+	std::string       field_buffer;
+
+	LogBinaryEncode(arg_buffer, 42);
+	recorder.RecordBinary(TimeSpec::Now(), LogLevel_Info, format_id,
+		arg_buffer.data(), arg_buffer.size());
+	recorder.RecordBinary(TimeSpec::Now(), LogLevel_Info, format_id,
+		arg_buffer.data(), arg_buffer.size() - 1);
+
+	LogEventEncode(field_buffer, "valid_event", LogKV("id", 7));
+	recorder.RecordBinary(TimeSpec::Now(), LogLevel_Info,
+		LogBinaryFormatId_Event, field_buffer.data(), field_buffer.size());
+	recorder.RecordBinary(TimeSpec::Now(), LogLevel_Info,
+		LogBinaryFormatId_Event, field_buffer.data(), field_buffer.size() - 1);
+
+	std::size_t line_count = recorder.Dump(dump_file.c_str());
+	std::string dump_data(TEST_ReadFile(dump_file));
+
+	std::cout << dump_data;
+
+	TEST_Expect(line_count == 4, "Expected 4 lines in the flight recorder "
+		"dump of invalid records, but found " + std::to_string(line_count) +
+		".");
+	TEST_Expect(dump_data.find(": Valid value 42\n") != std::string::npos,
+		"The valid deferred statement was not rendered.");
+	TEST_Expect(dump_data.find(": valid_event id=7\n") != std::string::npos,
+		"The valid structured event was not rendered.");
+
+	std::size_t invalid_count = 0;
+
+	for (std::string::size_type found_pos = 0;
+		(found_pos = dump_data.find(": [invalid record data]\n", found_pos)) !=
+		std::string::npos; ++found_pos)
+		++invalid_count;
+
+	TEST_Expect(invalid_count == 2, "Expected 2 invalid records in the "
+		"flight recorder dump, but found " + std::to_string(invalid_count) +
+		".");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	A child process records lines and crashes; the parent checks the dump
+	written by the fatal signal function and that the ring file survived.
+*/
+void TEST_FatalSignal()
+{
+	using namespace MLB::Utility;
+
+	std::string ring_file(TEST_GetLogFileName("LogFlightRecorder.fatal.ring"));
+	std::string dump_file(TEST_GetLogFileName("LogFlightRecorder.fatal.dump"));
+	pid_t       child_pid = ::fork();
+
+	if (child_pid < 0)
+		ThrowErrno("Attempt to fork failed");
+
+	if (!child_pid) {
+		LogFlightRecorderPtr recorder_ptr(new LogFlightRecorder(ring_file));
+		LogManager           log_manager(LogHandlerPtr(), Default);
+		LogStream            log_minutiae(log_manager, LogLevel_Minutiae);
+		log_manager.FlightRecorderInstall(recorder_ptr);
+		LogFlightRecorder::SetFatalDump(recorder_ptr.get(), dump_file.c_str());
+		CriticalEventHandler event_handler(LogFlightRecorder::FatalSignalDump);
+		log_minutiae << "Context before the crash." << std::endl;
+		::raise(SIGSEGV);
+		::_exit(0);
+	}
+
+	int child_status = 0;
+
+	::waitpid(child_pid, &child_status, 0);
+
+	TEST_Expect(WIFSIGNALED(child_status) && (WTERMSIG(child_status) == SIGSEGV),
+		"The child process did not terminate with SIGSEGV.");
+
+	std::string dump_data(TEST_ReadFile(dump_file));
+
+	TEST_Expect(dump_data.find("Fatal signal " + std::to_string(SIGSEGV)) == 0,
+		"The fatal signal dump does not begin with the signal.");
+	TEST_Expect(dump_data.find("MINUTIAE ") != std::string::npos,
+		"The fatal signal dump does not contain the minutiae line.");
+	TEST_Expect(dump_data.find(": Context before the crash.\n") !=
+		std::string::npos, "The fatal signal dump does not contain the line.");
+
+	int out_fd = ::open(dump_file.c_str(), O_WRONLY | O_TRUNC);
+	TEST_Expect(LogFlightRecorder::DumpFile(ring_file, out_fd) == 1,
+		"Post-mortem dump of the crashed process flight recorder file failed.");
+	::close(out_fd);
+
+	std::cout << dump_data;
+
+	//	A restarted process must not truncate the rings of the crashed one...
+	LogFlightRecorder new_recorder(ring_file, 4, 16, 64);
+	std::string       previous_file(ring_file + "." +
+		std::to_string(child_pid));
+
+	TEST_Expect(new_recorder.GetPreviousFileName() == previous_file,
+		"The rings of the crashed process were not preserved as '" +
+		previous_file + "'.");
+
+	out_fd = ::open(dump_file.c_str(), O_WRONLY | O_TRUNC);
+	TEST_Expect(LogFlightRecorder::DumpFile(previous_file, out_fd) == 1,
+		"Post-mortem dump of the preserved flight recorder file failed.");
+	::close(out_fd);
+	TEST_Expect(TEST_ReadFile(dump_file).find(
+		": Context before the crash.\n") != std::string::npos,
+		"The preserved flight recorder file does not contain the line.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_RecordAndDump();
+		TEST_DumpInvalidRecords();
+		TEST_FatalSignal();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
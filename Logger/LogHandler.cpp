@@ -26,6 +26,7 @@
 // ////////////////////////////////////////////////////////////////////////////
 
 #include <Logger/LogHandler.hpp>
+#include <Logger/LogClock.hpp>
 
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -66,13 +67,86 @@ void LogHandler::EmitLineSpecific(const std::string &line_buffer,
 	EmitLine(LogEmitControl(Default, LogFlag_Mask, LogFlag_Mask, TimeSpec(),
 		log_level, LogFlag_Info, line_buffer));
 */
-	LogEmitControl tmp_ctrl(Default, LogFlag_Mask, LogFlag_Mask, TimeSpec(),
+	LogEmitControl tmp_ctrl(Default, LogFlag_Mask, LogFlag_Mask, LogClockNow(),
 		log_level, LogFlag_Info, line_buffer);
 
 	EmitLine(tmp_ctrl);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Handlers which can persist deferred-formatting records directly should
+	override this. The default renders the record as text and emits it as
+	a normal line.
+*/
+void LogHandler::EmitBinary(const LogEmitControl &emit_control,
+	LogBinaryFormatId format_id, const char *arg_ptr, std::size_t arg_length)
+{
+	std::string line_buffer;
+	char        line_leader[LogLineLeaderLength + 1];
+
+	LogBinaryRender(format_id, arg_ptr, arg_length, line_buffer);
+
+	//	The leader reflects the time and thread at which the record was made.
+	LogEmitControl tmp_ctrl(emit_control.log_flags_,
+		emit_control.log_level_screen_, emit_control.log_level_persistent_,
+		emit_control.line_start_time_, emit_control.log_level_,
+		emit_control.log_level_flag_, line_buffer, emit_control.thread_id_,
+		LogEmitControl::FormatLeader(line_leader, emit_control.line_start_time_,
+		emit_control.log_level_, emit_control.thread_id_,
+		emit_control.log_flags_));
+
+	EmitLine(tmp_ctrl);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Handlers which can persist structured events directly should override
+	this. The default renders the event as a JSON line if the \c LogJsonEvent
+	flag is set and otherwise in the text layout as a normal line.
+*/
+void LogHandler::EmitEvent(const LogEmitControl &emit_control)
+{
+	//	Re-used so that rendering doesn't allocate once the buffer has grown.
+	thread_local std::string line_buffer;
+
+	if (emit_control.log_flags_ & LogJsonEvent) {
+		LogEventRenderJson(emit_control, line_buffer);
+		EmitLiteral(emit_control, static_cast<unsigned int>(line_buffer.size()),
+			line_buffer.c_str());
+		return;
+	}
+
+	char line_leader[LogLineLeaderLength + 1];
+
+	LogEventRenderText(emit_control.field_ptr_, emit_control.field_length_,
+		line_buffer);
+
+	LogEmitControl tmp_ctrl(emit_control.log_flags_,
+		emit_control.log_level_screen_, emit_control.log_level_persistent_,
+		emit_control.line_start_time_, emit_control.log_level_,
+		emit_control.log_level_flag_, line_buffer, emit_control.thread_id_,
+		LogEmitControl::FormatLeader(line_leader, emit_control.line_start_time_,
+		emit_control.log_level_, emit_control.thread_id_,
+		emit_control.log_flags_));
+
+	EmitLine(tmp_ctrl);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Handlers which buffer output should override this so that all lines
+	emitted before the call have been handed to the operating system upon
+	return.
+*/
+void LogHandler::Flush()
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 } // namespace Utility
 
 } // namespace MLB
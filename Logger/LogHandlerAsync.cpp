@@ -0,0 +1,906 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerAsync.cpp
+
+   File Description  :  Implementation of the asynchronous log handler class.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerAsync.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Counts a producer as in-flight from before its check of the stop flag
+	until its record has been committed, so that StopConsumer() can wait
+	for it. Both the increment and the check are sequentially consistent so
+	that a producer either sees the stop flag or is seen by StopConsumer().
+*/
+class ProducerScope {
+public:
+	explicit ProducerScope(std::atomic<std::uint64_t> &producer_count)
+		:producer_count_ptr_(&producer_count)
+	{
+		producer_count_ptr_->fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	~ProducerScope()
+	{
+		Release();
+	}
+
+	void Release()
+	{
+		if (producer_count_ptr_ != NULL) {
+			producer_count_ptr_->fetch_sub(1, std::memory_order_release);
+			producer_count_ptr_ = NULL;
+		}
+	}
+
+private:
+	std::atomic<std::uint64_t> *producer_count_ptr_;
+
+	ProducerScope(const ProducerScope &) = delete;
+	ProducerScope & operator = (const ProducerScope &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t FixUpQueueSize(std::size_t queue_size)
+{
+	if (queue_size < 2)
+		throw std::invalid_argument("The asynchronous log handler queue size "
+			"must be at least 2.");
+	else if (queue_size > (std::size_t(1) << 30))
+		throw std::invalid_argument("The asynchronous log handler queue size (" +
+			std::to_string(queue_size) + ") exceeds the maximum permissible "
+			"size (" + std::to_string(std::size_t(1) << 30) + ").");
+
+	std::size_t actual_size = 2;
+
+	while (actual_size < queue_size)
+		actual_size <<= 1;
+
+	return(actual_size);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerAsync::QueueSlot::QueueSlot()
+	:sequence_(0)
+	,record_type_(RecordType_Line)
+	,log_flags_(MLB::Utility::Default)
+	,log_level_screen_(LogFlag_Mask)
+	,log_level_persistent_(LogFlag_Mask)
+	,line_start_time_(0, 0)
+	,log_level_(LogLevel_Info)
+	,log_level_flag_(LogFlag_Info)
+	,thread_id_(0)
+	,format_id_(LogBinaryFormatId_Text)
+	,line_buffer_()
+{
+	line_leader_[0] = '\0';
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerAsync::LogHandlerAsync(LogHandlerPtr target_handler_ptr,
+	std::size_t queue_size, QueueFullPolicy full_policy)
+	:LogHandler()
+	,target_handler_ptr_(target_handler_ptr)
+	,full_policy_(full_policy)
+	,queue_(FixUpQueueSize(queue_size))
+	,queue_mask_(queue_.size() - 1)
+	,enqueue_pos_(0)
+	,dequeue_pos_(0)
+	,wakeup_count_(0)
+	,done_count_(0)
+	,drop_count_(0)
+	,producer_count_(0)
+	,stop_flag_(true)
+	,consumer_thread_()
+	,control_lock_()
+{
+	if (target_handler_ptr_ == NULL)
+		throw std::invalid_argument("The target handler for an asynchronous "
+			"log handler is NULL.");
+
+	if ((full_policy_ != Block) && (full_policy_ != DropOldest) &&
+		(full_policy_ != DropNewest))
+		throw std::invalid_argument("Invalid asynchronous log handler queue-full "
+			"policy (" + std::to_string(static_cast<int>(full_policy_)) + ").");
+
+	for (std::size_t count_1 = 0; count_1 < queue_.size(); ++count_1)
+		queue_[count_1].sequence_.store(count_1, std::memory_order_relaxed);
+
+	StartConsumer();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerAsync::~LogHandlerAsync()
+{
+	try {
+		LogLockScoped my_lock(control_lock_);
+		StopConsumer();
+		target_handler_ptr_->Flush();
+	}
+	catch (const std::exception &) {
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::InstallHandler()
+{
+	LogLockScoped my_lock(control_lock_);
+
+	target_handler_ptr_->InstallHandler();
+
+	StartConsumer();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::RemoveHandler()
+{
+	LogLockScoped my_lock(control_lock_);
+
+	StopConsumer();
+
+	target_handler_ptr_->RemoveHandler();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::EmitLine(const LogEmitControl &emit_control)
+{
+	ProducerScope producer_scope(producer_count_);
+
+	if (stop_flag_.load(std::memory_order_seq_cst)) {
+		producer_scope.Release();
+		LogLockScoped my_lock(control_lock_);
+		target_handler_ptr_->EmitLine(emit_control);
+		return;
+	}
+
+	//	The leader is formatted here so as to reflect the originating thread...
+	emit_control.UpdateTime();
+
+	std::uint64_t  slot_pos;
+	QueueSlot     *slot_ptr = AcquireSlot(slot_pos);
+
+	if (slot_ptr != NULL) {
+		slot_ptr->record_type_          = RecordType_Line;
+		slot_ptr->log_flags_            = emit_control.log_flags_;
+		slot_ptr->log_level_screen_     = emit_control.log_level_screen_;
+		slot_ptr->log_level_persistent_ = emit_control.log_level_persistent_;
+		slot_ptr->line_start_time_      = emit_control.line_start_time_;
+		slot_ptr->log_level_            = emit_control.log_level_;
+		slot_ptr->log_level_flag_       = emit_control.log_level_flag_;
+		slot_ptr->thread_id_            = emit_control.thread_id_;
+		::memcpy(slot_ptr->line_leader_, emit_control.GetLeaderPtr(),
+			LogLineLeaderLength);
+		slot_ptr->line_leader_[LogLineLeaderLength] = '\0';
+		slot_ptr->line_buffer_.assign(emit_control.line_buffer_);
+		CommitEnqueueSlot(slot_ptr, slot_pos);
+	}
+
+	producer_scope.Release();
+
+	if (emit_control.log_level_ >= LogLevel_Fatal)
+		Flush();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::EmitLiteral(unsigned int literal_length,
+	const char *literal_string)
+{
+	ProducerScope producer_scope(producer_count_);
+
+	if (stop_flag_.load(std::memory_order_seq_cst)) {
+		producer_scope.Release();
+		LogLockScoped my_lock(control_lock_);
+		target_handler_ptr_->EmitLiteral(literal_length, literal_string);
+		return;
+	}
+
+	std::uint64_t  slot_pos;
+	QueueSlot     *slot_ptr = AcquireSlot(slot_pos);
+
+	if (slot_ptr != NULL) {
+		slot_ptr->record_type_ = RecordType_Literal;
+		slot_ptr->line_buffer_.assign(literal_string, literal_length);
+		CommitEnqueueSlot(slot_ptr, slot_pos);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::EmitLiteral(const LogEmitControl &emit_control,
+	unsigned int literal_length, const char *literal_string)
+{
+	ProducerScope producer_scope(producer_count_);
+
+	if (stop_flag_.load(std::memory_order_seq_cst)) {
+		producer_scope.Release();
+		LogLockScoped my_lock(control_lock_);
+		target_handler_ptr_->EmitLiteral(emit_control, literal_length,
+			literal_string);
+		return;
+	}
+
+	std::uint64_t  slot_pos;
+	QueueSlot     *slot_ptr = AcquireSlot(slot_pos);
+
+	if (slot_ptr != NULL) {
+		slot_ptr->record_type_          = RecordType_LiteralControl;
+		slot_ptr->log_flags_            = emit_control.log_flags_;
+		slot_ptr->log_level_screen_     = emit_control.log_level_screen_;
+		slot_ptr->log_level_persistent_ = emit_control.log_level_persistent_;
+		slot_ptr->log_level_            = emit_control.log_level_;
+		slot_ptr->log_level_flag_       = emit_control.log_level_flag_;
+		slot_ptr->line_buffer_.assign(literal_string, literal_length);
+		CommitEnqueueSlot(slot_ptr, slot_pos);
+	}
+
+	producer_scope.Release();
+
+	if (emit_control.log_level_ >= LogLevel_Fatal)
+		Flush();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::EmitBinary(const LogEmitControl &emit_control,
+	LogBinaryFormatId format_id, const char *arg_ptr, std::size_t arg_length)
+{
+	ProducerScope producer_scope(producer_count_);
+
+	if (stop_flag_.load(std::memory_order_seq_cst)) {
+		producer_scope.Release();
+		LogLockScoped my_lock(control_lock_);
+		target_handler_ptr_->EmitBinary(emit_control, format_id, arg_ptr,
+			arg_length);
+		return;
+	}
+
+	std::uint64_t  slot_pos;
+	QueueSlot     *slot_ptr = AcquireSlot(slot_pos);
+
+	if (slot_ptr != NULL) {
+		slot_ptr->record_type_          = RecordType_Binary;
+		slot_ptr->log_flags_            = emit_control.log_flags_;
+		slot_ptr->log_level_screen_     = emit_control.log_level_screen_;
+		slot_ptr->log_level_persistent_ = emit_control.log_level_persistent_;
+		slot_ptr->line_start_time_      = emit_control.line_start_time_;
+		slot_ptr->log_level_            = emit_control.log_level_;
+		slot_ptr->log_level_flag_       = emit_control.log_level_flag_;
+		slot_ptr->thread_id_            = emit_control.thread_id_;
+		slot_ptr->format_id_            = format_id;
+		slot_ptr->line_buffer_.assign(arg_ptr, arg_length);
+		CommitEnqueueSlot(slot_ptr, slot_pos);
+	}
+
+	producer_scope.Release();
+
+	if (emit_control.log_level_ >= LogLevel_Fatal)
+		Flush();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::EmitEvent(const LogEmitControl &emit_control)
+{
+	ProducerScope producer_scope(producer_count_);
+
+	if (stop_flag_.load(std::memory_order_seq_cst)) {
+		producer_scope.Release();
+		LogLockScoped my_lock(control_lock_);
+		target_handler_ptr_->EmitEvent(emit_control);
+		return;
+	}
+
+	std::uint64_t  slot_pos;
+	QueueSlot     *slot_ptr = AcquireSlot(slot_pos);
+
+	if (slot_ptr != NULL) {
+		slot_ptr->record_type_          = RecordType_Event;
+		slot_ptr->log_flags_            = emit_control.log_flags_;
+		slot_ptr->log_level_screen_     = emit_control.log_level_screen_;
+		slot_ptr->log_level_persistent_ = emit_control.log_level_persistent_;
+		slot_ptr->line_start_time_      = emit_control.line_start_time_;
+		slot_ptr->log_level_            = emit_control.log_level_;
+		slot_ptr->log_level_flag_       = emit_control.log_level_flag_;
+		slot_ptr->thread_id_            = emit_control.thread_id_;
+		slot_ptr->line_buffer_.assign(emit_control.field_ptr_,
+			emit_control.field_length_);
+		CommitEnqueueSlot(slot_ptr, slot_pos);
+	}
+
+	producer_scope.Release();
+
+	if (emit_control.log_level_ >= LogLevel_Fatal)
+		Flush();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Acts as a barrier: upon return, all records queued by this thread before
+	the call have been emitted to the target handler (or discarded under one
+	of the drop policies) and the target handler has been flushed.
+*/
+void LogHandlerAsync::Flush()
+{
+	if (!stop_flag_.load(std::memory_order_acquire))
+		WaitForDone(enqueue_pos_.load(std::memory_order_acquire));
+
+	target_handler_ptr_->Flush();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerPtr LogHandlerAsync::GetTargetHandlerPtr() const
+{
+	return(target_handler_ptr_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerAsync::QueueFullPolicy LogHandlerAsync::GetQueueFullPolicy() const
+{
+	return(full_policy_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogHandlerAsync::GetQueueSize() const
+{
+	return(queue_.size());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+unsigned long long LogHandlerAsync::GetDropCount() const
+{
+	return(drop_count_.load(std::memory_order_relaxed));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The queue is the bounded multi-producer/multi-consumer array queue
+	described by Dmitry Vyukov. Each slot carries a sequence number which
+	indicates whether it may be written by the producer which claims the
+	enqueue position or read by the consumer which claims the dequeue
+	position. Claiming a position is a single compare-and-swap.
+
+	Returns NULL if the queue is full.
+*/
+LogHandlerAsync::QueueSlot *LogHandlerAsync::AcquireEnqueueSlot(
+	std::uint64_t &slot_pos)
+{
+	std::uint64_t this_pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+	for ( ; ; ) {
+		QueueSlot     &this_slot = queue_[this_pos & queue_mask_];
+		std::uint64_t  this_seq  =
+			this_slot.sequence_.load(std::memory_order_acquire);
+		std::int64_t   diff      = static_cast<std::int64_t>(this_seq) -
+			static_cast<std::int64_t>(this_pos);
+		if (!diff) {
+			if (enqueue_pos_.compare_exchange_weak(this_pos, this_pos + 1,
+				std::memory_order_relaxed)) {
+				slot_pos = this_pos;
+				return(&this_slot);
+			}
+		}
+		else if (diff < 0)
+			return(NULL);
+		else
+			this_pos = enqueue_pos_.load(std::memory_order_relaxed);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Returns NULL if the queue is empty.
+*/
+LogHandlerAsync::QueueSlot *LogHandlerAsync::AcquireDequeueSlot(
+	std::uint64_t &slot_pos)
+{
+	std::uint64_t this_pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+	for ( ; ; ) {
+		QueueSlot     &this_slot = queue_[this_pos & queue_mask_];
+		std::uint64_t  this_seq  =
+			this_slot.sequence_.load(std::memory_order_acquire);
+		std::int64_t   diff      = static_cast<std::int64_t>(this_seq) -
+			static_cast<std::int64_t>(this_pos + 1);
+		if (!diff) {
+			if (dequeue_pos_.compare_exchange_weak(this_pos, this_pos + 1,
+				std::memory_order_relaxed)) {
+				slot_pos = this_pos;
+				return(&this_slot);
+			}
+		}
+		else if (diff < 0)
+			return(NULL);
+		else
+			this_pos = dequeue_pos_.load(std::memory_order_relaxed);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Applies the queue-full policy. Returns NULL if the record being emitted
+	is to be discarded.
+*/
+LogHandlerAsync::QueueSlot *LogHandlerAsync::AcquireSlot(
+	std::uint64_t &slot_pos)
+{
+	for ( ; ; ) {
+		std::uint64_t  done_count = done_count_.load(std::memory_order_acquire);
+		QueueSlot     *slot_ptr   = AcquireEnqueueSlot(slot_pos);
+		if (slot_ptr != NULL)
+			return(slot_ptr);
+		if (full_policy_ == DropNewest) {
+			drop_count_.fetch_add(1, std::memory_order_relaxed);
+			return(NULL);
+		}
+		else if (full_policy_ == DropOldest) {
+			std::uint64_t  old_pos;
+			QueueSlot     *old_ptr = AcquireDequeueSlot(old_pos);
+			if (old_ptr != NULL) {
+				ReleaseDequeueSlot(old_ptr, old_pos);
+				drop_count_.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+				std::this_thread::yield();
+		}
+		else
+			done_count_.wait(done_count, std::memory_order_acquire);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::CommitEnqueueSlot(QueueSlot *slot_ptr,
+	std::uint64_t slot_pos)
+{
+	slot_ptr->sequence_.store(slot_pos + 1, std::memory_order_release);
+
+	wakeup_count_.fetch_add(1, std::memory_order_release);
+	wakeup_count_.notify_one();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::ReleaseDequeueSlot(QueueSlot *slot_ptr,
+	std::uint64_t slot_pos)
+{
+	slot_ptr->sequence_.store(slot_pos + queue_mask_ + 1,
+		std::memory_order_release);
+
+	done_count_.fetch_add(1, std::memory_order_release);
+	done_count_.notify_all();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::EmitSlot(const QueueSlot &slot)
+{
+	if (slot.record_type_ == RecordType_Line) {
+		LogEmitControl emit_ctl(slot.log_flags_, slot.log_level_screen_,
+			slot.log_level_persistent_, slot.line_start_time_, slot.log_level_,
+			slot.log_level_flag_, slot.line_buffer_, slot.thread_id_,
+			slot.line_leader_);
+		target_handler_ptr_->EmitLine(emit_ctl);
+	}
+	else if (slot.record_type_ == RecordType_Binary) {
+		//	The binary argument data is held in the slot's line buffer...
+		std::string    empty_line;
+		char           line_leader[LogLineLeaderLength + 1];
+		LogEmitControl emit_ctl(slot.log_flags_, slot.log_level_screen_,
+			slot.log_level_persistent_, slot.line_start_time_, slot.log_level_,
+			slot.log_level_flag_, empty_line, slot.thread_id_,
+			LogEmitControl::FormatLeader(line_leader, slot.line_start_time_,
+			slot.log_level_, slot.thread_id_, slot.log_flags_));
+		target_handler_ptr_->EmitBinary(emit_ctl, slot.format_id_,
+			slot.line_buffer_.data(), slot.line_buffer_.size());
+	}
+	else if (slot.record_type_ == RecordType_Event) {
+		//	The encoded event fields are held in the slot's line buffer...
+		std::string    empty_line;
+		LogEmitControl emit_ctl(slot.log_flags_, slot.log_level_screen_,
+			slot.log_level_persistent_, slot.line_start_time_, slot.log_level_,
+			slot.log_level_flag_, empty_line);
+		emit_ctl.thread_id_    = slot.thread_id_;
+		emit_ctl.field_ptr_    = slot.line_buffer_.data();
+		emit_ctl.field_length_ = slot.line_buffer_.size();
+		target_handler_ptr_->EmitEvent(emit_ctl);
+	}
+	else if (slot.record_type_ == RecordType_Literal)
+		target_handler_ptr_->EmitLiteral(
+			static_cast<unsigned int>(slot.line_buffer_.size()),
+			slot.line_buffer_.c_str());
+	else {
+		LogEmitControl emit_ctl(slot.log_flags_, slot.log_level_screen_,
+			slot.log_level_persistent_, slot.log_level_, slot.log_level_flag_);
+		target_handler_ptr_->EmitLiteral(emit_ctl,
+			static_cast<unsigned int>(slot.line_buffer_.size()),
+			slot.line_buffer_.c_str());
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerAsync::ConsumerThreadProc()
+{
+	for ( ; ; ) {
+		std::uint64_t  wakeup_count =
+			wakeup_count_.load(std::memory_order_acquire);
+		std::uint64_t  slot_pos;
+		QueueSlot     *slot_ptr     = AcquireDequeueSlot(slot_pos);
+		if (slot_ptr != NULL) {
+			try {
+				EmitSlot(*slot_ptr);
+			}
+			catch (const std::exception &) {
+				//	There is no one to whom the error could be reported...
+			}
+			ReleaseDequeueSlot(slot_ptr, slot_pos);
+		}
+		else if (stop_flag_.load(std::memory_order_acquire))
+			break;
+		else
+			wakeup_count_.wait(wakeup_count, std::memory_order_acquire);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Called with control_lock_ held.
+void LogHandlerAsync::StartConsumer()
+{
+	if (!stop_flag_.load(std::memory_order_acquire))
+		return;
+
+	stop_flag_.store(false, std::memory_order_release);
+
+	try {
+		std::thread tmp_thread(&LogHandlerAsync::ConsumerThreadProc, this);
+		consumer_thread_.swap(tmp_thread);
+	}
+	catch (const std::exception &) {
+		stop_flag_.store(true, std::memory_order_release);
+		throw;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Called with control_lock_ held.
+
+	Producers which had not seen the stop flag may still be queueing records
+	after the consumer has exited. The queue is drained until none remain in
+	flight, draining once more after the count is seen to be zero. Draining
+	also frees slots for producers blocked under the Block policy.
+*/
+void LogHandlerAsync::StopConsumer()
+{
+	if (stop_flag_.load(std::memory_order_acquire))
+		return;
+
+	stop_flag_.store(true, std::memory_order_seq_cst);
+	wakeup_count_.fetch_add(1, std::memory_order_release);
+	wakeup_count_.notify_all();
+
+	if (consumer_thread_.joinable())
+		consumer_thread_.join();
+
+	for ( ; ; ) {
+		bool           idle_flag =
+			(producer_count_.load(std::memory_order_seq_cst) == 0);
+		std::uint64_t  slot_pos;
+		QueueSlot     *slot_ptr;
+		while ((slot_ptr = AcquireDequeueSlot(slot_pos)) != NULL) {
+			try {
+				EmitSlot(*slot_ptr);
+			}
+			catch (const std::exception &) {
+			}
+			ReleaseDequeueSlot(slot_ptr, slot_pos);
+		}
+		if (idle_flag)
+			break;
+		std::this_thread::yield();
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Waits until every queue position less than target_count has either been
+	emitted by the consumer or discarded.
+
+	Under the DropOldest policy producers release positions while the
+	consumer is emitting an earlier one, so the count of released positions
+	doesn't suffice. Instead, the sequence of each slot is checked: it
+	reaches the position plus the queue size only when the position has been
+	released, and thereafter only increases. Positions more than the queue
+	size below target_count must already have been released, as their slots
+	have since been claimed for enqueueing.
+*/
+void LogHandlerAsync::WaitForDone(std::uint64_t target_count)
+{
+	std::uint64_t queue_size = queue_mask_ + 1;
+	std::uint64_t check_pos  =
+		(target_count > queue_size) ? (target_count - queue_size) : 0;
+
+	for ( ; ; ) {
+		std::uint64_t done_count = done_count_.load(std::memory_order_acquire);
+		while ((check_pos < target_count) &&
+			(queue_[check_pos & queue_mask_].sequence_.load(
+			std::memory_order_acquire) >= (check_pos + queue_size)))
+			++check_pos;
+		if (check_pos >= target_count)
+			break;
+		if (stop_flag_.load(std::memory_order_acquire))
+			break;
+		done_count_.wait(done_count, std::memory_order_acquire);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogHandlerFile.hpp>
+#include <Logger/LogManager.hpp>
+#include <Logger/LogTestSupport.hpp>
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+class TEST_LineCounter : public MLB::Utility::LogHandler {
+public:
+	TEST_LineCounter()
+		:MLB::Utility::LogHandler()
+		,line_count_(0)
+	{
+	}
+
+	void EmitLine(const MLB::Utility::LogEmitControl &) override {
+		line_count_.fetch_add(1, std::memory_order_relaxed);
+	}
+	void EmitLiteral(unsigned int, const char *) override {
+	}
+	void EmitLiteral(const MLB::Utility::LogEmitControl &, unsigned int,
+		const char *) override {
+	}
+
+	std::atomic<unsigned int> line_count_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Stops and restarts the handler while threads are emitting. Every line
+	must reach the target, whether queued or emitted directly while stopped.
+*/
+void TEST_StopWhileEmitting(MLB::Utility::LogHandlerAsync::QueueFullPolicy
+	full_policy)
+{
+	using namespace MLB::Utility;
+
+	const unsigned int        thread_count = 4;
+	const unsigned int        line_count   = 20000;
+	LogSPtr<TEST_LineCounter> counter_ptr(new TEST_LineCounter);
+	std::atomic<unsigned int> done_count(0);
+	std::vector<std::thread>  thread_list;
+
+	{
+		LogHandlerAsync async_handler(counter_ptr, 64, full_policy);
+		for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1)
+			thread_list.emplace_back([&async_handler, &done_count, line_count]() {
+				for (unsigned int count_2 = 0; count_2 < line_count; ++count_2)
+					async_handler.EmitLineSpecific("Stop test line " +
+						std::to_string(count_2));
+				++done_count;
+			});
+		while (done_count.load() < thread_count) {
+			async_handler.RemoveHandler();
+			async_handler.InstallHandler();
+		}
+		for (auto &this_thread : thread_list)
+			this_thread.join();
+		async_handler.RemoveHandler();
+		if (full_policy == LogHandlerAsync::Block) {
+			if (counter_ptr->line_count_.load() != (thread_count * line_count))
+				throw std::logic_error("Expected " +
+					std::to_string(thread_count * line_count) + " lines across "
+					"handler stops, but " +
+					std::to_string(counter_ptr->line_count_.load()) +
+					" were emitted.");
+		}
+		else if ((counter_ptr->line_count_.load() +
+			async_handler.GetDropCount()) != (thread_count * line_count))
+			throw std::logic_error("Expected " +
+				std::to_string(thread_count * line_count) + " lines emitted or "
+				"dropped across handler stops, but " +
+				std::to_string(counter_ptr->line_count_.load()) + " were emitted "
+				"and " + std::to_string(async_handler.GetDropCount()) +
+				" dropped.");
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Captures each line once it has been emitted. The short sleep keeps the
+	queue full, so that producers continually discard the oldest records
+	while the consumer is emitting.
+*/
+class TEST_SlowCapture : public MLB::Utility::LogHandlerCapture {
+public:
+	explicit TEST_SlowCapture(std::size_t record_count)
+		:MLB::Utility::LogHandlerCapture(record_count)
+	{
+	}
+
+	void EmitLine(const MLB::Utility::LogEmitControl &emit_control) override {
+		std::this_thread::sleep_for(std::chrono::microseconds(20));
+		MLB::Utility::LogHandlerCapture::EmitLine(emit_control);
+	}
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Flushes under the DropOldest policy while other threads flood the queue.
+	Every record queued by the flushing thread before a call to Flush() must
+	have been emitted or discarded by the time the call returns, so none may
+	be emitted afterwards.
+*/
+void TEST_FlushDropOldest()
+{
+	using namespace MLB::Utility;
+
+	const unsigned int         thread_count = 3;
+	const unsigned int         flush_count  = 2000;
+	LogSPtr<TEST_SlowCapture>  capture_ptr(new TEST_SlowCapture(1 << 17));
+	std::atomic<bool>          stop_flag(false);
+	std::vector<std::thread>   thread_list;
+	std::vector<std::uint64_t> flushed_list;
+
+	{
+		LogHandlerAsync async_handler(capture_ptr, 16,
+			LogHandlerAsync::DropOldest);
+		for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1)
+			thread_list.emplace_back([&async_handler, &stop_flag]() {
+				while (!stop_flag.load(std::memory_order_relaxed))
+					async_handler.EmitLineSpecific("Flood line");
+			});
+		for (unsigned int count_1 = 0; count_1 < flush_count; ++count_1) {
+			async_handler.EmitLineSpecific("Flush line " +
+				std::to_string(count_1));
+			async_handler.Flush();
+			flushed_list.push_back(capture_ptr->GetCaptureCount());
+		}
+		stop_flag = true;
+		for (auto &this_thread : thread_list)
+			this_thread.join();
+	}
+
+	if (capture_ptr->GetCaptureCount() > capture_ptr->GetRecordCapacity())
+		throw std::logic_error("The capture of the flush test overflowed.");
+
+	std::string late_line;
+
+	capture_ptr->Visit([&](const LogCaptureRecord &this_record) {
+		static const std::string flush_prefix("Flush line ");
+		if (this_record.message_.compare(0, flush_prefix.size(), flush_prefix))
+			return;
+		std::size_t flush_index = std::stoul(std::string(
+			this_record.message_.substr(flush_prefix.size())));
+		if (this_record.sequence_ >= flushed_list[flush_index])
+			late_line.assign(this_record.message_);
+	});
+
+	if (!late_line.empty())
+		throw std::logic_error("The line '" + late_line + "' was emitted "
+			"after the Flush() which followed it returned.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	using namespace MLB::Utility;
+
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		//	Queue lines to a LogHandlerXFile from the asynchronous handler...
+		LogHandlerPtr my_log_handler(
+			new LogHandlerAsync(LogHandlerPtr(new LogHandlerXFile(
+				TEST_GetLogFileName("LogHandlerAsync"),
+				LogHandlerFileBase::NoConsoleOutput))));
+		TEST_TestControl(my_log_handler, 10000, 200, 1, 2000000);
+		//	Small queues under the drop policies must count their discards...
+		LogHandlerAsync drop_handler(LogHandlerPtr(new LogHandlerXFile(
+			TEST_GetLogFileName("LogHandlerAsync.DropNewest"),
+			LogHandlerFileBase::NoConsoleOutput)), 2,
+			LogHandlerAsync::DropNewest);
+		for (unsigned int count_1 = 0; count_1 < 100000; ++count_1)
+			drop_handler.EmitLineSpecific("Drop test line " +
+				std::to_string(count_1));
+		drop_handler.Flush();
+		std::cout << "LogHandlerAsync::DropNewest discarded " <<
+			drop_handler.GetDropCount() << " of 100000 lines." << std::endl;
+		TEST_StopWhileEmitting(LogHandlerAsync::Block);
+		TEST_StopWhileEmitting(LogHandlerAsync::DropOldest);
+		TEST_StopWhileEmitting(LogHandlerAsync::DropNewest);
+		TEST_FlushDropOldest();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
@@ -0,0 +1,626 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerBinary.cpp
+
+   File Description  :  Implementation of the binary log file handler class.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerBinary.hpp>
+
+#include <Utility/ThrowErrno.hpp>
+
+#include <iostream>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerBinary::LogHandlerBinary()
+	:LogHandlerFileBase()
+	,file_fd_(-1)
+	,out_buffer_(DefaultBufferSize)
+	,out_buffer_used_(0)
+	,format_written_list_()
+	,write_failure_count_(0)
+	,file_size_(0)
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerBinary::LogHandlerBinary(const char *file_name,
+	LogHandlerFileBaseFlag flags)
+	:LogHandlerFileBase(flags)
+	,file_fd_(-1)
+	,out_buffer_(DefaultBufferSize)
+	,out_buffer_used_(0)
+	,format_written_list_()
+	,write_failure_count_(0)
+	,file_size_(0)
+{
+	OpenFile(file_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerBinary::LogHandlerBinary(const std::string &file_name,
+	LogHandlerFileBaseFlag flags)
+	:LogHandlerFileBase(flags)
+	,file_fd_(-1)
+	,out_buffer_(DefaultBufferSize)
+	,out_buffer_used_(0)
+	,format_written_list_()
+	,write_failure_count_(0)
+	,file_size_(0)
+{
+	OpenFile(file_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerBinary::~LogHandlerBinary()
+{
+	LogLockScoped my_lock(the_lock_);
+
+	try {
+		CloseFile();
+	}
+	catch (const std::exception &) {
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerBinary::GetWriteFailureCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(write_failure_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Persistent output doesn't use the formatted leader, so the time is only
+	formatted when the line is also to be written to the console.
+*/
+void LogHandlerBinary::EmitLine(const LogEmitControl &emit_control)
+{
+	bool to_console = (!(my_flags_ & NoConsoleOutput)) &&
+		emit_control.ShouldLogScreen();
+
+	if (emit_control.ShouldLogPersistent() || to_console) {
+		LogLockScoped my_lock(the_lock_);
+		if (emit_control.ShouldLogPersistent())
+			EmitLineImpl(emit_control);
+		if (to_console) {
+			emit_control.UpdateTime();
+			std::cout.write(emit_control.GetLeaderPtr(),
+				static_cast<std::streamsize>(emit_control.GetLeaderLength()));
+			std::cout.write(emit_control.line_buffer_.c_str(),
+				static_cast<std::streamsize>(emit_control.line_buffer_.size()));
+			std::cout << std::endl;
+		}
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::EmitBinary(const LogEmitControl &emit_control,
+	LogBinaryFormatId format_id, const char *arg_ptr, std::size_t arg_length)
+{
+	bool to_console = (!(my_flags_ & NoConsoleOutput)) &&
+		emit_control.ShouldLogScreen();
+
+	if (emit_control.ShouldLogPersistent() || to_console) {
+		LogLockScoped my_lock(the_lock_);
+		if (emit_control.ShouldLogPersistent() && (file_fd_ >= 0)) {
+			WriteFormatRecord(format_id);
+			WriteRecord(LogBinaryRecordType_Line, emit_control.log_level_,
+				emit_control.line_start_time_, emit_control.thread_id_,
+				format_id, arg_ptr, arg_length);
+			if (emit_control.log_level_ >= LogLevel_Fatal)
+				FlushBuffer();
+		}
+		if (to_console) {
+			std::string line_buffer;
+			char        line_leader[LogLineLeaderLength + 1];
+			LogBinaryRender(format_id, arg_ptr, arg_length, line_buffer);
+			std::cout.write(LogEmitControl::FormatLeader(line_leader,
+				emit_control.line_start_time_, emit_control.log_level_,
+				emit_control.thread_id_, emit_control.log_flags_),
+				static_cast<std::streamsize>(LogLineLeaderLength));
+			std::cout.write(line_buffer.c_str(),
+				static_cast<std::streamsize>(line_buffer.size()));
+			std::cout << std::endl;
+		}
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The encoded event fields are written as-is under the reserved event
+	format id.
+*/
+void LogHandlerBinary::EmitEvent(const LogEmitControl &emit_control)
+{
+	EmitBinary(emit_control, LogBinaryFormatId_Event, emit_control.field_ptr_,
+		emit_control.field_length_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::InstallHandlerImpl()
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::RemoveHandlerImpl()
+{
+	FlushBuffer();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::OpenFileImpl(const char *file_name)
+{
+	int           tmp_fd        = ::open(file_name, O_WRONLY | O_CREAT |
+		O_APPEND | ((my_flags_ & DoNotAppend) ? O_TRUNC : 0), 0644);
+	std::uint64_t tmp_file_size = 0;
+
+	if (tmp_fd < 0)
+		ThrowErrno("Open attempt failed");
+
+	try {
+		struct stat stat_data;
+		if (::fstat(tmp_fd, &stat_data))
+			ThrowErrno("Attempt to determine the size of the file failed");
+		tmp_file_size = static_cast<std::uint64_t>(stat_data.st_size);
+		if (!stat_data.st_size) {
+			LogBinaryFileHeader file_header;
+			::memset(&file_header, '\0', sizeof(file_header));
+			::memcpy(file_header.magic_, LogBinaryFileMagic,
+				sizeof(LogBinaryFileMagic));
+			file_header.byte_order_    = LogBinaryFileByteOrder;
+			file_header.version_       = LogBinaryFileVersion;
+			file_header.header_length_ = sizeof(file_header);
+			if (::write(tmp_fd, &file_header, sizeof(file_header)) !=
+				static_cast<ssize_t>(sizeof(file_header)))
+				ThrowErrno("Attempt to write the binary log file header failed");
+			tmp_file_size = sizeof(file_header);
+		}
+	}
+	catch (const std::exception &) {
+		::close(tmp_fd);
+		throw;
+	}
+
+	{
+		std::string   tmp_file_name(file_name);
+		LogLockScoped my_lock(the_lock_);
+		CloseFile();
+		file_fd_   = tmp_fd;
+		file_size_ = tmp_file_size;
+		out_file_name_.swap(tmp_file_name);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::FlushImpl()
+{
+	FlushBuffer();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::EmitLineImpl(const LogEmitControl &emit_control)
+{
+	if (file_fd_ >= 0) {
+		std::uint32_t text_length =
+			static_cast<std::uint32_t>(emit_control.line_buffer_.size());
+		char          text_prefix[1 + sizeof(text_length)];
+		text_prefix[0] = static_cast<char>(LogBinaryArgType_String);
+		::memcpy(text_prefix + 1, &text_length, sizeof(text_length));
+		WriteRecord(LogBinaryRecordType_Line, emit_control.log_level_,
+			emit_control.line_start_time_, emit_control.thread_id_,
+			LogBinaryFormatId_Text, text_prefix, sizeof(text_prefix),
+			emit_control.line_buffer_.data(), text_length);
+		if (emit_control.log_level_ >= LogLevel_Fatal)
+			FlushBuffer();
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::EmitLiteralImpl(unsigned int literal_length,
+	const char *literal_string)
+{
+	if (file_fd_ >= 0)
+		WriteRecord(LogBinaryRecordType_Literal, LogLevel_Literal, TimeSpec(),
+			CurrentThreadId(), LogBinaryFormatId_Text, literal_string,
+			literal_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::WriteRecord(LogBinaryRecordType record_type,
+	LogLevel log_level, const TimeSpec &record_time, ThreadId thread_id,
+	LogBinaryFormatId format_id, const char *data_ptr_1,
+	std::size_t data_length_1, const char *data_ptr_2,
+	std::size_t data_length_2)
+{
+	if ((data_length_1 + data_length_2) > LogBinaryMaxDataLength) {
+		++write_failure_count_;
+		return;
+	}
+
+	LogBinaryRecordHeader record_header;
+
+	::memset(&record_header, '\0', sizeof(record_header));
+
+	record_header.data_length_   =
+		static_cast<std::uint32_t>(data_length_1 + data_length_2);
+	record_header.record_length_ =
+		static_cast<std::uint32_t>(sizeof(record_header)) +
+		record_header.data_length_;
+	record_header.record_type_   = static_cast<std::uint8_t>(record_type);
+	record_header.log_level_     = static_cast<std::uint8_t>(log_level);
+	record_header.time_secs_     =
+		static_cast<std::uint64_t>(record_time.tv_sec);
+	record_header.time_nsecs_    =
+		static_cast<std::uint32_t>(record_time.tv_nsec);
+	record_header.thread_id_     = static_cast<std::uint32_t>(thread_id);
+	record_header.format_id_     = format_id;
+
+	std::size_t record_length = record_header.record_length_;
+
+	if ((out_buffer_used_ + record_length) > out_buffer_.size())
+		FlushBuffer();
+
+	if (record_length > out_buffer_.size()) {
+		if (WriteOut(reinterpret_cast<const char *>(&record_header),
+			sizeof(record_header)) && WriteOut(data_ptr_1, data_length_1) &&
+			WriteOut(data_ptr_2, data_length_2))
+			file_size_ += record_length;
+		else
+			DiscardFailedWrite();
+	}
+	else {
+		BufferData(&record_header, sizeof(record_header));
+		BufferData(data_ptr_1, data_length_1);
+		BufferData(data_ptr_2, data_length_2);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Each format is described in the file once, prior to its first use.
+*/
+void LogHandlerBinary::WriteFormatRecord(LogBinaryFormatId format_id)
+{
+	if ((format_id < format_written_list_.size()) &&
+		format_written_list_[format_id])
+		return;
+
+	LogBinaryFormat format;
+
+	if ((format_id == LogBinaryFormatId_Text) ||
+		(format_id == LogBinaryFormatId_Event) ||
+		(!LogBinaryFormatGet(format_id, format)))
+		return;
+
+	if (format_id >= format_written_list_.size())
+		format_written_list_.resize(format_id + 1, false);
+
+	std::string   format_data;
+	std::uint32_t line_number      = format.line_number_;
+	std::uint32_t file_name_length =
+		static_cast<std::uint32_t>(::strlen(format.file_name_));
+
+	format_data.append(reinterpret_cast<const char *>(&line_number),
+		sizeof(line_number));
+	format_data.append(reinterpret_cast<const char *>(&file_name_length),
+		sizeof(file_name_length));
+	format_data.append(format.file_name_, file_name_length);
+	format_data.append(format.format_string_);
+
+	WriteRecord(LogBinaryRecordType_Format, LogLevel_Literal, TimeSpec(),
+		CurrentThreadId(), format_id, format_data.data(), format_data.size());
+
+	format_written_list_[format_id] = true;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	The caller ensures that the buffer has room for the data.
+void LogHandlerBinary::BufferData(const void *data_ptr, std::size_t data_length)
+{
+	if (data_length) {
+		::memcpy(out_buffer_.data() + out_buffer_used_, data_ptr, data_length);
+		out_buffer_used_ += data_length;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogHandlerBinary::WriteOut(const char *data_ptr, std::size_t data_length)
+{
+	while (data_length) {
+		ssize_t write_count = ::write(file_fd_, data_ptr, data_length);
+		if (write_count < 0) {
+			if (errno == EINTR)
+				continue;
+			return(false);
+		}
+		data_ptr    += write_count;
+		data_length -= static_cast<std::size_t>(write_count);
+	}
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	As with LogHandlerXFile, a failed write doesn't throw into the thread
+	which is logging: the data is discarded and the failure is counted.
+
+	Writes to the file end on record boundaries, so the file is truncated to
+	the end of the last record written in full. A partial write thus never
+	leaves a torn record before the records which follow. The formats
+	described in the discarded data are described again upon their next use.
+*/
+void LogHandlerBinary::DiscardFailedWrite()
+{
+	++write_failure_count_;
+
+	format_written_list_.clear();
+
+	if (::ftruncate(file_fd_, static_cast<off_t>(file_size_)) != 0) {
+		//	Nothing more can be done; the next write will also likely fail...
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::FlushBuffer()
+{
+	if (out_buffer_used_ && (file_fd_ >= 0)) {
+		std::size_t data_length = out_buffer_used_;
+		out_buffer_used_ = 0;
+		if (WriteOut(out_buffer_.data(), data_length))
+			file_size_ += data_length;
+		else
+			DiscardFailedWrite();
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerBinary::CloseFile()
+{
+	if (file_fd_ >= 0) {
+		FlushBuffer();
+		::close(file_fd_);
+		file_fd_ = -1;
+		format_written_list_.clear();
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogManager.hpp>
+#include <Logger/LogTestSupport.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include <signal.h>
+#include <sys/resource.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+LogManagerMacroDeclaration(MB_LIB_LOCAL)
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_DeferredStatements(MLB::Utility::LogHandlerPtr my_log_handler)
+{
+	using namespace MLB::Utility;
+
+	LogLevelPair old_levels_console = MyLogManager.GetLogLevelConsole();
+	LogLevelPair old_levels_file    = MyLogManager.GetLogLevelFile();
+
+	MyLogManager.SetLogLevelConsole(LogLevel_Info);
+	MyLogManager.SetLogLevelFile(LogLevel_Info);
+
+	for (unsigned int count_1 = 0; count_1 < 10; ++count_1)
+		LogDeferred(LogLevel_Info, LogInfo, "Deferred line {} of {}: "
+			"ratio={} name={} ok={}", count_1 + 1, 10, 0.25 * count_1, "alpha",
+			count_1 & 1);
+
+	LogDeferred(LogLevel_Info, LogInfo, "Braces {{}} and too few arguments "
+		"{} {}", 'x');
+	LogDeferred(LogLevel_Info, LogInfo, "Extra arguments:", -1,
+		std::string("beta"));
+	LogDeferred(LogLevel_Spam, LogSpam, "Never emitted {}", 0);
+	LogInfo.Event("order_ack", LogKV("id", 42), LogKV("venue", "NYSE ARCA"));
+
+	MyLogManager.SetLogLevelConsole(old_levels_console.first,
+		old_levels_console.second);
+	MyLogManager.SetLogLevelFile(old_levels_file.first, old_levels_file.second);
+
+	my_log_handler->Flush();
+
+	std::ifstream      in_file(
+		dynamic_cast<LogHandlerBinary &>(*my_log_handler).GetFileName(),
+		std::ios_base::in | std::ios_base::binary);
+	std::ostringstream o_str;
+
+	LogBinaryDecode(in_file, o_str);
+
+	const char *expected_list[] = {
+		"Deferred line 1 of 10: ratio=0 name=alpha ok=0",
+		"Deferred line 10 of 10: ratio=2.25 name=alpha ok=1",
+		"Braces {} and too few arguments x {}",
+		"Extra arguments: -1 beta",
+		"order_ack id=42 venue=\"NYSE ARCA\"",
+		"LITERAL #1: std::string(hello, world)"
+	};
+
+	for (const char *expected : expected_list) {
+		if (o_str.str().find(expected) == std::string::npos)
+			throw std::logic_error("Decoded binary log file does not contain "
+				"the expected text '" + std::string(expected) + "'.");
+	}
+
+	if (o_str.str().find("Never emitted") != std::string::npos)
+		throw std::logic_error("Decoded binary log file contains a record "
+			"for a disabled log level.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Writes beyond a file size limit fail with EFBIG. They must be counted
+	rather than thrown into the logging thread.
+*/
+void TEST_WriteFailures()
+{
+	using namespace MLB::Utility;
+
+	struct rlimit old_limit;
+	struct rlimit new_limit;
+
+	if (::getrlimit(RLIMIT_FSIZE, &old_limit))
+		ThrowErrno("Attempt to get the file size limit failed");
+
+	new_limit          = old_limit;
+	new_limit.rlim_cur = 64 * 1024;
+
+	LogHandlerBinary binary_handler(TEST_GetLogFileName(
+		"LogHandlerBinary.WriteFailures"), static_cast<
+		LogHandlerFileBase::LogHandlerFileBaseFlag>(
+		LogHandlerFileBase::DoNotAppend | LogHandlerFileBase::NoConsoleOutput));
+	auto             old_handler = ::signal(SIGXFSZ, SIG_IGN);
+
+	if (::setrlimit(RLIMIT_FSIZE, &new_limit))
+		ThrowErrno("Attempt to set the file size limit failed");
+
+	try {
+		for (unsigned int count_1 = 0; count_1 < 10000; ++count_1)
+			binary_handler.EmitLineSpecific("Write failure test line " +
+				std::to_string(count_1));
+		binary_handler.Flush();
+	}
+	catch (const std::exception &except) {
+		::setrlimit(RLIMIT_FSIZE, &old_limit);
+		::signal(SIGXFSZ, old_handler);
+		throw std::logic_error("A failed write to a binary log file threw: " +
+			std::string(except.what()));
+	}
+
+	::setrlimit(RLIMIT_FSIZE, &old_limit);
+	::signal(SIGXFSZ, old_handler);
+
+	if (!binary_handler.GetWriteFailureCount())
+		throw std::logic_error("Writes beyond the file size limit were not "
+			"counted as failures.");
+
+	//	The partial writes must not have left a torn record in the file...
+	binary_handler.EmitLineSpecific("Line after the write failures");
+	binary_handler.Flush();
+
+	std::ifstream      in_file(binary_handler.GetFileName(),
+		std::ios_base::in | std::ios_base::binary);
+	std::ostringstream o_str;
+
+	try {
+		LogBinaryDecode(in_file, o_str);
+	}
+	catch (const std::exception &except) {
+		throw std::logic_error("Unable to decode the binary log file after "
+			"the write failures: " + std::string(except.what()));
+	}
+
+	if (o_str.str().find("Line after the write failures") ==
+		std::string::npos)
+		throw std::logic_error("The line written after the write failures was "
+			"not decoded.");
+
+	std::cout << "LogHandlerBinary counted " <<
+		binary_handler.GetWriteFailureCount() << " failed writes." << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	using namespace MLB::Utility;
+
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		LogHandlerPtr my_log_handler(
+			new LogHandlerBinary(TEST_GetLogFileName("LogHandlerBinary"),
+			LogHandlerFileBase::DoNotAppend));
+		TEST_TestControl(my_log_handler, 10000, 200, 1, 2000000);
+		TEST_DeferredStatements(my_log_handler);
+		TEST_WriteFailures();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
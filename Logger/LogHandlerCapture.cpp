@@ -0,0 +1,614 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerCapture.cpp
+
+   File Description  :  Implementation of the in-process log capture handler.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerCapture.hpp>
+
+#include <Utility/ThrowErrno.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <shared_mutex>
+#include <vector>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The record with sequence number N is held in slot N % record_count. The
+	retained records are those from GetOldestSequence() up to (but not
+	including) next_sequence_.
+*/
+struct LogCaptureSubscriber::Ring {
+	explicit Ring(std::size_t record_count);
+
+	struct Slot {
+		Slot();
+
+		LogLevel    log_level_;
+		ThreadId    thread_id_;
+		TimeSpec    line_time_;
+		std::string leader_;
+		std::string message_;
+	};
+
+	mutable std::shared_mutex           ring_lock_;
+	std::vector<Slot>                   slot_list_;
+	std::uint64_t                       next_sequence_;
+	std::uint64_t                       clear_sequence_;
+	std::vector<LogCaptureSubscriber *> subscriber_list_;
+
+	std::uint64_t GetOldestSequence() const;
+	std::size_t   Visit(const LogCaptureFunc &record_func,
+		LogLevelFlag level_mask, std::uint64_t &next_sequence,
+		std::size_t max_records) const;
+
+private:
+	Ring(const Ring &) = delete;
+	Ring & operator = (const Ring &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogCaptureSubscriber::Ring::Slot::Slot()
+	:log_level_(LogLevel_Literal)
+	,thread_id_()
+	,line_time_(0, 0)
+	,leader_()
+	,message_()
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogCaptureSubscriber::Ring::Ring(std::size_t record_count)
+	:ring_lock_()
+	,slot_list_(record_count)
+	,next_sequence_(0)
+	,clear_sequence_(0)
+	,subscriber_list_()
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Called with the lock held.
+std::uint64_t LogCaptureSubscriber::Ring::GetOldestSequence() const
+{
+	std::uint64_t oldest_sequence = (next_sequence_ > slot_list_.size()) ?
+		(next_sequence_ - slot_list_.size()) : 0;
+
+	return(std::max(oldest_sequence, clear_sequence_));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Called with the lock held in at least shared mode. Passes the records
+	from next_sequence onwards and updates it to follow the last record
+	examined.
+*/
+std::size_t LogCaptureSubscriber::Ring::Visit(
+	const LogCaptureFunc &record_func, LogLevelFlag level_mask,
+	std::uint64_t &next_sequence, std::size_t max_records) const
+{
+	std::size_t      record_count = 0;
+	LogCaptureRecord this_record;
+
+	while ((next_sequence < next_sequence_) && (record_count < max_records)) {
+		const Slot &slot_ref =
+			slot_list_[static_cast<std::size_t>(next_sequence % slot_list_.size())];
+		if (level_mask & (1 << slot_ref.log_level_)) {
+			this_record.sequence_  = next_sequence;
+			this_record.log_level_ = slot_ref.log_level_;
+			this_record.thread_id_ = slot_ref.thread_id_;
+			this_record.line_time_ = slot_ref.line_time_;
+			this_record.leader_    = slot_ref.leader_;
+			this_record.message_   = slot_ref.message_;
+			record_func(this_record);
+			++record_count;
+		}
+		++next_sequence;
+	}
+
+	return(record_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogCaptureSubscriber::LogCaptureSubscriber(LogSPtr<Ring> ring_sptr,
+	LogLevelFlag level_mask, bool use_event_fd)
+	:ring_sptr_(ring_sptr)
+	,level_mask_(level_mask)
+	,event_fd_(-1)
+	,next_sequence_(0)
+	,dropped_count_(0)
+	,armed_flag_(true)
+{
+	if (use_event_fd &&
+		((event_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0))
+		ThrowErrno("Attempt to create a log capture eventfd failed");
+
+	std::unique_lock<std::shared_mutex> my_lock(ring_sptr_->ring_lock_);
+
+	next_sequence_ = ring_sptr_->next_sequence_;
+
+	ring_sptr_->subscriber_list_.push_back(this);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogCaptureSubscriber::~LogCaptureSubscriber()
+{
+	{
+		std::unique_lock<std::shared_mutex> my_lock(ring_sptr_->ring_lock_);
+		auto &subscriber_list = ring_sptr_->subscriber_list_;
+		subscriber_list.erase(std::remove(subscriber_list.begin(),
+			subscriber_list.end(), this), subscriber_list.end());
+	}
+
+	if (event_fd_ >= 0)
+		::close(event_fd_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The subscriber is armed (and so will be signalled by the next record in
+	its mask) only once it has received every available record. Because the
+	ring is locked, no record can arrive between the last record being
+	passed and the subscriber being armed.
+*/
+std::size_t LogCaptureSubscriber::Poll(const LogCaptureFunc &record_func,
+	std::size_t max_records)
+{
+	std::shared_lock<std::shared_mutex> my_lock(ring_sptr_->ring_lock_);
+
+	std::uint64_t oldest_sequence = ring_sptr_->GetOldestSequence();
+
+	if (next_sequence_ < oldest_sequence) {
+		dropped_count_ += oldest_sequence - next_sequence_;
+		next_sequence_  = oldest_sequence;
+	}
+
+	std::size_t record_count = ring_sptr_->Visit(record_func, level_mask_,
+		next_sequence_, max_records);
+
+	if (next_sequence_ == ring_sptr_->next_sequence_)
+		armed_flag_ = true;
+
+	return(record_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogCaptureSubscriber::Wait(int timeout_ms)
+{
+	if (event_fd_ < 0)
+		throw std::invalid_argument("The log capture subscriber was created "
+			"without an eventfd.");
+
+	struct pollfd poll_fd;
+
+	poll_fd.fd      = event_fd_;
+	poll_fd.events  = POLLIN;
+	poll_fd.revents = 0;
+
+	int poll_count;
+
+	while ((poll_count = ::poll(&poll_fd, 1, timeout_ms)) < 0) {
+		if (errno != EINTR)
+			ThrowErrno("Attempt to wait for a log capture eventfd failed");
+	}
+
+	if (!poll_count)
+		return(false);
+
+	eventfd_t event_value;
+
+	::eventfd_read(event_fd_, &event_value);
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+int LogCaptureSubscriber::GetEventFd() const
+{
+	return(event_fd_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogLevelFlag LogCaptureSubscriber::GetLevelMask() const
+{
+	return(level_mask_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogCaptureSubscriber::GetDroppedCount() const
+{
+	return(dropped_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerCapture::LogHandlerCapture(std::size_t record_count)
+	:LogHandler()
+	,ring_sptr_()
+{
+	if (!record_count)
+		throw std::invalid_argument("The log capture record count must be "
+			"greater than zero.");
+
+	ring_sptr_ = std::make_shared<LogCaptureSubscriber::Ring>(record_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerCapture::~LogHandlerCapture()
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerCapture::EmitLine(const LogEmitControl &emit_control)
+{
+	if (emit_control.ShouldLogPersistent() || emit_control.ShouldLogScreen()) {
+		emit_control.UpdateTime();
+		Capture(emit_control.log_level_, emit_control.thread_id_,
+			emit_control.line_start_time_, emit_control.GetLeaderPtr(),
+			emit_control.GetLeaderLength(), emit_control.line_buffer_.data(),
+			emit_control.line_buffer_.size());
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerCapture::EmitLiteral(unsigned int literal_length,
+	const char *literal_string)
+{
+	Capture(LogLevel_Literal, ThreadId(), TimeSpec(), NULL, 0, literal_string,
+		literal_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerCapture::EmitLiteral(const LogEmitControl &emit_control,
+	unsigned int literal_length, const char *literal_string)
+{
+	if (emit_control.ShouldLogPersistent() || emit_control.ShouldLogScreen())
+		Capture(emit_control.log_level_, emit_control.thread_id_,
+			emit_control.line_start_time_, NULL, 0, literal_string,
+			literal_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogCaptureSubscriberPtr LogHandlerCapture::Subscribe(LogLevelFlag level_mask,
+	bool use_event_fd)
+{
+	return(std::make_shared<LogCaptureSubscriber>(ring_sptr_, level_mask,
+		use_event_fd));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogHandlerCapture::Visit(const LogCaptureFunc &record_func,
+	LogLevelFlag level_mask) const
+{
+	std::shared_lock<std::shared_mutex> my_lock(ring_sptr_->ring_lock_);
+
+	std::uint64_t next_sequence = ring_sptr_->GetOldestSequence();
+
+	return(ring_sptr_->Visit(record_func, level_mask, next_sequence,
+		std::numeric_limits<std::size_t>::max()));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogHandlerCapture::Count(const std::string &message_text,
+	LogLevelFlag level_mask) const
+{
+	std::size_t match_count = 0;
+
+	Visit([&message_text, &match_count](const LogCaptureRecord &this_record) {
+		if (this_record.message_.find(message_text) != std::string_view::npos)
+			++match_count;
+	}, level_mask);
+
+	return(match_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerCapture::Clear()
+{
+	std::unique_lock<std::shared_mutex> my_lock(ring_sptr_->ring_lock_);
+
+	ring_sptr_->clear_sequence_ = ring_sptr_->next_sequence_;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogHandlerCapture::GetRecordCapacity() const
+{
+	return(ring_sptr_->slot_list_.size());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerCapture::GetCaptureCount() const
+{
+	std::shared_lock<std::shared_mutex> my_lock(ring_sptr_->ring_lock_);
+
+	return(ring_sptr_->next_sequence_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Armed subscribers whose mask includes the level are signalled once and
+	then disarmed until they next poll every available record, so a burst of
+	records costs each subscriber a single eventfd write.
+*/
+void LogHandlerCapture::Capture(LogLevel log_level, ThreadId thread_id,
+	const TimeSpec &line_time, const char *leader_ptr,
+	std::size_t leader_length, const char *message_ptr,
+	std::size_t message_length)
+{
+	LogCaptureSubscriber::Ring          &ring_ref = *ring_sptr_;
+	std::unique_lock<std::shared_mutex>  my_lock(ring_ref.ring_lock_);
+
+	LogCaptureSubscriber::Ring::Slot &slot_ref = ring_ref.slot_list_[
+		static_cast<std::size_t>(ring_ref.next_sequence_ %
+		ring_ref.slot_list_.size())];
+
+	slot_ref.log_level_ = log_level;
+	slot_ref.thread_id_ = thread_id;
+	slot_ref.line_time_ = line_time;
+	slot_ref.leader_.assign(leader_ptr, leader_length);
+	slot_ref.message_.assign(message_ptr, message_length);
+
+	++ring_ref.next_sequence_;
+
+	for (LogCaptureSubscriber *subscriber_ptr : ring_ref.subscriber_list_) {
+		if (subscriber_ptr->armed_flag_ &&
+			(subscriber_ptr->level_mask_ & (1 << log_level))) {
+			subscriber_ptr->armed_flag_ = false;
+			if (subscriber_ptr->event_fd_ >= 0)
+				::eventfd_write(subscriber_ptr->event_fd_, 1);
+		}
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogHandlerCapture.hpp>
+#include <Logger/LogManager.hpp>
+#include <Logger/LogTestSupport.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+// ////////////////////////////////////////////////////////////////////////////
+LogManagerMacroDeclaration(MB_LIB_LOCAL)
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Expect(bool condition, const char *failure_text)
+{
+	if (!condition)
+		throw std::logic_error(failure_text);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_EmitLine(MLB::Utility::LogHandler &handler_ref,
+	MLB::Utility::LogLevel log_level, const std::string &line_buffer)
+{
+	using namespace MLB::Utility;
+
+	LogEmitControl emit_control(MLB::Utility::Default, LogFlag_Mask,
+		LogFlag_Mask, TimeSpec::Now(), log_level,
+		static_cast<LogLevelFlag>(1 << log_level), line_buffer);
+
+	handler_ref.EmitLine(emit_control);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_RecordViews()
+{
+	using namespace MLB::Utility;
+
+	LogHandlerCapture my_handler(16);
+
+	TEST_EmitLine(my_handler, LogLevel_Warning, "First line\nSecond line");
+	my_handler.EmitLiteral(7, "Literal");
+
+	std::vector<std::string> leader_list;
+	std::vector<std::string> message_list;
+	ThreadId                 thread_id = 0;
+
+	my_handler.Visit([&](const LogCaptureRecord &this_record) {
+		leader_list.emplace_back(this_record.leader_);
+		message_list.emplace_back(this_record.message_);
+		if (this_record.log_level_ == LogLevel_Warning)
+			thread_id = this_record.thread_id_;
+	});
+
+	TEST_Expect(message_list.size() == 2, "Expected two captured records.");
+	TEST_Expect(message_list[0] == "First line\nSecond line", "The message of "
+		"a multi-line record was not captured intact.");
+	TEST_Expect((leader_list[0].size() == LogLineLeaderLength) &&
+		(leader_list[0].find("WARNING") != std::string::npos),
+		"The leader of a line was not captured.");
+	TEST_Expect(thread_id == CurrentThreadId(), "The thread of a line was not "
+		"captured.");
+	TEST_Expect(leader_list[1].empty() && (message_list[1] == "Literal"),
+		"A literal was not captured without a leader.");
+	TEST_Expect(my_handler.Count("line", LogFlag_Warning) == 1,
+		"Count() did not honor the level mask.");
+
+	my_handler.Clear();
+
+	TEST_Expect(!my_handler.Count(""), "Clear() did not discard the records.");
+	TEST_Expect(my_handler.GetCaptureCount() == 2, "Clear() altered the "
+		"capture count.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	A subscriber woken by its eventfd must receive exactly the error lines,
+	in order, while the producer runs.
+*/
+void TEST_Subscriber()
+{
+	using namespace MLB::Utility;
+
+	const unsigned int      line_count = 20000;
+	LogHandlerCapture       my_handler(line_count);
+	LogCaptureSubscriberPtr sub_ptr(my_handler.Subscribe(
+		static_cast<LogLevelFlag>(LogFlag_Error | LogFlag_Fatal)));
+	std::atomic<bool>       done_flag(false);
+	unsigned int            received_count = 0;
+	unsigned int            wait_count     = 0;
+	bool                    order_flag     = true;
+
+	std::thread consumer_thread([&]() {
+		for ( ; ; ) {
+			bool last_pass = done_flag.load();
+			sub_ptr->Poll([&](const LogCaptureRecord &this_record) {
+				if ((this_record.log_level_ != LogLevel_Error) ||
+					(this_record.message_ != ("Capture line " +
+					std::to_string(received_count * 10))))
+					order_flag = false;
+				++received_count;
+			});
+			if (last_pass)
+				break;
+			if (sub_ptr->Wait(10))
+				++wait_count;
+		}
+	});
+
+	for (unsigned int count_1 = 0; count_1 < line_count; ++count_1)
+		TEST_EmitLine(my_handler, (count_1 % 10) ? LogLevel_Info :
+			LogLevel_Error, "Capture line " + std::to_string(count_1));
+
+	done_flag = true;
+	consumer_thread.join();
+
+	TEST_Expect(order_flag, "The subscriber received a record out of order "
+		"or outside of its mask.");
+	TEST_Expect(received_count == (line_count / 10), "The subscriber did not "
+		"receive every error line.");
+	TEST_Expect(!sub_ptr->GetDroppedCount(), "The subscriber dropped records "
+		"which were retained.");
+
+	std::cout << "LogHandlerCapture: subscriber received " << received_count <<
+		" of " << line_count << " lines after " << wait_count <<
+		" wake-ups." << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Overrun()
+{
+	using namespace MLB::Utility;
+
+	LogHandlerCapture       my_handler(16);
+	LogCaptureSubscriberPtr sub_ptr(my_handler.Subscribe(LogFlag_Mask, false));
+	std::uint64_t           first_sequence = 0;
+
+	for (unsigned int count_1 = 0; count_1 < 100; ++count_1)
+		TEST_EmitLine(my_handler, LogLevel_Info, std::to_string(count_1));
+
+	std::size_t record_count = sub_ptr->Poll(
+		[&first_sequence](const LogCaptureRecord &this_record) {
+			if (!first_sequence)
+				first_sequence = this_record.sequence_;
+		});
+
+	TEST_Expect((record_count == 16) && (first_sequence == 84) &&
+		(sub_ptr->GetDroppedCount() == 84), "The overwritten records were not "
+		"counted as dropped.");
+	TEST_Expect(sub_ptr->GetEventFd() < 0, "A subscriber created without an "
+		"eventfd has one.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	using namespace MLB::Utility;
+
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_RecordViews();
+		TEST_Subscriber();
+		TEST_Overrun();
+		LogHandlerPtr my_log_handler(new LogHandlerCapture);
+		TEST_TestControl(my_log_handler, 10000, 200, 1, 2000000);
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
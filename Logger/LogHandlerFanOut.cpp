@@ -0,0 +1,423 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerFanOut.cpp
+
+   File Description  :  Implementation of the fan-out log handler.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerFanOut.hpp>
+
+#include <stdexcept>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerFanOut::Sink::Sink(LogHandlerPtr handler_ptr,
+	LogHandlerPtr emit_handler_ptr, LogLevelFlag level_mask)
+	:handler_ptr_(handler_ptr)
+	,emit_handler_ptr_(emit_handler_ptr)
+	,level_mask_(level_mask)
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerFanOut::LogHandlerFanOut()
+	:LogHandler()
+	,sink_list_sptr_(std::make_shared<const SinkList>())
+	,installed_flag_(false)
+	,control_lock_()
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerFanOut::~LogHandlerFanOut()
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFanOut::InstallHandler()
+{
+	LogLockScoped my_lock(control_lock_);
+
+	if (!installed_flag_) {
+		SinkListSPtr sink_list_sptr(GetSinkList());
+		for (const auto &this_sink : *sink_list_sptr)
+			this_sink.emit_handler_ptr_->InstallHandler();
+		installed_flag_ = true;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFanOut::RemoveHandler()
+{
+	LogLockScoped my_lock(control_lock_);
+
+	if (installed_flag_) {
+		SinkListSPtr sink_list_sptr(GetSinkList());
+		for (const auto &this_sink : *sink_list_sptr)
+			this_sink.emit_handler_ptr_->RemoveHandler();
+		installed_flag_ = false;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFanOut::EmitLine(const LogEmitControl &emit_control)
+{
+	SinkListSPtr sink_list_sptr(GetSinkList());
+
+	for (const auto &this_sink : *sink_list_sptr) {
+		if (emit_control.log_level_flag_ & this_sink.level_mask_)
+			this_sink.emit_handler_ptr_->EmitLine(emit_control);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFanOut::EmitLiteral(unsigned int literal_length,
+	const char *literal_string)
+{
+	SinkListSPtr sink_list_sptr(GetSinkList());
+
+	for (const auto &this_sink : *sink_list_sptr)
+		this_sink.emit_handler_ptr_->EmitLiteral(literal_length,
+			literal_string);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFanOut::EmitLiteral(const LogEmitControl &emit_control,
+	unsigned int literal_length, const char *literal_string)
+{
+	SinkListSPtr sink_list_sptr(GetSinkList());
+
+	for (const auto &this_sink : *sink_list_sptr) {
+		if (emit_control.log_level_flag_ & this_sink.level_mask_)
+			this_sink.emit_handler_ptr_->EmitLiteral(emit_control,
+				literal_length, literal_string);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFanOut::EmitBinary(const LogEmitControl &emit_control,
+	LogBinaryFormatId format_id, const char *arg_ptr, std::size_t arg_length)
+{
+	SinkListSPtr sink_list_sptr(GetSinkList());
+
+	for (const auto &this_sink : *sink_list_sptr) {
+		if (emit_control.log_level_flag_ & this_sink.level_mask_)
+			this_sink.emit_handler_ptr_->EmitBinary(emit_control, format_id,
+				arg_ptr, arg_length);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFanOut::EmitEvent(const LogEmitControl &emit_control)
+{
+	SinkListSPtr sink_list_sptr(GetSinkList());
+
+	for (const auto &this_sink : *sink_list_sptr) {
+		if (emit_control.log_level_flag_ & this_sink.level_mask_)
+			this_sink.emit_handler_ptr_->EmitEvent(emit_control);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFanOut::Flush()
+{
+	SinkListSPtr sink_list_sptr(GetSinkList());
+
+	for (const auto &this_sink : *sink_list_sptr)
+		this_sink.emit_handler_ptr_->Flush();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFanOut::AddSink(LogHandlerPtr handler_ptr,
+	LogLevelFlag level_mask, bool own_thread, std::size_t queue_size,
+	LogHandlerAsync::QueueFullPolicy full_policy)
+{
+	if (!handler_ptr)
+		throw std::invalid_argument("The log handler to be added as a sink to "
+			"the fan-out log handler is NULL.");
+
+	LogHandlerPtr emit_handler_ptr((own_thread) ?
+		LogHandlerPtr(new LogHandlerAsync(handler_ptr, queue_size,
+		full_policy)) : handler_ptr);
+	LogLockScoped my_lock(control_lock_);
+	SinkListSPtr  old_list_sptr(GetSinkList());
+
+	for (const auto &this_sink : *old_list_sptr) {
+		if (this_sink.handler_ptr_ == handler_ptr)
+			throw std::invalid_argument("The log handler is already a sink of "
+				"the fan-out log handler.");
+	}
+
+	auto new_list_sptr(std::make_shared<SinkList>(*old_list_sptr));
+
+	new_list_sptr->emplace_back(handler_ptr, emit_handler_ptr, level_mask);
+
+	if (installed_flag_)
+		emit_handler_ptr->InstallHandler();
+
+	sink_list_sptr_.store(new_list_sptr, std::memory_order_release);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Threads which obtained the sink list before the sink was removed may
+	still emit to it. If the sink has its own thread, such lines are passed
+	directly to the sink handler once its thread has been stopped.
+*/
+bool LogHandlerFanOut::RemoveSink(LogHandlerPtr handler_ptr)
+{
+	LogLockScoped my_lock(control_lock_);
+	SinkListSPtr  old_list_sptr(GetSinkList());
+	auto          new_list_sptr(std::make_shared<SinkList>());
+	LogHandlerPtr emit_handler_ptr;
+
+	for (const auto &this_sink : *old_list_sptr) {
+		if (this_sink.handler_ptr_ == handler_ptr)
+			emit_handler_ptr = this_sink.emit_handler_ptr_;
+		else
+			new_list_sptr->push_back(this_sink);
+	}
+
+	if (!emit_handler_ptr)
+		return(false);
+
+	sink_list_sptr_.store(new_list_sptr, std::memory_order_release);
+
+	if (installed_flag_)
+		emit_handler_ptr->RemoveHandler();
+	else
+		emit_handler_ptr->Flush();
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogHandlerFanOut::SetSinkLevelMask(LogHandlerPtr handler_ptr,
+	LogLevelFlag level_mask)
+{
+	LogLockScoped my_lock(control_lock_);
+	auto          new_list_sptr(std::make_shared<SinkList>(*GetSinkList()));
+
+	for (auto &this_sink : *new_list_sptr) {
+		if (this_sink.handler_ptr_ == handler_ptr) {
+			this_sink.level_mask_ = level_mask;
+			sink_list_sptr_.store(new_list_sptr, std::memory_order_release);
+			return(true);
+		}
+	}
+
+	return(false);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogLevelFlag LogHandlerFanOut::GetSinkLevelMask(LogHandlerPtr handler_ptr) const
+{
+	SinkListSPtr sink_list_sptr(GetSinkList());
+
+	for (const auto &this_sink : *sink_list_sptr) {
+		if (this_sink.handler_ptr_ == handler_ptr)
+			return(this_sink.level_mask_);
+	}
+
+	throw std::invalid_argument("The log handler is not a sink of the fan-out "
+		"log handler.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogHandlerFanOut::GetSinkCount() const
+{
+	return(GetSinkList()->size());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerFanOut::SinkListSPtr LogHandlerFanOut::GetSinkList() const
+{
+	return(sink_list_sptr_.load(std::memory_order_acquire));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogHandlerCapture.hpp>
+#include <Logger/LogHandlerConsole.hpp>
+#include <Logger/LogHandlerFile.hpp>
+#include <Logger/LogManager.hpp>
+#include <Logger/LogTestSupport.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Stands in for a slow sink such as a network connection or the console on
+	a congested terminal session.
+*/
+class TEST_SlowHandler : public MLB::Utility::LogHandler {
+public:
+	TEST_SlowHandler()
+		:line_count_(0)
+	{
+	}
+
+	virtual void EmitLine(const MLB::Utility::LogEmitControl &) override
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		++line_count_;
+	}
+
+	virtual void EmitLiteral(unsigned int, const char *) override
+	{
+	}
+
+	virtual void EmitLiteral(const MLB::Utility::LogEmitControl &,
+		unsigned int, const char *) override
+	{
+	}
+
+	std::atomic<unsigned int> line_count_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_SlowSink()
+{
+	using namespace MLB::Utility;
+
+	const unsigned int line_count = 2000;
+	auto               all_sptr(std::make_shared<LogHandlerCapture>(line_count));
+	auto               err_sptr(std::make_shared<LogHandlerCapture>(line_count));
+	auto               slow_sptr(std::make_shared<TEST_SlowHandler>());
+	LogHandlerFanOut   fan_out;
+	double             elapsed_secs;
+
+	fan_out.AddSink(all_sptr);
+	fan_out.AddSink(err_sptr,
+		static_cast<LogLevelFlag>(LogFlag_Error | LogFlag_Fatal), false);
+	fan_out.AddSink(slow_sptr, LogFlag_Mask, true, 64,
+		LogHandlerAsync::DropNewest);
+	fan_out.InstallHandler();
+
+	{
+		auto start_time = std::chrono::steady_clock::now();
+		for (unsigned int count_1 = 0; count_1 < line_count; ++count_1) {
+			std::string    line_buffer("Fan-out test line " +
+				std::to_string(count_1));
+			LogLevel       log_level = (count_1 % 10) ? LogLevel_Info :
+				LogLevel_Error;
+			LogEmitControl emit_control(MLB::Utility::Default, LogFlag_Mask,
+				LogFlag_Mask, TimeSpec(), log_level,
+				static_cast<LogLevelFlag>(1 << log_level), line_buffer);
+			fan_out.EmitLine(emit_control);
+		}
+		elapsed_secs = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start_time).count();
+	}
+
+	fan_out.Flush();
+	fan_out.RemoveHandler();
+
+	if (elapsed_secs >= ((line_count * 0.002) / 2.0))
+		throw std::logic_error("The slow sink held up the producer for " +
+			std::to_string(elapsed_secs) + " seconds.");
+
+	if (all_sptr->Count("Fan-out test line ") != line_count)
+		throw std::logic_error("The unfiltered sink did not receive every "
+			"line.");
+
+	if (err_sptr->Count("Fan-out test line ") != (line_count / 10))
+		throw std::logic_error("The error sink did not receive exactly the "
+			"error lines.");
+
+	if (!fan_out.RemoveSink(slow_sptr))
+		throw std::logic_error("Unable to remove the slow sink.");
+
+	std::cout << "LogHandlerFanOut: " << line_count << " lines in " <<
+		elapsed_secs << " seconds; the slow sink handled " <<
+		slow_sptr->line_count_ << " of them." << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	using namespace MLB::Utility;
+
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_SlowSink();
+		//	The file and the console each with their own thread...
+		LogHandlerFanOut *fan_out_ptr = new LogHandlerFanOut;
+		LogHandlerPtr     my_log_handler(fan_out_ptr);
+		fan_out_ptr->AddSink(LogHandlerPtr(new LogHandlerFile(
+			TEST_GetLogFileName("LogHandlerFanOut"),
+			LogHandlerFile::NoConsoleOutput)));
+		fan_out_ptr->AddSink(LogHandlerPtr(new LogHandlerConsole));
+		TEST_TestControl(my_log_handler, 10000, 200, 1, 2000000);
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
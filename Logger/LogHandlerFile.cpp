@@ -31,10 +31,19 @@
 
 #include <Utility/AnyToString.hpp>
 #include <Utility/ExceptionRethrow.hpp>
+#include <Utility/PageSize.hpp>
+#include <Utility/ThrowErrno.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
 // ////////////////////////////////////////////////////////////////////////////
 
 namespace MLB {
@@ -48,6 +57,8 @@ LogHandlerFile::LogHandlerFile()
 	,out_file_ptr_()
 	,my_flags_(Default)
 	,the_lock_()
+	,rotator_()
+	,reopen_failure_count_(0)
 {
 }
 // ////////////////////////////////////////////////////////////////////////////
@@ -59,6 +70,8 @@ LogHandlerFile::LogHandlerFile(const char *file_name, LogHandlerFileFlag flags)
 	,out_file_ptr_()
 	,my_flags_(flags)
 	,the_lock_()
+	,rotator_()
+	,reopen_failure_count_(0)
 {
 	OpenFile(file_name);
 }
@@ -72,6 +85,8 @@ LogHandlerFile::LogHandlerFile(const std::string &file_name,
 	,out_file_ptr_()
 	,my_flags_(flags)
 	,the_lock_()
+	,rotator_()
+	,reopen_failure_count_(0)
 {
 	OpenFile(file_name);
 }
@@ -168,6 +183,8 @@ void LogHandlerFile::EmitLine(const LogEmitControl &emit_control)
 		LogLockScoped my_lock(the_lock_);
 		emit_control.UpdateTime();
 		if (emit_control.ShouldLogPersistent() && (out_file_ptr_ != NULL)) {
+			RotateIfNeeded(emit_control.GetLeaderLength() +
+				emit_control.line_buffer_.size() + 1);
 			out_file_ptr_->write(emit_control.GetLeaderPtr(),
 				static_cast<std::streamsize>(emit_control.GetLeaderLength()));
 			out_file_ptr_->write(emit_control.line_buffer_.c_str(),
@@ -192,6 +209,7 @@ void LogHandlerFile::EmitLiteral(unsigned int literal_length,
 	LogLockScoped my_lock(the_lock_);
 
 	if (out_file_ptr_ != NULL) {
+		RotateIfNeeded(literal_length + 1);
 		out_file_ptr_->write(literal_string,
 			static_cast<std::streamsize>(literal_length));
 		*out_file_ptr_ << std::endl;
@@ -212,6 +230,7 @@ void LogHandlerFile::EmitLiteral(const LogEmitControl &emit_control,
 	if (emit_control.ShouldLogPersistent() || emit_control.ShouldLogScreen()) {
 		LogLockScoped my_lock(the_lock_);
 		if (emit_control.ShouldLogPersistent() && (out_file_ptr_ != NULL)) {
+			RotateIfNeeded(literal_length + 1);
 			out_file_ptr_->write(literal_string,
 				static_cast<std::streamsize>(literal_length));
 			*out_file_ptr_ << std::endl;
@@ -236,7 +255,7 @@ void LogHandlerFile::OpenFile(const char *file_name)
 			new std::ofstream(file_name,
 				(!(my_flags_ & DoNotAppend)) ?
 				(std::ios_base::app | std::ios_base::ate) :
-				(std::ios_base::app | std::ios_base::trunc)));
+				(std::ios_base::out | std::ios_base::trunc)));
 		if (tmp_file_ptr->fail())
 			throw std::runtime_error("Open attempt failed.");
 		{
@@ -248,6 +267,8 @@ void LogHandlerFile::OpenFile(const char *file_name)
 			}
 			out_file_ptr_  = tmp_file_ptr;
 			out_file_name_ = file_name;
+			rotator_.FileOpened(static_cast<std::uint64_t>(
+				std::max<std::streamoff>(out_file_ptr_->tellp(), 0)));
 		}
 	}
 	catch (const std::exception &except) {
@@ -363,6 +384,109 @@ std::string LogHandlerFile::GetFileName() const
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+LogFileRotationSpec LogHandlerFile::GetRotationSpec() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(rotator_.GetRotationSpec());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Rotation is disabled by default. Lines are written to the active file
+	name; rotated segments are renamed (see LogFileRotator) and compressed
+	in the background as specified.
+*/
+void LogHandlerFile::SetRotationSpec(const LogFileRotationSpec &rotation_spec)
+{
+	LogLockScoped my_lock(the_lock_);
+
+	rotator_.SetRotationSpec(rotation_spec);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerFile::GetRotationCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(rotator_.GetRotationCount());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerFile::GetReopenFailureCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(reopen_failure_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFile::WaitForCompression()
+{
+	rotator_.WaitForCompression();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Must be called with the lock held. An empty file isn't rotated, so that
+	an idle interval doesn't produce an empty segment.
+*/
+void LogHandlerFile::RotateIfNeeded(std::size_t pending_length)
+{
+	if (rotator_.CheckRotate(pending_length)) {
+		if (rotator_.GetFileSize())
+			RotateFile();
+		else
+			rotator_.DeferRotation();
+	}
+
+	rotator_.AddBytes(pending_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Must be called with the lock held. Because the cut-over is performed
+	between lines under the lock, no line is split across files or lost.
+
+	If the active file can't be renamed, writing continues to it, its size
+	is retained and rotation will be attempted again after the maximum size
+	has again been written or the next interval boundary has been reached.
+
+	If the new file can't be opened the failure is counted (see
+	GetReopenFailureCount()) and lines are discarded until a later rotation
+	opens it.
+*/
+void LogHandlerFile::RotateFile()
+{
+	out_file_ptr_->flush();
+	out_file_ptr_->close();
+
+	std::string segment_name(rotator_.RenameToSegment(out_file_name_));
+
+	out_file_ptr_.reset(new std::ofstream(out_file_name_.c_str(),
+		std::ios_base::app | std::ios_base::ate));
+
+	if (!out_file_ptr_->is_open())
+		++reopen_failure_count_;
+
+	if (segment_name.empty())
+		rotator_.DeferRotation();
+	else
+		rotator_.FileOpened((!out_file_ptr_->is_open()) ? 0 :
+			static_cast<std::uint64_t>(
+			std::max<std::streamoff>(out_file_ptr_->tellp(), 0)));
+
+	rotator_.SegmentCompleted(segment_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 } // namespace Utility
 
 } // namespace MLB
@@ -377,30 +501,85 @@ namespace MLB {
 
 namespace Utility {
 
+// ////////////////////////////////////////////////////////////////////////////
+LogFlushPolicy::LogFlushPolicy(std::size_t flush_bytes,
+	unsigned int flush_micros, LogLevel flush_level)
+	:flush_bytes_(flush_bytes)
+	,flush_micros_(flush_micros)
+	,flush_level_(flush_level)
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerXFile::BatchFree::operator () (char *batch_ptr) const
+{
+	::free(batch_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 // ////////////////////////////////////////////////////////////////////////////
 LogHandlerXFile::LogHandlerXFile()
 	:LogHandlerFileBase()
-	,out_file_ptr_()
+	,file_fd_(-1)
+	,rotator_()
+	,reopen_failure_count_(0)
+	,flush_policy_()
+	,batch_ptr_()
+	,batch_used_(0)
+	,batch_time_()
+	,write_call_count_(0)
+	,write_failure_count_(0)
+	,flush_stop_(false)
+	,flush_cond_()
+	,flush_thread_()
 {
+	AllocateBatch();
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 LogHandlerXFile::LogHandlerXFile(const char *file_name,
-	LogHandlerFileBaseFlag flags)
+	LogHandlerFileBaseFlag flags, const LogFlushPolicy &flush_policy)
 	:LogHandlerFileBase(flags)
-	,out_file_ptr_()
+	,file_fd_(-1)
+	,rotator_()
+	,reopen_failure_count_(0)
+	,flush_policy_(flush_policy)
+	,batch_ptr_()
+	,batch_used_(0)
+	,batch_time_()
+	,write_call_count_(0)
+	,write_failure_count_(0)
+	,flush_stop_(false)
+	,flush_cond_()
+	,flush_thread_()
 {
+	AllocateBatch();
+
 	OpenFile(file_name);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 LogHandlerXFile::LogHandlerXFile(const std::string &file_name,
-	LogHandlerFileBaseFlag flags)
+	LogHandlerFileBaseFlag flags, const LogFlushPolicy &flush_policy)
 	:LogHandlerFileBase(flags)
-	,out_file_ptr_()
+	,file_fd_(-1)
+	,rotator_()
+	,reopen_failure_count_(0)
+	,flush_policy_(flush_policy)
+	,batch_ptr_()
+	,batch_used_(0)
+	,batch_time_()
+	,write_call_count_(0)
+	,write_failure_count_(0)
+	,flush_stop_(false)
+	,flush_cond_()
+	,flush_thread_()
 {
+	AllocateBatch();
+
 	OpenFile(file_name);
 }
 // ////////////////////////////////////////////////////////////////////////////
@@ -452,12 +631,30 @@ LogHandlerXFile::LogHandlerXFile(const std::string &base_name,
 // ////////////////////////////////////////////////////////////////////////////
 LogHandlerXFile::~LogHandlerXFile()
 {
+	StopFlushThread();
+
 	LogLockScoped my_lock(the_lock_);
 
-	if ((out_file_ptr_ != NULL) && out_file_ptr_->is_open()) {
-		out_file_ptr_->flush();
-		out_file_ptr_->close();
+	CloseFile();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Once stopped, the flush thread isn't restarted. Batches are then written
+	only when full, flushed or at a level at or above the flush level.
+*/
+void LogHandlerXFile::StopFlushThread()
+{
+	{
+		LogLockScoped my_lock(the_lock_);
+		flush_stop_ = true;
 	}
+
+	flush_cond_.notify_all();
+
+	if (flush_thread_.joinable())
+		flush_thread_.join();
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -470,93 +667,353 @@ void LogHandlerXFile::InstallHandlerImpl()
 // ////////////////////////////////////////////////////////////////////////////
 void LogHandlerXFile::RemoveHandlerImpl()
 {
-	if (out_file_ptr_->is_open())
-		out_file_ptr_->flush();
+	FlushBatch();
 }
 // ////////////////////////////////////////////////////////////////////////////
 
-namespace {
-
 // ////////////////////////////////////////////////////////////////////////////
-/*
-	CODE NOTE: LogFileHandler buffering test code. Restricts LogHandlerXFile
-	to single instance use. To be replaced.
-*/
-static char TestFileBuffer[2000000];
+void LogHandlerXFile::OpenFileImpl(const char *file_name)
+{
+	int tmp_fd = OpenXFile(file_name, (my_flags_ & DoNotAppend) != 0);
+
+	{
+		std::string   tmp_file_name(file_name);
+		LogLockScoped my_lock(the_lock_);
+		CloseFile();
+		file_fd_ = tmp_fd;
+		out_file_name_.swap(tmp_file_name);
+		rotator_.FileOpened(static_cast<std::uint64_t>(
+			std::max<off_t>(::lseek(file_fd_, 0, SEEK_END), 0)));
+	}
+}
 // ////////////////////////////////////////////////////////////////////////////
 
-} // Anonymous namespace
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerXFile::FlushImpl()
+{
+	FlushBatch();
+}
+// ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-void LogHandlerXFile::OpenFileImpl(const char *file_name)
+void LogHandlerXFile::EmitLineImpl(const LogEmitControl &emit_control)
 {
-	LogSPtr<std::ofstream> tmp_file_ptr(
-		new std::ofstream(file_name,
-			(!(my_flags_ & DoNotAppend)) ?
-			(std::ios_base::app | std::ios_base::ate) :
-			(std::ios_base::app | std::ios_base::trunc)));
+	EmitRecord(emit_control.log_level_, emit_control.GetLeaderPtr(),
+		emit_control.GetLeaderLength(), emit_control.line_buffer_.data(),
+		emit_control.line_buffer_.size());
+}
+// ////////////////////////////////////////////////////////////////////////////
 
-	if (tmp_file_ptr->fail())
-		throw std::runtime_error("Open attempt failed.");
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerXFile::EmitLiteralImpl(unsigned int literal_length,
+	const char *literal_string)
+{
+	EmitRecord(LogLevel_Literal, literal_string, literal_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
 
-	/*
-		CODE NOTE: LogFileHandler buffering test code. Restricts LogHandlerXFile
-		to single instance use. To be replaced.
-	*/
-	std::streambuf *new_buffer_ptr =
-		tmp_file_ptr->rdbuf()->pubsetbuf(TestFileBuffer, sizeof(TestFileBuffer));
-	if (new_buffer_ptr == NULL) {
-		throw std::runtime_error("Attempt to set the log file buffer size to " +
-			AnyToString(sizeof(TestFileBuffer)) + " bytes failed.");
+// ////////////////////////////////////////////////////////////////////////////
+bool LogHandlerXFile::WriteOut(struct iovec *iov_list, int iov_count)
+{
+	while (iov_count) {
+		++write_call_count_;
+		ssize_t write_count = ::writev(file_fd_, iov_list, iov_count);
+		if (write_count < 0) {
+			if (errno == EINTR)
+				continue;
+			return(false);
+		}
+		//	Skip past whatever was written by a partial write...
+		std::size_t written = static_cast<std::size_t>(write_count);
+		while (iov_count && (written >= iov_list->iov_len)) {
+			written -= iov_list->iov_len;
+			++iov_list;
+			--iov_count;
+		}
+		if (iov_count) {
+			iov_list->iov_base = static_cast<char *>(iov_list->iov_base) + written;
+			iov_list->iov_len -= written;
+		}
 	}
 
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerXFile::WaitForWrites()
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogFileRotationSpec LogHandlerXFile::GetRotationSpec() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(rotator_.GetRotationSpec());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerXFile::SetRotationSpec(const LogFileRotationSpec &rotation_spec)
+{
+	LogLockScoped my_lock(the_lock_);
+
+	rotator_.SetRotationSpec(rotation_spec);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerXFile::GetRotationCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(rotator_.GetRotationCount());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerXFile::GetReopenFailureCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(reopen_failure_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerXFile::WaitForCompression()
+{
+	rotator_.WaitForCompression();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogFlushPolicy LogHandlerXFile::GetFlushPolicy() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(flush_policy_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerXFile::SetFlushPolicy(const LogFlushPolicy &flush_policy)
+{
 	{
-		std::string   tmp_file_name(file_name);
 		LogLockScoped my_lock(the_lock_);
-		if ((out_file_ptr_ != NULL) && out_file_ptr_->is_open()) {
-			out_file_ptr_->flush();
-			out_file_ptr_->close();
-			out_file_ptr_.reset();
+		FlushBatch();
+		flush_policy_ = flush_policy;
+		AllocateBatch();
+	}
+
+	flush_cond_.notify_all();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerXFile::GetWriteCallCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(write_call_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerXFile::GetWriteFailureCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(write_failure_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Called from the Impl functions, so the lock is held.
+void LogHandlerXFile::RotateIfNeeded(std::size_t pending_length)
+{
+	if (rotator_.CheckRotate(pending_length)) {
+		if (rotator_.GetFileSize())
+			RotateFile();
+		else
+			rotator_.DeferRotation();
+	}
+
+	rotator_.AddBytes(pending_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The batch is written to the current file before it is closed. See
+	LogHandlerFile::RotateFile(), including for the counting of failures to
+	re-open the file.
+*/
+void LogHandlerXFile::RotateFile()
+{
+	CloseFile();
+
+	std::string segment_name(rotator_.RenameToSegment(out_file_name_));
+
+	try {
+		file_fd_ = OpenXFile(out_file_name_.c_str(), false);
+	}
+	catch (const std::exception &) {
+		++reopen_failure_count_;
+	}
+
+	if (segment_name.empty())
+		rotator_.DeferRotation();
+	else
+		rotator_.FileOpened((file_fd_ < 0) ? 0 :
+			static_cast<std::uint64_t>(
+			std::max<off_t>(::lseek(file_fd_, 0, SEEK_END), 0)));
+
+	rotator_.SegmentCompleted(segment_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Called with the lock held. The record is terminated by a new-line.
+*/
+void LogHandlerXFile::EmitRecord(LogLevel log_level, const char *data_ptr_1,
+	std::size_t data_length_1, const char *data_ptr_2,
+	std::size_t data_length_2)
+{
+	std::size_t record_length = data_length_1 + data_length_2 + 1;
+
+	RotateIfNeeded(record_length);
+
+	if (file_fd_ < 0)
+		return;
+
+	if ((batch_used_ + record_length) <= flush_policy_.flush_bytes_) {
+		char *batch_ptr = batch_ptr_.get() + batch_used_;
+		::memcpy(batch_ptr, data_ptr_1, data_length_1);
+		if (data_length_2)
+			::memcpy(batch_ptr + data_length_1, data_ptr_2, data_length_2);
+		batch_ptr[data_length_1 + data_length_2] = '\n';
+		if (!batch_used_) {
+			batch_time_ = MyClock::now();
+			if (flush_policy_.flush_micros_) {
+				if ((!flush_thread_.joinable()) && (!flush_stop_))
+					flush_thread_ =
+						std::thread(&LogHandlerXFile::FlushThreadProc, this);
+				flush_cond_.notify_all();
+			}
 		}
-		out_file_ptr_.swap(tmp_file_ptr);
-		out_file_name_.swap(tmp_file_name);
+		batch_used_ += record_length;
+		if ((log_level >= flush_policy_.flush_level_) ||
+			(log_level >= LogLevel_Fatal))
+			FlushBatch();
+	}
+	else {
+		//	Write the batch and the record in one call without copying it...
+		struct iovec iov_list[4];
+		int          iov_count = 0;
+		if (batch_used_) {
+			iov_list[iov_count].iov_base = batch_ptr_.get();
+			iov_list[iov_count++].iov_len = batch_used_;
+		}
+		iov_list[iov_count].iov_base = const_cast<char *>(data_ptr_1);
+		iov_list[iov_count++].iov_len = data_length_1;
+		if (data_length_2) {
+			iov_list[iov_count].iov_base = const_cast<char *>(data_ptr_2);
+			iov_list[iov_count++].iov_len = data_length_2;
+		}
+		iov_list[iov_count].iov_base = const_cast<char *>("\n");
+		iov_list[iov_count++].iov_len = 1;
+		if (!WriteOut(iov_list, iov_count))
+			++write_failure_count_;
+		batch_used_ = 0;
 	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-void LogHandlerXFile::FlushImpl()
+//	Called with the lock held.
+void LogHandlerXFile::FlushBatch()
 {
-	if ((out_file_ptr_ != NULL) && out_file_ptr_->is_open())
-		out_file_ptr_->flush();
+	if (batch_used_ && (file_fd_ >= 0)) {
+		struct iovec iov_list[1];
+		iov_list[0].iov_base = batch_ptr_.get();
+		iov_list[0].iov_len  = batch_used_;
+		if (!WriteOut(iov_list, 1))
+			++write_failure_count_;
+	}
+
+	batch_used_ = 0;
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-void LogHandlerXFile::EmitLineImpl(const LogEmitControl &emit_control)
+//	Called with the lock held and the batch empty.
+void LogHandlerXFile::AllocateBatch()
 {
-	if (out_file_ptr_ != NULL) {
-		out_file_ptr_->write(emit_control.GetLeaderPtr(),
-			static_cast<std::streamsize>(emit_control.GetLeaderLength()));
-		out_file_ptr_->write(emit_control.line_buffer_.c_str(),
-			static_cast<std::streamsize>(emit_control.line_buffer_.size()));
-		*out_file_ptr_ << std::endl;
+	void *batch_ptr = NULL;
+
+	if (flush_policy_.flush_bytes_ &&
+		::posix_memalign(&batch_ptr, GetPageSize(), flush_policy_.flush_bytes_))
+		throw std::bad_alloc();
+
+	batch_ptr_.reset(static_cast<char *>(batch_ptr));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Called with the lock held.
+void LogHandlerXFile::CloseFile()
+{
+	FlushBatch();
+
+	WaitForWrites();
+
+	if (file_fd_ >= 0) {
+		::close(file_fd_);
+		file_fd_ = -1;
 	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-void LogHandlerXFile::EmitLiteralImpl(unsigned int literal_length,
-	const char *literal_string)
+/*
+	Writes the batch once it has been held for the flush interval.
+*/
+void LogHandlerXFile::FlushThreadProc()
 {
-	if (out_file_ptr_ != NULL) {
-		out_file_ptr_->write(literal_string,
-			static_cast<std::streamsize>(literal_length));
-		*out_file_ptr_ << std::endl;
+	std::unique_lock<LogLock> my_lock(the_lock_);
+
+	while (!flush_stop_) {
+		if ((!batch_used_) || (!flush_policy_.flush_micros_))
+			flush_cond_.wait(my_lock);
+		else {
+			MyClock::time_point flush_time = batch_time_ +
+				std::chrono::microseconds(flush_policy_.flush_micros_);
+			if (MyClock::now() >= flush_time)
+				FlushBatch();
+			else
+				flush_cond_.wait_until(my_lock, flush_time);
+		}
 	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+int LogHandlerXFile::OpenXFile(const char *file_name, bool do_not_append)
+{
+	int file_fd = ::open(file_name, O_WRONLY | O_CREAT | O_APPEND |
+		((do_not_append) ? O_TRUNC : 0), 0644);
+
+	if (file_fd < 0)
+		ThrowErrno("Open attempt failed");
+
+	return(file_fd);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 } // namespace Utility
 
 } // namespace MLB
@@ -573,6 +1030,346 @@ void LogHandlerXFile::EmitLiteralImpl(unsigned int literal_length,
 #include <Logger/LogManager.hpp>
 #include <Logger/LogTestSupport.hpp>
 
+#include <filesystem>
+#include <iomanip>
+#include <set>
+
+#include <zlib.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+LogManagerMacroDeclaration(MB_LIB_LOCAL)
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string TEST_ReadFile(const std::string &file_name)
+{
+	std::string file_data;
+	gzFile      in_file = ::gzopen(file_name.c_str(), "rb");
+
+	if (in_file == NULL)
+		throw std::runtime_error("Unable to open file '" + file_name + "'.");
+
+	char buffer[65536];
+	int  read_count;
+
+	while ((read_count = ::gzread(in_file, buffer, sizeof(buffer))) > 0)
+		file_data.append(buffer, static_cast<std::size_t>(read_count));
+
+	::gzclose(in_file);
+
+	return(file_data);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Every line must appear exactly once and in order across the compressed
+	segments (in name order) followed by the active file.
+*/
+template <typename HandlerType, typename FlagType>
+	void TEST_Rotation(const char *base_name, FlagType flags)
+{
+	using namespace MLB::Utility;
+
+	const unsigned int line_count = 20000;
+	std::string        file_name(TEST_GetLogFileName(base_name));
+	std::uint64_t      rotation_count;
+
+	{
+		HandlerType my_handler(file_name, flags);
+		my_handler.SetRotationSpec(LogFileRotationSpec(64 * 1024));
+		for (unsigned int count_1 = 0; count_1 < line_count; ++count_1)
+			my_handler.EmitLineSpecific("Rotation test line " +
+				std::to_string(count_1) + " " + std::string(count_1 % 97, '*'));
+		my_handler.Flush();
+		rotation_count = my_handler.GetRotationCount();
+		my_handler.WaitForCompression();
+	}
+
+	std::string           stem_name(file_name.substr(0, file_name.size() - 4));
+	std::set<std::string> segment_set;
+
+	for (const auto &this_entry : std::filesystem::directory_iterator(".")) {
+		std::string this_name(this_entry.path().filename().string());
+		if ((this_name != file_name) && (!this_name.find(stem_name + "."))) {
+			if ((this_name.size() < 7) ||
+				this_name.compare(this_name.size() - 7, 7, ".log.gz"))
+				throw std::logic_error("Log file segment '" + this_name +
+					"' was not compressed.");
+			segment_set.insert(this_name);
+		}
+	}
+
+	if ((!rotation_count) || (segment_set.size() != rotation_count))
+		throw std::logic_error("Expected " + std::to_string(rotation_count) +
+			" compressed log file segments, but found " +
+			std::to_string(segment_set.size()) + ".");
+
+	std::vector<std::string> file_list(segment_set.begin(), segment_set.end());
+	unsigned int             next_line = 0;
+
+	file_list.push_back(file_name);
+
+	for (const auto &this_file : file_list) {
+		std::string            file_data(TEST_ReadFile(this_file));
+		std::string::size_type line_start = 0;
+		std::string::size_type line_end;
+		while ((line_end = file_data.find('\n', line_start)) !=
+			std::string::npos) {
+			std::string            this_line(file_data.substr(line_start,
+				line_end - line_start));
+			std::string            expected("Rotation test line " +
+				std::to_string(next_line) + " ");
+			std::string::size_type found_pos = this_line.find(expected);
+			if ((found_pos != LogLineLeaderLength) ||
+				((this_line.size() - found_pos - expected.size()) !=
+				(next_line % 97)))
+				throw std::logic_error("Line " + std::to_string(next_line) +
+					" is missing, split or out of order in file '" + this_file +
+					"'.");
+			++next_line;
+			line_start = line_end + 1;
+		}
+		if (line_start != file_data.size())
+			throw std::logic_error("File '" + this_file + "' ends with a "
+				"partial line.");
+	}
+
+	if (next_line != line_count)
+		throw std::logic_error("Expected " + std::to_string(line_count) +
+			" lines across the rotated files, but found " +
+			std::to_string(next_line) + ".");
+
+	std::cout << base_name << ": " << line_count << " lines in " <<
+		rotation_count << " compressed segments and the active file." <<
+		std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	A file which is still empty when an interval boundary is crossed must not
+	be rotated, as that would leave an empty segment.
+*/
+template <typename HandlerType, typename FlagType>
+	void TEST_RotationEmpty(const char *base_name, FlagType flags)
+{
+	using namespace MLB::Utility;
+
+	HandlerType my_handler(TEST_GetLogFileName(base_name), flags);
+
+	my_handler.SetRotationSpec(LogFileRotationSpec(0, 1,
+		LogFileRotationSpec::Compression_None));
+	std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+	my_handler.EmitLineSpecific("Line written after an idle interval");
+	my_handler.Flush();
+
+	if (my_handler.GetRotationCount())
+		throw std::logic_error(std::string(base_name) + ": an empty log file "
+			"was rotated at an interval boundary.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Removing the directory of the log file makes both the rename and the
+	re-opening of the file fail at the next rotation.
+*/
+template <typename HandlerType, typename FlagType>
+	void TEST_RotationReopenFailure(const char *base_name, FlagType flags)
+{
+	using namespace MLB::Utility;
+
+	std::filesystem::path dir_name(TEST_GetLogFileName(base_name) + ".dir");
+
+	std::filesystem::create_directory(dir_name);
+
+	HandlerType my_handler((dir_name / "Active.log").string(), flags);
+
+	my_handler.SetRotationSpec(LogFileRotationSpec(1024, 0,
+		LogFileRotationSpec::Compression_None));
+	my_handler.EmitLineSpecific("Line written before the directory removal");
+	my_handler.Flush();
+	std::filesystem::remove_all(dir_name);
+
+	for (unsigned int count_1 = 0; count_1 < 100; ++count_1)
+		my_handler.EmitLineSpecific("Line written after the directory removal");
+	my_handler.Flush();
+
+	if (!my_handler.GetReopenFailureCount())
+		throw std::logic_error(std::string(base_name) + ": the failure to "
+			"re-open the log file after rotation was not counted.");
+
+	std::cout << base_name << ": " << my_handler.GetReopenFailureCount() <<
+		" re-open failures." << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Lines below the flush level are held in the batch until the interval
+	expires, but a fatal line must reach the file before EmitLine() returns.
+*/
+void TEST_FlushPolicy()
+{
+	using namespace MLB::Utility;
+
+	std::string     file_name(TEST_GetLogFileName("LogHandlerXFile.Flush"));
+	LogHandlerXFile my_handler(file_name, LogHandlerFileBase::NoConsoleOutput,
+		LogFlushPolicy(1 << 20, 0, LogLevel_Fatal));
+
+	my_handler.EmitLineSpecific("Batched line", LogLevel_Info);
+
+	if (std::filesystem::file_size(file_name))
+		throw std::logic_error("A batched line was written before a flush "
+			"was required.");
+
+	LogEmitControl fatal_control(MLB::Utility::Default, LogFlag_Mask,
+		LogFlag_Mask, TimeSpec(), LogLevel_Fatal, LogFlag_Fatal,
+		file_name);
+
+	my_handler.EmitLine(fatal_control);
+
+	if (std::filesystem::file_size(file_name) !=
+		(2 * LogLineLeaderLength + 13 + file_name.size() + 1))
+		throw std::logic_error("A fatal line was not written before the "
+			"emitting call returned.");
+
+	my_handler.SetFlushPolicy(LogFlushPolicy(1 << 20, 10000, LogLevel_Fatal));
+	my_handler.EmitLineSpecific("Timed line", LogLevel_Info);
+
+	for (unsigned int count_1 = 0; count_1 < 100; ++count_1) {
+		if (std::filesystem::file_size(file_name) >
+			(2 * LogLineLeaderLength + 13 + file_name.size() + 1))
+			return;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	throw std::logic_error("A batched line was not written once the flush "
+		"interval had expired.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Performs the same work as TEST_StressLines() / TEST_StressSize() in
+	LogTestSupport.cpp through the given handler and returns the elapsed
+	seconds, including the time to flush the handler.
+
+	Because the formatting performed by the log streams dominates the time
+	for those tests, the lines are also emitted directly to the handler to
+	isolate the cost of the handler itself.
+*/
+double TEST_StressHandler(MLB::Utility::LogHandlerPtr my_log_handler,
+	std::size_t line_count, std::size_t line_length, bool use_stream)
+{
+	using namespace MLB::Utility;
+
+	std::string test_string(line_length, 'X');
+	TimeSpec    start_time(TimeSpec::Now());
+
+	if (use_stream) {
+		MyLogManager.HandlerInstall(my_log_handler);
+		start_time = TimeSpec::Now();
+		for (std::size_t count_1 = 0; count_1 < line_count; ++count_1)
+			LogDetail << std::setw(10) << count_1 << ": " << test_string <<
+				std::endl;
+	}
+	else {
+		std::string line_buffer(std::string(10, ' ') + ": " + test_string);
+		for (std::size_t count_1 = 0; count_1 < line_count; ++count_1) {
+			LogEmitControl emit_control(MLB::Utility::Default, LogFlag_Fatal,
+				LogFlag_Mask, TimeSpec(), LogLevel_Detail, LogFlag_Detail,
+				line_buffer);
+			my_log_handler->EmitLine(emit_control);
+		}
+	}
+
+	my_log_handler->Flush();
+
+	return(TimeSpec::Now().GetDifference(start_time).GetDouble());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_BatchBenchmark()
+{
+	using namespace MLB::Utility;
+
+	struct {
+		std::size_t line_count_;
+		std::size_t line_length_;
+	} workload_list[] = {
+		{ 100000,     200 },
+		{     10, 2000000 }
+	};
+
+	LogLevelPair old_levels_console = MyLogManager.GetLogLevelConsole();
+	LogLevelPair old_levels_file    = MyLogManager.GetLogLevelFile();
+
+	MyLogManager.SetLogLevelConsole(LogLevel_Fatal);
+	MyLogManager.SetLogLevelFile(LogLevel_Detail);
+
+	std::cout << "Handler                       Lines  Length  Stream ns/Line"
+		"  Direct ns/Line  Write Calls" << std::endl;
+
+	for (const auto &this_workload : workload_list) {
+		for (unsigned int count_1 = 0; count_1 < 3; ++count_1) {
+			const char    *handler_name;
+			double         elapsed_secs[2];
+			std::uint64_t  write_calls = 0;
+			for (unsigned int count_2 = 0; count_2 < 2; ++count_2) {
+				LogHandlerPtr    my_log_handler;
+				LogHandlerXFile *xfile_ptr = NULL;
+				if (!count_1) {
+					handler_name = "LogHandlerFile (iostream)";
+					my_log_handler.reset(new LogHandlerFile(
+						TEST_GetLogFileName("LogHandlerFile.Bench"),
+						LogHandlerFile::NoConsoleOutput));
+				}
+				else {
+					handler_name = (count_1 == 1) ?
+						"LogHandlerXFile (batched)" : "LogHandlerXFile (per line)";
+					xfile_ptr = new LogHandlerXFile(
+						TEST_GetLogFileName("LogHandlerXFile.Bench"),
+						LogHandlerFileBase::NoConsoleOutput, (count_1 == 1) ?
+						LogFlushPolicy() : LogFlushPolicy(0, 0));
+					my_log_handler.reset(xfile_ptr);
+				}
+				elapsed_secs[count_2] = TEST_StressHandler(my_log_handler,
+					this_workload.line_count_, this_workload.line_length_,
+					count_2 == 0);
+				if (xfile_ptr != NULL)
+					write_calls = xfile_ptr->GetWriteCallCount();
+			}
+			std::cout << std::left << std::setw(27) << handler_name <<
+				std::right << std::setw(8) << this_workload.line_count_ <<
+				std::setw(8) << this_workload.line_length_ << std::fixed <<
+				std::setprecision(1) << std::setw(16) <<
+				((elapsed_secs[0] * 1.0e9) /
+				static_cast<double>(this_workload.line_count_)) <<
+				std::setw(16) << ((elapsed_secs[1] * 1.0e9) /
+				static_cast<double>(this_workload.line_count_)) <<
+				std::setw(13);
+			if (count_1)
+				std::cout << write_calls;
+			else
+				std::cout << "-";
+			std::cout << std::endl;
+		}
+	}
+
+	MyLogManager.SetLogLevelConsole(old_levels_console.first,
+		old_levels_console.second);
+	MyLogManager.SetLogLevelFile(old_levels_file.first,
+		old_levels_file.second);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
 // ////////////////////////////////////////////////////////////////////////////
 int main()
 {
@@ -581,6 +1378,23 @@ int main()
 	int return_code = EXIT_SUCCESS;
 
 	try {
+		//	Rotation by size, with background compression...
+		TEST_Rotation<LogHandlerFile>("LogHandlerFile.Rotation",
+			LogHandlerFile::NoConsoleOutput);
+		TEST_Rotation<LogHandlerXFile>("LogHandlerXFile.Rotation",
+			LogHandlerFileBase::NoConsoleOutput);
+		TEST_RotationEmpty<LogHandlerFile>("LogHandlerFile.RotationEmpty",
+			LogHandlerFile::NoConsoleOutput);
+		TEST_RotationEmpty<LogHandlerXFile>("LogHandlerXFile.RotationEmpty",
+			LogHandlerFileBase::NoConsoleOutput);
+		TEST_RotationReopenFailure<LogHandlerFile>(
+			"LogHandlerFile.ReopenFailure", LogHandlerFile::NoConsoleOutput);
+		TEST_RotationReopenFailure<LogHandlerXFile>(
+			"LogHandlerXFile.ReopenFailure", LogHandlerFileBase::NoConsoleOutput);
+		//	Batched output must honor the flush policy...
+		TEST_FlushPolicy();
+		//	Batched output compared to the iostream-based handler...
+		TEST_BatchBenchmark();
 		//	Create a LogHandlerFile...
 /*
 		LogHandlerPtr my_log_handler(
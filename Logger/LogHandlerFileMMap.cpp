@@ -13,8 +13,11 @@
                            Michael L. Brock
                         2023-01-05 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- Lock-free space reservation with
+                                       chunks mapped ahead of the writers.
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 1993 - 2023.
+      Copyright Michael L. Brock 1993 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -29,14 +32,18 @@
 
 #include <Logger/LogHandlerFileMMap.hpp>
 
-#include <Utility/ExceptionRethrow.hpp>
 #include <Utility/GranularRound.hpp>
 #include <Utility/PageSize.hpp>
-#include <Utility/AnyToString.hpp>
+#include <Utility/ThrowErrno.hpp>
 
-#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <iostream>
 
-#include <boost/interprocess/detail/file_wrapper.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -44,45 +51,53 @@ namespace MLB {
 
 namespace Utility {
 
-namespace {
-
-// ////////////////////////////////////////////////////////////////////////////
-const std::size_t LogFileMMapDefaultAllocSize = 1 << 20;
-// ////////////////////////////////////////////////////////////////////////////
-
-} // Anonymous namespace
-
 // ////////////////////////////////////////////////////////////////////////////
-LogHandlerFileMMap::LogHandlerFileMMap()
+LogHandlerFileMMap::LogHandlerFileMMap(std::size_t chunk_size)
 	:LogHandlerFileBase()
 	,eol_string_("\n")
 	,eol_string_length_(eol_string_.size())
 	,page_alloc_size_(GetPageAllocGranularitySize())
-	,chunk_alloc_size_(GranularRoundUp(LogFileMMapDefaultAllocSize,
-		page_alloc_size_))
-	,mapping_sptr_()
-	,region_sptr_()
-	,mapping_size_(0)
-	,mapping_offset_(0)
-	,write_offset_(0)
+	,chunk_alloc_size_(GranularRoundUp(chunk_size, page_alloc_size_))
+	,file_fd_(-1)
+	,file_size_(0)
+	,first_chunk_index_(0)
+	,first_chunk_done_(0)
+	,next_map_index_(0)
+	,next_retire_index_(0)
+	,chunk_slot_list_()
+	,stall_count_(0)
+	,map_failure_count_(0)
+	,map_stop_(false)
+	,map_signal_(0)
+	,map_thread_()
+	,chunk_lock_()
+	,write_offset_(ClosedFlag)
 {
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 LogHandlerFileMMap::LogHandlerFileMMap(const char *file_name,
-	LogHandlerFileBaseFlag flags)
+	LogHandlerFileBaseFlag flags, std::size_t chunk_size)
 	:LogHandlerFileBase(flags)
 	,eol_string_("\n")
 	,eol_string_length_(eol_string_.size())
 	,page_alloc_size_(GetPageAllocGranularitySize())
-	,chunk_alloc_size_(GranularRoundUp(LogFileMMapDefaultAllocSize,
-		page_alloc_size_))
-	,mapping_sptr_()
-	,region_sptr_()
-	,mapping_size_(0)
-	,mapping_offset_(0)
-	,write_offset_(0)
+	,chunk_alloc_size_(GranularRoundUp(chunk_size, page_alloc_size_))
+	,file_fd_(-1)
+	,file_size_(0)
+	,first_chunk_index_(0)
+	,first_chunk_done_(0)
+	,next_map_index_(0)
+	,next_retire_index_(0)
+	,chunk_slot_list_()
+	,stall_count_(0)
+	,map_failure_count_(0)
+	,map_stop_(false)
+	,map_signal_(0)
+	,map_thread_()
+	,chunk_lock_()
+	,write_offset_(ClosedFlag)
 {
 	OpenFile(file_name);
 }
@@ -90,144 +105,115 @@ LogHandlerFileMMap::LogHandlerFileMMap(const char *file_name,
 
 // ////////////////////////////////////////////////////////////////////////////
 LogHandlerFileMMap::LogHandlerFileMMap(const std::string &file_name,
-	LogHandlerFileBaseFlag flags)
+	LogHandlerFileBaseFlag flags, std::size_t chunk_size)
 	:LogHandlerFileBase(flags)
 	,eol_string_("\n")
 	,eol_string_length_(eol_string_.size())
 	,page_alloc_size_(GetPageAllocGranularitySize())
-	,chunk_alloc_size_(GranularRoundUp(LogFileMMapDefaultAllocSize,
-		page_alloc_size_))
-	,mapping_sptr_()
-	,region_sptr_()
-	,mapping_size_(0)
-	,mapping_offset_(0)
-	,write_offset_(0)
+	,chunk_alloc_size_(GranularRoundUp(chunk_size, page_alloc_size_))
+	,file_fd_(-1)
+	,file_size_(0)
+	,first_chunk_index_(0)
+	,first_chunk_done_(0)
+	,next_map_index_(0)
+	,next_retire_index_(0)
+	,chunk_slot_list_()
+	,stall_count_(0)
+	,map_failure_count_(0)
+	,map_stop_(false)
+	,map_signal_(0)
+	,map_thread_()
+	,chunk_lock_()
+	,write_offset_(ClosedFlag)
 {
 	OpenFile(file_name);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
-/* 
-	CODE NOTE: Decide whether to remove the elaborate instances of the OpenFile() overload.
 // ////////////////////////////////////////////////////////////////////////////
-LogHandlerFileMMap::LogHandlerFileMMap(const char *base_name,
-	const char *dir_name, LogHandlerFileBaseFlag flags)
-	:LogHandlerFileBase(flags)
-	,eol_string_("\n")
-	,eol_string_length_(eol_string_.size())
-	,page_alloc_size_(GetPageAllocGranularitySize())
-	,chunk_alloc_size_(GranularRoundUp(LogFileMMapDefaultAllocSize,
-		page_alloc_size_))
-	,mapping_sptr_()
-	,region_sptr_()
-	,mapping_size_(0)
-	,mapping_offset_(0)
-	,write_offset_(0)
+LogHandlerFileMMap::~LogHandlerFileMMap()
 {
-	OpenFile(base_name, dir_name);
+	LogLockScoped my_lock(the_lock_);
+
+	CloseFile();
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-LogHandlerFileMMap::LogHandlerFileMMap(const std::string &base_name,
-	const std::string &dir_name, LogHandlerFileBaseFlag flags)
-	:LogHandlerFileBase(flags)
-	,eol_string_("\n")
-	,eol_string_length_(eol_string_.size())
-	,page_alloc_size_(GetPageAllocGranularitySize())
-	,chunk_alloc_size_(GranularRoundUp(LogFileMMapDefaultAllocSize,
-		page_alloc_size_))
-	,mapping_sptr_()
-	,region_sptr_()
-	,mapping_size_(0)
-	,mapping_offset_(0)
-	,write_offset_(0)
+/*
+	The persistent output doesn't use the handler lock, which continues to
+	serialize output to the console.
+*/
+void LogHandlerFileMMap::EmitLine(const LogEmitControl &emit_control)
 {
-	OpenFile(base_name, dir_name);
+	bool to_console = (!(my_flags_ & NoConsoleOutput)) &&
+		emit_control.ShouldLogScreen();
+
+	if (emit_control.ShouldLogPersistent() || to_console) {
+		emit_control.UpdateTime();
+		if (emit_control.ShouldLogPersistent())
+			EmitLineImpl(emit_control);
+		if (to_console) {
+			LogLockScoped my_lock(the_lock_);
+			std::cout.write(emit_control.GetLeaderPtr(),
+				static_cast<std::streamsize>(emit_control.GetLeaderLength()));
+			std::cout.write(emit_control.line_buffer_.c_str(),
+				static_cast<std::streamsize>(emit_control.line_buffer_.size()));
+			std::cout << std::endl;
+		}
+	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-LogHandlerFileMMap::LogHandlerFileMMap(const char *base_name,
-	const char *dir_name, const MLB::Utility::TimeT &start_time,
-	LogHandlerFileBaseFlag flags)
-	:LogHandlerFileBase(flags)
-	,eol_string_("\n")
-	,eol_string_length_(eol_string_.size())
-	,page_alloc_size_(GetPageAllocGranularitySize())
-	,chunk_alloc_size_(GranularRoundUp(LogFileMMapDefaultAllocSize,
-		page_alloc_size_))
-	,mapping_sptr_()
-	,region_sptr_()
-	,mapping_size_(0)
-	,mapping_offset_(0)
-	,write_offset_(0)
+void LogHandlerFileMMap::EmitLiteral(unsigned int literal_length,
+	const char *literal_string)
 {
-	OpenFile(base_name, dir_name, start_time);
+	EmitLiteralImpl(literal_length, literal_string);
+
+	if (!(my_flags_ & NoConsoleOutput)) {
+		LogLockScoped my_lock(the_lock_);
+		std::cout.write(literal_string,
+			static_cast<std::streamsize>(literal_length));
+		std::cout << std::endl;
+	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-LogHandlerFileMMap::LogHandlerFileMMap(const std::string &base_name,
-	const std::string &dir_name, const MLB::Utility::TimeT &start_time,
-	LogHandlerFileBaseFlag flags)
-	:LogHandlerFileBase(flags)
-	,eol_string_("\n")
-	,eol_string_length_(eol_string_.size())
-	,page_alloc_size_(GetPageAllocGranularitySize())
-	,chunk_alloc_size_(GranularRoundUp(LogFileMMapDefaultAllocSize,
-		page_alloc_size_))
-	,mapping_sptr_()
-	,region_sptr_()
-	,mapping_size_(0)
-	,mapping_offset_(0)
-	,write_offset_(0)
+void LogHandlerFileMMap::EmitLiteral(const LogEmitControl &emit_control,
+	unsigned int literal_length, const char *literal_string)
 {
-	OpenFile(base_name, dir_name, start_time);
+	if (emit_control.ShouldLogPersistent())
+		EmitLiteralImpl(literal_length, literal_string);
+
+	if ((!(my_flags_ & NoConsoleOutput)) && emit_control.ShouldLogScreen()) {
+		LogLockScoped my_lock(the_lock_);
+		std::cout.write(literal_string,
+			static_cast<std::streamsize>(literal_length));
+		std::cout << std::endl;
+	}
 }
 // ////////////////////////////////////////////////////////////////////////////
-*/
 
 // ////////////////////////////////////////////////////////////////////////////
-LogHandlerFileMMap::~LogHandlerFileMMap()
+std::size_t LogHandlerFileMMap::GetChunkSize() const
 {
-	bool           truncate_file_flag = false;
-	MyMappingValue truncate_file_size = 0;
-	LogLockScoped  my_lock(the_lock_);
-
-	if (region_sptr_.get() != NULL) {
-		/*
-			Truncate the file just beyond the last byte written in the current
-			chunk. This drops the zero-filled portion of the file...
-		*/
-		truncate_file_flag = true;
-		truncate_file_size = mapping_offset_ + write_offset_;
-		try {
-			region_sptr_->flush();
-		}
-		catch (const std::exception &) {
-		}
-	}
+	return(chunk_alloc_size_);
+}
+// ////////////////////////////////////////////////////////////////////////////
 
-	region_sptr_.reset();
-	mapping_sptr_.reset();
-
-	if (truncate_file_flag) {
-		try {
-			boost::interprocess::ipcdetail::file_wrapper tmp_file(
-				boost::interprocess::open_only_t(),
-				out_file_name_.c_str(), boost::interprocess::read_write);
-//			TruncateFileSize(out_file_name_, truncate_file_size);
-			if (!boost::interprocess::ipcdetail::truncate_file(
-				tmp_file.get_mapping_handle().handle, truncate_file_size))
-			{
-				; // Failed for some reason. Helpless to fix in a dtor.
-			}
-		}
-		catch (const std::exception &) {
-			;	// TLILB
-		}
-	}
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerFileMMap::GetStallCount() const
+{
+	return(stall_count_.load(std::memory_order_relaxed));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerFileMMap::GetMapFailureCount() const
+{
+	return(map_failure_count_.load(std::memory_order_relaxed));
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -246,185 +232,81 @@ void LogHandlerFileMMap::RemoveHandlerImpl()
 // ////////////////////////////////////////////////////////////////////////////
 void LogHandlerFileMMap::OpenFileImpl(const char *file_name)
 {
-	bool               file_created = false;
-	unsigned long long file_size    = 0;
-	std::string        tmp_file_name;
-	bool               file_existed;
+	int tmp_fd = ::open(file_name, O_RDWR | O_CREAT |
+		((my_flags_ & DoNotAppend) ? O_TRUNC : 0), 0644);
 
-	file_existed = ResolveFilePathGeneral(file_name, tmp_file_name, "",
-		false, false, true);
+	if (tmp_fd < 0)
+		ThrowErrno("Open attempt failed");
 
-	using namespace boost::interprocess;
+	std::uint64_t file_size;
+	std::uint64_t data_size;
 
 	try {
-		unsigned int   mapping_size   = chunk_alloc_size_;
-		MyMappingValue mapping_offset = 0;
-		MyMappingValue write_offset   = 0;
-		if (file_existed) {
-			/*
-				If the file already exists, we attempt to determine whether the
-				file ends in a string of ASCII NUL characters. If any such string
-				is found, we'll attempt to 'back over' it.
-
-				The reason such a string can come into existence is a result of
-				the fact that memory-mapping, in both Windows and various Unices,
-				operates on pages, and not characters. Pages are padded-out by
-				being zero-filled upon assignment to the process by the operating
-				system.
-
-				The destructor logic is written to truncate the file such that
-				file contents will include only characters written. But if a
-				run time mishap prevents the destructor from completing correctly,
-				the removal of the padding bytes may not be performed.
-			*/
-			if (my_flags_ & DoNotAppend) {
-				TruncateFileSize(tmp_file_name, 0);
-				file_size = 0;
-			}
-			else
-				file_size = MLB::Utility::GetFileSize(tmp_file_name);
-			if (!file_size) {
-				mapping_offset = 0;
-				write_offset   = 0;
-			}
-			if (!(file_size % page_alloc_size_)) {
-				unsigned int   tmp_map_size;
-				MyMappingValue tmp_map_offset;
-				if (file_size < chunk_alloc_size_) {
-					tmp_map_size   = static_cast<unsigned int>(file_size);
-					tmp_map_offset = 0;
-				}
-				else {
-					tmp_map_size   = chunk_alloc_size_;
-					tmp_map_offset = file_size - chunk_alloc_size_;
-				}
-				file_mapping  tmp_mapping(tmp_file_name.c_str(), read_write);
-				mapped_region tmp_region(tmp_mapping, read_write,
-					static_cast<boost::interprocess::offset_t>(tmp_map_offset),
-					tmp_map_size);
-				const char *start_ptr = 
-					static_cast<const char *>(tmp_region.get_address());
-				const char *end_ptr   = start_ptr + tmp_map_size;
-				if (end_ptr[-1]) {
-					TruncateFileSize(tmp_file_name, file_size + chunk_alloc_size_);
-					mapping_offset = file_size;
-					write_offset   = 0;
-				}
-				else {
-					while ((end_ptr > start_ptr) && (!end_ptr[-1]))
-						--end_ptr;
-					if (end_ptr > start_ptr) {
-						mapping_size   = tmp_map_size;
-						mapping_offset = tmp_map_offset;
-						write_offset   =
-							static_cast<MyMappingValue>(end_ptr - start_ptr);
-					}
-					else {
-						mapping_size   = tmp_map_size;
-						mapping_offset = tmp_map_offset;
-						write_offset   = 0;
-					}
-				}
-			}
-			else {
-				file_size = GranularRoundUp<unsigned long long>(file_size,
-					chunk_alloc_size_);
-				TruncateFileSize(tmp_file_name, file_size);
-				unsigned int   tmp_map_size   = chunk_alloc_size_;
-				MyMappingValue tmp_map_offset = file_size - chunk_alloc_size_;
-				file_mapping   tmp_mapping(tmp_file_name.c_str(), read_write);
-				mapped_region  tmp_region(tmp_mapping, read_write,
-					static_cast<boost::interprocess::offset_t>(tmp_map_offset),
-					tmp_map_size);
-				const char *start_ptr = 
-					static_cast<const char *>(tmp_region.get_address());
-				const char *end_ptr   = start_ptr + tmp_map_size;
-				while ((end_ptr > start_ptr) && (!end_ptr[-1]))
-					--end_ptr;
-				if (end_ptr > start_ptr) {
-					mapping_size   = tmp_map_size;
-					mapping_offset = tmp_map_offset;
-					write_offset   =
-						static_cast<MyMappingValue>(end_ptr - start_ptr);
-				}
-				else {
-					mapping_size   = tmp_map_size;
-					mapping_offset = tmp_map_offset;
-					write_offset   = 0;
-				}
-			}
-		}
-		else {
-			/*
-				Otherwise, the file doesn't exist. So create it...
-			*/
-			{
-				std::ofstream this_file(tmp_file_name.c_str(),
-					(!(my_flags_ & DoNotAppend)) ?
-					(std::ios_base::app | std::ios_base::ate) :
-					(std::ios_base::app | std::ios_base::trunc));
-				if (this_file.fail())
-					ThrowErrno("Open attempt for the new file failed.");
-			}
-			TruncateFileSize(tmp_file_name, mapping_size);
-			file_created   = true;
-			mapping_offset = 0;
-			write_offset   = 0;
-		}
-		MyFileMappingSPtr mapping_sptr(
-			new file_mapping(tmp_file_name.c_str(), read_write));
-		MyMappedRegionSPtr region_sptr(
-			new mapped_region(*mapping_sptr, read_write,
-			static_cast<boost::interprocess::offset_t>(mapping_offset),
-			mapping_size));
-		{
-			LogLockScoped my_lock(the_lock_);
-			mapping_sptr_.swap(mapping_sptr);
-			region_sptr_.swap(region_sptr);
-			out_file_name_.swap(tmp_file_name);
-			mapping_size_   = mapping_size;
-			mapping_offset_ = mapping_offset;
-			write_offset_   = write_offset;
-		}
+		struct stat stat_data;
+		if (::fstat(tmp_fd, &stat_data))
+			ThrowErrno("Attempt to determine the size of the file failed");
+		file_size = static_cast<std::uint64_t>(stat_data.st_size);
+		data_size = FindEndOfData(tmp_fd, file_size);
 	}
-	catch (const std::exception &except) {
-		if (file_created) {
-			try {
-				RemoveFile(tmp_file_name, true);
-			}
-			catch (const std::exception &) {
-				; // TLILB
-			}
+	catch (const std::exception &) {
+		::close(tmp_fd);
+		throw;
+	}
+
+	{
+		std::string   tmp_file_name(file_name);
+		LogLockScoped my_lock(the_lock_);
+		CloseFile();
+		file_fd_           = tmp_fd;
+		file_size_         = file_size;
+		first_chunk_index_ = data_size / chunk_alloc_size_;
+		first_chunk_done_  =
+			static_cast<std::size_t>(data_size % chunk_alloc_size_);
+		next_map_index_    = first_chunk_index_;
+		next_retire_index_.store(first_chunk_index_, std::memory_order_relaxed);
+		for (auto &this_slot : chunk_slot_list_) {
+			this_slot.chunk_ptr_.store(NULL, std::memory_order_relaxed);
+			this_slot.bytes_done_.store(0, std::memory_order_relaxed);
+			this_slot.chunk_index_.store(NoChunkIndex, std::memory_order_relaxed);
 		}
-		MLB::Utility::Rethrow(except, "Attempt to open log file '" +
-			tmp_file_name + "' for memory-mapped write access failed: " +
-			std::string(except.what()));
+		map_stop_.store(false, std::memory_order_relaxed);
+		out_file_name_.swap(tmp_file_name);
+		map_thread_ = std::thread(&LogHandlerFileMMap::MapThreadProc, this);
+		write_offset_.store(data_size, std::memory_order_release);
 	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
+/*
+	Asks the operating system to start writing the mapped chunks; as with the
+	other file handlers, flushing doesn't wait for the data to reach the
+	disk.
+*/
 void LogHandlerFileMMap::FlushImpl()
 {
-	if (region_sptr_.get() != NULL)
-		region_sptr_->flush();
+	LogLockScoped my_lock(chunk_lock_);
+
+	for (const auto &this_slot : chunk_slot_list_) {
+		char *chunk_ptr = this_slot.chunk_ptr_.load(std::memory_order_relaxed);
+		if (chunk_ptr != NULL)
+			::msync(chunk_ptr, chunk_alloc_size_, MS_ASYNC);
+	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 void LogHandlerFileMMap::EmitLineImpl(const LogEmitControl &emit_control)
 {
-	if (region_sptr_.get() != NULL) {
-		EnsureNeededSpace(emit_control.GetLeaderLength() +
-			emit_control.line_buffer_.size() + eol_string_length_);
-		::memcpy(GetCurrentPtr(), emit_control.GetLeaderPtr(),
+	std::uint64_t write_offset;
+
+	if (ReserveSpace(emit_control.GetLeaderLength() +
+		emit_control.line_buffer_.size() + eol_string_length_, write_offset)) {
+		write_offset = CopyToFile(write_offset, emit_control.GetLeaderPtr(),
 			emit_control.GetLeaderLength());
-		AddToOffset(emit_control.GetLeaderLength());
-		::memcpy(GetCurrentPtr(), emit_control.line_buffer_.c_str(),
-			emit_control.line_buffer_.size());
-		AddToOffset(emit_control.line_buffer_.size());
-		::memcpy(GetCurrentPtr(), eol_string_.c_str(), eol_string_length_);
-		AddToOffset(eol_string_length_);
+		write_offset = CopyToFile(write_offset,
+			emit_control.line_buffer_.data(), emit_control.line_buffer_.size());
+		CopyToFile(write_offset, eol_string_.data(), eol_string_length_);
 	}
 }
 // ////////////////////////////////////////////////////////////////////////////
@@ -433,77 +315,283 @@ void LogHandlerFileMMap::EmitLineImpl(const LogEmitControl &emit_control)
 void LogHandlerFileMMap::EmitLiteralImpl(unsigned int literal_length,
 	const char *literal_string)
 {
-	if (region_sptr_.get() != NULL) {
-		EnsureNeededSpace(literal_length + eol_string_length_);
-		::memcpy(GetCurrentPtr(), literal_string, literal_length);
-		AddToOffset(literal_length);
-		::memcpy(GetCurrentPtr(), eol_string_.c_str(), eol_string_length_);
-		AddToOffset(eol_string_length_);
+	std::uint64_t write_offset;
+
+	if (ReserveSpace(literal_length + eol_string_length_, write_offset)) {
+		write_offset = CopyToFile(write_offset, literal_string, literal_length);
+		CopyToFile(write_offset, eol_string_.data(), eol_string_length_);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	While the file is being closed (or if it was never opened) the offset has
+	the 'ClosedFlag' bit set. Writers which see it wait for any re-open in
+	progress to complete by acquiring the handler lock and then try again.
+*/
+bool LogHandlerFileMMap::ReserveSpace(std::size_t length,
+	std::uint64_t &offset)
+{
+	offset = write_offset_.fetch_add(length, std::memory_order_relaxed);
+
+	if (offset & ClosedFlag) {
+		LogLockScoped my_lock(the_lock_);
+		offset = write_offset_.fetch_add(length, std::memory_order_relaxed);
+		if (offset & ClosedFlag)
+			return(false);
+	}
+
+	//	Let the map thread know when a chunk boundary is crossed...
+	if ((!(offset % chunk_alloc_size_)) ||
+		((offset / chunk_alloc_size_) !=
+		((offset + length) / chunk_alloc_size_)))
+		WakeMapThread();
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Data which spans chunks is copied a chunk at a time, in order, so that
+	a writer never holds an incomplete chunk while waiting for a later one.
+	If the map thread couldn't map a chunk the data is discarded, but is still
+	counted so that the chunk can be retired.
+*/
+std::uint64_t LogHandlerFileMMap::CopyToFile(std::uint64_t offset,
+	const char *data_ptr, std::size_t data_length)
+{
+	while (data_length) {
+		std::uint64_t  chunk_index  = offset / chunk_alloc_size_;
+		std::size_t    chunk_offset =
+			static_cast<std::size_t>(offset % chunk_alloc_size_);
+		std::size_t    copy_length  =
+			(data_length < (chunk_alloc_size_ - chunk_offset)) ? data_length :
+			(chunk_alloc_size_ - chunk_offset);
+		ChunkSlot     &this_slot    = GetChunkSlot(chunk_index);
+		char          *chunk_ptr    =
+			this_slot.chunk_ptr_.load(std::memory_order_relaxed);
+		if (chunk_ptr != NULL)
+			::memcpy(chunk_ptr + chunk_offset, data_ptr, copy_length);
+		if ((this_slot.bytes_done_.fetch_add(copy_length,
+			std::memory_order_acq_rel) + copy_length) == chunk_alloc_size_)
+			WakeMapThread();
+		offset      += copy_length;
+		data_ptr    += copy_length;
+		data_length -= copy_length;
 	}
+
+	return(offset);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-void *LogHandlerFileMMap::GetCurrentPtr()
+LogHandlerFileMMap::ChunkSlot &LogHandlerFileMMap::GetChunkSlot(
+	std::uint64_t chunk_index)
 {
-	return(static_cast<void *>(static_cast<char *>(
-		region_sptr_->get_address()) + write_offset_));
+	ChunkSlot     &this_slot = chunk_slot_list_[chunk_index % ChunkSlotCount];
+	std::uint64_t  slot_index;
+
+	if ((slot_index = this_slot.chunk_index_.load(std::memory_order_acquire)) !=
+		chunk_index) {
+		stall_count_.fetch_add(1, std::memory_order_relaxed);
+		do {
+			WakeMapThread();
+			this_slot.chunk_index_.wait(slot_index, std::memory_order_acquire);
+		} while ((slot_index =
+			this_slot.chunk_index_.load(std::memory_order_acquire)) !=
+			chunk_index);
+	}
+
+	return(this_slot);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-void LogHandlerFileMMap::AddToOffset(std::size_t added_offset)
+void LogHandlerFileMMap::WakeMapThread()
 {
-	if ((write_offset_ + added_offset) > mapping_size_)
-		throw std::invalid_argument("The value specified to "
-			"'LogHandlerFileMMap::AddToOffset()' (" +
-			AnyToString(added_offset) + ") when added to the current "
-			"'write_offset_' value (" + AnyToString(write_offset_) +
-			") is greater than the 'mapped_size_' member (" +
-			AnyToString(mapping_size_) + ").");
-
-	write_offset_ += added_offset;
+	map_signal_.fetch_add(1, std::memory_order_release);
+	map_signal_.notify_one();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileMMap::MapThreadProc()
+{
+	for ( ; ; ) {
+		std::uint32_t signal_value =
+			map_signal_.load(std::memory_order_acquire);
+		RetireChunks();
+		if (map_stop_.load(std::memory_order_acquire))
+			break;
+		MapChunks();
+		map_signal_.wait(signal_value, std::memory_order_acquire);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileMMap::RetireChunks()
+{
+	std::uint64_t retire_index =
+		next_retire_index_.load(std::memory_order_relaxed);
+
+	while (retire_index < next_map_index_) {
+		ChunkSlot &this_slot = chunk_slot_list_[retire_index % ChunkSlotCount];
+		if (this_slot.bytes_done_.load(std::memory_order_acquire) <
+			chunk_alloc_size_)
+			break;
+		{
+			LogLockScoped my_lock(chunk_lock_);
+			char *chunk_ptr = this_slot.chunk_ptr_.load(std::memory_order_relaxed);
+			if (chunk_ptr != NULL)
+				::munmap(chunk_ptr, chunk_alloc_size_);
+			this_slot.chunk_ptr_.store(NULL, std::memory_order_relaxed);
+		}
+		this_slot.chunk_index_.store(NoChunkIndex, std::memory_order_release);
+		next_retire_index_.store(++retire_index, std::memory_order_release);
+	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 /*
-	Assumes the lock has been acquired.
+	Maps the chunk being written and up to 'ChunkLookAhead' chunks beyond it,
+	subject to the availability of a free slot. The pages of each chunk are
+	faulted in here so that writers don't take the page faults themselves.
 */
-void LogHandlerFileMMap::EnsureNeededSpace(std::size_t needed_length)
+void LogHandlerFileMMap::MapChunks()
 {
-	MyMappingValue remaining_length = (write_offset_ <= mapping_size_) ?
-		(mapping_size_ - write_offset_) : 0;
+	std::uint64_t write_index = (write_offset_.load(std::memory_order_acquire) &
+		(~ClosedFlag)) / chunk_alloc_size_;
+
+	while ((next_map_index_ <= (write_index + ChunkLookAhead)) &&
+		(next_map_index_ <
+		(next_retire_index_.load(std::memory_order_relaxed) + ChunkSlotCount))) {
+		ChunkSlot     &this_slot  = chunk_slot_list_[next_map_index_ %
+			ChunkSlotCount];
+		std::uint64_t  map_offset = next_map_index_ * chunk_alloc_size_;
+		char          *chunk_ptr  = NULL;
+		if ((file_size_ < (map_offset + chunk_alloc_size_)) &&
+			(!::ftruncate(file_fd_,
+			static_cast<off_t>(map_offset + chunk_alloc_size_))))
+			file_size_ = map_offset + chunk_alloc_size_;
+		if (file_size_ >= (map_offset + chunk_alloc_size_)) {
+			LogLockScoped my_lock(chunk_lock_);
+			void *map_ptr = ::mmap(NULL, chunk_alloc_size_,
+				PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, file_fd_,
+				static_cast<off_t>(map_offset));
+			if (map_ptr != MAP_FAILED) {
+				::madvise(map_ptr, chunk_alloc_size_, MADV_WILLNEED);
+				chunk_ptr = static_cast<char *>(map_ptr);
+			}
+		}
+		if (chunk_ptr == NULL)
+			map_failure_count_.fetch_add(1, std::memory_order_relaxed);
+		this_slot.bytes_done_.store((next_map_index_ == first_chunk_index_) ?
+			first_chunk_done_ : 0, std::memory_order_relaxed);
+		this_slot.chunk_ptr_.store(chunk_ptr, std::memory_order_relaxed);
+		this_slot.chunk_index_.store(next_map_index_, std::memory_order_release);
+		this_slot.chunk_index_.notify_all();
+		++next_map_index_;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Waits until every byte reserved before the file was marked as closed has
+	been copied. The map thread must still be running.
+*/
+void LogHandlerFileMMap::WaitForWriters(std::uint64_t final_offset)
+{
+	std::uint64_t  final_index = final_offset / chunk_alloc_size_;
+	std::size_t    final_done  =
+		static_cast<std::size_t>(final_offset % chunk_alloc_size_);
+	ChunkSlot     &final_slot  = chunk_slot_list_[final_index % ChunkSlotCount];
+
+	for ( ; ; ) {
+		if ((next_retire_index_.load(std::memory_order_acquire) >=
+			final_index) && ((!final_done) ||
+			((final_slot.chunk_index_.load(std::memory_order_acquire) ==
+			final_index) &&
+			(final_slot.bytes_done_.load(std::memory_order_acquire) >=
+			final_done))))
+			break;
+		WakeMapThread();
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
 
-	//	Note that if equal we'll go ahead and allocate more space...
-	if (needed_length < remaining_length)
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Assumes the handler lock has been acquired.
+*/
+void LogHandlerFileMMap::CloseFile()
+{
+	if (file_fd_ < 0)
 		return;
 
-	MyMappingValue mapping_offset = GranularRoundDown<MyMappingValue>(
-		mapping_offset_ + write_offset_, page_alloc_size_);
-	MyMappingValue write_offset   = (mapping_offset_ + write_offset_) -
-		mapping_offset;
-	MyMappingValue mapping_size   = (std::max)(chunk_alloc_size_,
-		GranularRoundUp(needed_length, page_alloc_size_) +
-		page_alloc_size_);
+	std::uint64_t final_offset =
+		write_offset_.fetch_or(ClosedFlag, std::memory_order_acq_rel);
+
+	WaitForWriters(final_offset);
 
-	TruncateFileSize(out_file_name_, mapping_offset + mapping_size);
+	map_stop_.store(true, std::memory_order_release);
+	WakeMapThread();
+	map_thread_.join();
 
-	using namespace boost::interprocess;
+	for (auto &this_slot : chunk_slot_list_) {
+		char *chunk_ptr = this_slot.chunk_ptr_.load(std::memory_order_relaxed);
+		if (chunk_ptr != NULL)
+			::munmap(chunk_ptr, chunk_alloc_size_);
+		this_slot.chunk_ptr_.store(NULL, std::memory_order_relaxed);
+		this_slot.chunk_index_.store(NoChunkIndex, std::memory_order_relaxed);
+	}
 
-	MyFileMappingSPtr        mapping_sptr(
-		new file_mapping(out_file_name_.c_str(), read_write));
-	MyMappedRegionSPtr        region_sptr(
-		new mapped_region(*mapping_sptr, read_write,
-		static_cast<boost::interprocess::offset_t>(mapping_offset),
-		static_cast<std::size_t>(mapping_size)));
+	//	Drop the zero-filled portion of the file beyond the last byte written.
+	if (::ftruncate(file_fd_, static_cast<off_t>(final_offset))) {
+		;	// Helpless to fix that here.
+	}
+
+	::close(file_fd_);
+
+	file_fd_ = -1;
+}
+// ////////////////////////////////////////////////////////////////////////////
 
-	mapping_sptr_.swap(mapping_sptr);
-	region_sptr_.swap(region_sptr);
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Memory-mapping operates on pages, not characters, and the file is extended
+	a chunk at a time ahead of the writers. If the process fails before the
+	file is truncated by 'CloseFile()' the file ends with ASCII NUL padding,
+	which we back over so that new lines follow the last one written.
+*/
+std::uint64_t LogHandlerFileMMap::FindEndOfData(int file_fd,
+	std::uint64_t file_size)
+{
+	char          buffer[1 << 16];
+	std::uint64_t end_offset = file_size;
+
+	while (end_offset) {
+		std::size_t read_length = (end_offset < sizeof(buffer)) ?
+			static_cast<std::size_t>(end_offset) : sizeof(buffer);
+		if (::pread(file_fd, buffer, read_length,
+			static_cast<off_t>(end_offset - read_length)) !=
+			static_cast<ssize_t>(read_length))
+			ThrowErrno("Attempt to read the end of the file failed");
+		const char *end_ptr = buffer + read_length;
+		while ((end_ptr > buffer) && (!end_ptr[-1]))
+			--end_ptr;
+		end_offset -= static_cast<std::uint64_t>((buffer + read_length) -
+			end_ptr);
+		if (end_ptr > buffer)
+			break;
+	}
 
-	mapping_size_   = static_cast<unsigned int>(mapping_size);
-	mapping_offset_ = mapping_offset;
-	write_offset_   = write_offset;
+	return(end_offset);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -519,10 +607,132 @@ void LogHandlerFileMMap::EnsureNeededSpace(std::size_t needed_length)
 
 #ifdef TEST_MAIN
 
-#include <Logger/LogHandlerFile.hpp>
 #include <Logger/LogManager.hpp>
 #include <Logger/LogTestSupport.hpp>
 
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string TEST_ReadFile(const std::string &file_name)
+{
+	std::ifstream      in_file(file_name.c_str(),
+		std::ios_base::in | std::ios_base::binary);
+	std::ostringstream file_data;
+
+	file_data << in_file.rdbuf();
+
+	return(file_data.str());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string TEST_MakeLine(unsigned int thread_index, unsigned int line_index)
+{
+	//	Every 1000th line is larger than a chunk...
+	std::size_t pad_length = (line_index % 1000) ? (line_index % 131) :
+		(100 * 1024);
+
+	return("Thread " + std::to_string(thread_index) + " line " +
+		std::to_string(line_index) + " " + std::string(pad_length, '*'));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Lines from concurrent writers may be interleaved, but each must be intact
+	and the lines of each writer must be in order. A second handler appends
+	to the file after NUL padding has been added to it, as would be the case
+	had the first handler not been able to truncate the file.
+*/
+void TEST_ConcurrentWriters()
+{
+	using namespace MLB::Utility;
+
+	const unsigned int thread_count = 4;
+	const unsigned int line_count   = 20000;
+	std::string        file_name(TEST_GetLogFileName("LogHandlerFileMMap.Writers"));
+	std::uint64_t      stall_count;
+
+	{
+		LogHandlerFileMMap       my_handler(file_name,
+			LogHandlerFileBase::NoConsoleOutput, 64 * 1024);
+		std::vector<std::thread> thread_list;
+		for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1)
+			thread_list.emplace_back([&my_handler, count_1]() {
+				for (unsigned int count_2 = 0; count_2 < line_count; ++count_2)
+					my_handler.EmitLineSpecific(TEST_MakeLine(count_1, count_2));
+			});
+		for (auto &this_thread : thread_list)
+			this_thread.join();
+		stall_count = my_handler.GetStallCount();
+		if (my_handler.GetMapFailureCount())
+			throw std::logic_error("Attempts to map chunks failed.");
+	}
+
+	{
+		std::ofstream pad_file(file_name.c_str(),
+			std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+		pad_file << std::string(10000, '\0');
+	}
+
+	{
+		LogHandlerFileMMap my_handler(file_name,
+			LogHandlerFileBase::NoConsoleOutput, 64 * 1024);
+		my_handler.EmitLineSpecific("Appended line");
+	}
+
+	std::string               file_data(TEST_ReadFile(file_name));
+	std::vector<unsigned int> next_line_list(thread_count, 0);
+	std::string::size_type    line_start = 0;
+	std::string::size_type    line_end;
+	bool                      appended_found = false;
+
+	while ((line_end = file_data.find('\n', line_start)) != std::string::npos) {
+		std::string this_line(file_data.substr(line_start + LogLineLeaderLength,
+			line_end - line_start - LogLineLeaderLength));
+		line_start = line_end + 1;
+		if (this_line == "Appended line") {
+			appended_found = true;
+			continue;
+		}
+		unsigned int thread_index;
+		unsigned int line_index;
+		if ((::sscanf(this_line.c_str(), "Thread %u line %u", &thread_index,
+			&line_index) != 2) || (thread_index >= thread_count) ||
+			appended_found)
+			throw std::logic_error("Unexpected line found in file '" +
+				file_name + "' at offset " + std::to_string(line_start) + ".");
+		if ((line_index != next_line_list[thread_index]) ||
+			(this_line != TEST_MakeLine(thread_index, line_index)))
+			throw std::logic_error("Line " + std::to_string(line_index) +
+				" of thread " + std::to_string(thread_index) + " is corrupt, "
+				"missing or out of order.");
+		++next_line_list[thread_index];
+	}
+
+	if ((line_start != file_data.size()) || (!appended_found))
+		throw std::logic_error("File '" + file_name + "' does not end with the "
+			"appended line.");
+
+	for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1) {
+		if (next_line_list[count_1] != line_count)
+			throw std::logic_error("Expected " + std::to_string(line_count) +
+				" lines from thread " + std::to_string(count_1) + ", but found " +
+				std::to_string(next_line_list[count_1]) + ".");
+	}
+
+	std::cout << "LogHandlerFileMMap: " << (thread_count * line_count) <<
+		" lines from " << thread_count << " threads (" << file_data.size() <<
+		" bytes) with " << stall_count << " writer stalls." << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
 // ////////////////////////////////////////////////////////////////////////////
 int main()
 {
@@ -531,9 +741,9 @@ int main()
 	int return_code = EXIT_SUCCESS;
 
 	try {
-		//	Create a LogHandlerFile...
+		TEST_ConcurrentWriters();
 		LogHandlerPtr my_log_handler(
-			new LogHandlerFileMMap("TestLogFileMMap.VERSION_OLD_001.log"));
+			new LogHandlerFileMMap(TEST_GetLogFileName("LogHandlerFileMMap")));
 		TEST_TestControl(my_log_handler, 10000, 200, 1, 2000000);
 	}
 	catch (const std::exception &except) {
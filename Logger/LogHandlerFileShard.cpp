@@ -0,0 +1,886 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerFileShard.cpp
+
+   File Description  :  Implementation of the per-thread sharded file log
+                        handler and of the merging of the shards.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerFileShard.hpp>
+
+#include <Utility/ThrowErrno.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The state of a thread's shard. Only the owning thread writes records to
+	it; the shard lock is otherwise taken only by the flush thread, by
+	Flush() and when the thread or the handler goes away, so it's almost
+	never contended.
+
+	When its thread exits the shard is released: its file is closed and its
+	buffer freed. It's then claimed by the next thread to log without a
+	shard, so there are only as many shards as threads which have logged
+	concurrently.
+*/
+struct LogHandlerFileShard::Shard {
+	typedef std::chrono::steady_clock MyClock;
+
+	explicit Shard(unsigned int shard_number)
+		:shard_lock_()
+		,shard_number_(shard_number)
+		,file_generation_(0)
+		,file_fd_(-1)
+		,buffer_()
+		,buffer_used_(0)
+		,buffer_time_()
+		,in_use_(false)
+	{
+	}
+
+	~Shard() {
+		Close();
+	}
+
+	bool Open(const std::string &file_name, std::uint64_t file_generation,
+		bool do_not_append) {
+		Close();
+		file_generation_ = file_generation;
+		file_fd_         = ::open(file_name.c_str(), O_WRONLY | O_CREAT |
+			O_APPEND | ((do_not_append) ? O_TRUNC : 0), 0644);
+		return(file_fd_ >= 0);
+	}
+
+	bool Write(struct iovec *iov_list, int iov_count) {
+		while (iov_count) {
+			ssize_t write_count = ::writev(file_fd_, iov_list, iov_count);
+			if (write_count < 0) {
+				if (errno == EINTR)
+					continue;
+				return(false);
+			}
+			std::size_t written = static_cast<std::size_t>(write_count);
+			while (iov_count && (written >= iov_list->iov_len)) {
+				written -= iov_list->iov_len;
+				++iov_list;
+				--iov_count;
+			}
+			if (iov_count) {
+				iov_list->iov_base =
+					static_cast<char *>(iov_list->iov_base) + written;
+				iov_list->iov_len -= written;
+			}
+		}
+		return(true);
+	}
+
+	bool FlushBuffer() {
+		bool write_ok = true;
+		if (buffer_used_ && (file_fd_ >= 0)) {
+			struct iovec iov_list[1];
+			iov_list[0].iov_base = buffer_.data();
+			iov_list[0].iov_len  = buffer_used_;
+			write_ok             = Write(iov_list, 1);
+		}
+		buffer_used_ = 0;
+		return(write_ok);
+	}
+
+	bool Close() {
+		bool write_ok = FlushBuffer();
+		if (file_fd_ >= 0) {
+			::close(file_fd_);
+			file_fd_ = -1;
+		}
+		return(write_ok);
+	}
+
+	bool Claim(const std::string &file_name, std::uint64_t file_generation,
+		std::size_t buffer_size, bool do_not_append) {
+		in_use_ = true;
+		buffer_.resize(buffer_size);
+		return(Open(file_name, file_generation, do_not_append));
+	}
+
+	bool Release() {
+		bool write_ok = Close();
+		std::vector<char>().swap(buffer_);
+		in_use_ = false;
+		return(write_ok);
+	}
+
+	LogLock             shard_lock_;
+	unsigned int        shard_number_;
+	std::uint64_t       file_generation_;
+	int                 file_fd_;
+	std::vector<char>   buffer_;
+	std::size_t         buffer_used_;
+	MyClock::time_point buffer_time_;
+	bool                in_use_;
+
+private:
+	Shard(const Shard &) = delete;
+	Shard & operator = (const Shard &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+std::atomic<std::uint64_t> ShardHandlerSerial(0);
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The shards of the calling thread, by handler serial number. The shards
+	are released when the thread exits.
+*/
+struct ThreadShardCache {
+	typedef std::shared_ptr<LogHandlerFileShard::Shard> ShardPtr;
+	typedef std::pair<std::uint64_t, ShardPtr>          ShardEntry;
+
+	ThreadShardCache()
+		:shard_list_()
+	{
+	}
+
+	~ThreadShardCache();
+
+	std::vector<ShardEntry> shard_list_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Set once the thread's cache has been destroyed, so that lines logged by
+	the destructors of thread-local objects which run after it don't use it.
+	Being trivially destructible it remains valid until the thread exits.
+*/
+thread_local bool             ThreadShardsDestroyed = false;
+thread_local ThreadShardCache ThreadShards;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+ThreadShardCache::~ThreadShardCache()
+{
+	ThreadShardsDestroyed = true;
+
+	for (auto &this_entry : shard_list_) {
+		LogLockScoped my_lock(this_entry.second->shard_lock_);
+		this_entry.second->Release();
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerFileShard::LogHandlerFileShard(const char *file_name,
+	LogHandlerFileBaseFlag flags, const LogFlushPolicy &flush_policy)
+	:LogHandlerFileBase(flags)
+	,handler_serial_(ShardHandlerSerial.fetch_add(1) + 1)
+	,flush_policy_(flush_policy)
+	,file_generation_(0)
+	,write_failure_count_(0)
+	,shard_list_()
+	,flush_stop_(false)
+	,flush_cond_()
+	,flush_thread_()
+{
+	OpenFile(file_name);
+
+	if (flush_policy_.flush_micros_ && flush_policy_.flush_bytes_)
+		flush_thread_ = std::thread(&LogHandlerFileShard::FlushThreadProc, this);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerFileShard::LogHandlerFileShard(const std::string &file_name,
+	LogHandlerFileBaseFlag flags, const LogFlushPolicy &flush_policy)
+	:LogHandlerFileShard(file_name.c_str(), flags, flush_policy)
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerFileShard::~LogHandlerFileShard()
+{
+	{
+		LogLockScoped my_lock(the_lock_);
+		flush_stop_ = true;
+	}
+
+	flush_cond_.notify_all();
+
+	if (flush_thread_.joinable())
+		flush_thread_.join();
+
+	LogLockScoped my_lock(the_lock_);
+
+	for (const auto &this_shard : shard_list_) {
+		LogLockScoped shard_lock(this_shard->shard_lock_);
+		this_shard->Close();
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileShard::EmitLine(const LogEmitControl &emit_control)
+{
+	bool to_console = (!(my_flags_ & NoConsoleOutput)) &&
+		emit_control.ShouldLogScreen();
+
+	if (emit_control.ShouldLogPersistent() || to_console) {
+		emit_control.UpdateTime();
+		if (emit_control.ShouldLogPersistent())
+			EmitLineImpl(emit_control);
+		if (to_console) {
+			LogLockScoped my_lock(the_lock_);
+			std::cout.write(emit_control.GetLeaderPtr(),
+				static_cast<std::streamsize>(emit_control.GetLeaderLength()));
+			std::cout.write(emit_control.line_buffer_.c_str(),
+				static_cast<std::streamsize>(emit_control.line_buffer_.size()));
+			std::cout << std::endl;
+		}
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileShard::EmitLiteral(unsigned int literal_length,
+	const char *literal_string)
+{
+	EmitLiteralImpl(literal_length, literal_string);
+
+	if (!(my_flags_ & NoConsoleOutput)) {
+		LogLockScoped my_lock(the_lock_);
+		std::cout.write(literal_string,
+			static_cast<std::streamsize>(literal_length));
+		std::cout << std::endl;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileShard::EmitLiteral(const LogEmitControl &emit_control,
+	unsigned int literal_length, const char *literal_string)
+{
+	if (emit_control.ShouldLogPersistent())
+		EmitLiteralImpl(literal_length, literal_string);
+
+	if ((!(my_flags_ & NoConsoleOutput)) && emit_control.ShouldLogScreen()) {
+		LogLockScoped my_lock(the_lock_);
+		std::cout.write(literal_string,
+			static_cast<std::streamsize>(literal_length));
+		std::cout << std::endl;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> LogHandlerFileShard::GetShardFileNameList() const
+{
+	LogLockScoped            my_lock(the_lock_);
+	std::vector<std::string> file_name_list;
+
+	for (const auto &this_shard : shard_list_)
+		file_name_list.push_back(GetShardFileName(out_file_name_,
+			this_shard->shard_number_));
+
+	return(file_name_list);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerFileShard::GetWriteFailureCount() const
+{
+	return(write_failure_count_.load(std::memory_order_relaxed));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string LogHandlerFileShard::GetShardFileName(const std::string &file_name,
+	unsigned int shard_number)
+{
+	std::ostringstream o_str;
+
+	o_str << file_name << "." << std::setfill('0') << std::setw(4) <<
+		shard_number;
+
+	return(o_str.str());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileShard::InstallHandlerImpl()
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileShard::RemoveHandlerImpl()
+{
+	FlushImpl();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Existing shards are re-opened under the new name by their threads the
+	next time they log.
+*/
+void LogHandlerFileShard::OpenFileImpl(const char *file_name)
+{
+	std::string   tmp_file_name(file_name);
+	LogLockScoped my_lock(the_lock_);
+
+	out_file_name_.swap(tmp_file_name);
+	file_generation_.fetch_add(1, std::memory_order_release);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Called with the lock held.
+void LogHandlerFileShard::FlushImpl()
+{
+	for (const auto &this_shard : shard_list_) {
+		LogLockScoped shard_lock(this_shard->shard_lock_);
+		if (!this_shard->FlushBuffer())
+			write_failure_count_.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileShard::EmitLineImpl(const LogEmitControl &emit_control)
+{
+	EmitRecord(emit_control.log_level_, emit_control.GetLeaderPtr(),
+		emit_control.GetLeaderLength(), emit_control.line_buffer_.data(),
+		emit_control.line_buffer_.size());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileShard::EmitLiteralImpl(unsigned int literal_length,
+	const char *literal_string)
+{
+	EmitRecord(LogLevel_Literal, literal_string, literal_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Claims a shard released by a thread which has exited, or creates one.
+	Only a new shard is truncated under the DoNotAppend flag, as a released
+	shard's file holds the lines of the threads which used it before.
+*/
+LogHandlerFileShard::ShardPtr LogHandlerFileShard::ClaimShard()
+{
+	LogLockScoped my_lock(the_lock_);
+	ShardPtr      shard_ptr;
+	bool          do_not_append = false;
+
+	for (const auto &this_shard : shard_list_) {
+		LogLockScoped shard_lock(this_shard->shard_lock_);
+		if (!this_shard->in_use_) {
+			shard_ptr = this_shard;
+			break;
+		}
+	}
+
+	if (!shard_ptr) {
+		shard_ptr = std::make_shared<Shard>(
+			static_cast<unsigned int>(shard_list_.size() + 1));
+		shard_list_.push_back(shard_ptr);
+		do_not_append = (my_flags_ & DoNotAppend) != 0;
+	}
+
+	LogLockScoped shard_lock(shard_ptr->shard_lock_);
+
+	if (!shard_ptr->Claim(GetShardFileName(out_file_name_,
+		shard_ptr->shard_number_),
+		file_generation_.load(std::memory_order_acquire),
+		flush_policy_.flush_bytes_, do_not_append))
+		write_failure_count_.fetch_add(1, std::memory_order_relaxed);
+
+	return(shard_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Returns NULL if the calling thread's shard cache has been destroyed.
+LogHandlerFileShard::Shard *LogHandlerFileShard::GetThreadShard()
+{
+	if (ThreadShardsDestroyed)
+		return(NULL);
+
+	ThreadShardCache &thread_shards(ThreadShards);
+
+	for (const auto &this_entry : thread_shards.shard_list_) {
+		if (this_entry.first == handler_serial_)
+			return(this_entry.second.get());
+	}
+
+	//	Drop the shards of handlers which no longer exist...
+	for (auto iter_f = thread_shards.shard_list_.begin();
+		iter_f != thread_shards.shard_list_.end(); ) {
+		if (iter_f->second.use_count() == 1)
+			iter_f = thread_shards.shard_list_.erase(iter_f);
+		else
+			++iter_f;
+	}
+
+	ShardPtr shard_ptr(ClaimShard());
+
+	thread_shards.shard_list_.push_back(std::make_pair(handler_serial_,
+		shard_ptr));
+
+	return(shard_ptr.get());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerFileShard::EmitRecord(LogLevel log_level,
+	const char *data_ptr_1, std::size_t data_length_1, const char *data_ptr_2,
+	std::size_t data_length_2)
+{
+	Shard         *shard_ptr       = GetThreadShard();
+	ShardPtr       orphan_ptr;
+
+	//	A thread which is exiting uses a shard for the one record...
+	if (shard_ptr == NULL) {
+		orphan_ptr = ClaimShard();
+		shard_ptr  = orphan_ptr.get();
+	}
+
+	std::uint64_t  file_generation =
+		file_generation_.load(std::memory_order_acquire);
+	std::string    new_file_name;
+
+	//	The handler lock is never taken while holding a shard lock...
+	if (shard_ptr->file_generation_ != file_generation) {
+		LogLockScoped my_lock(the_lock_);
+		new_file_name   = GetShardFileName(out_file_name_,
+			shard_ptr->shard_number_);
+		file_generation = file_generation_.load(std::memory_order_acquire);
+	}
+
+	LogLockScoped shard_lock(shard_ptr->shard_lock_);
+	bool          write_ok = true;
+
+	if ((!new_file_name.empty()) && (!shard_ptr->Open(new_file_name,
+		file_generation, (my_flags_ & DoNotAppend) != 0)))
+		write_ok = false;
+	else if (shard_ptr->file_fd_ >= 0) {
+		std::size_t record_length = data_length_1 + data_length_2 + 1;
+		if ((shard_ptr->buffer_used_ + record_length) <=
+			shard_ptr->buffer_.size()) {
+			char *buffer_ptr = shard_ptr->buffer_.data() + shard_ptr->buffer_used_;
+			::memcpy(buffer_ptr, data_ptr_1, data_length_1);
+			if (data_length_2)
+				::memcpy(buffer_ptr + data_length_1, data_ptr_2, data_length_2);
+			buffer_ptr[data_length_1 + data_length_2] = '\n';
+			if (!shard_ptr->buffer_used_)
+				shard_ptr->buffer_time_ = Shard::MyClock::now();
+			shard_ptr->buffer_used_ += record_length;
+			if ((log_level >= flush_policy_.flush_level_) ||
+				(log_level >= LogLevel_Fatal))
+				write_ok = shard_ptr->FlushBuffer();
+		}
+		else {
+			//	Write the buffer and the record in one call without copying it...
+			struct iovec iov_list[4];
+			int          iov_count = 0;
+			if (shard_ptr->buffer_used_) {
+				iov_list[iov_count].iov_base  = shard_ptr->buffer_.data();
+				iov_list[iov_count++].iov_len = shard_ptr->buffer_used_;
+			}
+			iov_list[iov_count].iov_base  = const_cast<char *>(data_ptr_1);
+			iov_list[iov_count++].iov_len = data_length_1;
+			if (data_length_2) {
+				iov_list[iov_count].iov_base  = const_cast<char *>(data_ptr_2);
+				iov_list[iov_count++].iov_len = data_length_2;
+			}
+			iov_list[iov_count].iov_base  = const_cast<char *>("\n");
+			iov_list[iov_count++].iov_len = 1;
+			write_ok                 = shard_ptr->Write(iov_list, iov_count);
+			shard_ptr->buffer_used_  = 0;
+		}
+	}
+
+	if (orphan_ptr && (!shard_ptr->Release()))
+		write_ok = false;
+
+	if (!write_ok)
+		write_failure_count_.fetch_add(1, std::memory_order_relaxed);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Writes the shards which have been held for the flush interval.
+*/
+void LogHandlerFileShard::FlushThreadProc()
+{
+	std::chrono::microseconds flush_interval(flush_policy_.flush_micros_);
+	std::unique_lock<LogLock> my_lock(the_lock_);
+
+	while (!flush_stop_) {
+		flush_cond_.wait_for(my_lock, flush_interval);
+		Shard::MyClock::time_point flush_time =
+			Shard::MyClock::now() - flush_interval;
+		for (const auto &this_shard : shard_list_) {
+			LogLockScoped shard_lock(this_shard->shard_lock_);
+			if (this_shard->buffer_used_ &&
+				(this_shard->buffer_time_ <= flush_time) &&
+				(!this_shard->FlushBuffer()))
+				write_failure_count_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Matches the "YYYY-MM-DD HH:MM:SS.nnnnnnnnn" which begins a line leader.
+bool HasTimeLeader(const std::string &in_line)
+{
+	static const char *Pattern = "9999-99-99 99:99:99.999999999";
+
+	if (in_line.size() < Length_TimeSpec)
+		return(false);
+
+	for (std::size_t count_1 = 0; count_1 < Length_TimeSpec; ++count_1) {
+		if (Pattern[count_1] == '9') {
+			if ((in_line[count_1] < '0') || (in_line[count_1] > '9'))
+				return(false);
+		}
+		else if (in_line[count_1] != Pattern[count_1])
+			return(false);
+	}
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Reads one record from a shard: a line with a leader followed by any
+	lines without one.
+*/
+class ShardReader {
+public:
+	explicit ShardReader(const std::string &file_name)
+		:in_file_(file_name.c_str(), std::ios_base::in | std::ios_base::binary)
+		,time_key_()
+		,record_()
+		,line_count_(0)
+		,next_line_()
+		,next_valid_(false)
+	{
+		if (!in_file_)
+			throw std::runtime_error("Unable to open log shard '" + file_name +
+				"'.");
+
+		next_valid_ = static_cast<bool>(std::getline(in_file_, next_line_));
+	}
+
+	bool ReadRecord() {
+		if (!next_valid_)
+			return(false);
+		if (HasTimeLeader(next_line_))
+			time_key_.assign(next_line_, 0, Length_TimeSpec);
+		record_.swap(next_line_);
+		record_    += '\n';
+		line_count_ = 1;
+		while ((next_valid_ = static_cast<bool>(
+			std::getline(in_file_, next_line_))) && (!HasTimeLeader(next_line_))) {
+			record_ += next_line_;
+			record_ += '\n';
+			++line_count_;
+		}
+		return(true);
+	}
+
+	std::ifstream in_file_;
+	std::string   time_key_;
+	std::string   record_;
+	std::size_t   line_count_;
+
+private:
+	std::string   next_line_;
+	bool          next_valid_;
+
+	ShardReader(const ShardReader &) = delete;
+	ShardReader & operator = (const ShardReader &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogShardMerge(const std::vector<std::string> &file_name_list,
+	std::ostream &out_stream)
+{
+	typedef std::unique_ptr<ShardReader> ShardReaderPtr;
+	typedef std::pair<std::string, std::size_t> MergeKey;
+
+	std::vector<ShardReaderPtr> reader_list;
+	std::priority_queue<MergeKey, std::vector<MergeKey>,
+		std::greater<MergeKey> > merge_queue;
+	std::size_t                 line_count = 0;
+
+	for (const auto &this_file_name : file_name_list) {
+		reader_list.emplace_back(new ShardReader(this_file_name));
+		if (reader_list.back()->ReadRecord())
+			merge_queue.push(MergeKey(reader_list.back()->time_key_,
+				reader_list.size() - 1));
+	}
+
+	while (!merge_queue.empty()) {
+		ShardReader &this_reader(*reader_list[merge_queue.top().second]);
+		std::size_t  reader_index = merge_queue.top().second;
+		merge_queue.pop();
+		out_stream.write(this_reader.record_.data(),
+			static_cast<std::streamsize>(this_reader.record_.size()));
+		line_count += this_reader.line_count_;
+		if (this_reader.ReadRecord())
+			merge_queue.push(MergeKey(this_reader.time_key_, reader_index));
+	}
+
+	return(line_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogManager.hpp>
+#include <Logger/LogTestSupport.hpp>
+
+#include <cstdio>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_ShardAndMerge()
+{
+	using namespace MLB::Utility;
+
+	const unsigned int thread_count = 4;
+	const unsigned int line_count   = 2000;
+	std::string        file_name(TEST_GetLogFileName("LogHandlerFileShard"));
+
+	LogSPtr<LogHandlerFileShard> handler_ptr(new LogHandlerFileShard(
+		file_name, static_cast<LogHandlerFileBase::LogHandlerFileBaseFlag>(
+		LogHandlerFileBase::DoNotAppend | LogHandlerFileBase::NoConsoleOutput)));
+	LogManager                   log_manager(handler_ptr);
+	LogStream                    log_info(log_manager, LogLevel_Info);
+	std::atomic<unsigned int>    done_count(0);
+	std::vector<std::thread>     thread_list;
+
+	//	The threads exit together, so that none re-uses another's shard...
+	for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1)
+		thread_list.emplace_back([&log_info, &done_count, count_1,
+			line_count]() {
+			for (unsigned int count_2 = 0; count_2 < line_count; ++count_2)
+				log_info << "Thread " << count_1 << " line " << count_2 <<
+					std::endl;
+			log_info.LogLiteral("Literal after the last line.");
+			++done_count;
+			while (done_count.load() < thread_count)
+				std::this_thread::yield();
+		});
+
+	for (auto &this_thread : thread_list)
+		this_thread.join();
+
+	std::vector<std::string> shard_list(handler_ptr->GetShardFileNameList());
+
+	if (shard_list.size() != thread_count)
+		throw std::logic_error("Expected " + std::to_string(thread_count) +
+			" shards, but " + std::to_string(shard_list.size()) +
+			" were created.");
+
+	std::ostringstream merge_stream;
+	std::size_t        merge_count = LogShardMerge(shard_list, merge_stream);
+
+	if (merge_count != (thread_count * (line_count + 1)))
+		throw std::logic_error("Expected " +
+			std::to_string(thread_count * (line_count + 1)) + " merged lines, "
+			"but " + std::to_string(merge_count) + " were written.");
+
+	std::istringstream in_stream(merge_stream.str());
+	std::string        in_line;
+	std::string        last_time;
+	std::size_t        literal_count = 0;
+
+	while (std::getline(in_stream, in_line)) {
+		if (in_line.compare(0, 7, "Literal") == 0) {
+			++literal_count;
+			continue;
+		}
+		std::string this_time(in_line.substr(0, Length_TimeSpec));
+		if (this_time < last_time)
+			throw std::logic_error("Merged lines are out of time order at '" +
+				in_line + "'.");
+		last_time.swap(this_time);
+	}
+
+	if (literal_count != thread_count)
+		throw std::logic_error("Expected " + std::to_string(thread_count) +
+			" literals in the merged output, but found " +
+			std::to_string(literal_count) + ".");
+
+	log_manager.HandlerRemove();
+	handler_ptr.reset();
+
+	for (const auto &this_shard : shard_list)
+		::remove(this_shard.c_str());
+
+	std::cout << "Merged " << merge_count << " lines from " <<
+		shard_list.size() << " shards." << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Logs a line when the thread exits. Constructed before the thread first
+	logs, it's destroyed after the thread's shard cache.
+*/
+struct TEST_ExitLogger {
+	~TEST_ExitLogger() {
+		if (log_stream_ptr_ != NULL)
+			(*log_stream_ptr_) << "Line logged at thread exit." << std::endl;
+	}
+
+	MLB::Utility::LogStream *log_stream_ptr_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+thread_local TEST_ExitLogger TEST_ThreadExitLogger;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Threads which log one after another must share a single shard, and the
+	lines they log after their shard caches are destroyed must be written.
+*/
+void TEST_ThreadChurn()
+{
+	using namespace MLB::Utility;
+
+	const unsigned int thread_count = 50;
+	const unsigned int line_count   = 100;
+	std::string        file_name(TEST_GetLogFileName(
+		"LogHandlerFileShard.Churn"));
+
+	LogSPtr<LogHandlerFileShard> handler_ptr(new LogHandlerFileShard(
+		file_name, static_cast<LogHandlerFileBase::LogHandlerFileBaseFlag>(
+		LogHandlerFileBase::DoNotAppend | LogHandlerFileBase::NoConsoleOutput)));
+	LogManager                   log_manager(handler_ptr);
+	LogStream                    log_info(log_manager, LogLevel_Info);
+
+	for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1)
+		std::thread([&log_info, count_1, line_count]() {
+			TEST_ThreadExitLogger.log_stream_ptr_ = &log_info;
+			for (unsigned int count_2 = 0; count_2 < line_count; ++count_2)
+				log_info << "Thread " << count_1 << " line " << count_2 <<
+					std::endl;
+		}).join();
+
+	std::vector<std::string> shard_list(handler_ptr->GetShardFileNameList());
+
+	if (shard_list.size() != 1)
+		throw std::logic_error("Expected the threads to share one shard, but " +
+			std::to_string(shard_list.size()) + " were created.");
+
+	log_manager.HandlerRemove();
+
+	std::ostringstream merge_stream;
+	std::size_t        merge_count = LogShardMerge(shard_list, merge_stream);
+
+	if (merge_count != (thread_count * (line_count + 1)))
+		throw std::logic_error("Expected " +
+			std::to_string(thread_count * (line_count + 1)) + " lines from "
+			"the shared shard, but " + std::to_string(merge_count) +
+			" were written.");
+
+	if (handler_ptr->GetWriteFailureCount())
+		throw std::logic_error("Expected no write failures, but " +
+			std::to_string(handler_ptr->GetWriteFailureCount()) +
+			" were counted.");
+
+	handler_ptr.reset();
+
+	for (const auto &this_shard : shard_list)
+		::remove(this_shard.c_str());
+
+	std::cout << "Wrote " << merge_count << " lines from " << thread_count <<
+		" threads to " << shard_list.size() << " shard." << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_ShardAndMerge();
+		TEST_ThreadChurn();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
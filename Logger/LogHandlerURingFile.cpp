@@ -0,0 +1,996 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerURingFile.cpp
+
+   File Description  :  Implementation of the io_uring file log handler.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerURingFile.hpp>
+
+#include <Utility/PageSize.hpp>
+#include <Utility/ThrowErrno.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+//	The user data of the completion of a sync operation.
+const std::uint64_t SyncUserData = ~static_cast<std::uint64_t>(0);
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+int URingSetup(unsigned int entries, struct io_uring_params *params_ptr)
+{
+	return(static_cast<int>(::syscall(__NR_io_uring_setup, entries,
+		params_ptr)));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+int URingEnter(int ring_fd, unsigned int to_submit, unsigned int min_complete,
+	unsigned int flags)
+{
+	return(static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit,
+		min_complete, flags, NULL, 0)));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+int URingRegister(int ring_fd, unsigned int op_code, const void *arg_ptr,
+	unsigned int arg_count)
+{
+	return(static_cast<int>(::syscall(__NR_io_uring_register, ring_fd,
+		op_code, arg_ptr, arg_count)));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	The ring indices are shared with the kernel.
+unsigned int LoadAcquire(unsigned int *index_ptr)
+{
+	return(std::atomic_ref<unsigned int>(*index_ptr).load(
+		std::memory_order_acquire));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void StoreRelease(unsigned int *index_ptr, unsigned int index_value)
+{
+	std::atomic_ref<unsigned int>(*index_ptr).store(index_value,
+		std::memory_order_release);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Writes the data synchronously. Returns false if it could not be written.
+bool WriteAt(int file_fd, const char *data_ptr, std::size_t data_length,
+	std::uint64_t file_offset)
+{
+	while (data_length) {
+		ssize_t write_count = ::pwrite(file_fd, data_ptr, data_length,
+			static_cast<off_t>(file_offset));
+		if (write_count < 0) {
+			if (errno == EINTR)
+				continue;
+			return(false);
+		}
+		data_ptr    += write_count;
+		data_length -= static_cast<std::size_t>(write_count);
+		file_offset += static_cast<std::uint64_t>(write_count);
+	}
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void SyncFile(int file_fd, LogURingSync sync_mode)
+{
+	if (sync_mode == LogURingSync_FDataSync)
+		::fdatasync(file_fd);
+	else if (sync_mode == LogURingSync_FSync)
+		::fsync(file_fd);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The submission and completion rings mapped from the kernel, and the
+	buffers registered with it.
+*/
+struct LogHandlerURingFile::Ring {
+	Ring(unsigned int entries, std::size_t buffer_bytes,
+		unsigned int buffer_count);
+	~Ring();
+
+	int                  ring_fd_;
+	void                *sq_ring_ptr_;
+	std::size_t          sq_ring_size_;
+	void                *cq_ring_ptr_;
+	std::size_t          cq_ring_size_;
+	struct io_uring_sqe *sqe_list_;
+	std::size_t          sqe_list_size_;
+	unsigned int        *sq_head_;
+	unsigned int        *sq_tail_;
+	unsigned int        *sq_mask_;
+	unsigned int        *sq_array_;
+	unsigned int         sq_entries_;
+	unsigned int        *cq_head_;
+	unsigned int        *cq_tail_;
+	unsigned int        *cq_mask_;
+	struct io_uring_cqe *cqe_list_;
+	char                *buffer_ptr_;
+	bool                 fixed_buffer_flag_;
+	unsigned int         unsubmitted_count_;
+
+	void Enter(unsigned int min_complete);
+
+private:
+	void Destroy();
+
+	Ring(const Ring &) = delete;
+	Ring & operator = (const Ring &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerURingFile::Ring::Ring(unsigned int entries,
+	std::size_t buffer_bytes, unsigned int buffer_count)
+	:ring_fd_(-1)
+	,sq_ring_ptr_(MAP_FAILED)
+	,sq_ring_size_(0)
+	,cq_ring_ptr_(MAP_FAILED)
+	,cq_ring_size_(0)
+	,sqe_list_(NULL)
+	,sqe_list_size_(0)
+	,sq_head_(NULL)
+	,sq_tail_(NULL)
+	,sq_mask_(NULL)
+	,sq_array_(NULL)
+	,sq_entries_(0)
+	,cq_head_(NULL)
+	,cq_tail_(NULL)
+	,cq_mask_(NULL)
+	,cqe_list_(NULL)
+	,buffer_ptr_(NULL)
+	,fixed_buffer_flag_(false)
+	,unsubmitted_count_(0)
+{
+	struct io_uring_params params;
+
+	::memset(&params, '\0', sizeof(params));
+
+	try {
+		if ((ring_fd_ = URingSetup(entries, &params)) < 0)
+			ThrowErrno("Attempt to create an io_uring instance failed");
+		sq_ring_size_ = params.sq_off.array +
+			(params.sq_entries * sizeof(unsigned int));
+		cq_ring_size_ = params.cq_off.cqes +
+			(params.cq_entries * sizeof(struct io_uring_cqe));
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+			sq_ring_size_ = cq_ring_size_ =
+				std::max(sq_ring_size_, cq_ring_size_);
+		if ((sq_ring_ptr_ = ::mmap(NULL, sq_ring_size_, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING)) ==
+			MAP_FAILED)
+			ThrowErrno("Attempt to map the io_uring submission ring failed");
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+			cq_ring_ptr_ = sq_ring_ptr_;
+		else if ((cq_ring_ptr_ = ::mmap(NULL, cq_ring_size_,
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+			IORING_OFF_CQ_RING)) == MAP_FAILED)
+			ThrowErrno("Attempt to map the io_uring completion ring failed");
+		sqe_list_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+		void *sqe_ptr = ::mmap(NULL, sqe_list_size_, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+		if (sqe_ptr == MAP_FAILED)
+			ThrowErrno("Attempt to map the io_uring submission entries failed");
+		sqe_list_   = static_cast<struct io_uring_sqe *>(sqe_ptr);
+		char *sq_ptr = static_cast<char *>(sq_ring_ptr_);
+		char *cq_ptr = static_cast<char *>(cq_ring_ptr_);
+		sq_head_    = reinterpret_cast<unsigned int *>(sq_ptr +
+			params.sq_off.head);
+		sq_tail_    = reinterpret_cast<unsigned int *>(sq_ptr +
+			params.sq_off.tail);
+		sq_mask_    = reinterpret_cast<unsigned int *>(sq_ptr +
+			params.sq_off.ring_mask);
+		sq_array_   = reinterpret_cast<unsigned int *>(sq_ptr +
+			params.sq_off.array);
+		sq_entries_ = params.sq_entries;
+		cq_head_    = reinterpret_cast<unsigned int *>(cq_ptr +
+			params.cq_off.head);
+		cq_tail_    = reinterpret_cast<unsigned int *>(cq_ptr +
+			params.cq_off.tail);
+		cq_mask_    = reinterpret_cast<unsigned int *>(cq_ptr +
+			params.cq_off.ring_mask);
+		cqe_list_   = reinterpret_cast<struct io_uring_cqe *>(cq_ptr +
+			params.cq_off.cqes);
+		void *buffer_ptr = NULL;
+		if (::posix_memalign(&buffer_ptr, GetPageSize(),
+			buffer_bytes * buffer_count))
+			throw std::bad_alloc();
+		buffer_ptr_ = static_cast<char *>(buffer_ptr);
+		//	Registered buffers count against RLIMIT_MEMLOCK; do without them...
+		std::vector<struct iovec> iov_list(buffer_count);
+		for (unsigned int count_1 = 0; count_1 < buffer_count; ++count_1) {
+			iov_list[count_1].iov_base = buffer_ptr_ + (count_1 * buffer_bytes);
+			iov_list[count_1].iov_len  = buffer_bytes;
+		}
+		fixed_buffer_flag_ = (URingRegister(ring_fd_, IORING_REGISTER_BUFFERS,
+			iov_list.data(), buffer_count) == 0);
+	}
+	catch (const std::exception &) {
+		Destroy();
+		throw;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerURingFile::Ring::~Ring()
+{
+	Destroy();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Submits the entries which the kernel hasn't yet consumed and waits for at
+	least the specified number of completions.
+*/
+void LogHandlerURingFile::Ring::Enter(unsigned int min_complete)
+{
+	for ( ; ; ) {
+		int submit_count = URingEnter(ring_fd_, unsubmitted_count_,
+			min_complete, (min_complete) ? IORING_ENTER_GETEVENTS : 0);
+		if (submit_count >= 0) {
+			unsubmitted_count_ -= std::min(unsubmitted_count_,
+				static_cast<unsigned int>(submit_count));
+			break;
+		}
+		if ((errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY))
+			ThrowErrno("Attempt to submit to an io_uring instance failed");
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerURingFile::Ring::Destroy()
+{
+	if (sqe_list_ != NULL)
+		::munmap(sqe_list_, sqe_list_size_);
+
+	if ((cq_ring_ptr_ != MAP_FAILED) && (cq_ring_ptr_ != sq_ring_ptr_))
+		::munmap(cq_ring_ptr_, cq_ring_size_);
+
+	if (sq_ring_ptr_ != MAP_FAILED)
+		::munmap(sq_ring_ptr_, sq_ring_size_);
+
+	//	Closing the ring also unregisters the buffers and files...
+	if (ring_fd_ >= 0)
+		::close(ring_fd_);
+
+	::free(buffer_ptr_);
+
+	sqe_list_    = NULL;
+	cq_ring_ptr_ = MAP_FAILED;
+	sq_ring_ptr_ = MAP_FAILED;
+	ring_fd_     = -1;
+	buffer_ptr_  = NULL;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerURingFile::Slot::Slot()
+	:buffer_ptr_(NULL)
+	,data_length_(0)
+	,file_offset_(0)
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerURingFile::LogHandlerURingFile(const char *file_name,
+	LogHandlerFileBaseFlag flags, const LogFlushPolicy &flush_policy,
+	LogURingSync sync_mode, unsigned int buffer_count)
+	:LogHandlerXFile(file_name, flags, flush_policy)
+	,sync_mode_(sync_mode)
+	,ring_ptr_()
+	,slot_list_()
+	,free_slot_list_()
+	,in_flight_count_(0)
+	,source_fd_(-1)
+	,writer_fd_(-1)
+	,fixed_file_flag_(false)
+	,file_offset_(0)
+	,submit_count_(0)
+	,buffer_wait_count_(0)
+	,completion_failure_count_(0)
+{
+	CreateRing(buffer_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogHandlerURingFile::LogHandlerURingFile(const std::string &file_name,
+	LogHandlerFileBaseFlag flags, const LogFlushPolicy &flush_policy,
+	LogURingSync sync_mode, unsigned int buffer_count)
+	:LogHandlerXFile(file_name, flags, flush_policy)
+	,sync_mode_(sync_mode)
+	,ring_ptr_()
+	,slot_list_()
+	,free_slot_list_()
+	,in_flight_count_(0)
+	,source_fd_(-1)
+	,writer_fd_(-1)
+	,fixed_file_flag_(false)
+	,file_offset_(0)
+	,submit_count_(0)
+	,buffer_wait_count_(0)
+	,completion_failure_count_(0)
+{
+	CreateRing(buffer_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The flush thread is stopped before anything else, as it calls the
+	WriteOut() override. The batch is then written and the ring torn down
+	here so that the LogHandlerXFile destructor finds nothing in flight.
+*/
+LogHandlerURingFile::~LogHandlerURingFile()
+{
+	StopFlushThread();
+
+	LogLockScoped my_lock(the_lock_);
+
+	try {
+		LogHandlerXFile::FlushImpl();
+		DetachFile();
+	}
+	catch (const std::exception &) {
+	}
+
+	ring_ptr_.reset();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogHandlerURingFile::IsURingActive() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(ring_ptr_ != NULL);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerURingFile::GetSubmitCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(submit_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerURingFile::GetBufferWaitCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(buffer_wait_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::uint64_t LogHandlerURingFile::GetCompletionFailureCount() const
+{
+	LogLockScoped my_lock(the_lock_);
+
+	return(completion_failure_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerURingFile::FlushImpl()
+{
+	LogHandlerXFile::FlushImpl();
+
+	if ((ring_ptr_ == NULL) || (writer_fd_ < 0)) {
+		if (file_fd_ >= 0)
+			SyncFile(file_fd_, sync_mode_);
+		return;
+	}
+
+	//	IOSQE_IO_DRAIN starts the sync once the preceding writes complete...
+	if (sync_mode_ != LogURingSync_None)
+		Submit(IORING_OP_FSYNC, 0, IOSQE_IO_DRAIN,
+			(sync_mode_ == LogURingSync_FDataSync) ? IORING_FSYNC_DATASYNC : 0);
+
+	WaitForAll();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerURingFile::EmitLineImpl(const LogEmitControl &emit_control)
+{
+	LogHandlerXFile::EmitLineImpl(emit_control);
+
+	//	A fatal line must be on the file before EmitLine() returns...
+	if ((emit_control.log_level_ >= LogLevel_Fatal) && (ring_ptr_ != NULL))
+		WaitForAll();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Copies the data to the free buffers and submits a write for each. Waits
+	only when all of the buffers are in flight.
+*/
+bool LogHandlerURingFile::WriteOut(struct iovec *iov_list, int iov_count)
+{
+	if (ring_ptr_ == NULL)
+		return(LogHandlerXFile::WriteOut(iov_list, iov_count));
+
+	if (file_fd_ != source_fd_)
+		AttachFile();
+
+	if (writer_fd_ < 0)
+		return(LogHandlerXFile::WriteOut(iov_list, iov_count));
+
+	const char  *data_ptr    = NULL;
+	std::size_t  data_length = 0;
+	Slot        *slot_ptr    = NULL;
+	unsigned int slot_index  = 0;
+
+	for ( ; ; ) {
+		if (!data_length) {
+			if (!iov_count)
+				break;
+			data_ptr    = static_cast<const char *>(iov_list->iov_base);
+			data_length = iov_list->iov_len;
+			++iov_list;
+			--iov_count;
+			continue;
+		}
+		if (slot_ptr == NULL) {
+			if (free_slot_list_.empty()) {
+				++buffer_wait_count_;
+				while (free_slot_list_.empty())
+					Reap(1);
+			}
+			slot_index = free_slot_list_.back();
+			free_slot_list_.pop_back();
+			slot_ptr   = &slot_list_[slot_index];
+			slot_ptr->data_length_ = 0;
+		}
+		std::size_t copy_length = std::min(data_length,
+			DefaultBufferBytes - slot_ptr->data_length_);
+		::memcpy(slot_ptr->buffer_ptr_ + slot_ptr->data_length_, data_ptr,
+			copy_length);
+		slot_ptr->data_length_ += copy_length;
+		data_ptr               += copy_length;
+		data_length            -= copy_length;
+		if (slot_ptr->data_length_ == DefaultBufferBytes) {
+			Submit(IORING_OP_WRITE_FIXED, slot_index);
+			slot_ptr = NULL;
+		}
+	}
+
+	if (slot_ptr != NULL)
+		Submit(IORING_OP_WRITE_FIXED, slot_index);
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogHandlerURingFile::WaitForWrites()
+{
+	DetachFile();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Called from the constructors. The handler is usable if this fails.
+void LogHandlerURingFile::CreateRing(unsigned int buffer_count)
+{
+	if (!buffer_count)
+		return;
+
+	try {
+		//	One more entry for the sync operation...
+		ring_ptr_.reset(new Ring(buffer_count + 1, DefaultBufferBytes,
+			buffer_count));
+		slot_list_.resize(buffer_count);
+		for (unsigned int count_1 = 0; count_1 < buffer_count; ++count_1) {
+			slot_list_[count_1].buffer_ptr_ = ring_ptr_->buffer_ptr_ +
+				(count_1 * DefaultBufferBytes);
+			free_slot_list_.push_back(buffer_count - count_1 - 1);
+		}
+	}
+	catch (const std::exception &) {
+		ring_ptr_.reset();
+		slot_list_.clear();
+		free_slot_list_.clear();
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Called with the lock held and nothing in flight when the file descriptor
+	of the LogHandlerXFile has changed.
+
+	The writes are made at explicit offsets so that their order in the file
+	doesn't depend upon the order in which they complete. This requires a
+	descriptor opened without O_APPEND. If it can't be opened the writes for
+	this file are made with writev() by LogHandlerXFile.
+*/
+void LogHandlerURingFile::AttachFile()
+{
+	DetachFile();
+
+	source_fd_ = file_fd_;
+
+	if (file_fd_ < 0)
+		return;
+
+	struct stat source_stat;
+	struct stat writer_stat;
+	int         writer_fd = ::open(out_file_name_.c_str(),
+		O_WRONLY | O_CLOEXEC);
+
+	if (writer_fd < 0)
+		return;
+
+	if (::fstat(file_fd_, &source_stat) || ::fstat(writer_fd, &writer_stat) ||
+		(source_stat.st_dev != writer_stat.st_dev) ||
+		(source_stat.st_ino != writer_stat.st_ino)) {
+		::close(writer_fd);
+		return;
+	}
+
+	writer_fd_       = writer_fd;
+	file_offset_     = static_cast<std::uint64_t>(writer_stat.st_size);
+	fixed_file_flag_ = (URingRegister(ring_ptr_->ring_fd_,
+		IORING_REGISTER_FILES, &writer_fd_, 1) == 0);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Called with the lock held.
+void LogHandlerURingFile::DetachFile()
+{
+	if (ring_ptr_ == NULL)
+		return;
+
+	WaitForAll();
+
+	if (fixed_file_flag_) {
+		URingRegister(ring_ptr_->ring_fd_, IORING_UNREGISTER_FILES, NULL, 0);
+		fixed_file_flag_ = false;
+	}
+
+	if (writer_fd_ >= 0) {
+		::close(writer_fd_);
+		writer_fd_ = -1;
+	}
+
+	source_fd_ = -1;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Adds a write of the specified slot or a sync (IORING_OP_FSYNC) to the
+	submission ring and submits it.
+*/
+void LogHandlerURingFile::Submit(unsigned char op_code,
+	unsigned int slot_index, unsigned char sqe_flags, unsigned int op_flags)
+{
+	Ring                &ring_ref = *ring_ptr_;
+	unsigned int         sq_tail  = *ring_ref.sq_tail_;
+	unsigned int         sq_index = sq_tail & *ring_ref.sq_mask_;
+	struct io_uring_sqe *sqe_ptr  = ring_ref.sqe_list_ + sq_index;
+
+	::memset(sqe_ptr, '\0', sizeof(*sqe_ptr));
+
+	sqe_ptr->flags = sqe_flags;
+
+	if (fixed_file_flag_) {
+		sqe_ptr->fd     = 0;
+		sqe_ptr->flags |= IOSQE_FIXED_FILE;
+	}
+	else
+		sqe_ptr->fd     = writer_fd_;
+
+	if (op_code == IORING_OP_FSYNC) {
+		sqe_ptr->opcode      = IORING_OP_FSYNC;
+		sqe_ptr->fsync_flags = op_flags;
+		sqe_ptr->user_data   = SyncUserData;
+	}
+	else {
+		Slot &slot_ref = slot_list_[slot_index];
+		slot_ref.file_offset_ = file_offset_;
+		file_offset_         += slot_ref.data_length_;
+		sqe_ptr->addr         = reinterpret_cast<std::uintptr_t>(
+			slot_ref.buffer_ptr_);
+		sqe_ptr->len          = static_cast<std::uint32_t>(
+			slot_ref.data_length_);
+		sqe_ptr->off          = slot_ref.file_offset_;
+		sqe_ptr->user_data    = slot_index;
+		if (ring_ref.fixed_buffer_flag_) {
+			sqe_ptr->opcode    = IORING_OP_WRITE_FIXED;
+			sqe_ptr->buf_index = static_cast<std::uint16_t>(slot_index);
+		}
+		else
+			sqe_ptr->opcode    = IORING_OP_WRITE;
+	}
+
+	ring_ref.sq_array_[sq_index] = sq_index;
+
+	StoreRelease(ring_ref.sq_tail_, sq_tail + 1);
+
+	++ring_ref.unsubmitted_count_;
+	++in_flight_count_;
+	++submit_count_;
+
+	try {
+		ring_ref.Enter(0);
+	}
+	catch (const std::exception &) {
+		//	The entry remains in the ring and is submitted by the next call.
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Processes the available completions after waiting for wait_count of them.
+void LogHandlerURingFile::Reap(unsigned int wait_count)
+{
+	Ring         &ring_ref = *ring_ptr_;
+	unsigned int  cq_head  = *ring_ref.cq_head_;
+
+	if ((cq_head == LoadAcquire(ring_ref.cq_tail_)) &&
+		(wait_count || ring_ref.unsubmitted_count_))
+		ring_ref.Enter(wait_count);
+
+	unsigned int cq_tail = LoadAcquire(ring_ref.cq_tail_);
+
+	while (cq_head != cq_tail) {
+		const struct io_uring_cqe &cqe_ref =
+			ring_ref.cqe_list_[cq_head & *ring_ref.cq_mask_];
+		std::uint64_t user_data = cqe_ref.user_data;
+		int           result    = cqe_ref.res;
+		StoreRelease(ring_ref.cq_head_, ++cq_head);
+		Complete(user_data, result);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	A write which failed or was only partially made is completed
+	synchronously.
+*/
+void LogHandlerURingFile::Complete(std::uint64_t user_data, int result)
+{
+	--in_flight_count_;
+
+	if (user_data == SyncUserData) {
+		if (result < 0) {
+			++completion_failure_count_;
+			SyncFile(writer_fd_, sync_mode_);
+		}
+		return;
+	}
+
+	Slot        &slot_ref = slot_list_[static_cast<std::size_t>(user_data)];
+	std::size_t  written  = (result < 0) ? 0 : static_cast<std::size_t>(result);
+
+	if (written < slot_ref.data_length_) {
+		++completion_failure_count_;
+		WriteAt(writer_fd_, slot_ref.buffer_ptr_ + written,
+			slot_ref.data_length_ - written, slot_ref.file_offset_ + written);
+	}
+
+	free_slot_list_.push_back(static_cast<unsigned int>(user_data));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Called with the lock held.
+void LogHandlerURingFile::WaitForAll()
+{
+	while (in_flight_count_)
+		Reap(1);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogHandlerURingFile.hpp>
+#include <Logger/LogManager.hpp>
+#include <Logger/LogTestSupport.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+#include <zlib.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+LogManagerMacroDeclaration(MB_LIB_LOCAL)
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string TEST_ReadFile(const std::string &file_name)
+{
+	std::string file_data;
+	gzFile      in_file = ::gzopen(file_name.c_str(), "rb");
+
+	if (in_file == NULL)
+		throw std::runtime_error("Unable to open file '" + file_name + "'.");
+
+	char buffer[65536];
+	int  read_count;
+
+	while ((read_count = ::gzread(in_file, buffer, sizeof(buffer))) > 0)
+		file_data.append(buffer, static_cast<std::size_t>(read_count));
+
+	::gzclose(in_file);
+
+	return(file_data);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Each line reads "URing line <thread> <line>". Every line of every thread
+	must appear exactly once, in order, and unbroken.
+*/
+void TEST_CheckLines(const std::vector<std::string> &file_list,
+	unsigned int thread_count, unsigned int line_count)
+{
+	std::vector<unsigned int> next_line_list(thread_count, 0);
+
+	for (const auto &this_file : file_list) {
+		std::istringstream in_stream(TEST_ReadFile(this_file));
+		std::string        this_line;
+		while (std::getline(in_stream, this_line)) {
+			std::string::size_type found_pos = this_line.find("URing line ");
+			unsigned int           thread_index;
+			unsigned int           line_index;
+			if ((found_pos != MLB::Utility::LogLineLeaderLength) ||
+				(::sscanf(this_line.c_str() + found_pos, "URing line %u %u",
+				&thread_index, &line_index) != 2) ||
+				(thread_index >= thread_count) ||
+				(line_index != next_line_list[thread_index]))
+				throw std::logic_error("Line '" + this_line + "' in file '" +
+					this_file + "' is malformed or out of order.");
+			++next_line_list[thread_index];
+		}
+	}
+
+	for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1) {
+		if (next_line_list[count_1] != line_count)
+			throw std::logic_error("Expected " + std::to_string(line_count) +
+				" lines from thread " + std::to_string(count_1) + ", but found " +
+				std::to_string(next_line_list[count_1]) + ".");
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Small batches from several threads keep many writes in flight.
+*/
+void TEST_InFlight(unsigned int buffer_count)
+{
+	using namespace MLB::Utility;
+
+	const unsigned int thread_count = 4;
+	const unsigned int line_count   = 20000;
+	std::string        file_name(TEST_GetLogFileName("LogHandlerURingFile." +
+		std::to_string(buffer_count)));
+	bool               active_flag;
+	std::uint64_t      submit_count;
+	std::uint64_t      failure_count;
+
+	{
+		LogHandlerURingFile my_handler(file_name,
+			LogHandlerFileBase::NoConsoleOutput, LogFlushPolicy(4096, 0),
+			LogURingSync_FDataSync, buffer_count);
+		std::vector<std::thread> thread_list;
+		for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1)
+			thread_list.emplace_back([&my_handler, count_1, line_count]() {
+				for (unsigned int count_2 = 0; count_2 < line_count; ++count_2)
+					my_handler.EmitLineSpecific("URing line " +
+						std::to_string(count_1) + " " + std::to_string(count_2));
+			});
+		for (auto &this_thread : thread_list)
+			this_thread.join();
+		my_handler.Flush();
+		active_flag   = my_handler.IsURingActive();
+		submit_count  = my_handler.GetSubmitCount();
+		failure_count = my_handler.GetCompletionFailureCount();
+		if (active_flag && (!buffer_count))
+			throw std::logic_error("The ring was created without buffers.");
+	}
+
+	TEST_CheckLines(std::vector<std::string>(1, file_name), thread_count,
+		line_count);
+
+	std::cout << "LogHandlerURingFile with " << buffer_count << " buffers: " <<
+		(thread_count * line_count) << " lines, io_uring " <<
+		((active_flag) ? "active" : "inactive") << ", " << submit_count <<
+		" submissions, " << failure_count << " failed completions." <<
+		std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The writes in flight must complete before a segment is renamed and
+	compressed.
+*/
+void TEST_Rotation()
+{
+	using namespace MLB::Utility;
+
+	const unsigned int line_count = 20000;
+	std::string        file_name(
+		TEST_GetLogFileName("LogHandlerURingFile.Rotation"));
+	std::uint64_t      rotation_count;
+
+	{
+		LogHandlerURingFile my_handler(file_name,
+			LogHandlerFileBase::NoConsoleOutput, LogFlushPolicy(4096, 0));
+		my_handler.SetRotationSpec(LogFileRotationSpec(64 * 1024));
+		for (unsigned int count_1 = 0; count_1 < line_count; ++count_1)
+			my_handler.EmitLineSpecific("URing line 0 " +
+				std::to_string(count_1));
+		my_handler.Flush();
+		rotation_count = my_handler.GetRotationCount();
+		my_handler.WaitForCompression();
+	}
+
+	std::string           stem_name(file_name.substr(0, file_name.size() - 4));
+	std::set<std::string> segment_set;
+
+	for (const auto &this_entry : std::filesystem::directory_iterator(".")) {
+		std::string this_name(this_entry.path().filename().string());
+		if ((this_name != file_name) && (!this_name.find(stem_name + ".")))
+			segment_set.insert(this_name);
+	}
+
+	if ((!rotation_count) || (segment_set.size() != rotation_count))
+		throw std::logic_error("Expected " + std::to_string(rotation_count) +
+			" log file segments, but found " +
+			std::to_string(segment_set.size()) + ".");
+
+	std::vector<std::string> file_list(segment_set.begin(), segment_set.end());
+
+	file_list.push_back(file_name);
+
+	TEST_CheckLines(file_list, 1, line_count);
+
+	std::cout << "LogHandlerURingFile rotation: " << line_count <<
+		" lines in " << rotation_count << " segments and the active file." <<
+		std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Fatal()
+{
+	using namespace MLB::Utility;
+
+	std::string         file_name(
+		TEST_GetLogFileName("LogHandlerURingFile.Fatal"));
+	LogHandlerURingFile my_handler(file_name,
+		LogHandlerFileBase::NoConsoleOutput, LogFlushPolicy(1 << 20, 0));
+
+	my_handler.EmitLineSpecific("Batched line", LogLevel_Info);
+
+	if (std::filesystem::file_size(file_name))
+		throw std::logic_error("A batched line was written before a flush "
+			"was required.");
+
+	LogEmitControl fatal_control(MLB::Utility::Default, LogFlag_Mask,
+		LogFlag_Mask, TimeSpec(), LogLevel_Fatal, LogFlag_Fatal,
+		file_name);
+
+	my_handler.EmitLine(fatal_control);
+
+	if (std::filesystem::file_size(file_name) !=
+		(2 * LogLineLeaderLength + 13 + file_name.size() + 1))
+		throw std::logic_error("A fatal line was not written before the "
+			"emitting call returned.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	using namespace MLB::Utility;
+
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		//	Through the ring, then the LogHandlerXFile fall-back...
+		TEST_InFlight(LogHandlerURingFile::DefaultBufferCount);
+		TEST_InFlight(0);
+		TEST_Rotation();
+		TEST_Fatal();
+		LogHandlerPtr my_log_handler(
+			new LogHandlerURingFile(TEST_GetLogFileName("LogHandlerURingFile")));
+		TEST_TestControl(my_log_handler, 10000, 200, 1, 2000000);
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
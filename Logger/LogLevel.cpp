@@ -11,8 +11,10 @@
                            Michael L. Brock
                         2023-01-05 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- Added ConvertTextToLogLevel().
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 1998 - 2023.
+      Copyright Michael L. Brock 1998 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -30,6 +32,9 @@
 #include <Utility/AnyToString.hpp>
 #include <Utility/ToStringRadix.hpp>
 
+#include <cctype>
+#include <stdexcept>
+
 // ////////////////////////////////////////////////////////////////////////////
 
 namespace MLB {
@@ -124,6 +129,33 @@ std::string ConvertLogLevelToTextSimple(LogLevel log_level)
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+LogLevel ConvertTextToLogLevel(const std::string &level_text)
+{
+	std::string upper_text(level_text);
+
+	for (auto &this_char : upper_text)
+		this_char = static_cast<char>(
+			::toupper(static_cast<unsigned char>(this_char)));
+
+	for (std::size_t enum_idx = 0; enum_idx < LogTextCount; ++enum_idx) {
+		if (upper_text == LogTextListSimple[enum_idx])
+			return(static_cast<LogLevel>(enum_idx));
+	}
+
+	if ((!upper_text.empty()) && (upper_text.size() < 3) &&
+		(upper_text.find_first_not_of("0123456789") == std::string::npos))
+		return(CheckLogLevel(static_cast<LogLevel>(std::stoi(upper_text))));
+
+	throw std::invalid_argument("Invalid log level name encountered ('" +
+		level_text + "') --- permissible values are the names of the levels "
+		"from '" + ConvertLogLevelToTextSimple(LogLevel_Minimum) + "' to '" +
+		ConvertLogLevelToTextSimple(LogLevel_Maximum) + "' or their numbers "
+		"from " + AnyToString(LogLevel_Minimum) + " to " +
+		AnyToString(LogLevel_Maximum) + ", inclusive.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 // ////////////////////////////////////////////////////////////////////////////
 LogLevel CheckLogLevel(LogLevel log_level)
 {
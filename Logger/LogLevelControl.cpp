@@ -0,0 +1,553 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogLevelControl.cpp
+
+   File Description  :  Implementation of the run-time control of log levels
+                        from a configuration file.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogLevelControl.hpp>
+
+#include <Utility/ThrowErrno.hpp>
+
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Incremented by the reload signal handler; watchers compare it to the
+//	count they last saw.
+std::atomic<unsigned int> ReloadSignalCount(0);
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+extern "C" void ReloadSignalHandler(int)
+{
+	ReloadSignalCount.fetch_add(1, std::memory_order_relaxed);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string TrimText(const std::string &in_text)
+{
+	std::string::size_type first_pos = in_text.find_first_not_of(" \t\r");
+
+	if (first_pos == std::string::npos)
+		return(std::string());
+
+	return(in_text.substr(first_pos,
+		in_text.find_last_not_of(" \t\r") - first_pos + 1));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	A minimum level ("debug") or an inclusive range ("debug-error").
+LogLevelPair ParseLevelRange(const std::string &level_text)
+{
+	std::string::size_type sep_pos = level_text.find('-');
+
+	if (sep_pos == std::string::npos)
+		return(LogLevelPair(ConvertTextToLogLevel(level_text),
+			LogLevel_Maximum));
+
+	LogLevelPair level_pair(
+		ConvertTextToLogLevel(TrimText(level_text.substr(0, sep_pos))),
+		ConvertTextToLogLevel(TrimText(level_text.substr(sep_pos + 1))));
+
+	if (level_pair.first > level_pair.second)
+		throw std::invalid_argument("The first level of the range '" +
+			level_text + "' is greater than the second.");
+
+	return(level_pair);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogLevelFlag GetLevelRangeMask(const LogLevelPair &level_pair)
+{
+	unsigned int level_flags = 0;
+
+	for (int level_idx = static_cast<int>(level_pair.first);
+		level_idx <= static_cast<int>(level_pair.second); ++level_idx)
+		level_flags |= 1U << static_cast<unsigned int>(level_idx);
+
+	return(static_cast<LogLevelFlag>(level_flags & LogFlag_Mask));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+struct LevelSetting {
+	LevelSetting()
+		:set_flag_(false)
+		,level_pair_(LogLevel_Minimum, LogLevel_Maximum)
+	{
+	}
+
+	//	The level "default" removes the setting.
+	void Set(const std::string &level_text) {
+		if (IsDefaultText(level_text))
+			set_flag_ = false;
+		else {
+			level_pair_ = ParseLevelRange(level_text);
+			set_flag_   = true;
+		}
+	}
+
+	static bool IsDefaultText(std::string level_text) {
+		for (auto &this_char : level_text)
+			this_char = static_cast<char>(
+				::tolower(static_cast<unsigned char>(this_char)));
+		return(level_text == "default");
+	}
+
+	bool         set_flag_;
+	LogLevelPair level_pair_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+struct LevelConfig {
+	typedef std::pair<LevelSetting, LevelSetting> TagSetting;
+
+	LevelSetting                       console_;
+	LevelSetting                       file_;
+	std::map<std::string, TagSetting>  tag_map_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void ParseConfigLine(const std::string &in_line, LevelConfig &level_config)
+{
+	std::string line_text(TrimText(in_line.substr(0, in_line.find('#'))));
+
+	if (line_text.empty())
+		return;
+
+	std::string::size_type equal_pos = line_text.find('=');
+
+	if (equal_pos == std::string::npos)
+		throw std::invalid_argument("Expected an entry of the form "
+			"'<name> = <level>'.");
+
+	std::string key_text(TrimText(line_text.substr(0, equal_pos)));
+	std::string value_text(TrimText(line_text.substr(equal_pos + 1)));
+
+	if (value_text.empty())
+		throw std::invalid_argument("The level of the entry '" + key_text +
+			"' is empty.");
+
+	if (key_text == "console")
+		level_config.console_.Set(value_text);
+	else if (key_text == "file")
+		level_config.file_.Set(value_text);
+	else if ((key_text.compare(0, 8, "console.") == 0) &&
+		(key_text.size() > 8))
+		level_config.tag_map_[key_text.substr(8)].first.Set(value_text);
+	else if ((key_text.compare(0, 5, "file.") == 0) && (key_text.size() > 5))
+		level_config.tag_map_[key_text.substr(5)].second.Set(value_text);
+	else
+		throw std::invalid_argument("Unknown entry name '" + key_text +
+			"' --- expected 'console', 'file', 'console.<tag>' or "
+			"'file.<tag>'.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+struct LogLevelControl::FileState {
+	FileState()
+		:exists_flag_(false)
+		,mtime_sec_(0)
+		,mtime_nsec_(0)
+		,file_size_(0)
+	{
+	}
+
+	bool operator != (const FileState &other) const {
+		return((exists_flag_ != other.exists_flag_) ||
+			(mtime_sec_ != other.mtime_sec_) ||
+			(mtime_nsec_ != other.mtime_nsec_) ||
+			(file_size_ != other.file_size_));
+	}
+
+	static FileState Get(const std::string &file_name) {
+		FileState   file_state;
+		struct stat stat_data;
+
+		if (::stat(file_name.c_str(), &stat_data) == 0) {
+			file_state.exists_flag_ = true;
+			file_state.mtime_sec_   =
+				static_cast<long long>(stat_data.st_mtim.tv_sec);
+			file_state.mtime_nsec_  =
+				static_cast<long long>(stat_data.st_mtim.tv_nsec);
+			file_state.file_size_   = static_cast<long long>(stat_data.st_size);
+		}
+
+		return(file_state);
+	}
+
+	bool       exists_flag_;
+	long long  mtime_sec_;
+	long long  mtime_nsec_;
+	long long  file_size_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogLevelControl::LogLevelControl(LogManager &manager_ref,
+	const std::string &file_name, unsigned int poll_ms)
+	:manager_ref_(manager_ref)
+	,file_name_(file_name)
+	,poll_ms_(std::max(1U, poll_ms))
+	,initial_console_(manager_ref.GetLogLevelConsole())
+	,initial_file_(manager_ref.GetLogLevelFile())
+	,tag_name_set_()
+	,last_error_()
+	,reload_count_(0)
+	,control_lock_()
+	,stop_condition_()
+	,stop_flag_(false)
+	,watcher_thread_()
+{
+	if (file_name_.empty())
+		throw std::invalid_argument("The name of the log level control file is "
+			"empty.");
+
+	/*
+		The levels in the file are in effect by the time the constructor
+		returns. The state of the file is taken before it's read so that the
+		watcher reloads it if it changes in the meantime.
+	*/
+	unsigned int signal_count = ReloadSignalCount.load(std::memory_order_relaxed);
+	FileState    file_state(FileState::Get(file_name_));
+
+	if (file_state.exists_flag_)
+		Reload();
+
+	std::thread tmp_thread(&LogLevelControl::WatcherThreadProc, this,
+		signal_count, file_state);
+
+	watcher_thread_.swap(tmp_thread);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogLevelControl::~LogLevelControl()
+{
+	{
+		std::lock_guard<LogLock> my_lock(control_lock_);
+		stop_flag_ = true;
+	}
+
+	stop_condition_.notify_all();
+
+	if (watcher_thread_.joinable())
+		watcher_thread_.join();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogLevelControl::Reload()
+{
+	LevelConfig   level_config;
+	std::ifstream config_file(file_name_.c_str());
+
+	try {
+		if (!config_file)
+			throw std::runtime_error("Unable to open the file.");
+		std::string   in_line;
+		unsigned int  line_number = 0;
+		while (std::getline(config_file, in_line)) {
+			++line_number;
+			try {
+				ParseConfigLine(in_line, level_config);
+			}
+			catch (const std::exception &except) {
+				throw std::invalid_argument("Error on line " +
+					std::to_string(line_number) + ": " + except.what());
+			}
+		}
+	}
+	catch (const std::exception &except) {
+		std::string error_text("Unable to reload the log levels from '" +
+			file_name_ + "': " + except.what());
+		{
+			std::lock_guard<LogLock> my_lock(control_lock_);
+			last_error_ = error_text;
+		}
+		manager_ref_.EmitLine(error_text, LogLevel_Warning);
+		return(false);
+	}
+
+	std::lock_guard<LogLock> my_lock(control_lock_);
+
+	LogLevelPair console_pair((level_config.console_.set_flag_) ?
+		level_config.console_.level_pair_ : initial_console_);
+	LogLevelPair file_pair((level_config.file_.set_flag_) ?
+		level_config.file_.level_pair_ : initial_file_);
+
+	manager_ref_.SetLogLevelConsole(console_pair.first, console_pair.second);
+	manager_ref_.SetLogLevelFile(file_pair.first, file_pair.second);
+
+	std::set<std::string> tag_name_set;
+
+	for (const auto &this_tag : level_config.tag_map_) {
+		const LevelSetting &tag_console(this_tag.second.first);
+		const LevelSetting &tag_file(this_tag.second.second);
+		if ((!tag_console.set_flag_) && (!tag_file.set_flag_))
+			continue;
+		LogTag::SetOverride(this_tag.first.c_str(), LogTagMakeOverride(
+			GetLevelRangeMask((tag_console.set_flag_) ?
+				tag_console.level_pair_ : console_pair),
+			GetLevelRangeMask((tag_file.set_flag_) ?
+				tag_file.level_pair_ : file_pair)));
+		tag_name_set.insert(this_tag.first);
+	}
+
+	for (const auto &this_name : tag_name_set_) {
+		if (tag_name_set.find(this_name) == tag_name_set.end())
+			LogTag::ClearOverride(this_name.c_str());
+	}
+
+	tag_name_set_.swap(tag_name_set);
+	last_error_.clear();
+	++reload_count_;
+
+	manager_ref_.EmitLine("Reloaded the log levels from '" + file_name_ +
+		"'.", LogLevel_Info);
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const std::string &LogLevelControl::GetFileName() const
+{
+	return(file_name_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::string LogLevelControl::GetLastError() const
+{
+	std::lock_guard<LogLock> my_lock(control_lock_);
+
+	return(last_error_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+unsigned int LogLevelControl::GetReloadCount() const
+{
+	std::lock_guard<LogLock> my_lock(control_lock_);
+
+	return(reload_count_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogLevelControl::InstallSignalReload(int signal_number)
+{
+	struct sigaction signal_action;
+
+	::memset(&signal_action, '\0', sizeof(signal_action));
+	signal_action.sa_handler = ReloadSignalHandler;
+	signal_action.sa_flags   = SA_RESTART;
+	::sigemptyset(&signal_action.sa_mask);
+
+	if (::sigaction(signal_number, &signal_action, NULL) != 0)
+		ThrowErrno("Attempt to install the log level reload handler for "
+			"signal number " + std::to_string(signal_number) + " failed");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogLevelControl::WatcherThreadProc(unsigned int signal_count,
+	FileState file_state)
+{
+	for ( ; ; ) {
+		{
+			std::unique_lock<LogLock> my_lock(control_lock_);
+			if (stop_condition_.wait_for(my_lock,
+				std::chrono::milliseconds(poll_ms_),
+				[this]() { return(stop_flag_); }))
+				break;
+		}
+		unsigned int new_signal_count =
+			ReloadSignalCount.load(std::memory_order_relaxed);
+		FileState    new_file_state(FileState::Get(file_name_));
+		if ((new_signal_count != signal_count) ||
+			(new_file_state.exists_flag_ && (new_file_state != file_state)))
+			Reload();
+		signal_count = new_signal_count;
+		file_state   = new_file_state;
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogTestSupport.hpp>
+
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+const char *TEST_FileName = "LogLevelControl.test.cfg";
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_WriteFile(const std::string &file_text)
+{
+	std::ofstream out_file(TEST_FileName, std::ios::out | std::ios::trunc);
+
+	out_file << file_text;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_WaitForReload(const MLB::Utility::LogLevelControl &level_control,
+	unsigned int reload_count)
+{
+	for (int count_1 = 0; count_1 < 500; ++count_1) {
+		if (level_control.GetReloadCount() >= reload_count)
+			return;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	throw std::logic_error("Timed out waiting for reload number " +
+		std::to_string(reload_count) + " of the log level control file.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Reload()
+{
+	using namespace MLB::Utility;
+
+	static LogTag TEST_Tag("test.control");
+
+	LogSPtr<LogHandlerCapture> capture_ptr(new LogHandlerCapture);
+	LogManager                 log_manager(capture_ptr, Default,
+		LogLevel_Info, LogLevel_Fatal, LogLevel_Info, LogLevel_Fatal);
+	LogStream                  log_debug(log_manager, LogLevel_Debug);
+
+	TEST_WriteFile("# Test file\nconsole = debug\n");
+
+	LogLevelControl level_control(log_manager, TEST_FileName, 10);
+
+	//	The file is loaded before the constructor returns...
+	TEST_ExpectCount("Reloads after construction",
+		level_control.GetReloadCount(), 1);
+	TEST_ExpectCount("Console minimum after load",
+		log_manager.GetLogLevelConsole().first, LogLevel_Debug);
+	TEST_ExpectCount("File minimum after load",
+		log_manager.GetLogLevelFile().first, LogLevel_Info);
+
+	//	Remove the console entry and add a tag override...
+	TEST_WriteFile("file = warning-error\nconsole.test.control = spam\n");
+	TEST_WaitForReload(level_control, 2);
+	TEST_ExpectCount("Console minimum restored",
+		log_manager.GetLogLevelConsole().first, LogLevel_Info);
+	TEST_ExpectCount("File maximum after reload",
+		log_manager.GetLogLevelFile().second, LogLevel_Error);
+
+	LogIfTag(TEST_Tag, LogLevel_Debug, log_debug) << "Tagged debug line" <<
+		std::endl;
+	LogIfLevel(LogLevel_Debug, log_debug) << "Untagged debug line" <<
+		std::endl;
+	TEST_ExpectCount("Tagged debug lines emitted",
+		capture_ptr->Count("Tagged debug line"), 1);
+	TEST_ExpectCount("Untagged debug lines emitted",
+		capture_ptr->Count("Untagged debug line"), 0);
+
+	//	A bad file is rejected and the levels are left as they were...
+	TEST_WriteFile("console = verbose\n");
+	for (int count_1 = 0; (count_1 < 500) &&
+		level_control.GetLastError().empty(); ++count_1)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	TEST_ExpectCount("Reload warnings emitted",
+		capture_ptr->Count("line 1: Invalid log level name"), 1);
+	TEST_ExpectCount("Tag override retained",
+		(TEST_Tag.GetOverride() & LogTagOverride_Active) != 0, 1);
+
+	//	Removing the tag entry removes the override...
+	TEST_WriteFile("# Empty\n");
+	TEST_WaitForReload(level_control, 3);
+	TEST_ExpectCount("Tag override cleared",
+		(TEST_Tag.GetOverride() & LogTagOverride_Active) != 0, 0);
+	LogIfTag(TEST_Tag, LogLevel_Debug, log_debug) << "Tagged debug line" <<
+		std::endl;
+	TEST_ExpectCount("Tagged debug lines emitted",
+		capture_ptr->Count("Tagged debug line"), 1);
+
+	//	Signal reload, without any change to the file...
+	LogLevelControl::InstallSignalReload(SIGUSR1);
+	std::raise(SIGUSR1);
+	TEST_WaitForReload(level_control, 4);
+	TEST_ExpectCount("Reloads after signal", level_control.GetReloadCount(),
+		4);
+
+	::remove(TEST_FileName);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_Reload();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
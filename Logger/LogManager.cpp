@@ -13,8 +13,11 @@
                            Michael L. Brock
                         2023-01-05 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- Handlers are called without the
+                                       log manager lock.
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 1993 - 2023.
+      Copyright Michael L. Brock 1993 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -31,8 +34,11 @@
 
 #include <Utility/ExceptionRethrow.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <thread>
 
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -40,18 +46,94 @@ namespace MLB {
 
 namespace Utility {
 
+#ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+std::atomic<std::uint64_t> LogStreamSerialNext(1);
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+struct LogStreamThreadEntry {
+	const LogStream       *stream_ptr_;
+	std::uint64_t          stream_serial_;
+	std::weak_ptr<int>     life_token_;
+	LogSPtr<ThreadStream>  thread_stream_ptr_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+class LogStreamThreadCache;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	These are trivially-initialized so that they may safely be examined after
+	the thread's instance of LogStreamThreadCache has been destroyed.
+*/
+thread_local LogStreamThreadCache *ThreadCachePtr  = NULL;
+thread_local bool                  ThreadCacheGone = false;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The per-thread collection of streams for each LogStream used by a thread.
+	Destroyed at thread exit, which causes any partial lines to be emitted
+	(if the owning LogStream still exists) and reclaims the memory.
+*/
+class LogStreamThreadCache {
+public:
+	LogStreamThreadCache()
+		:entry_list_()
+		,last_index_(0)
+	{
+		ThreadCachePtr = this;
+	}
+
+	~LogStreamThreadCache()
+	{
+		ThreadCachePtr  = NULL;
+		ThreadCacheGone = true;
+
+		for (auto &this_entry : entry_list_) {
+			if (this_entry.life_token_.expired())
+				this_entry.thread_stream_ptr_->GetBufferPtrRef()->Abandon();
+		}
+	}
+
+	std::vector<LogStreamThreadEntry> entry_list_;
+	std::size_t                       last_index_;
+
+private:
+	LogStreamThreadCache(const LogStreamThreadCache &) = delete;
+	LogStreamThreadCache & operator = (const LogStreamThreadCache &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+thread_local LogStreamThreadCache ThreadCache;
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+#endif // #ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+
 // ////////////////////////////////////////////////////////////////////////////
 LogManager::LogManager(LogFlag log_flags,
 	LogLevel min_log_level_screen, LogLevel max_log_level_screen,
 	LogLevel min_log_level_persistent, LogLevel max_log_level_persistent)
-	:log_handler_ptr_()
+	:handler_entry_ptr_()
 	,log_flags_(log_flags)
+	,the_lock_()
+	,level_lock_()
 	,log_level_screen_(GetLogLevelMask(min_log_level_screen,
 		max_log_level_screen))
 	,log_level_persistent_(GetLogLevelMask(min_log_level_persistent,
 		max_log_level_persistent))
-	,the_lock_()
+	,log_level_enabled_(0)
+	,log_level_recorder_(0)
+	,flight_recorder_ptr_()
 {
+	UpdateLevelEnabled();
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -60,14 +142,19 @@ LogManager::LogManager(LogHandlerPtr log_handler_ptr,
 	LogFlag log_flags, LogLevel min_log_level_screen,
 	LogLevel max_log_level_screen, LogLevel min_log_level_persistent,
 	LogLevel max_log_level_persistent)
-	:log_handler_ptr_()
+	:handler_entry_ptr_()
 	,log_flags_(log_flags)
+	,the_lock_()
+	,level_lock_()
 	,log_level_screen_(GetLogLevelMask(min_log_level_screen,
 		max_log_level_screen))
 	,log_level_persistent_(GetLogLevelMask(min_log_level_persistent,
 		max_log_level_persistent))
-	,the_lock_()
+	,log_level_enabled_(0)
+	,log_level_recorder_(0)
+	,flight_recorder_ptr_()
 {
+	UpdateLevelEnabled();
 	HandlerInstall(log_handler_ptr);
 }
 // ////////////////////////////////////////////////////////////////////////////
@@ -83,15 +170,36 @@ LogManager::~LogManager()
 LogHandlerPtr LogManager::HandlerInstall(LogHandlerPtr log_handler_ptr)
 {
 	LogLockScoped my_lock(the_lock_);
-	LogHandlerPtr old_log_handler_ptr = log_handler_ptr_;
-
-	if (log_handler_ptr_ != NULL)
-		log_handler_ptr_->RemoveHandler();
-
-	log_handler_ptr_ = log_handler_ptr;
+	LogHandlerPtr old_log_handler_ptr(GetHandlerPtr());
+
+	if (log_handler_ptr == old_log_handler_ptr) {
+		if (log_handler_ptr != NULL) {
+			log_handler_ptr->RemoveHandler();
+			log_handler_ptr->InstallHandler();
+		}
+		return(old_log_handler_ptr);
+	}
 
-	if (log_handler_ptr_ != NULL)
-		log_handler_ptr_->InstallHandler();
+	/*
+		Emitting threads don't take the lock, so the new handler is installed
+		before it's published. Threads which loaded the old entry before the
+		exchange may still be emitting to the old handler, so it's removed
+		only after they have released the entry.
+	*/
+	if (log_handler_ptr != NULL)
+		log_handler_ptr->InstallHandler();
+
+	HandlerEntryPtr old_entry_ptr(handler_entry_ptr_.exchange(
+		(log_handler_ptr != NULL) ?
+		std::make_shared<const HandlerEntry>(log_handler_ptr) :
+		HandlerEntryPtr(), std::memory_order_acq_rel));
+
+	if (old_entry_ptr != NULL) {
+		while (old_entry_ptr.use_count() > 1)
+			std::this_thread::yield();
+		std::atomic_thread_fence(std::memory_order_acquire);
+		old_log_handler_ptr->RemoveHandler();
+	}
 
 	return(old_log_handler_ptr);
 }
@@ -105,25 +213,28 @@ LogHandlerPtr LogManager::HandlerRemove()
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-LogHandlerPtr LogManager::GetHandlerPtr()
+LogHandlerPtr LogManager::GetHandlerPtr() const
 {
-	LogLockScoped my_lock(the_lock_);
+	HandlerEntryPtr handler_entry_ptr(GetHandlerEntryPtr());
 
-	return(log_handler_ptr_);
+	return((handler_entry_ptr != NULL) ? handler_entry_ptr->log_handler_ptr_ :
+		LogHandlerPtr());
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 LogLevelPair LogManager::GetLogLevelConsole() const
 {
-	return(LogLevelFlagsToLevels(log_level_screen_));
+	return(LogLevelFlagsToLevels(
+		log_level_screen_.load(std::memory_order_relaxed)));
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 LogLevelPair LogManager::GetLogLevelFile() const
 {
-	return(LogLevelFlagsToLevels(log_level_persistent_));
+	return(LogLevelFlagsToLevels(
+		log_level_persistent_.load(std::memory_order_relaxed)));
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -131,10 +242,13 @@ LogLevelPair LogManager::GetLogLevelFile() const
 LogLevelPair LogManager::SetLogLevelConsole(LogLevel min_log_level,
 	LogLevel max_log_level)
 {
-	LogLockScoped my_lock(the_lock_);
+	LogLockScoped my_lock(level_lock_);
 	LogLevelPair  old_levels(GetLogLevelConsole());
 
-	log_level_screen_ = GetLogLevelMask(min_log_level, max_log_level);
+	log_level_screen_.store(GetLogLevelMask(min_log_level, max_log_level),
+		std::memory_order_relaxed);
+
+	UpdateLevelEnabled();
 
 	return(old_levels);
 }
@@ -144,15 +258,53 @@ LogLevelPair LogManager::SetLogLevelConsole(LogLevel min_log_level,
 LogLevelPair LogManager::SetLogLevelFile(LogLevel min_log_level,
 	LogLevel max_log_level)
 {
-	LogLockScoped my_lock(the_lock_);
+	LogLockScoped my_lock(level_lock_);
 	LogLevelPair  old_levels(GetLogLevelFile());
 
-	log_level_persistent_ = GetLogLevelMask(min_log_level, max_log_level);
+	log_level_persistent_.store(GetLogLevelMask(min_log_level, max_log_level),
+		std::memory_order_relaxed);
+
+	UpdateLevelEnabled();
 
 	return(old_levels);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+LogFlightRecorderPtr LogManager::FlightRecorderInstall(
+	LogFlightRecorderPtr recorder_ptr, LogLevel min_log_level,
+	LogLevel max_log_level)
+{
+	LogLockScoped my_lock(the_lock_);
+
+	{
+		LogLockScoped level_lock(level_lock_);
+		log_level_recorder_.store(0, std::memory_order_relaxed);
+		UpdateLevelEnabled();
+	}
+
+	LogFlightRecorderPtr old_recorder_ptr(flight_recorder_ptr_.exchange(
+		recorder_ptr, std::memory_order_acq_rel));
+
+	LogLockScoped level_lock(level_lock_);
+
+	if (recorder_ptr != NULL)
+		log_level_recorder_.store(GetLogLevelMask(min_log_level, max_log_level),
+			std::memory_order_relaxed);
+
+	UpdateLevelEnabled();
+
+	return(old_recorder_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogFlightRecorderPtr LogManager::FlightRecorderRemove()
+{
+	return(FlightRecorderInstall(LogFlightRecorderPtr()));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 // ////////////////////////////////////////////////////////////////////////////
 void LogManager::SetLogLevelConsoleAll()
 {
@@ -169,29 +321,28 @@ void LogManager::SetLogLevelFileAll()
 
 // ////////////////////////////////////////////////////////////////////////////
 void LogManager::EmitLine(const TimeSpec &line_start_time, LogLevel log_level,
-	const std::string &line_buffer)
+	const std::string &line_buffer, LogTagOverride tag_override)
 {
-	LogLevelFlag log_level_flag = static_cast<LogLevelFlag>
+	LogLevelFlag         log_level_flag = static_cast<LogLevelFlag>
 		((1 << log_level) & LogFlag_Mask);
-	LogLockScoped my_lock(the_lock_);
+	LogFlightRecorderPtr recorder_ptr(GetFlightRecorder(log_level_flag));
 
-	if ((log_handler_ptr_ != NULL) && ((log_level_flag & log_level_screen_) ||
-		(log_level_flag & log_level_persistent_))) {
-		LogEmitControl emit_ctl(log_flags_, log_level_screen_,
-			log_level_persistent_, line_start_time, log_level, log_level_flag,
-			line_buffer);
-/*
-		Can't early-release std::lock_guard.
+	if (recorder_ptr != NULL)
+		recorder_ptr->Record(line_start_time, log_level, line_buffer);
 
-		But should have taken a copy of log_handler_ptr_ before the early
-		release and used that anyway.
+	LogLevelFlag level_screen;
+	LogLevelFlag level_persistent;
 
-		To be re-factored into something like:
-		LogHandlerPtr tmp_log_handler_ptr = log_handler_ptr_;
-		my_lock.unlock();
-		log_handler_ptr_->EmitLine(emit_ctl);
-*/
-		log_handler_ptr_->EmitLine(emit_ctl);
+	if (!GetHandlerLevels(log_level_flag, tag_override, level_screen,
+		level_persistent))
+		return;
+
+	HandlerEntryPtr handler_entry_ptr(GetHandlerEntryPtr());
+
+	if (handler_entry_ptr != NULL) {
+		LogEmitControl emit_ctl(log_flags_, level_screen, level_persistent,
+			line_start_time, log_level, log_level_flag, line_buffer);
+		handler_entry_ptr->log_handler_ptr_->EmitLine(emit_ctl);
 	}
 }
 // ////////////////////////////////////////////////////////////////////////////
@@ -200,7 +351,7 @@ void LogManager::EmitLine(const TimeSpec &line_start_time, LogLevel log_level,
 void LogManager::EmitLine(const std::string &line_buffer,
 	LogLevel log_level)
 {
-	EmitLine(TimeSpec(), log_level, line_buffer);
+	EmitLine(LogClockNow(), log_level, line_buffer);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -218,10 +369,11 @@ void LogManager::EmitLiteral(unsigned int literal_length,
 {
 	literal_ptr = (literal_ptr == NULL) ? "" : literal_ptr;
 
-	LogLockScoped my_lock(the_lock_);
+	HandlerEntryPtr handler_entry_ptr(GetHandlerEntryPtr());
 
-	if (log_handler_ptr_ != NULL)
-		log_handler_ptr_->EmitLiteral(literal_length, literal_ptr);
+	if (handler_entry_ptr != NULL)
+		handler_entry_ptr->log_handler_ptr_->EmitLiteral(literal_length,
+			literal_ptr);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -240,19 +392,110 @@ void LogManager::EmitLiteral(LogLevel log_level, unsigned int literal_length,
 {
 	literal_ptr = (literal_ptr == NULL) ? "" : literal_ptr;
 
-	LogLevelFlag log_level_flag = static_cast<LogLevelFlag>
+	LogLevelFlag         log_level_flag = static_cast<LogLevelFlag>
 		((1 << log_level) & LogFlag_Mask);
-	LogLockScoped my_lock(the_lock_);
+	LogFlightRecorderPtr recorder_ptr(GetFlightRecorder(log_level_flag));
+
+	if (recorder_ptr != NULL)
+		recorder_ptr->Record(LogClockNow(), log_level, literal_ptr,
+			literal_length);
+
+	LogLevelFlag level_screen;
+	LogLevelFlag level_persistent;
+
+	if (!GetHandlerLevels(log_level_flag, LogTagOverride_None, level_screen,
+		level_persistent))
+		return;
+
+	HandlerEntryPtr handler_entry_ptr(GetHandlerEntryPtr());
+
+	if (handler_entry_ptr != NULL) {
+		LogEmitControl emit_ctl(log_flags_, level_screen, level_persistent,
+			log_level, log_level_flag);
+		handler_entry_ptr->log_handler_ptr_->EmitLiteral(emit_ctl,
+			literal_length, literal_ptr);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogManager::EmitBinary(const TimeSpec &line_start_time,
+	LogLevel log_level, LogBinaryFormatId format_id,
+	const std::string &arg_buffer)
+{
+	LogLevelFlag         log_level_flag = static_cast<LogLevelFlag>
+		((1 << log_level) & LogFlag_Mask);
+	LogFlightRecorderPtr recorder_ptr(GetFlightRecorder(log_level_flag));
 
-	if ((log_handler_ptr_ != NULL) && ((log_level_flag & log_level_screen_) ||
-		(log_level_flag & log_level_persistent_))) {
-		LogEmitControl emit_ctl(log_flags_, log_level_screen_,
-			log_level_persistent_, log_level, log_level_flag);
-		log_handler_ptr_->EmitLiteral(emit_ctl, literal_length, literal_ptr);
+	if (recorder_ptr != NULL)
+		recorder_ptr->RecordBinary(line_start_time, log_level, format_id,
+			arg_buffer.data(), arg_buffer.size());
+
+	LogLevelFlag level_screen;
+	LogLevelFlag level_persistent;
+
+	if (!GetHandlerLevels(log_level_flag, LogTagOverride_None, level_screen,
+		level_persistent))
+		return;
+
+	std::string     empty_line;
+	HandlerEntryPtr handler_entry_ptr(GetHandlerEntryPtr());
+
+	if (handler_entry_ptr != NULL) {
+		LogEmitControl emit_ctl(log_flags_, level_screen, level_persistent,
+			line_start_time, log_level, log_level_flag, empty_line);
+		handler_entry_ptr->log_handler_ptr_->EmitBinary(emit_ctl, format_id,
+			arg_buffer.data(), arg_buffer.size());
 	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+void LogManager::EmitEvent(const TimeSpec &line_start_time,
+	LogLevel log_level, const std::string &field_buffer)
+{
+	LogLevelFlag         log_level_flag = static_cast<LogLevelFlag>
+		((1 << log_level) & LogFlag_Mask);
+	LogFlightRecorderPtr recorder_ptr(GetFlightRecorder(log_level_flag));
+
+	if (recorder_ptr != NULL)
+		recorder_ptr->RecordBinary(line_start_time, log_level,
+			LogBinaryFormatId_Event, field_buffer.data(), field_buffer.size());
+
+	LogLevelFlag level_screen;
+	LogLevelFlag level_persistent;
+
+	if (!GetHandlerLevels(log_level_flag, LogTagOverride_None, level_screen,
+		level_persistent))
+		return;
+
+	std::string     empty_line;
+	HandlerEntryPtr handler_entry_ptr(GetHandlerEntryPtr());
+
+	if (handler_entry_ptr != NULL) {
+		LogEmitControl emit_ctl(log_flags_, level_screen, level_persistent,
+			line_start_time, log_level, log_level_flag, empty_line);
+		emit_ctl.field_ptr_    = field_buffer.data();
+		emit_ctl.field_length_ = field_buffer.size();
+		handler_entry_ptr->log_handler_ptr_->EmitEvent(emit_ctl);
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogManager::UpdateLevelEnabled()
+{
+	unsigned int handler_mask = static_cast<unsigned int>(
+		log_level_screen_.load(std::memory_order_relaxed)) |
+		static_cast<unsigned int>(
+		log_level_persistent_.load(std::memory_order_relaxed));
+
+	log_level_enabled_.store(handler_mask |
+		log_level_recorder_.load(std::memory_order_relaxed),
+		std::memory_order_relaxed);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 // ////////////////////////////////////////////////////////////////////////////
 LogLevelFlag LogManager::GetLogLevelMask(LogLevel min_level, LogLevel max_level)
 {
@@ -280,9 +523,48 @@ LogLevelFlag LogManager::GetLogLevelMask(LogLevel min_level, LogLevel max_level)
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
+LogStream::LogStream(LogManager &manager_ref, LogLevel log_level)
+	:std::ostream(new ThreadStreamBuffer(manager_ref, log_level))
+	,manager_ref_(manager_ref)
+	,log_level_(log_level)
+	,thread_stream_map_()
+	,the_lock_()
+#ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+	,stream_serial_(LogStreamSerialNext.fetch_add(1,
+		std::memory_order_relaxed))
+	,life_token_(std::make_shared<int>(0))
+#endif // #ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Where thread-local storage is used, only the calling thread's stream
+	for this instance can be released here. Streams held by other threads
+	are abandoned when next encountered by those threads or at their exit.
+*/
 LogStream::~LogStream()
 {
 	try {
+#ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+		life_token_.reset();
+		if (ThreadCachePtr != NULL) {
+			std::vector<LogStreamThreadEntry> &entry_list =
+				ThreadCachePtr->entry_list_;
+			for (std::size_t count_1 = 0; count_1 < entry_list.size(); ++count_1) {
+				if ((entry_list[count_1].stream_ptr_ == this) &&
+					(entry_list[count_1].stream_serial_ == stream_serial_)) {
+					LogSPtr<ThreadStream> tmp_ptr;
+					tmp_ptr.swap(entry_list[count_1].thread_stream_ptr_);
+					entry_list.erase(entry_list.begin() +
+						static_cast<std::ptrdiff_t>(count_1));
+					ThreadCachePtr->last_index_ = 0;
+					break;
+				}
+			}
+		}
+#endif // #ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
 		LogLockScoped my_lock(the_lock_);
 		thread_stream_map_.clear();
 	}
@@ -295,19 +577,89 @@ LogStream::~LogStream()
 // ////////////////////////////////////////////////////////////////////////////
 void LogStream::LogSeparator(char sep_char, unsigned int text_length)
 {
-	GetThreadStream()->GetBufferPtrRef()->LogSeparator(sep_char, text_length);
+	GetThreadStream().GetBufferPtrRef()->LogSeparator(sep_char, text_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+ThreadStream &LogStream::GetThreadStream()
+{
+#ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+	//	Threads logging after their thread-local storage has been destroyed
+	//	(for example, from static destructors) fall back to the mapped case.
+	if (!ThreadCacheGone)
+		return(GetThreadStreamLocal());
+#endif // #ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+
+	return(GetThreadStreamMapped());
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Lock-free: the cache is private to the calling thread. The common case
+	of repeated use of the same LogStream is satisfied by the first test.
+*/
+ThreadStream &LogStream::GetThreadStreamLocal()
+{
+	LogStreamThreadCache              &thread_cache = ThreadCache;
+	std::vector<LogStreamThreadEntry> &entry_list   = thread_cache.entry_list_;
+
+	if (thread_cache.last_index_ < entry_list.size()) {
+		LogStreamThreadEntry &this_entry = entry_list[thread_cache.last_index_];
+		if ((this_entry.stream_ptr_ == this) &&
+			(this_entry.stream_serial_ == stream_serial_))
+			return(*this_entry.thread_stream_ptr_);
+	}
+
+	std::size_t count_1 = 0;
+
+	while (count_1 < entry_list.size()) {
+		LogStreamThreadEntry &this_entry = entry_list[count_1];
+		if ((this_entry.stream_ptr_ == this) &&
+			(this_entry.stream_serial_ == stream_serial_)) {
+			thread_cache.last_index_ = count_1;
+			return(*this_entry.thread_stream_ptr_);
+		}
+		if (this_entry.life_token_.expired()) {
+			//	The owning LogStream has been destroyed...
+			this_entry.thread_stream_ptr_->GetBufferPtrRef()->Abandon();
+			entry_list.erase(entry_list.begin() +
+				static_cast<std::ptrdiff_t>(count_1));
+		}
+		else
+			++count_1;
+	}
+
+	ThreadStreamBufferPtr buffer_ptr(
+									new ThreadStreamBuffer(manager_ref_, log_level_));
+	LogStreamThreadEntry  new_entry;
+
+	new_entry.stream_ptr_        = this;
+	new_entry.stream_serial_     = stream_serial_;
+	new_entry.life_token_        = life_token_;
+	new_entry.thread_stream_ptr_.reset(
+		new ThreadStream(manager_ref_, log_level_, buffer_ptr));
+
+	entry_list.push_back(new_entry);
+
+	thread_cache.last_index_ = entry_list.size() - 1;
+
+	return(*entry_list.back().thread_stream_ptr_);
 }
 // ////////////////////////////////////////////////////////////////////////////
+#endif // #ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
 
 // ////////////////////////////////////////////////////////////////////////////
-LogStream::ThreadStreamPtr LogStream::GetThreadStream()
+ThreadStream &LogStream::GetThreadStreamMapped()
 {
 	LogLockScoped       my_lock(the_lock_);
 	ThreadId            thread_id(CurrentThreadId());
 	ThreadStreamMapIter iter_f(thread_stream_map_.find(thread_id));
 
 	if (iter_f != thread_stream_map_.end())
-		return(iter_f->second);
+		return(*iter_f->second);
 
 	ThreadStreamBufferPtr buffer_ptr(
 									new ThreadStreamBuffer(manager_ref_, log_level_));
@@ -317,7 +669,7 @@ LogStream::ThreadStreamPtr LogStream::GetThreadStream()
 
 	thread_stream_map_[thread_id] = ostream_ptr;
 
-	return(ostream_ptr);
+	return(*ostream_ptr);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -337,6 +689,248 @@ LogStream::ThreadStreamPtr LogStream::GetThreadStream()
 #include <Logger/LogManager.hpp>
 #include <Logger/LogTestSupport.hpp>
 
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+LogManagerMacroDeclaration(MB_LIB_LOCAL)
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+unsigned int TEST_EvaluationCount = 0;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const char *TEST_CountEvaluation()
+{
+	++TEST_EvaluationCount;
+
+	return("Guarded log statement argument evaluated.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_GuardedStatements()
+{
+	using namespace MLB::Utility;
+
+	LogLevelPair old_levels_console = MyLogManager.GetLogLevelConsole();
+	LogLevelPair old_levels_file    = MyLogManager.GetLogLevelFile();
+
+	MyLogManager.SetLogLevelConsole(LogLevel_Info);
+	MyLogManager.SetLogLevelFile(LogLevel_Info);
+
+	TEST_EvaluationCount = 0;
+
+	if (MyLogManager.IsLevelEnabled(LogLevel_Spam) || LogSpam.IsEnabled() ||
+		(!LogInfo.IsEnabled()))
+		throw std::logic_error("LogManager::IsLevelEnabled() returned an "
+			"incorrect result.");
+
+	LogIfSpam     << TEST_CountEvaluation() << std::endl;
+	LogIfMinutiae << TEST_CountEvaluation() << std::endl;
+	if (TEST_EvaluationCount)
+		throw std::logic_error("Arguments of disabled guarded log statements "
+			"were evaluated.");
+
+	if (TEST_EvaluationCount)
+		LogIfInfo << "Not reached." << std::endl;
+	else
+		LogIfInfo << TEST_CountEvaluation() << std::endl;
+	if (TEST_EvaluationCount != 1)
+		throw std::logic_error("The argument of an enabled guarded log "
+			"statement was not evaluated.");
+
+	MyLogManager.SetLogLevelConsole(old_levels_console.first,
+		old_levels_console.second);
+	MyLogManager.SetLogLevelFile(old_levels_file.first, old_levels_file.second);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_LineAssembly()
+{
+	using namespace MLB::Utility;
+
+	LogSPtr<LogHandlerCapture> capture_ptr(new LogHandlerCapture);
+	LogManager                 log_manager(capture_ptr);
+	std::string                long_text(
+		(ThreadStreamBuffer::PutAreaSize * 3) + 7, 'L');
+
+	{
+		ThreadStream  thread_stream(log_manager, LogLevel_Info);
+		std::ostream &o_str(thread_stream);
+		o_str << "Line " << 1 << std::endl;
+		o_str << "Line 2\nLine 3\n\nLine 5" << std::endl;
+		for (const char *char_ptr = "Line 6\nLine 7\n"; *char_ptr; ++char_ptr)
+			o_str.put(*char_ptr);
+		for (std::size_t count_1 = 0; count_1 < long_text.size(); ++count_1)
+			o_str.put(long_text[count_1]);
+		o_str << std::endl;
+		o_str << "Partial " << 9.5;
+		o_str.flush();
+		o_str << "Unterminated";
+	}
+
+	std::vector<std::string> expected_list = {
+		"Line 1", "Line 2", "Line 3", "", "Line 5", "Line 6", "Line 7",
+		long_text, "Partial 9.5", "Unterminated"
+	};
+
+	std::vector<std::string> line_list(TEST_GetCapturedMessages(*capture_ptr));
+
+	if (line_list != expected_list) {
+		std::ostringstream o_str;
+		o_str << "ThreadStreamBuffer line assembly failed: expected " <<
+			expected_list.size() << " lines, emitted " << line_list.size() <<
+			":";
+		for (const auto &this_line : line_list)
+			o_str << " [" << this_line.substr(0, 40) << "]";
+		throw std::logic_error(o_str.str());
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Holds each line until another thread is also in EmitLine (or a timeout).
+class TEST_RendezvousHandler : public MLB::Utility::LogHandler {
+public:
+	TEST_RendezvousHandler()
+		:MLB::Utility::LogHandler()
+		,in_flight_(0)
+		,max_in_flight_(0)
+		,line_count_(0)
+	{
+	}
+
+	void EmitLine(const MLB::Utility::LogEmitControl &) override {
+		unsigned int in_flight = in_flight_.fetch_add(1) + 1;
+		for (int count_1 = 0; (count_1 < 2000) && (in_flight < 2); ++count_1) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			in_flight = in_flight_.load();
+		}
+		unsigned int max_in_flight = max_in_flight_.load();
+		while ((in_flight > max_in_flight) &&
+			(!max_in_flight_.compare_exchange_weak(max_in_flight, in_flight)))
+			;
+		++line_count_;
+		in_flight_.fetch_sub(1);
+	}
+	void EmitLiteral(unsigned int, const char *) override {
+	}
+	void EmitLiteral(const MLB::Utility::LogEmitControl &, unsigned int,
+		const char *) override {
+	}
+
+	std::atomic<unsigned int> in_flight_;
+	std::atomic<unsigned int> max_in_flight_;
+	std::atomic<unsigned int> line_count_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Counts lines, and separately those which arrive after RemoveHandler().
+class TEST_LineCounter : public MLB::Utility::LogHandler {
+public:
+	TEST_LineCounter()
+		:MLB::Utility::LogHandler()
+		,line_count_(0)
+		,removed_count_(0)
+		,installed_flag_(false)
+	{
+	}
+
+	void InstallHandler() override {
+		installed_flag_.store(true);
+	}
+	void RemoveHandler() override {
+		installed_flag_.store(false);
+	}
+	void EmitLine(const MLB::Utility::LogEmitControl &) override {
+		//	Widens the window in which a swap could remove this handler...
+		std::this_thread::yield();
+		if (installed_flag_.load())
+			line_count_.fetch_add(1, std::memory_order_relaxed);
+		else
+			removed_count_.fetch_add(1, std::memory_order_relaxed);
+	}
+	void EmitLiteral(unsigned int, const char *) override {
+	}
+	void EmitLiteral(const MLB::Utility::LogEmitControl &, unsigned int,
+		const char *) override {
+	}
+
+	std::atomic<unsigned int> line_count_;
+	std::atomic<unsigned int> removed_count_;
+	std::atomic<bool>         installed_flag_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_ConcurrentDispatch()
+{
+	using namespace MLB::Utility;
+
+	//	Two threads must be able to be in the handler at once...
+	{
+		LogSPtr<TEST_RendezvousHandler> handler_ptr(new TEST_RendezvousHandler);
+		LogManager                      log_manager(handler_ptr);
+		LogStream                       log_info(log_manager, LogLevel_Info);
+		std::vector<std::thread>        thread_list;
+		for (int count_1 = 0; count_1 < 2; ++count_1)
+			thread_list.emplace_back([&log_info]() {
+				log_info << "Concurrent line" << std::endl;
+			});
+		for (auto &this_thread : thread_list)
+			this_thread.join();
+		if (handler_ptr->max_in_flight_.load() != 2)
+			throw std::logic_error("Handler calls were serialized by the log "
+				"manager.");
+	}
+
+	//	Handlers swapped while threads are emitting lose no lines...
+	{
+		const unsigned int        thread_count = 4;
+		const unsigned int        line_count   = 5000;
+		LogSPtr<TEST_LineCounter> handler_list[2] = {
+			LogSPtr<TEST_LineCounter>(new TEST_LineCounter),
+			LogSPtr<TEST_LineCounter>(new TEST_LineCounter)
+		};
+		LogManager                log_manager(handler_list[0]);
+		LogStream                 log_info(log_manager, LogLevel_Info);
+		std::atomic<unsigned int> done_count(0);
+		std::vector<std::thread>  thread_list;
+		for (unsigned int count_1 = 0; count_1 < thread_count; ++count_1)
+			thread_list.emplace_back([&log_info, &done_count, line_count]() {
+				for (unsigned int count_2 = 0; count_2 < line_count; ++count_2)
+					log_info << "Swapped line " << count_2 << std::endl;
+				++done_count;
+			});
+		for (unsigned int count_1 = 0; done_count.load() < thread_count;
+			++count_1)
+			log_manager.HandlerInstall(handler_list[count_1 % 2]);
+		for (auto &this_thread : thread_list)
+			this_thread.join();
+		unsigned int total_count   = 0;
+		unsigned int removed_count = 0;
+		for (const auto &this_handler : handler_list) {
+			total_count   += this_handler->line_count_.load();
+			removed_count += this_handler->removed_count_.load();
+		}
+		if ((total_count != (thread_count * line_count)) || removed_count)
+			throw std::logic_error("Expected " +
+				std::to_string(thread_count * line_count) + " lines across "
+				"handler swaps, but " + std::to_string(total_count) +
+				" were emitted to installed handlers and " +
+				std::to_string(removed_count) + " to removed handlers.");
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
 // ////////////////////////////////////////////////////////////////////////////
 int main()
 {
@@ -353,6 +947,9 @@ int main()
 		LogHandlerPtr my_log_handler(
 			new LogHandlerFile(TEST_GetLogFileName("LogManager")));
 		TEST_TestControl(my_log_handler, 0, 0, 0, 0);
+		TEST_GuardedStatements();
+		TEST_LineAssembly();
+		TEST_ConcurrentDispatch();
 	}
 	catch (const std::exception &except) {
 		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
@@ -0,0 +1,279 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogRateLimit.cpp
+
+   File Description  :  Implementation of per-call-site rate limiting and
+                        duplicate suppression of log statements.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogManager.hpp>
+
+#include <stdexcept>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Call sites are pushed onto the head of the list as they are constructed
+	and are never removed: they live in static storage.
+*/
+std::atomic<LogRateLimiter *> RateLimiterListHead(nullptr);
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+LogRateLimiter::LogRateLimiter(LogStream &log_stream, const char *file_name,
+	int line_number, unsigned int burst_count, double per_second,
+	double report_seconds)
+	:log_stream_(log_stream)
+	,file_name_((file_name == NULL) ? "" : file_name)
+	,line_number_(line_number)
+	,interval_ns_(0)
+	,tolerance_ns_(0)
+	,report_ns_(0)
+	,arrival_ns_(0)
+	,next_report_ns_(0)
+	,last_hash_(0)
+	,limited_count_(0)
+	,repeat_count_(0)
+	,next_ptr_(NULL)
+{
+	if (burst_count < 1)
+		throw std::invalid_argument("The burst count for the rate-limited log "
+			"statement at " + std::string(file_name_) + ":" +
+			std::to_string(line_number_) + " is zero.");
+
+	if (!(per_second > 0.0))
+		throw std::invalid_argument("The rate for the rate-limited log "
+			"statement at " + std::string(file_name_) + ":" +
+			std::to_string(line_number_) + " (" + std::to_string(per_second) +
+			" per second) is not greater than zero.");
+
+	if (!(report_seconds > 0.0))
+		throw std::invalid_argument("The report interval for the rate-limited "
+			"log statement at " + std::string(file_name_) + ":" +
+			std::to_string(line_number_) + " (" +
+			std::to_string(report_seconds) + " seconds) is not greater than "
+			"zero.");
+
+	interval_ns_  = std::max<std::int64_t>(1,
+		static_cast<std::int64_t>(1.0e9 / per_second));
+	tolerance_ns_ = interval_ns_ * static_cast<std::int64_t>(burst_count - 1);
+	report_ns_    = static_cast<std::int64_t>(report_seconds * 1.0e9);
+
+	next_report_ns_.store(GetNowNanoseconds() + report_ns_,
+		std::memory_order_relaxed);
+
+	next_ptr_ = RateLimiterListHead.load(std::memory_order_relaxed);
+
+	while (!RateLimiterListHead.compare_exchange_weak(next_ptr_, this,
+		std::memory_order_release, std::memory_order_relaxed))
+		;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool LogRateLimiter::ReportIfPending(std::int64_t now_ns, bool force_flag)
+{
+	if ((!limited_count_.load(std::memory_order_relaxed)) &&
+		(!repeat_count_.load(std::memory_order_relaxed)))
+		return(false);
+
+	std::int64_t next_report_ns =
+		next_report_ns_.load(std::memory_order_relaxed);
+
+	if (force_flag)
+		next_report_ns_.store(now_ns + report_ns_, std::memory_order_relaxed);
+	else if ((now_ns < next_report_ns) ||
+		(!next_report_ns_.compare_exchange_strong(next_report_ns,
+		now_ns + report_ns_, std::memory_order_relaxed)))
+		return(false);
+
+	std::uint64_t repeat_count  =
+		repeat_count_.exchange(0, std::memory_order_relaxed);
+	std::uint64_t limited_count =
+		limited_count_.exchange(0, std::memory_order_relaxed);
+
+	if (repeat_count)
+		log_stream_ << "Last message repeated " << repeat_count << " time" <<
+			((repeat_count == 1) ? "" : "s") << " [" << file_name_ << ":" <<
+			line_number_ << "]." << std::endl;
+
+	if (limited_count)
+		log_stream_ << "Rate limit suppressed " << limited_count <<
+			" message" << ((limited_count == 1) ? "" : "s") << " [" <<
+			file_name_ << ":" << line_number_ << "]." << std::endl;
+
+	return((repeat_count != 0) || (limited_count != 0));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogRateLimiter *LogRateLimiter::GetFirst()
+{
+	return(RateLimiterListHead.load(std::memory_order_acquire));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+std::size_t LogRateLimitReport(bool force_flag)
+{
+	std::int64_t now_ns       = LogRateLimiter::GetNowNanoseconds();
+	std::size_t  report_count = 0;
+
+	for (LogRateLimiter *limiter_ptr = LogRateLimiter::GetFirst();
+		limiter_ptr != NULL; limiter_ptr = limiter_ptr->GetNext()) {
+		if (limiter_ptr->ReportIfPending(now_ns, force_flag))
+			++report_count;
+	}
+
+	return(report_count);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#ifdef TEST_MAIN
+
+#include <Logger/LogTestSupport.hpp>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_RateLimit()
+{
+	using namespace MLB::Utility;
+
+	LogSPtr<LogHandlerCapture> capture_ptr(new LogHandlerCapture);
+	LogManager                 log_manager(capture_ptr);
+	LogStream                  log_info(log_manager, LogLevel_Info);
+
+	//	A burst of 5, then no more than one per 100 seconds...
+	for (int count_1 = 0; count_1 < 1000; ++count_1)
+		LogIfLimited(LogLevel_Info, log_info, 5, 0.01) << "Storm line " <<
+			count_1 << std::endl;
+
+	TEST_ExpectCount("Rate-limited lines emitted",
+		capture_ptr->Count("Storm line "), 5);
+	TEST_ExpectCount("Rate-limit reports during storm",
+		capture_ptr->Count("Rate limit suppressed "), 0);
+	TEST_ExpectCount("Sites with pending reports", LogRateLimitReport(true),
+		1);
+	TEST_ExpectCount("Rate-limit reports after storm",
+		capture_ptr->Count("Rate limit suppressed 995 messages"), 1);
+	TEST_ExpectCount("Sites with pending reports", LogRateLimitReport(true),
+		0);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_RateLimitThreaded()
+{
+	using namespace MLB::Utility;
+
+	LogSPtr<LogHandlerCapture> capture_ptr(new LogHandlerCapture);
+	LogManager                 log_manager(capture_ptr);
+	LogStream                  log_info(log_manager, LogLevel_Info);
+	std::vector<std::thread>   thread_list;
+
+	//	Many threads on one call site: no more than the burst gets through...
+
+	for (int count_1 = 0; count_1 < 4; ++count_1)
+		thread_list.emplace_back([&log_info]() {
+			for (int count_2 = 0; count_2 < 10000; ++count_2)
+				LogIfLimited(LogLevel_Info, log_info, 10, 0.01) <<
+					"Threaded storm line" << std::endl;
+		});
+
+	for (auto &this_thread : thread_list)
+		this_thread.join();
+
+	TEST_ExpectCount("Threaded rate-limited lines emitted",
+		capture_ptr->Count("Threaded storm line"), 10);
+	LogRateLimitReport(true);
+	TEST_ExpectCount("Threaded rate-limit reports",
+		capture_ptr->Count("Rate limit suppressed 39990 messages"), 1);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Duplicates()
+{
+	using namespace MLB::Utility;
+
+	LogSPtr<LogHandlerCapture> capture_ptr(new LogHandlerCapture);
+	LogManager                 log_manager(capture_ptr);
+	LogStream                  log_info(log_manager, LogLevel_Info);
+
+	for (int count_1 = 0; count_1 < 3; ++count_1) {
+		for (int count_2 = 0; count_2 < 100; ++count_2)
+			LogDeferredLimited(LogLevel_Info, log_info, 100, 1000.0,
+				"Check {} failed with code {}", "mfstore", count_1);
+	}
+
+	TEST_ExpectCount("Distinct lines emitted",
+		capture_ptr->Count("Check mfstore failed with code "), 3);
+	TEST_ExpectCount("Repeat reports emitted",
+		capture_ptr->Count("Last message repeated 99 times"), 2);
+	TEST_ExpectCount("Sites with pending reports", LogRateLimitReport(true),
+		1);
+	TEST_ExpectCount("Repeat reports emitted",
+		capture_ptr->Count("Last message repeated 99 times"), 3);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_RateLimit();
+		TEST_RateLimitThreaded();
+		TEST_Duplicates();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
@@ -0,0 +1,71 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Program File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogShardMerge.cpp
+
+   File Description  :  Merges the shards of a sharded text log into a single
+                        time-ordered log.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerFileShard.hpp>
+
+#include <cstring>
+#include <iostream>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Usage: LogShardMerge <log-shard-file> [ ... ]
+
+	The merged log is written to the standard output.
+*/
+int main(int argc, char **argv)
+{
+	using namespace MLB::Utility;
+
+	int                      return_code = EXIT_SUCCESS;
+	std::vector<std::string> file_name_list;
+
+	try {
+		for (int count_1 = 1; count_1 < argc; ++count_1) {
+			if ((!::strcmp(argv[count_1], "-h")) ||
+				(!::strcmp(argv[count_1], "-help"))) {
+				std::cout << "Usage: " << argv[0] <<
+					" <log-shard-file> [ ... ]" << std::endl;
+				return(EXIT_SUCCESS);
+			}
+			file_name_list.push_back(argv[count_1]);
+		}
+		if (file_name_list.empty())
+			throw std::invalid_argument("No log shard files were specified.");
+		LogShardMerge(file_name_list, std::cout);
+		std::cout.flush();
+	}
+	catch (const std::exception &except) {
+		std::cerr << std::endl << std::endl << "ERROR: " << except.what() <<
+			std::endl;
+		return_code = EXIT_FAILURE;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
@@ -0,0 +1,149 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogTag.cpp
+
+   File Description  :  Implementation of log tags.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogTag.hpp>
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The overrides by tag name, including those of tags not yet constructed,
+	and the tags which exist. Returned by a function so that tags may be
+	constructed during static initialization.
+*/
+struct TagRegistry {
+	std::mutex                             registry_lock_;
+	std::map<std::string, LogTagOverride>  override_map_;
+	std::multimap<std::string, LogTag *>   tag_map_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+TagRegistry &GetTagRegistry()
+{
+	static TagRegistry tag_registry;
+
+	return(tag_registry);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+LogTag::LogTag(const char *tag_name)
+	:tag_name_(tag_name)
+	,override_(LogTagOverride_None)
+{
+	if ((tag_name == NULL) || (!(*tag_name)))
+		throw std::invalid_argument("The name of a log tag is empty.");
+
+	TagRegistry                 &tag_registry(GetTagRegistry());
+	std::lock_guard<std::mutex>  my_lock(tag_registry.registry_lock_);
+	auto                         iter_f(tag_registry.override_map_.find(
+		tag_name_));
+
+	if (iter_f != tag_registry.override_map_.end())
+		override_.store(iter_f->second, std::memory_order_relaxed);
+
+	tag_registry.tag_map_.insert(std::make_pair(std::string(tag_name_), this));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+LogTag::~LogTag()
+{
+	TagRegistry                 &tag_registry(GetTagRegistry());
+	std::lock_guard<std::mutex>  my_lock(tag_registry.registry_lock_);
+	auto                         tag_range(
+		tag_registry.tag_map_.equal_range(tag_name_));
+
+	for (auto iter_f = tag_range.first; iter_f != tag_range.second; ++iter_f) {
+		if (iter_f->second == this) {
+			tag_registry.tag_map_.erase(iter_f);
+			break;
+		}
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogTag::SetOverride(const char *tag_name, LogTagOverride tag_override)
+{
+	if ((tag_name == NULL) || (!(*tag_name)))
+		throw std::invalid_argument("The name of a log tag is empty.");
+
+	TagRegistry                 &tag_registry(GetTagRegistry());
+	std::lock_guard<std::mutex>  my_lock(tag_registry.registry_lock_);
+
+	if (tag_override & LogTagOverride_Active)
+		tag_registry.override_map_[tag_name] = tag_override;
+	else {
+		tag_override = LogTagOverride_None;
+		tag_registry.override_map_.erase(tag_name);
+	}
+
+	auto tag_range(tag_registry.tag_map_.equal_range(tag_name));
+
+	for (auto iter_f = tag_range.first; iter_f != tag_range.second; ++iter_f)
+		iter_f->second->override_.store(tag_override, std::memory_order_relaxed);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogTag::ClearOverride(const char *tag_name)
+{
+	SetOverride(tag_name, LogTagOverride_None);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void LogTag::ClearOverrideAll()
+{
+	TagRegistry                 &tag_registry(GetTagRegistry());
+	std::lock_guard<std::mutex>  my_lock(tag_registry.registry_lock_);
+
+	for (auto &this_tag : tag_registry.tag_map_)
+		this_tag.second->override_.store(LogTagOverride_None,
+			std::memory_order_relaxed);
+
+	tag_registry.override_map_.clear();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
@@ -365,6 +365,34 @@ LogInfo    << std::string("std::string(hello, world)") << std::endl;
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_ExpectCount(const char *test_name, std::size_t actual,
+	std::size_t expected)
+{
+	if (actual != expected)
+		throw std::logic_error(std::string(test_name) + ": expected " +
+			std::to_string(expected) + " but found " + std::to_string(actual) +
+			".");
+
+	std::cout << test_name << ": " << actual << std::endl;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Returns the messages of the records retained by the handler, oldest first.
+std::vector<std::string> TEST_GetCapturedMessages(
+	const LogHandlerCapture &capture_handler)
+{
+	std::vector<std::string> message_list;
+
+	capture_handler.Visit([&message_list](const LogCaptureRecord &this_record) {
+		message_list.emplace_back(this_record.message_);
+	});
+
+	return(message_list);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 } // namespace Utility
 
 } // namespace MLB
@@ -36,6 +36,7 @@
 #include <Utility/ThrowErrno.hpp>
 #include <Utility/ThrowSystemError.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 // ////////////////////////////////////////////////////////////////////////////
@@ -164,6 +165,52 @@ MFStoreControl CreateMFStoreAdjusted(const std::string &file_name,
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreControl CreateMFStore(const std::string &file_name,
+	const MFStoreSectionList &section_list, MFStoreLen mmap_size,
+	MFStoreLen storage_gran)
+{
+	MFStoreControl     mfstore_ctl;
+	MFStoreSectionList full_list;
+
+	try {
+		CheckStorageGranularity(storage_gran);
+		full_list.reserve(MFStoreHeader::FirstUserSectionIndex +
+			section_list.size());
+		full_list.emplace_back(0, sizeof(MFStoreHeader), 1, 0, 0, 0, 0, 0,
+			"MFStore Header");
+		full_list.emplace_back(0, sizeof(MFStoreSection),
+			MFStoreHeader::FirstUserSectionIndex + section_list.size(),
+			0, 0, 0, 0, 0, "MFStore Section List");
+		full_list.insert(full_list.end(), section_list.begin(),
+			section_list.end());
+		MFStoreSection::FixupSectionList(full_list, storage_gran);
+		MFStoreLen file_size = full_list.back().CalcNextOffset();
+		mmap_size            = std::max(mmap_size, file_size);
+		mfstore_ctl = CreateMFStore(file_name, file_size, mmap_size,
+			storage_gran);
+		MFStoreHeader  *header_ptr  = mfstore_ctl.GetPtr<MFStoreHeader>(0);
+		MFStoreSection *section_ptr = mfstore_ctl.GetPtr<MFStoreSection>(
+			full_list[MFStoreHeader::SectionListSectionIndex].section_offset_);
+		header_ptr->Initialize(storage_gran, mmap_size, full_list);
+		std::copy(full_list.begin(), full_list.end(), section_ptr);
+		header_ptr->SetChecksum(section_ptr);
+		std::atomic_ref<uint64_t>(header_ptr->magic_).store(
+			MFStoreHeader::Magic, std::memory_order_release);
+		mfstore_ctl.SetSectionList(full_list);
+		mfstore_ctl.CheckSectionList();
+	}
+	catch (const std::exception &except) {
+		throw std::runtime_error("Unable to create file '" + file_name +
+			"' with a list of " + std::to_string(section_list.size()) +
+			" sections and a mmap size of " + std::to_string(mmap_size) +
+			" bytes: " + std::string(except.what()));
+	}
+
+	return(mfstore_ctl);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 } // namespace MFStore
 
 } // namespace MLB
@@ -185,6 +232,8 @@ MFStoreControl CreateMFStoreAdjusted(const std::string &file_name,
 
 #include <Utility/TimeSpec.hpp>
 
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 
 using namespace MLB::Utility;
@@ -193,11 +242,12 @@ using namespace MLB::MFStore;
 namespace {
 
 // ////////////////////////////////////////////////////////////////////////////
+/*
+	The header and section list sections are added by CreateMFStore().
+*/
 const MFStoreSection TEST_SectionList[] =
 {
-	 MFStoreSection( 0,                   1234,      1, 0, 0, 0, 0, 0, "Header")
-	,MFStoreSection( 0, sizeof(MFStoreSection),      8, 0, 0, 0, 0, 0, "Section List")
-	,MFStoreSection( 0,                      4,      6, 0, 0, 0, 0, 0, "Type Info")
+	 MFStoreSection( 0,                      4,      6, 0, 0, 0, 0, 0, "Type Info")
 	,MFStoreSection( 0,                    150, 112233, 0, 0, 0, 0, 0, "Info List All")
 	,MFStoreSection( 0,                    987, 112233, 0, 0, 0, 0, 0, "Info Serial")
 	,MFStoreSection( 0,                    150,   1024, 0, 0, 0, 0, 0, "Info List Sub")
@@ -210,32 +260,27 @@ const std::size_t TEST_SectionCount  =
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-MFStoreSectionList TEST_CreateSections()
+void TEST_CheckOpenFails(const std::string &file_name, const char *test_name)
 {
-	MFStoreSectionList section_list;
-
-	for (std::size_t section_idx = 0; section_idx < TEST_SectionCount;
-		++section_idx)
-		MFStoreSection::AppendSection(TEST_SectionList[section_idx],
-			section_list);
-
-	MFStoreSection::FixupSectionList(section_list);
-
-	MFStoreSection::CheckSectionList(1, section_list);
-
-//	MFStoreSection::ToStreamTabular(section_list) << '\n';
+	try {
+		MFStoreControl mfstore_ctl(file_name, false);
+	}
+	catch (const std::exception &except) {
+		std::cout << "Open with " << test_name << " failed as expected: " <<
+			except.what() << '\n';
+		return;
+	}
 
-	return(section_list);
+	throw std::logic_error("Open with " + std::string(test_name) +
+		" succeeded.");
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 void TEST_CreateMFStore(bool reuse_file_name = false, uint64_t mmap_size = 0)
 {
-reuse_file_name = true;
-	MFStoreSectionList section_list = TEST_CreateSections();
-
-	MFStoreSection::ToStreamTabular(section_list) << '\n';
+	MFStoreSectionList section_list(TEST_SectionList,
+		TEST_SectionList + TEST_SectionCount);
 
 	std::string file_name(
 		[](bool reuse_file_name_flag)
@@ -259,27 +304,59 @@ reuse_file_name = true;
 		}(reuse_file_name)
 	);
 
-	MFStoreLen file_size = section_list.back().section_offset_ +
-		section_list.back().length_padded_;
+	if (reuse_file_name)
+		std::filesystem::remove(file_name);
 
-	mmap_size = (!mmap_size) ? file_size : mmap_size;
+	std::cout << "Creating file '" << file_name << "' with " <<
+		section_list.size() << " sections and mmap size " << mmap_size <<
+		" ..." << std::flush;
 
-	std::cout << "Creating file '" << file_name << "' with file size " <<
-		file_size << " and mmap size " << mmap_size << " ..." << std::flush;
+	MFStoreControl mfstore_ctl(CreateMFStore(file_name, section_list,
+		mmap_size));
 
-	MFStoreControl mfstore_ctl(CreateMFStore(file_name, file_size, mmap_size));
-
-	mfstore_ctl.SetSectionList(section_list);
 	mfstore_ctl.CheckSectionList();
 
 	std::cout << " done.\n" << std::endl;
 
+	MFStoreSection::ToStreamTabular(mfstore_ctl.GetSectionList()) << '\n';
+
 	std::cout << "GetFileName   : " << mfstore_ctl.GetFileName()    << '\n';
 	std::cout << "GetFileHandle : " << mfstore_ctl.GetFileHandle()  << '\n';
 	std::cout << "GetFileSize   : " << mfstore_ctl.GetFileSize()    << '\n';
 	std::cout << "GetMmapSize   : " << mfstore_ctl.GetMmapSize()    << '\n';
 	std::cout << "GetAllocGran  : " << mfstore_ctl.GetAllocGran()   << '\n';
 	std::cout << "GetMmapAddress: " << mfstore_ctl.GetMmapAddress() << '\n';
+	std::cout << '\n';
+
+	{
+		MFStoreControl reader_ctl(file_name, false);
+		const MFStoreSectionList &src = mfstore_ctl.GetSectionList();
+		const MFStoreSectionList &dst = reader_ctl.GetSectionList();
+		if ((reader_ctl.GetFileSize()  != mfstore_ctl.GetFileSize())  ||
+			 (reader_ctl.GetMmapSize()  != mfstore_ctl.GetMmapSize())  ||
+			 (reader_ctl.GetAllocGran() != mfstore_ctl.GetAllocGran()) ||
+			 (dst.size() != src.size()) ||
+			 ::memcmp(dst.data(), src.data(), src.size() * sizeof(src[0])))
+			throw std::logic_error("The layout of the re-opened file is not "
+				"equal to that of the created file.");
+		std::cout << "Re-opened file '" << file_name << "' for reading with " <<
+			dst.size() << " sections.\n";
+	}
+
+	MFStoreSection *section_ptr = mfstore_ctl.GetPtr<MFStoreSection>(
+		mfstore_ctl.GetHeaderPtr()->section_list_offset_);
+	++section_ptr[MFStoreHeader::FirstUserSectionIndex].element_count_;
+	TEST_CheckOpenFails(file_name, "a modified section table");
+	--section_ptr[MFStoreHeader::FirstUserSectionIndex].element_count_;
+
+	++mfstore_ctl.GetHeaderPtr()->version_;
+	TEST_CheckOpenFails(file_name, "an unsupported version");
+	--mfstore_ctl.GetHeaderPtr()->version_;
+
+	MFStoreControl writer_ctl(file_name, true);
+	std::cout << "Re-opened file '" << file_name << "' for writing.\n";
+
+	std::filesystem::remove(file_name);
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -311,4 +388,3 @@ int main(int argc, char **argv)
 // ////////////////////////////////////////////////////////////////////////////
 
 #endif // #ifdef TEST_MAIN
-
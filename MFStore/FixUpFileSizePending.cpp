@@ -75,20 +75,22 @@ void FixUpFileSizePending(MFStoreControl &mfstore_ctl,
 			file_size_pending = file_size;
 			return;
 		}
-		if (actual_file_size == file_size_pending) {
+		/*
+			The file was extended (possibly only partially, if the increase was
+			interrupted) beyond the stored original file size.
+		*/
 #if MFStore_WITH_LOGGING
-			LogWarning << o_str_header.str() << ": Because the actual file size "
-				"is equal to the stored pending file size, the current logic will "
-				"attempt to ensure allocation of backing storage to the " <<
-				(file_size_pending - file_size) << " bytes between the stored "
-				"original file size and the stored pending file size and, if "
-				"successful, change the stored original file size to the value "
-				"of the pending file size.\n";
+		LogWarning << o_str_header.str() << ": Because the actual file size "
+			"is greater than the stored original file size, the current logic "
+			"will attempt to ensure allocation of backing storage to the " <<
+			(file_size_pending - file_size) << " bytes between the stored "
+			"original file size and the stored pending file size and, if "
+			"successful, change the stored original file size to the value "
+			"of the pending file size.\n";
 #endif // #if MFStore_WITH_LOGGING
-			EnsureFileBackingStore(mfstore_ctl, file_size, file_size_pending);
-			file_size = file_size_pending;
-			return;
-		}
+		EnsureFileBackingStore(mfstore_ctl, file_size,
+			file_size_pending - file_size);
+		file_size = file_size_pending;
 	}
 	catch (const std::exception &except) {
 		std::ostringstream o_str;
@@ -0,0 +1,245 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  IncreaseStorageSize.cpp
+
+   File Description  :  Implementation of the IncreaseStorageSize() function.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/IncreaseStorageSize.hpp>
+
+#include <MFStore/CheckValues.hpp>
+#include <MFStore/EnsureFileBackingStore.hpp>
+
+#include <stdexcept>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreLen IncreaseStorageSize(MFStoreControl &mfstore_ctl,
+	std::atomic<MFStoreLen> &file_size, MFStoreLen &file_size_pending,
+	MFStoreLen desired_file_size, MFStoreLen storage_gran)
+{
+	MFStoreLen old_file_size = file_size.load(std::memory_order_relaxed);
+
+	try {
+		mfstore_ctl.CheckIsWriter();
+		CheckFileSizeAndFileSizePending(old_file_size, file_size_pending,
+			storage_gran);
+		if (desired_file_size == old_file_size)
+			return(old_file_size);
+		else if (desired_file_size < old_file_size)
+			throw std::invalid_argument("The desired file size is less than the "
+				"current file size.");
+		CheckSizeHelper(desired_file_size, storage_gran, "desired file");
+		if (desired_file_size > mfstore_ctl.GetMmapSize())
+			throw std::invalid_argument("The desired file size exceeds the "
+				"memory-mapped size (" +
+				std::to_string(mfstore_ctl.GetMmapSize()) + ").");
+		file_size_pending = desired_file_size;
+		try {
+			EnsureFileBackingStore(mfstore_ctl, old_file_size,
+				desired_file_size - old_file_size);
+		}
+		catch (const std::exception &) {
+			/*
+				Any part of the file which was allocated lies beyond the stored
+				file size and so won't be referenced.
+			*/
+			file_size_pending = old_file_size;
+			throw;
+		}
+		file_size.store(desired_file_size, std::memory_order_release);
+		mfstore_ctl.SetFileSize(desired_file_size);
+	}
+	catch (const std::exception &except) {
+		throw std::runtime_error("Unable to increase the storage size of '" +
+			mfstore_ctl.GetFileName() + "' to the requested size of " +
+			std::to_string(desired_file_size) + " from the current file size "
+			"of " + std::to_string(old_file_size) + ": " +
+			std::string(except.what()));
+	}
+
+	return(desired_file_size);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreLen IncreaseStorageSize(MFStoreControl &mfstore_ctl,
+	MFStoreLen desired_file_size)
+{
+	MFStoreHeader *header_ptr = mfstore_ctl.GetHeaderPtr();
+
+	return(IncreaseStorageSize(mfstore_ctl, header_ptr->file_size_,
+		header_ptr->file_size_pending_, desired_file_size,
+		mfstore_ctl.GetAllocGran()));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <MFStore/CreateMFStore.hpp>
+#include <MFStore/FixUpFileSizePending.hpp>
+#include <MFStore/MFStoreTestSupport.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+using namespace MLB::MFStore;
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+struct TEST_StoreHeader {
+	std::atomic<MFStoreLen> file_size_;
+	MFStoreLen              file_size_pending_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreLen TEST_ActualFileSize(const std::string &file_name)
+{
+	return(static_cast<MFStoreLen>(std::filesystem::file_size(file_name)));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_IncreaseStorageSize()
+{
+	const std::string file_name("./TEST_MAIN.IncreaseStorageSize.bin");
+	const MFStoreLen  initial_size = MFStoreAllocGran;
+	const MFStoreLen  mmap_size    = 64 * 1024 * 1024;
+	const MFStoreLen  grown_size   = 1024 * 1024;
+	const char       *test_text    = "Written beyond the original file size.";
+
+	std::filesystem::remove(file_name);
+
+	MFStoreControl    writer_ctl(CreateMFStore(file_name, initial_size,
+		mmap_size));
+	TEST_StoreHeader *writer_hdr = new (writer_ctl.GetPtr<char>(0))
+		TEST_StoreHeader{ { initial_size }, initial_size };
+
+	MFStoreControl    reader_ctl(file_name, false, initial_size, mmap_size,
+		MFStoreAllocGran);
+	const TEST_StoreHeader *reader_hdr =
+		reader_ctl.GetPtr<TEST_StoreHeader>(0);
+	const char        *reader_ptr = reader_ctl.GetPtr<char>(grown_size - 4096);
+	void              *reader_address = reader_ctl.GetMmapAddress();
+
+	std::cout << "Increasing the file size from " << initial_size << " to " <<
+		grown_size << " ..." << std::flush;
+	TEST_Check(IncreaseStorageSize(writer_ctl, writer_hdr->file_size_,
+		writer_hdr->file_size_pending_, grown_size, MFStoreAllocGran) ==
+		grown_size, "IncreaseStorageSize() returns the new size");
+	std::cout << " done." << std::endl;
+
+	TEST_Check(writer_ctl.GetFileSize() == grown_size,
+		"the writer file size is updated");
+	TEST_Check(writer_hdr->file_size_pending_ == grown_size,
+		"the pending file size is updated");
+	TEST_Check(TEST_ActualFileSize(file_name) == grown_size,
+		"the file is extended");
+
+	::strcpy(writer_ctl.GetPtr<char>(grown_size - 4096), test_text);
+
+	TEST_Check(reader_ctl.GetFileSize() == initial_size,
+		"the reader file size is unchanged until refreshed");
+	TEST_Check(reader_ctl.RefreshFileSize(reader_hdr->file_size_) ==
+		grown_size, "the reader picks up the new file size");
+	TEST_Check(reader_ctl.GetMmapAddress() == reader_address,
+		"the reader mapping doesn't move");
+	TEST_Check(!::strcmp(reader_ptr, test_text),
+		"the reader sees the new extent through its existing pointer");
+
+	bool threw_flag = false;
+	try {
+		IncreaseStorageSize(writer_ctl, writer_hdr->file_size_,
+			writer_hdr->file_size_pending_, mmap_size + MFStoreAllocGran,
+			MFStoreAllocGran);
+	}
+	catch (const std::exception &) {
+		threw_flag = true;
+	}
+	TEST_Check(threw_flag, "an increase beyond the mmap size is rejected");
+	TEST_Check(writer_hdr->file_size_pending_ == grown_size,
+		"a rejected increase leaves the pending file size unchanged");
+
+	threw_flag = false;
+	try {
+		IncreaseStorageSize(reader_ctl, writer_hdr->file_size_,
+			writer_hdr->file_size_pending_, grown_size * 2, MFStoreAllocGran);
+	}
+	catch (const std::exception &) {
+		threw_flag = true;
+	}
+	TEST_Check(threw_flag, "an increase by a reader is rejected");
+
+	std::cout << "Recovering from an interrupted increase ..." << std::flush;
+	writer_hdr->file_size_pending_ = grown_size * 4;
+	EnsureFileBackingStore(writer_ctl, grown_size, grown_size);
+	FixUpFileSizePending(writer_ctl, writer_hdr->file_size_,
+		writer_hdr->file_size_pending_, MFStoreAllocGran);
+	TEST_Check(writer_hdr->file_size_ == grown_size * 4,
+		"the file size is fixed up to the pending file size");
+	TEST_Check(TEST_ActualFileSize(file_name) == grown_size * 4,
+		"the file is extended to the pending file size");
+	writer_ctl.SetFileSize(writer_hdr->file_size_);
+	std::cout << " done." << std::endl;
+
+	std::filesystem::remove(file_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_IncreaseStorageSize();
+	}
+	catch (const std::exception &except) {
+		return_code = EXIT_FAILURE;
+		std::cerr << "\n\nERROR: " << except.what() << std::endl;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
@@ -9,6 +9,13 @@
 
    Revision History  :  2021-02-14 --- Creation.
                            Michael L. Brock
+                        2026-10-16 --- Online file growth.
+                           Michael L. Brock
+                        2026-10-16 --- Files opened from a persisted header
+                                       and section table.
+                           Michael L. Brock
+                        2026-10-16 --- Section lookup by index or description.
+                           Michael L. Brock
 
       Copyright Michael L. Brock 2021 - 2024.
       Distributed under the Boost Software License, Version 1.0.
@@ -26,9 +33,13 @@
 #include <MFStore/MFStoreControl.hpp>
 
 #include <MFStore/CheckValues.hpp>
+#include <MFStore/FixUpFileSizePending.hpp>
 
 #include <Utility/ArgCheck.hpp>
 
+#include <algorithm>
+#include <filesystem>
+
 // ////////////////////////////////////////////////////////////////////////////
 
 namespace MLB {
@@ -82,10 +93,103 @@ try
 	alloc_gran_ = alloc_gran;
 }
 catch (const std::exception &except) {
-	std::runtime_error("Failed to create interprocess mapping and region for "
-		"'" + file_name + "' with a size of " + std::to_string(file_size) +
-		"bytes and a mmap size of " + std::to_string(mmap_size) + " bytes: " +
-		std::string(except.what()));
+	throw std::runtime_error("Failed to create interprocess mapping and "
+		"region for '" + file_name + "' with a size of " +
+		std::to_string(file_size) + " bytes and a mmap size of " +
+		std::to_string(mmap_size) + " bytes: " + std::string(except.what()));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreControl::MFStoreControl(const std::string &file_name, bool is_writer,
+	MFStoreLen mmap_size)
+try
+	:mapping_sptr_()
+	,region_sptr_()
+	,file_name_()
+	,file_size_(0)
+	,mmap_size_(0)
+	,alloc_gran_(0)
+	,section_list_()
+{
+	using namespace boost::interprocess;
+
+	MLB::Utility::ThrowIfEmpty(file_name, "The MFStore file name");
+
+	MFStoreLen actual_file_size = static_cast<MFStoreLen>(
+		std::filesystem::file_size(std::filesystem::path(file_name)));
+
+	if (actual_file_size < sizeof(MFStoreHeader))
+		throw std::invalid_argument("The file size (" +
+			std::to_string(actual_file_size) + ") is less than the size of the "
+			"MFStore header.");
+
+	FileMappingSPtr  mapping_sptr(
+		std::make_shared<FileMapping>(file_name.c_str(),
+			(is_writer) ? read_write : read_only));
+	MFStoreLen       alloc_gran;
+	MFStoreLen       file_size;
+
+	{
+		MappedRegion         header_region(*mapping_sptr, read_only, 0,
+			sizeof(MFStoreHeader));
+		const MFStoreHeader *header_ptr =
+			static_cast<const MFStoreHeader *>(header_region.get_address());
+		header_ptr->CheckHeader(actual_file_size);
+		alloc_gran = header_ptr->alloc_gran_;
+		file_size  = header_ptr->file_size_.load(std::memory_order_acquire);
+		if (!mmap_size)
+			mmap_size = std::max(header_ptr->mmap_size_,
+				header_ptr->file_size_pending_);
+	}
+
+	CheckInitialFileAndMmapSizes(file_size, mmap_size, alloc_gran);
+
+	MappedRegionSPtr region_sptr(
+		std::make_shared<MappedRegion>(*mapping_sptr,
+			(is_writer) ? read_write : read_only, 0, mmap_size));
+
+	mapping_sptr_.swap(mapping_sptr);
+	region_sptr_.swap(region_sptr);
+
+	file_name_  = file_name;
+	file_size_  = file_size;
+	mmap_size_  = mmap_size;
+	alloc_gran_ = alloc_gran;
+
+	MFStoreHeader        *header_ptr  = GetPtr<MFStoreHeader>(0);
+	const MFStoreSection *section_ptr =
+		GetPtr<MFStoreSection>(header_ptr->section_list_offset_);
+
+	header_ptr->CheckChecksum(section_ptr);
+
+	MFStoreSectionList section_list(section_ptr,
+		section_ptr + header_ptr->section_count_);
+
+	MFStoreSection::CheckSectionList(MFStoreHeader::SectionListSectionIndex,
+		section_list, alloc_gran);
+	CheckSectionList(section_list);
+
+	if ((section_list[MFStoreHeader::HeaderSectionIndex].element_size_ !=
+		sizeof(MFStoreHeader)) ||
+		(section_list[MFStoreHeader::SectionListSectionIndex].section_offset_ !=
+		header_ptr->section_list_offset_))
+		throw std::invalid_argument("The section table does not describe the "
+			"MFStore header and section table sections.");
+
+	if (is_writer) {
+		FixUpFileSizePending(*this, header_ptr->file_size_,
+			header_ptr->file_size_pending_, alloc_gran);
+		SetFileSize(header_ptr->file_size_.load(std::memory_order_acquire));
+	}
+
+	section_list_.swap(section_list);
+}
+catch (const std::exception &except) {
+	throw std::runtime_error("Failed to open the existing MFStore file '" +
+		file_name + "' for " + std::string((is_writer) ? "writing" :
+		"reading") + " with a mmap size of " + std::to_string(mmap_size) +
+		" bytes: " + std::string(except.what()));
 }
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -204,6 +308,97 @@ void MFStoreControl::SetSectionList(const MFStoreSectionList &src)
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+const MFStoreSection &MFStoreControl::GetSection(std::size_t section_index)
+	const
+{
+	if (section_index >= section_list_.size())
+		throw std::invalid_argument("The section index (" +
+			std::to_string(section_index) + ") is not less than the number of "
+			"sections in '" + file_name_ + "' (" +
+			std::to_string(section_list_.size()) + ").");
+
+	return(section_list_[section_index]);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const MFStoreSection &MFStoreControl::GetSection(
+	const std::string &description) const
+{
+	for (const auto &this_section : section_list_) {
+		if (description == this_section.description_)
+			return(this_section);
+	}
+
+	throw std::invalid_argument("No section with the description '" +
+		description + "' is present in '" + file_name_ + "'.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void MFStoreControl::SetFileSize(MFStoreLen file_size)
+{
+	CheckIsActive();
+
+	try {
+		CheckFileSize(file_size, alloc_gran_);
+		if (file_size < file_size_)
+			throw std::invalid_argument("The file size may not be decreased "
+				"from its current value (" + std::to_string(file_size_) + ").");
+		if (file_size > mmap_size_)
+			throw std::invalid_argument("The file size exceeds the memory-mapped "
+				"size (" + std::to_string(mmap_size_) + "); the file must be "
+				"re-opened with a larger memory-mapped size.");
+	}
+	catch (const std::exception &except) {
+		throw std::invalid_argument("Unable to set the file size for '" +
+			file_name_ + "' to " + std::to_string(file_size) + ": " +
+			std::string(except.what()));
+	}
+
+	file_size_ = file_size;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Called by readers to pick up a file size increased by the writer (see
+	IncreaseStorageSize()). Returns the file size now in effect.
+*/
+MFStoreLen MFStoreControl::RefreshFileSize(
+	const std::atomic<MFStoreLen> &file_size)
+{
+	MFStoreLen new_file_size = file_size.load(std::memory_order_acquire);
+
+	if (new_file_size != file_size_)
+		SetFileSize(new_file_size);
+
+	return(file_size_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreLen MFStoreControl::RefreshFileSize()
+{
+	return(RefreshFileSize(GetHeaderPtr()->file_size_));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreHeader *MFStoreControl::GetHeaderPtr() const
+{
+	MFStoreHeader *header_ptr = static_cast<MFStoreHeader *>(GetMmapAddress());
+
+	if (std::atomic_ref<const uint64_t>(header_ptr->magic_).load(
+		std::memory_order_acquire) != MFStoreHeader::Magic)
+		throw std::runtime_error("The MFStore file '" + file_name_ + "' was "
+			"not created with a header.");
+
+	return(header_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 // ////////////////////////////////////////////////////////////////////////////
 void MFStoreControl::CheckSectionList() const
 {
@@ -0,0 +1,168 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  MFStoreHeader.cpp
+
+   File Description  :  Implementation of the persistent MFStore file header.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/MFStoreHeader.hpp>
+
+#include <MFStore/CheckValues.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+// 64-bit FNV-1a.
+uint64_t CalcChecksum_Helper(const void *data_ptr, std::size_t data_length,
+	uint64_t checksum = 0xCBF29CE484222325ULL)
+{
+	const unsigned char *tmp_ptr = static_cast<const unsigned char *>(data_ptr);
+	const unsigned char *end_ptr = tmp_ptr + data_length;
+
+	for ( ; tmp_ptr < end_ptr; ++tmp_ptr)
+		checksum = (checksum ^ *tmp_ptr) * 0x00000100000001B3ULL;
+
+	return(checksum);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+void MFStoreHeader::Initialize(MFStoreLen alloc_gran, MFStoreLen mmap_size,
+	const MFStoreSectionList &section_list)
+{
+	if (section_list.size() < FirstUserSectionIndex)
+		throw std::invalid_argument("The section list does not contain the "
+			"header and section list sections.");
+
+	MFStoreLen file_size = section_list.back().CalcNextOffset();
+
+	magic_               = 0;
+	version_             = VersionCurrent;
+	header_size_         = sizeof(MFStoreHeader);
+	section_size_        = sizeof(MFStoreSection);
+	alloc_gran_          = alloc_gran;
+	mmap_size_           = mmap_size;
+	section_count_       = section_list.size();
+	section_list_offset_ =
+		section_list[SectionListSectionIndex].section_offset_;
+	::memset(reserved_, '\0', sizeof(reserved_));
+	checksum_            = 0;
+	file_size_.store(file_size, std::memory_order_relaxed);
+	file_size_pending_   = file_size;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void MFStoreHeader::CheckHeader(MFStoreLen actual_file_size) const
+{
+	try {
+		if (std::atomic_ref<const uint64_t>(magic_).load(
+			std::memory_order_acquire) != Magic)
+			throw std::invalid_argument("The magic number is not that of an "
+				"MFStore file.");
+		if (version_ != VersionCurrent)
+			throw std::invalid_argument("The version (" +
+				std::to_string(version_) + ") is not supported by this "
+				"library (version " + std::to_string(VersionCurrent) + ").");
+		if (header_size_ != sizeof(MFStoreHeader))
+			throw std::invalid_argument("The header size (" +
+				std::to_string(header_size_) + ") is not equal to the size of "
+				"the 'MFStoreHeader' structure (" +
+				std::to_string(sizeof(MFStoreHeader)) + ").");
+		if (section_size_ != sizeof(MFStoreSection))
+			throw std::invalid_argument("The section size (" +
+				std::to_string(section_size_) + ") is not equal to the size of "
+				"the 'MFStoreSection' class (" +
+				std::to_string(sizeof(MFStoreSection)) + ").");
+		CheckStorageGranularity(alloc_gran_);
+		MFStoreLen file_size = file_size_.load(std::memory_order_acquire);
+		CheckFileSizeAndFileSizePendingGE(file_size, file_size_pending_,
+			alloc_gran_);
+		if (file_size > actual_file_size)
+			throw std::invalid_argument("The stored file size (" +
+				std::to_string(file_size) + ") is greater than the actual file "
+				"size (" + std::to_string(actual_file_size) + ").");
+		if (section_count_ < FirstUserSectionIndex)
+			throw std::invalid_argument("The section count (" +
+				std::to_string(section_count_) + ") is less than the number of "
+				"sections required by the library (" +
+				std::to_string(FirstUserSectionIndex) + ").");
+		CheckExtent(file_size, section_list_offset_,
+			section_count_ * sizeof(MFStoreSection));
+	}
+	catch (const std::exception &except) {
+		throw std::invalid_argument("Invalid MFStore file header: " +
+			std::string(except.what()));
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void MFStoreHeader::CheckChecksum(const MFStoreSection *section_ptr) const
+{
+	uint64_t checksum = CalcChecksum(section_ptr);
+
+	if (checksum != checksum_)
+		throw std::invalid_argument("The stored MFStore header checksum (" +
+			std::to_string(checksum_) + ") is not equal to the checksum "
+			"calculated from the header and section table (" +
+			std::to_string(checksum) + ").");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void MFStoreHeader::SetChecksum(const MFStoreSection *section_ptr)
+{
+	checksum_ = CalcChecksum(section_ptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The magic number is excluded because it is stored after the checksum.
+*/
+uint64_t MFStoreHeader::CalcChecksum(const MFStoreSection *section_ptr) const
+{
+	const char *begin_ptr = reinterpret_cast<const char *>(&version_);
+	const char *end_ptr   = reinterpret_cast<const char *>(&checksum_);
+
+	return(CalcChecksum_Helper(section_ptr,
+		section_count_ * sizeof(MFStoreSection),
+		CalcChecksum_Helper(begin_ptr,
+		static_cast<std::size_t>(end_ptr - begin_ptr))));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
@@ -0,0 +1,700 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  MFStoreJournal.cpp
+
+   File Description  :  Implementation of the MFStoreJournal class.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/MFStoreJournal.hpp>
+
+#include <MFStore/IncreaseStorageSize.hpp>
+#include <MFStore/MFStoreSectionView.hpp>
+
+#include <Utility/GranularRound.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif // #ifdef __linux__
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+// ////////////////////////////////////////////////////////////////////////////
+static_assert(sizeof(MFStoreJournalControl) == 64,
+	"The journal control block must occupy a single cache line.");
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+	"The journal commit sequence is shared between processes.");
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+uint64_t CalcRecordSize(std::size_t data_length)
+{
+	return(sizeof(MFStoreJournalRecordHeader) +
+		MLB::Utility::GranularRoundUp<uint64_t>(data_length,
+		MFStoreJournal::RecordAlign));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreJournal::MFStoreJournal()
+	:mfstore_ctl_ptr_(nullptr)
+	,control_ptr_(nullptr)
+	,data_ptr_(nullptr)
+	,data_offset_(0)
+	,capacity_(0)
+	,map_limit_(0)
+	,pending_tail_(0)
+	,pending_count_(0)
+	,is_writer_flag_(false)
+	,can_grow_flag_(false)
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreJournal::MFStoreJournal(MFStoreControl &mfstore_ctl,
+	const MFStoreSection &section)
+	:MFStoreJournal()
+{
+	try {
+		section.CheckSectionFlags(MFStoreSection::SectionFlag_Journal);
+		if (section.element_count_ <= sizeof(MFStoreJournalControl))
+			throw std::invalid_argument("The section length (" +
+				std::to_string(section.element_count_) + ") is not greater than "
+				"the size of the journal control block.");
+		is_writer_flag_ = mfstore_ctl.IsWriter();
+		CheckSectionViewBind(mfstore_ctl, section, 1,
+			alignof(MFStoreJournalControl), is_writer_flag_);
+	}
+	catch (const std::exception &except) {
+		throw std::invalid_argument("Unable to bind a journal to section index " +
+			std::to_string(section.section_index_) + " ('" +
+			std::string(section.description_) + "') of '" +
+			mfstore_ctl.GetFileName() + "': " + std::string(except.what()));
+	}
+
+	char *section_ptr = static_cast<char *>(mfstore_ctl.GetMmapAddress()) +
+		section.section_offset_;
+
+	mfstore_ctl_ptr_ = &mfstore_ctl;
+	control_ptr_     = reinterpret_cast<MFStoreJournalControl *>(section_ptr);
+	data_ptr_        = section_ptr + sizeof(MFStoreJournalControl);
+	data_offset_     = section.section_offset_ + sizeof(MFStoreJournalControl);
+	map_limit_       = mfstore_ctl.GetMmapSize() - data_offset_;
+	can_grow_flag_   = is_writer_flag_ && (section.section_index_ ==
+		(mfstore_ctl.GetSectionList().size() - 1));
+	capacity_        = (can_grow_flag_) ?
+		(mfstore_ctl.GetFileSize() - data_offset_) :
+		(section.length_padded_ - sizeof(MFStoreJournalControl));
+	pending_tail_    =
+		control_ptr_->committed_tail_.load(std::memory_order_acquire);
+	pending_count_   = control_ptr_->record_count_.load(std::memory_order_relaxed);
+
+	if (is_writer_flag_ && (pending_tail_ > capacity_))
+		throw std::runtime_error("The committed tail of the journal in section "
+			"index " + std::to_string(section.section_index_) + " of '" +
+			mfstore_ctl.GetFileName() + "' (" + std::to_string(pending_tail_) +
+			") exceeds its capacity (" + std::to_string(capacity_) + ").");
+
+	if (is_writer_flag_)
+		RecoverCommit();
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreJournal::MFStoreJournal(MFStoreControl &mfstore_ctl,
+	std::size_t section_index)
+	:MFStoreJournal(mfstore_ctl, mfstore_ctl.GetSection(section_index))
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreJournal::MFStoreJournal(MFStoreControl &mfstore_ctl,
+	const std::string &description)
+	:MFStoreJournal(mfstore_ctl, mfstore_ctl.GetSection(description))
+{
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+MFStoreSection MFStoreJournal::MakeSection(uint64_t capacity,
+	const std::string &description)
+{
+	return(MFStoreSection(0, 1, sizeof(MFStoreJournalControl) + capacity, 0,
+		0, 0, MFStoreSection::SectionFlag_Journal, 0, description));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+uint64_t MFStoreJournal::Append(const void *data_ptr, std::size_t data_length,
+	uint32_t record_type, bool commit_flag)
+{
+	CheckIsBound();
+
+	if (!is_writer_flag_)
+		throw std::runtime_error("Unable to append to the journal because it "
+			"is not open for writing.");
+
+	if (data_length > MaxRecordLength)
+		throw std::invalid_argument("The journal record length (" +
+			std::to_string(data_length) + ") exceeds the maximum "
+			"permissible (" + std::to_string(MaxRecordLength) + ").");
+
+	uint64_t record_offset = pending_tail_;
+	uint64_t new_tail      = pending_tail_ + CalcRecordSize(data_length);
+
+	if (new_tail > capacity_)
+		Grow(new_tail);
+
+	MFStoreJournalRecordHeader *header_ptr =
+		reinterpret_cast<MFStoreJournalRecordHeader *>(data_ptr_ +
+		record_offset);
+
+	header_ptr->record_length_ = static_cast<uint32_t>(data_length);
+	header_ptr->record_type_   = record_type;
+
+	if (data_length)
+		::memcpy(header_ptr + 1, data_ptr, data_length);
+
+	pending_tail_ = new_tail;
+	++pending_count_;
+
+	if (commit_flag)
+		Commit();
+
+	return(record_offset);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The commit sequence is odd while the record count and the committed tail
+	are being stored, so that \c GetRecordCount() can load them as a pair.
+*/
+void MFStoreJournal::Commit()
+{
+	CheckIsBound();
+
+	if (pending_tail_ ==
+		control_ptr_->committed_tail_.load(std::memory_order_relaxed))
+		return;
+
+	uint32_t commit_sequence =
+		control_ptr_->commit_sequence_.load(std::memory_order_relaxed);
+
+	control_ptr_->commit_sequence_.store(commit_sequence + 1,
+		std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	control_ptr_->record_count_.store(pending_count_,
+		std::memory_order_relaxed);
+	control_ptr_->committed_tail_.store(pending_tail_,
+		std::memory_order_release);
+	control_ptr_->commit_sequence_.store(commit_sequence + 2,
+		std::memory_order_release);
+
+#ifdef __linux__
+	::syscall(SYS_futex, &control_ptr_->commit_sequence_, FUTEX_WAKE, INT_MAX,
+		nullptr, nullptr, 0);
+#endif // #ifdef __linux__
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool MFStoreJournal::GetNextRecord(uint64_t &read_offset,
+	MFStoreJournalRecord &record) const
+{
+	CheckIsBound();
+
+	uint64_t committed_tail =
+		control_ptr_->committed_tail_.load(std::memory_order_acquire);
+
+	if (read_offset >= committed_tail)
+		return(false);
+
+	if (committed_tail > map_limit_)
+		throw std::runtime_error("The committed records of the journal in '" +
+			mfstore_ctl_ptr_->GetFileName() + "' extend beyond the mmap size (" +
+			std::to_string(mfstore_ctl_ptr_->GetMmapSize()) + "); the file "
+			"must be re-opened with a larger mmap size.");
+
+	if ((committed_tail - read_offset) < sizeof(MFStoreJournalRecordHeader))
+		throw std::runtime_error("The journal record header at offset " +
+			std::to_string(read_offset) + " in '" +
+			mfstore_ctl_ptr_->GetFileName() + "' extends beyond the committed "
+			"tail (" + std::to_string(committed_tail) + ").");
+
+	const MFStoreJournalRecordHeader *header_ptr =
+		reinterpret_cast<const MFStoreJournalRecordHeader *>(data_ptr_ +
+		read_offset);
+	uint64_t                          record_size =
+		CalcRecordSize(header_ptr->record_length_);
+
+	if (record_size > (committed_tail - read_offset))
+		throw std::runtime_error("The journal record at offset " +
+			std::to_string(read_offset) + " in '" +
+			mfstore_ctl_ptr_->GetFileName() + "' has a length (" +
+			std::to_string(header_ptr->record_length_) + ") which extends "
+			"beyond the committed tail (" + std::to_string(committed_tail) +
+			"); the journal is corrupt.");
+
+	record.record_offset_ = read_offset;
+	record.record_type_   = header_ptr->record_type_;
+	record.record_data_   = std::span<const char>(
+		reinterpret_cast<const char *>(header_ptr + 1),
+		header_ptr->record_length_);
+
+	read_offset += record_size;
+
+	return(true);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The futex wait returns immediately if the commit sequence has changed
+	since it was loaded, so a commit between the check of the tail and the
+	wait isn't missed.
+*/
+bool MFStoreJournal::Wait(uint64_t read_offset, int timeout_ms) const
+{
+	CheckIsBound();
+
+	auto end_time = std::chrono::steady_clock::now() +
+		std::chrono::milliseconds(std::max(timeout_ms, 0));
+
+	for ( ; ; ) {
+		uint32_t commit_sequence =
+			control_ptr_->commit_sequence_.load(std::memory_order_acquire);
+		if (control_ptr_->committed_tail_.load(std::memory_order_acquire) >
+			read_offset)
+			return(true);
+		struct timespec  wait_time;
+		struct timespec *wait_time_ptr = nullptr;
+		if (timeout_ms >= 0) {
+			auto remaining_ns =
+				std::chrono::duration_cast<std::chrono::nanoseconds>(end_time -
+				std::chrono::steady_clock::now()).count();
+			if (remaining_ns <= 0)
+				return(false);
+			wait_time.tv_sec  = static_cast<time_t>(remaining_ns / 1000000000);
+			wait_time.tv_nsec = static_cast<long>(remaining_ns % 1000000000);
+			wait_time_ptr     = &wait_time;
+		}
+#ifdef __linux__
+		::syscall(SYS_futex, &control_ptr_->commit_sequence_, FUTEX_WAIT,
+			commit_sequence, wait_time_ptr, nullptr, 0);
+#else
+		static_cast<void>(commit_sequence);
+		static_cast<void>(wait_time_ptr);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif // #ifdef __linux__
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+uint64_t MFStoreJournal::GetCommittedTail() const
+{
+	CheckIsBound();
+
+	return(control_ptr_->committed_tail_.load(std::memory_order_acquire));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+uint64_t MFStoreJournal::GetRecordCount() const
+{
+	uint64_t committed_tail;
+
+	return(GetRecordCount(committed_tail));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+uint64_t MFStoreJournal::GetRecordCount(uint64_t &committed_tail) const
+{
+	CheckIsBound();
+
+	unsigned int attempt_count = 0;
+
+	for ( ; ; ) {
+		uint32_t commit_sequence =
+			control_ptr_->commit_sequence_.load(std::memory_order_acquire);
+		if (!(commit_sequence & 1)) {
+			uint64_t record_count =
+				control_ptr_->record_count_.load(std::memory_order_relaxed);
+			committed_tail       =
+				control_ptr_->committed_tail_.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (commit_sequence ==
+				control_ptr_->commit_sequence_.load(std::memory_order_relaxed))
+				return(record_count);
+		}
+		if (++attempt_count >= SpinCount) {
+			std::this_thread::yield();
+			attempt_count = 0;
+		}
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+uint64_t MFStoreJournal::GetCapacity() const
+{
+	return(capacity_);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+bool MFStoreJournal::IsBound() const
+{
+	return(control_ptr_ != nullptr);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	The journal capacity is at least doubled so that growth is infrequent.
+
+	Only the file size in the header is updated. The length of the section
+	in the checksummed section table remains that with which the file was
+	created, as readers may be validating the table while it would change.
+*/
+void MFStoreJournal::Grow(uint64_t required_tail)
+{
+	if (!can_grow_flag_)
+		throw std::runtime_error("Unable to append a record of " +
+			std::to_string(required_tail - pending_tail_) + " bytes to the "
+			"journal in '" + mfstore_ctl_ptr_->GetFileName() + "' because it "
+			"would exceed the capacity of the journal (" +
+			std::to_string(capacity_) + ") and the journal is not the last "
+			"section of the file.");
+
+	MFStoreLen alloc_gran    = mfstore_ctl_ptr_->GetAllocGran();
+	MFStoreLen required_size = MLB::Utility::GranularRoundUp(
+		data_offset_ + required_tail, alloc_gran);
+	MFStoreLen desired_size  = std::min(mfstore_ctl_ptr_->GetMmapSize(),
+		std::max(required_size, MLB::Utility::GranularRoundUp(
+		data_offset_ + (capacity_ * 2), alloc_gran)));
+
+	IncreaseStorageSize(*mfstore_ctl_ptr_, std::max(required_size,
+		desired_size));
+
+	capacity_ = mfstore_ctl_ptr_->GetFileSize() - data_offset_;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	If the previous writer stopped part way through a commit the commit
+	sequence is odd and the record count may not match the committed tail,
+	so the count is derived from the committed records.
+*/
+void MFStoreJournal::RecoverCommit()
+{
+	uint32_t commit_sequence =
+		control_ptr_->commit_sequence_.load(std::memory_order_acquire);
+
+	if (!(commit_sequence & 1))
+		return;
+
+	uint64_t read_offset = 0;
+
+	pending_count_ = Poll(read_offset, [](const MFStoreJournalRecord &) { });
+
+	control_ptr_->record_count_.store(pending_count_,
+		std::memory_order_relaxed);
+	control_ptr_->commit_sequence_.store(commit_sequence + 1,
+		std::memory_order_release);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void MFStoreJournal::CheckIsBound() const
+{
+	if (!IsBound())
+		throw std::runtime_error("The MFStoreJournal instance is not bound to "
+			"a journal section.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <MFStore/CreateMFStore.hpp>
+#include <MFStore/MFStoreTestSupport.hpp>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+
+using namespace MLB::MFStore;
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+const uint64_t   TEST_RecordCount = 20000;
+const MFStoreLen TEST_MmapSize    = 64 * 1024 * 1024;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Record n consists of (n % 97) copies of the character ('a' + (n % 26)).
+std::string TEST_MakeRecord(uint64_t record_index)
+{
+	return(std::string(record_index % 97,
+		static_cast<char>('a' + (record_index % 26))));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Run in a child process, so the reader has its own mapping.
+int TEST_TailJournal(const std::string &file_name)
+{
+	try {
+		MFStoreControl reader_ctl(file_name, false, TEST_MmapSize);
+		MFStoreJournal        journal(reader_ctl, "Feed");
+		uint64_t              read_offset  = 0;
+		uint64_t              record_index = 0;
+		std::vector<uint64_t> tail_list(1, 0);
+		for (uint64_t count_1 = 0; count_1 < TEST_RecordCount; ++count_1)
+			tail_list.push_back(tail_list.back() +
+				sizeof(MFStoreJournalRecordHeader) +
+				MLB::Utility::GranularRoundUp<uint64_t>(
+				TEST_MakeRecord(count_1).size(), MFStoreJournal::RecordAlign));
+		while (record_index < TEST_RecordCount) {
+			TEST_Check(journal.Wait(read_offset, 10000),
+				"the reader is woken when records are committed");
+			uint64_t committed_tail;
+			uint64_t record_count = journal.GetRecordCount(committed_tail);
+			TEST_Check((record_count <= TEST_RecordCount) &&
+				(tail_list[record_count] == committed_tail),
+				"the record count matches the committed tail");
+			journal.Poll(read_offset, [&](const MFStoreJournalRecord &record) {
+				std::string expected(TEST_MakeRecord(record_index));
+				TEST_Check(record.record_type_ == (record_index % 3),
+					"the record type is preserved");
+				TEST_Check(std::string(record.record_data_.data(),
+					record.record_data_.size()) == expected,
+					"the record data is preserved");
+				++record_index;
+			});
+		}
+		TEST_Check(!journal.Wait(read_offset, 10),
+			"the wait times out when no more records are committed");
+	}
+	catch (const std::exception &except) {
+		std::cerr << "\n\nERROR IN READER: " << except.what() << std::endl;
+		return(EXIT_FAILURE);
+	}
+
+	return(EXIT_SUCCESS);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_Journal()
+{
+	const std::string file_name("./TEST_MAIN.MFStoreJournal.bin");
+
+	std::filesystem::remove(file_name);
+
+	MFStoreSectionList section_list;
+	section_list.push_back(MFStoreJournal::MakeSection(4096, "Small"));
+	section_list.push_back(MFStoreJournal::MakeSection(4096, "Feed"));
+
+	MFStoreControl writer_ctl(CreateMFStore(file_name, section_list,
+		TEST_MmapSize));
+	MFStoreLen     initial_size = writer_ctl.GetFileSize();
+
+	{
+		MFStoreJournal small_journal(writer_ctl, "Small");
+		std::string    record_data(1000, 'x');
+		bool           threw_flag = false;
+		try {
+			for ( ; ; )
+				small_journal.Append(record_data.data(), record_data.size());
+		}
+		catch (const std::runtime_error &except) {
+			std::cout << "Append to a full journal failed as expected: " <<
+				except.what() << '\n';
+			threw_flag = true;
+		}
+		TEST_Check(threw_flag, "a journal which can't grow becomes full");
+		TEST_Check(writer_ctl.GetFileSize() == initial_size,
+			"a journal which isn't the last section doesn't grow the file");
+	}
+
+	pid_t child_pid = ::fork();
+
+	if (child_pid < 0)
+		throw std::runtime_error("Call to ::fork() failed.");
+	else if (!child_pid)
+		::_exit(TEST_TailJournal(file_name));
+
+	MFStoreJournal journal(writer_ctl, "Feed");
+
+	for (uint64_t count_1 = 0; count_1 < TEST_RecordCount; ++count_1) {
+		std::string record_data(TEST_MakeRecord(count_1));
+		journal.Append(record_data.data(), record_data.size(),
+			static_cast<uint32_t>(count_1 % 3), (count_1 % 8) == 7);
+		if (!(count_1 % 1000))
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	journal.Commit();
+
+	int child_status = 0;
+
+	::waitpid(child_pid, &child_status, 0);
+
+	std::cout << "Records     : " << journal.GetRecordCount()   << '\n';
+	std::cout << "Tail        : " << journal.GetCommittedTail() << '\n';
+	std::cout << "File size   : " << initial_size << " --> " <<
+		writer_ctl.GetFileSize() << '\n';
+
+	TEST_Check(WIFEXITED(child_status) &&
+		(WEXITSTATUS(child_status) == EXIT_SUCCESS),
+		"the reader process read every record");
+	TEST_Check(journal.GetRecordCount() == TEST_RecordCount,
+		"the record count is committed");
+	TEST_Check(writer_ctl.GetFileSize() > initial_size,
+		"the journal grew the file");
+
+	{
+		MFStoreJournal reopened_journal(writer_ctl, "Feed");
+		uint64_t       read_offset  = 0;
+		TEST_Check(reopened_journal.Poll(read_offset,
+			[](const MFStoreJournalRecord &) { }) == TEST_RecordCount,
+			"the records persist when the journal is bound again");
+	}
+
+	{
+		/*
+			Simulate a writer which stopped part way through a commit, after
+			storing the record count but before storing the committed tail.
+		*/
+		MFStoreJournalControl *control_ptr =
+			writer_ctl.GetPtr<MFStoreJournalControl>(
+			writer_ctl.GetSection("Feed").section_offset_);
+		control_ptr->commit_sequence_.fetch_add(1);
+		control_ptr->record_count_.store(TEST_RecordCount + 1);
+		MFStoreJournal recovered_journal(writer_ctl, "Feed");
+		TEST_Check(recovered_journal.GetRecordCount() == TEST_RecordCount,
+			"the record count is recovered from the committed records");
+	}
+
+	std::filesystem::remove(file_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_CorruptRecord()
+{
+	const std::string file_name("./TEST_MAIN.MFStoreJournal.Corrupt.bin");
+
+	std::filesystem::remove(file_name);
+
+	MFStoreSectionList section_list;
+	section_list.push_back(MFStoreJournal::MakeSection(4096, "Feed"));
+
+	MFStoreControl writer_ctl(CreateMFStore(file_name, section_list));
+	MFStoreJournal journal(writer_ctl, "Feed");
+	std::string    record_data(TEST_MakeRecord(40));
+	uint64_t       record_offset = journal.Append(record_data.data(),
+		record_data.size());
+
+	journal.Append(record_data.data(), record_data.size());
+
+	MFStoreJournalRecordHeader *header_ptr =
+		writer_ctl.GetPtr<MFStoreJournalRecordHeader>(
+		writer_ctl.GetSection("Feed").section_offset_ +
+		sizeof(MFStoreJournalControl) + record_offset);
+	header_ptr->record_length_ = 1000000;
+
+	uint64_t             read_offset = 0;
+	MFStoreJournalRecord record;
+	bool                 threw_flag  = false;
+
+	try {
+		journal.GetNextRecord(read_offset, record);
+	}
+	catch (const std::runtime_error &except) {
+		std::cout << "Read of a corrupt record failed as expected: " <<
+			except.what() << '\n';
+		threw_flag = true;
+	}
+
+	TEST_Check(threw_flag, "a record beyond the committed tail is rejected");
+	TEST_Check(read_offset == 0, "the read offset isn't advanced on error");
+
+	std::filesystem::remove(file_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_Journal();
+		TEST_CorruptRecord();
+	}
+	catch (const std::exception &except) {
+		return_code = EXIT_FAILURE;
+		std::cerr << "\n\nERROR: " << except.what() << std::endl;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
@@ -9,6 +9,8 @@
 
    Revision History  :  2021-02-14 --- Creation.
                            Michael L. Brock
+                        2026-10-16 --- Seqlock and journal section flags.
+                           Michael L. Brock
 
       Copyright Michael L. Brock 2021 - 2024.
       Distributed under the Boost Software License, Version 1.0.
@@ -148,6 +150,17 @@ void MFStoreSection::CheckElementInfo(uint64_t section_idx) const
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+void MFStoreSection::CheckSectionFlags(uint64_t required_flags) const
+{
+	if ((section_flags_ & required_flags) != required_flags)
+		throw std::invalid_argument("The section flags (" +
+			std::to_string(section_flags_) + ") of the section at index " +
+			std::to_string(section_index_) + " do not include the required "
+			"flags (" + std::to_string(required_flags) + ").");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 // ////////////////////////////////////////////////////////////////////////////
 std::ostream &MFStoreSection::ToStream(std::ostream &o_str) const
 {
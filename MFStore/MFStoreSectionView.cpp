@@ -0,0 +1,211 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  MFStoreSectionView.cpp
+
+   File Description  :  Implementation of the MFStoreSectionView binding
+                        checks.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/MFStoreSectionView.hpp>
+
+#include <MFStore/CheckValues.hpp>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+// ////////////////////////////////////////////////////////////////////////////
+void CheckSectionViewBind(const MFStoreControl &mfstore_ctl,
+	const MFStoreSection &section, std::size_t element_size,
+	std::size_t element_align, bool is_mutable)
+{
+	try {
+		if (is_mutable)
+			mfstore_ctl.CheckIsWriter();
+		else
+			mfstore_ctl.CheckIsActive();
+		if (section.element_size_ != element_size)
+			throw std::invalid_argument("The section element size (" +
+				std::to_string(section.element_size_) + ") is not equal to the "
+				"size of the view type (" + std::to_string(element_size) + ").");
+		std::uintptr_t section_address = reinterpret_cast<std::uintptr_t>(
+			mfstore_ctl.GetMmapAddress()) + section.section_offset_;
+		if (section_address % element_align)
+			throw std::invalid_argument("The section address is not aligned on "
+				"the alignment of the view type (" +
+				std::to_string(element_align) + ").");
+		CheckExtent(mfstore_ctl.GetFileSize(), section.section_offset_,
+			section.element_size_ * section.element_count_);
+	}
+	catch (const std::exception &except) {
+		throw std::invalid_argument("Unable to bind a view to section index " +
+			std::to_string(section.section_index_) + " ('" +
+			std::string(section.description_) + "') of '" +
+			mfstore_ctl.GetFileName() + "': " + std::string(except.what()));
+	}
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <MFStore/CreateMFStore.hpp>
+#include <MFStore/MFStoreTestSupport.hpp>
+
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+
+using namespace MLB::MFStore;
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+struct TEST_Quote {
+	uint64_t instrument_id_;
+	double   bid_price_;
+	double   ask_price_;
+	uint32_t bid_size_;
+	uint32_t ask_size_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+template <typename DatumType, typename BindType>
+	void TEST_CheckBindFails(const MFStoreControl &mfstore_ctl,
+		const BindType &bind_arg, const char *test_name)
+{
+	try {
+		MFStoreSectionView<DatumType> section_view(mfstore_ctl, bind_arg);
+	}
+	catch (const std::exception &except) {
+		std::cout << "Bind with " << test_name << " failed as expected: " <<
+			except.what() << '\n';
+		return;
+	}
+
+	throw std::logic_error("Bind with " + std::string(test_name) +
+		" succeeded.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_SectionView()
+{
+	const std::string file_name("./TEST_MAIN.MFStoreSectionView.bin");
+	const uint64_t    quote_count = 100000;
+
+	std::filesystem::remove(file_name);
+
+	MFStoreSectionList section_list;
+	section_list.emplace_back(0, sizeof(TEST_Quote), quote_count, 0, 0, 0, 0,
+		0, "Quotes");
+	section_list.emplace_back(0, sizeof(uint64_t), 1000, 0, 0, 0, 0, 0,
+		"Counters");
+
+	MFStoreSectionView<const TEST_Quote> reader_quotes;
+
+	{
+		MFStoreControl writer_ctl(CreateMFStore(file_name, section_list));
+
+		MFStoreSectionView<TEST_Quote> quotes(writer_ctl, "Quotes");
+		TEST_Check(quotes.size() == quote_count, "the view has every element");
+		for (std::size_t count_1 = 0; count_1 < quotes.size(); ++count_1)
+			quotes[count_1] = TEST_Quote{ count_1, count_1 * 0.5,
+				count_1 * 0.5 + 0.25, static_cast<uint32_t>(count_1 % 100),
+				static_cast<uint32_t>(count_1 % 200) };
+
+		MFStoreSectionView<uint64_t> counters(writer_ctl,
+			std::size_t(MFStoreHeader::FirstUserSectionIndex + 1));
+		std::iota(counters.begin(), counters.end(), 1);
+
+		TEST_CheckBindFails<double>(writer_ctl, std::string("Quotes"),
+			"a mismatched element size");
+		TEST_CheckBindFails<TEST_Quote>(writer_ctl, std::string("Missing"),
+			"an unknown description");
+
+		MFStoreControl reader_ctl(file_name, false);
+		TEST_CheckBindFails<TEST_Quote>(reader_ctl, std::string("Quotes"),
+			"a mutable view of a file opened for reading");
+		reader_quotes = MFStoreSectionView<const TEST_Quote>(reader_ctl,
+			"Quotes");
+	}
+
+	/*
+		The view remains valid after the control instances are destroyed.
+	*/
+	uint64_t id_sum = 0;
+	for (const auto &this_quote : reader_quotes)
+		id_sum += this_quote.instrument_id_;
+	TEST_Check(id_sum == ((quote_count * (quote_count - 1)) / 2),
+		"the reader sees the elements written through the writer view");
+	TEST_Check(reader_quotes.at(1234).ask_price_ == (1234 * 0.5 + 0.25),
+		"element access by index");
+	TEST_Check(reader_quotes.GetSpan().back().instrument_id_ ==
+		(quote_count - 1), "span access");
+
+	bool threw_flag = false;
+	try {
+		reader_quotes.at(quote_count);
+	}
+	catch (const std::out_of_range &) {
+		threw_flag = true;
+	}
+	TEST_Check(threw_flag, "checked access beyond the section end throws");
+
+	std::cout << "Section view tests passed.\n";
+
+	std::filesystem::remove(file_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_SectionView();
+	}
+	catch (const std::exception &except) {
+		return_code = EXIT_FAILURE;
+		std::cerr << "\n\nERROR: " << except.what() << std::endl;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
@@ -0,0 +1,270 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Module File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  MFStoreSeqLockView.cpp
+
+   File Description  :  Implementation of the MFStoreSeqLockView binding
+                        checks.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/MFStoreSeqLockView.hpp>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+// ////////////////////////////////////////////////////////////////////////////
+void CheckSeqLockViewBind(const MFStoreControl &mfstore_ctl,
+	const MFStoreSection &section, std::size_t record_size,
+	std::size_t record_align, bool is_mutable)
+{
+	try {
+		section.CheckSectionFlags(MFStoreSection::SectionFlag_SeqLock);
+	}
+	catch (const std::exception &except) {
+		throw std::invalid_argument("Unable to bind a seqlock view to section "
+			"index " + std::to_string(section.section_index_) + " ('" +
+			std::string(section.description_) + "') of '" +
+			mfstore_ctl.GetFileName() + "': " + std::string(except.what()));
+	}
+
+	CheckSectionViewBind(mfstore_ctl, section, record_size, record_align,
+		is_mutable);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
+// ////////////////////////////////////////////////////////////////////////////
+// ****************************************************************************
+// ****************************************************************************
+// ****************************************************************************
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_MAIN
+
+#include <MFStore/CreateMFStore.hpp>
+#include <MFStore/MFStoreTestSupport.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+using namespace MLB::MFStore;
+
+namespace {
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Every member of a consistent position holds the same value.
+*/
+struct TEST_Position {
+	uint64_t quantity_;
+	uint64_t cost_;
+	uint64_t realized_;
+	uint64_t unrealized_;
+	uint32_t update_count_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Has no default constructor, so Read() mustn't need one.
+*/
+class TEST_Price {
+public:
+	explicit TEST_Price(int64_t price_ticks)
+		:price_ticks_(price_ticks)
+	{
+	}
+
+	int64_t GetPriceTicks() const
+	{
+		return(price_ticks_);
+	}
+
+private:
+	int64_t price_ticks_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+const std::size_t TEST_PositionCount = 16;
+const std::size_t TEST_ReaderCount   = 3;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_SeqLock()
+{
+	const std::string file_name("./TEST_MAIN.MFStoreSeqLockView.bin");
+
+	std::filesystem::remove(file_name);
+
+	MFStoreSectionList section_list;
+	section_list.push_back(MFStoreSeqLockView<TEST_Position>::MakeSection(
+		TEST_PositionCount, "Positions"));
+	section_list.emplace_back(0, sizeof(TEST_Position), TEST_PositionCount, 0,
+		0, 0, 0, 0, "Plain Positions");
+
+	MFStoreControl                 writer_ctl(CreateMFStore(file_name,
+		section_list));
+	MFStoreSeqLockView<TEST_Position> positions(writer_ctl, "Positions");
+
+	try {
+		MFStoreSeqLockView<TEST_Position> bad_view(writer_ctl,
+			"Plain Positions");
+		throw std::logic_error("Bind to a section without the seqlock flag "
+			"succeeded.");
+	}
+	catch (const std::invalid_argument &except) {
+		std::cout << "Bind to a section without the seqlock flag failed as "
+			"expected: " << except.what() << '\n';
+	}
+
+	std::atomic<bool>        stop_flag(false);
+	std::atomic<uint64_t>    read_count(0);
+	std::atomic<uint64_t>    retry_count(0);
+	std::atomic<uint64_t>    torn_count(0);
+	std::vector<std::thread> reader_list;
+
+	/*
+		Each reader has its own mapping of the file, as would a reader in
+		another process.
+	*/
+	for (std::size_t count_1 = 0; count_1 < TEST_ReaderCount; ++count_1)
+		reader_list.emplace_back([&]() {
+			MFStoreControl                          reader_ctl(file_name, false);
+			MFStoreSeqLockView<const TEST_Position> reader_positions(reader_ctl,
+				"Positions");
+			std::vector<uint32_t>                   last_list(TEST_PositionCount);
+			uint64_t                                tmp_reads   = 0;
+			uint64_t                                tmp_retries = 0;
+			while (!stop_flag.load(std::memory_order_relaxed)) {
+				for (std::size_t count_2 = 0; count_2 < TEST_PositionCount;
+					++count_2) {
+					TEST_Position position;
+					if (!reader_positions.TryRead(count_2, position)) {
+						++tmp_retries;
+						position = reader_positions.Read(count_2);
+					}
+					if ((position.cost_       != position.quantity_) ||
+						 (position.realized_   != position.quantity_) ||
+						 (position.unrealized_ != position.quantity_) ||
+						 (position.update_count_ < last_list[count_2]))
+						++torn_count;
+					last_list[count_2] = position.update_count_;
+					++tmp_reads;
+				}
+			}
+			read_count  += tmp_reads;
+			retry_count += tmp_retries;
+		});
+
+	auto     end_time = std::chrono::steady_clock::now() +
+		std::chrono::milliseconds(500);
+	uint64_t write_count = 0;
+
+	while (std::chrono::steady_clock::now() < end_time) {
+		for (std::size_t count_1 = 0; count_1 < TEST_PositionCount; ++count_1) {
+			TEST_Position position = positions.Read(count_1);
+			uint64_t      new_value = position.quantity_ + 1000003;
+			positions.Write(count_1, TEST_Position{ new_value, new_value,
+				new_value, new_value, position.update_count_ + 1 });
+			++write_count;
+		}
+	}
+
+	stop_flag = true;
+
+	for (auto &this_thread : reader_list)
+		this_thread.join();
+
+	std::cout << "Writes : " << write_count << '\n';
+	std::cout << "Reads  : " << read_count  << '\n';
+	std::cout << "Retries: " << retry_count << '\n';
+	std::cout << "Torn   : " << torn_count  << '\n';
+
+	TEST_Check(torn_count == 0, "no reader saw a torn or stale position");
+	TEST_Check(read_count > 0, "the readers read the positions");
+	TEST_Check(positions.GetWriteCount(0) == positions.Read(0).update_count_,
+		"the write count matches the number of updates");
+
+	std::filesystem::remove(file_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+void TEST_NoDefaultConstructor()
+{
+	const std::string file_name("./TEST_MAIN.MFStoreSeqLockView.Price.bin");
+
+	std::filesystem::remove(file_name);
+
+	MFStoreSectionList section_list;
+	section_list.push_back(MFStoreSeqLockView<TEST_Price>::MakeSection(4,
+		"Prices"));
+
+	{
+		MFStoreControl                 writer_ctl(CreateMFStore(file_name,
+			section_list));
+		MFStoreSeqLockView<TEST_Price> prices(writer_ctl, "Prices");
+		prices.Write(2, TEST_Price(-12345));
+		TEST_Check(prices.Read(2).GetPriceTicks() == -12345,
+			"a datum without a default constructor is read back");
+	}
+
+	{
+		MFStoreControl                       reader_ctl(file_name, false);
+		MFStoreSeqLockView<const TEST_Price> prices(reader_ctl, "Prices");
+		TEST_Check(prices.Read(2).GetPriceTicks() == -12345,
+			"a const datum without a default constructor is read back");
+	}
+
+	std::filesystem::remove(file_name);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // Anonymous namespace
+
+// ////////////////////////////////////////////////////////////////////////////
+int main()
+{
+	int return_code = EXIT_SUCCESS;
+
+	try {
+		TEST_SeqLock();
+		TEST_NoDefaultConstructor();
+	}
+	catch (const std::exception &except) {
+		return_code = EXIT_FAILURE;
+		std::cerr << "\n\nERROR: " << except.what() << std::endl;
+	}
+
+	return(return_code);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+#endif // #ifdef TEST_MAIN
+
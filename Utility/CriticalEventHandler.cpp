@@ -13,8 +13,10 @@
                            Michael L. Brock
                         2024-08-10 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- Optional fatal signal function.
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 1994 - 2024.
+      Copyright Michael L. Brock 1994 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -42,21 +44,65 @@ namespace Utility {
 
 // ////////////////////////////////////////////////////////////////////////////
 alignas(64) std::atomic_bool CriticalEventHandler::event_flag_ = false;
+
+std::atomic<CriticalEventHandler::FatalSignalFunc>
+	CriticalEventHandler::fatal_signal_func_(nullptr);
+
+std::atomic<const CriticalEventHandler *>
+	CriticalEventHandler::fatal_signal_owner_(nullptr);
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 CriticalEventHandler::CriticalEventHandler()
 	:handlers_list_()
+	,previous_func_(nullptr)
+	,previous_owner_(nullptr)
 {
 	std::set<int> signal_set = { SIGINT, SIGTERM };
 
-	InstallHandlers(signal_set);
+	InstallHandlers(signal_set, SignalHandler);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+CriticalEventHandler::CriticalEventHandler(FatalSignalFunc fatal_signal_func)
+	:handlers_list_()
+	,previous_func_(nullptr)
+	,previous_owner_(nullptr)
+{
+	std::set<int> signal_set = { SIGINT, SIGTERM };
+
+	InstallHandlers(signal_set, SignalHandler);
+
+	if (fatal_signal_func != nullptr) {
+		std::set<int> fatal_signal_set = { SIGSEGV, SIGFPE, SIGILL, SIGABRT
+#ifdef SIGBUS
+			, SIGBUS
+#endif // #ifdef SIGBUS
+		};
+		try {
+			previous_func_  = fatal_signal_func_.exchange(fatal_signal_func);
+			previous_owner_ = fatal_signal_owner_.exchange(this);
+			InstallHandlers(fatal_signal_set, FatalSignalHandler);
+		}
+		catch (const std::exception &) {
+			ReleaseFatalSignalFunc();
+			while (!handlers_list_.empty()) {
+				::signal(handlers_list_.back().first,
+					handlers_list_.back().second);
+				handlers_list_.pop_back();
+			}
+			throw;
+		}
+	}
 }
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
 CriticalEventHandler::~CriticalEventHandler()
 {
+	ReleaseFatalSignalFunc();
+
 	while (!handlers_list_.empty()) {
 		::signal(handlers_list_.back().first, handlers_list_.back().second);
 		handlers_list_.pop_back();
@@ -79,13 +125,14 @@ bool CriticalEventHandler::GetFlag()
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
-void CriticalEventHandler::InstallHandlers(std::set<int> &signal_list)
+void CriticalEventHandler::InstallHandlers(std::set<int> &signal_list,
+	SignalFuncType handler_func)
 {
 	try {
 		handlers_list_.reserve(handlers_list_.size() + signal_list.size());
 		while (!signal_list.empty()) {
 			SignalFuncType return_code =
-				::signal(*signal_list.begin(), SignalHandler);
+				::signal(*signal_list.begin(), handler_func);
 			if (return_code == SIG_ERR)
 				ThrowErrno("Attempt to install a signal handler for signal "
 					"number " + std::to_string(*signal_list.begin()) +
@@ -104,6 +151,22 @@ void CriticalEventHandler::InstallHandlers(std::set<int> &signal_list)
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Restores the fatal signal function which this instance superseded, but
+	only if this instance is still the one which installed the current
+	function.
+*/
+void CriticalEventHandler::ReleaseFatalSignalFunc()
+{
+	const CriticalEventHandler *this_ptr = this;
+
+	if (fatal_signal_owner_.compare_exchange_strong(this_ptr,
+		previous_owner_))
+		fatal_signal_func_ = previous_func_;
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 // ////////////////////////////////////////////////////////////////////////////
 void CriticalEventHandler::SignalHandler(int /* signal_number */)
 {
@@ -111,6 +174,20 @@ void CriticalEventHandler::SignalHandler(int /* signal_number */)
 }
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+void CriticalEventHandler::FatalSignalHandler(int signal_number)
+{
+	//	Exchanged so that a fault within the function doesn't recurse...
+	FatalSignalFunc fatal_signal_func = fatal_signal_func_.exchange(nullptr);
+
+	if (fatal_signal_func != nullptr)
+		fatal_signal_func(signal_number);
+
+	::signal(signal_number, SIG_DFL);
+	::raise(signal_number);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 } // namespace Utility
 
 } // namespace MLB
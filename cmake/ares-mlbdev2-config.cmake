@@ -36,6 +36,9 @@ find_dependency(Boost COMPONENTS
 # The cnats config already includes OpenSSL in its INTERFACE_LINK_LIBRARIES
 find_dependency(cnats)
 
+# zlib - Logger compresses rotated log files
+find_dependency(ZLIB)
+
 # -----------------------------------------------------------------------------
 # Create the ares::mlbdev2 imported target
 # -----------------------------------------------------------------------------
@@ -56,7 +59,7 @@ if(NOT TARGET ares::mlbdev2)
     set_target_properties(ares::mlbdev2 PROPERTIES
         INTERFACE_INCLUDE_DIRECTORIES "${_MLBDEV2_ROOT}/include"
         INTERFACE_LINK_LIBRARIES 
-            "${_MLBDEV2_LIBS};cnats::nats_static;Boost::headers;Boost::thread;Boost::filesystem;Boost::chrono;Boost::date_time;Boost::regex;Boost::atomic"
+            "${_MLBDEV2_LIBS};cnats::nats_static;Boost::headers;Boost::thread;Boost::filesystem;Boost::chrono;Boost::date_time;Boost::regex;Boost::atomic;ZLIB::ZLIB"
     )
 endif()
 
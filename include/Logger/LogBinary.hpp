@@ -0,0 +1,261 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogBinary.hpp
+
+   File Description  :  Include file for binary deferred-formatting log
+                        records.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogBinary_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogBinary_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogEmitControl.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Identifies a format string registered by a deferred log statement.
+
+	Format strings use \c {} as the argument placeholder. \c {{ and \c }}
+	render as a single brace.
+
+	Format id 0 is reserved for lines which were formatted as text by the
+	producer. Such lines have a single string argument.
+
+	Format id 1 is reserved for structured events (see \c LogEvent.hpp ). The
+	arguments of such records are the event name followed by pairs of field
+	name and field value.
+*/
+typedef std::uint32_t LogBinaryFormatId;
+
+const LogBinaryFormatId LogBinaryFormatId_Text  = 0;
+const LogBinaryFormatId LogBinaryFormatId_Event = 1;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	The tag byte which precedes each encoded argument. Integers are encoded as
+	64-bit values, strings as a 32-bit length followed by the characters.
+	All values are in the byte order of the producing host.
+*/
+enum LogBinaryArgType {
+	LogBinaryArgType_Bool    = 1,
+	LogBinaryArgType_Char    = 2,
+	LogBinaryArgType_Int     = 3,
+	LogBinaryArgType_UInt    = 4,
+	LogBinaryArgType_Double  = 5,
+	LogBinaryArgType_String  = 6,
+	LogBinaryArgType_Pointer = 7
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	A single decoded argument. Booleans and characters are held in
+	\c int_value_ , pointers in \c uint_value_ . Strings refer to the encoded
+	data.
+*/
+struct LogBinaryArg {
+	LogBinaryArgType  arg_type_;
+	std::int64_t      int_value_;
+	std::uint64_t     uint_value_;
+	double            double_value_;
+	const char       *string_ptr_;
+	std::size_t       string_length_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+struct LogBinaryFormat {
+	LogBinaryFormatId  format_id_;
+	const char        *file_name_;
+	unsigned int       line_number_;
+	const char        *format_string_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Binary log file layout.
+
+	A file begins with a \c LogBinaryFileHeader and is followed by records,
+	each of which begins with a \c LogBinaryRecordHeader and is followed by
+	\c data_length_ bytes of data:
+
+	\li	\e LogBinaryRecordType_Format records describe a format id the first
+		time it is used in the file. The data is the 32-bit line number, the
+		32-bit length of the source file name, the source file name and then
+		the format string.
+
+	\li	\e LogBinaryRecordType_Line records hold the encoded arguments.
+
+	\li	\e LogBinaryRecordType_Literal records hold the literal text.
+
+	The \c data_length_ of a record may not exceed \c LogBinaryMaxDataLength ,
+	so that a reader can reject a corrupt length before it reads the data.
+*/
+const char          LogBinaryFileMagic[8]   =
+	{ 'M', 'L', 'B', 'L', 'O', 'G', 'B', '1' };
+const std::uint32_t LogBinaryFileByteOrder  = 0x01020304;
+const std::uint32_t LogBinaryFileVersion    = 1;
+const std::uint32_t LogBinaryMaxDataLength  = 0x40000000;
+
+struct LogBinaryFileHeader {
+	char          magic_[sizeof(LogBinaryFileMagic)];
+	std::uint32_t byte_order_;
+	std::uint32_t version_;
+	std::uint32_t header_length_;
+	std::uint32_t reserved_;
+};
+
+enum LogBinaryRecordType {
+	LogBinaryRecordType_Format  = 1,
+	LogBinaryRecordType_Line    = 2,
+	LogBinaryRecordType_Literal = 3
+};
+
+struct LogBinaryRecordHeader {
+	std::uint32_t record_length_;
+	std::uint8_t  record_type_;
+	std::uint8_t  log_level_;
+	std::uint16_t reserved_;
+	std::uint64_t time_secs_;
+	std::uint32_t time_nsecs_;
+	std::uint32_t thread_id_;
+	std::uint32_t format_id_;
+	std::uint32_t data_length_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+API_UTILITY LogBinaryFormatId  LogBinaryFormatRegister(const char *file_name,
+	unsigned int line_number, const char *format_string);
+API_UTILITY bool               LogBinaryFormatGet(LogBinaryFormatId format_id,
+	LogBinaryFormat &format);
+
+API_UTILITY std::string       &LogBinaryRender(const char *format_string,
+	const char *arg_ptr, std::size_t arg_length, std::string &out_string);
+API_UTILITY std::string       &LogBinaryRender(LogBinaryFormatId format_id,
+	const char *arg_ptr, std::size_t arg_length, std::string &out_string);
+
+API_UTILITY const char        *LogBinaryExtractArg(const char *arg_ptr,
+	const char *end_ptr, LogBinaryArg &arg);
+API_UTILITY const char        *LogBinaryTryExtractArg(const char *arg_ptr,
+	const char *end_ptr, LogBinaryArg &arg);
+API_UTILITY bool               LogBinaryCheckArgs(const char *arg_ptr,
+	std::size_t arg_length);
+API_UTILITY std::string       &LogBinaryAppendArg(const LogBinaryArg &arg,
+	std::string &out_string);
+
+API_UTILITY std::string       &LogBinaryGetThreadBuffer();
+
+API_UTILITY std::size_t        LogBinaryDecode(std::istream &in_stream,
+	std::ostream &out_stream, LogFlag log_flags = Default);
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+template <typename DatumType>
+	inline void LogBinaryEncodeRaw(std::string &buffer, LogBinaryArgType arg_type,
+		const DatumType &datum)
+{
+	buffer.push_back(static_cast<char>(arg_type));
+	buffer.append(reinterpret_cast<const char *>(&datum), sizeof(datum));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+inline void LogBinaryEncodeString(std::string &buffer, const char *datum_ptr,
+	std::size_t datum_length)
+{
+	std::uint32_t tmp_length = static_cast<std::uint32_t>(datum_length);
+
+	LogBinaryEncodeRaw(buffer, LogBinaryArgType_String, tmp_length);
+	buffer.append(datum_ptr, tmp_length);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Appends the tagged binary encoding of a single argument to the buffer.
+	No text formatting is performed.
+*/
+template <typename DatumType>
+	inline void LogBinaryEncode(std::string &buffer, const DatumType &datum)
+{
+	typedef std::decay_t<DatumType> Type;
+
+	if constexpr (std::is_same_v<Type, bool>)
+		LogBinaryEncodeRaw(buffer, LogBinaryArgType_Bool,
+			static_cast<std::uint8_t>(datum));
+	else if constexpr (std::is_same_v<Type, char>)
+		LogBinaryEncodeRaw(buffer, LogBinaryArgType_Char, datum);
+	else if constexpr (std::is_enum_v<Type>)
+		LogBinaryEncode(buffer, static_cast<std::underlying_type_t<Type>>(datum));
+	else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+		LogBinaryEncodeRaw(buffer, LogBinaryArgType_Int,
+			static_cast<std::int64_t>(datum));
+	else if constexpr (std::is_integral_v<Type>)
+		LogBinaryEncodeRaw(buffer, LogBinaryArgType_UInt,
+			static_cast<std::uint64_t>(datum));
+	else if constexpr (std::is_floating_point_v<Type>)
+		LogBinaryEncodeRaw(buffer, LogBinaryArgType_Double,
+			static_cast<double>(datum));
+	else if constexpr (std::is_same_v<Type, char *> ||
+		std::is_same_v<Type, const char *>) {
+		//	Also reached by character arrays, so decay before the NULL check.
+		const char *datum_ptr = datum;
+		if (datum_ptr == NULL)
+			LogBinaryEncodeString(buffer, "(null)", 6);
+		else
+			LogBinaryEncodeString(buffer, datum_ptr, ::strlen(datum_ptr));
+	}
+	else if constexpr (std::is_convertible_v<const Type &, std::string_view>) {
+		std::string_view tmp_view(datum);
+		LogBinaryEncodeString(buffer, tmp_view.data(), tmp_view.size());
+	}
+	else if constexpr (std::is_pointer_v<Type>)
+		LogBinaryEncodeRaw(buffer, LogBinaryArgType_Pointer,
+			static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(datum)));
+	else
+		static_assert(std::is_pointer_v<Type>,
+			"Type not supported by deferred-formatting log statements.");
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogBinary_hpp__HH
+
@@ -0,0 +1,79 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogClock.hpp
+
+   File Description  :  Include file for the clock used to time log lines.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogClock_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogClock_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Utility/TimeSpec.hpp>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	The source of the time stamps given to log lines when they are started.
+
+	\li	\e LogClock_Realtime uses \c clock_gettime(CLOCK_REALTIME) .
+
+	\li	\e LogClock_RealtimeCoarse uses \c CLOCK_REALTIME_COARSE , which is
+		cheaper but has the resolution of the kernel tick (typically 1 to 4
+		milliseconds).
+
+	\li	\e LogClock_TSC reads the processor time stamp counter and converts
+		it to wall-clock time using a rate and an anchor to \c CLOCK_REALTIME
+		which are established when the clock is selected. It is available
+		only on x86 processors with an invariant TSC. Because it isn't
+		steered by NTP, its time stamps drift from wall-clock time (by as
+		much as the NTP correction applied to the host clock) until it is
+		re-anchored. The clock is re-anchored only when it is re-selected
+		with \c LogClockSetType() , so long-running processes should do so
+		periodically.
+*/
+enum LogClockType {
+	LogClock_Realtime       = 0,
+	LogClock_RealtimeCoarse = 1,
+	LogClock_TSC            = 2,
+	LogClock_Default        = LogClock_Realtime
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+API_UTILITY TimeSpec     LogClockNow();
+API_UTILITY LogClockType LogClockGetType();
+API_UTILITY LogClockType LogClockSetType(LogClockType clock_type);
+API_UTILITY bool         LogClockIsAvailable(LogClockType clock_type);
+API_UTILITY double       LogClockGetTSCTicksPerSecond();
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogClock_hpp__HH
+
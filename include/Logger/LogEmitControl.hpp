@@ -11,8 +11,13 @@
                            Michael L. Brock
                         2023-01-05 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- Leaders formatted in another thread
+                                       and cached per thread.
+                           Michael L. Brock
+                        2026-10-16 --- Structured event fields.
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 2005 - 2023.
+      Copyright Michael L. Brock 2005 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -31,6 +36,7 @@
 
 #include <Logger/LogLevel.hpp>
 
+#include <Utility/ThreadId.hpp>
 #include <Utility/TimeSpec.hpp>
 
 // ////////////////////////////////////////////////////////////////////////////
@@ -51,11 +57,17 @@ enum LogFlag {
 	LogBothTimes = 0x0002,
 	LogZeroTime  = 0x0004,
 	LogZeroTid   = 0x0008,
+	LogJsonEvent = 0x0010,
 	Default      = 0x0000
 };
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
+/**
+	Structured events (see \c LogEvent.hpp ) carry their encoded fields in
+	\c field_ptr_ and \c field_length_ ; for other records \c field_ptr_ is
+	\c NULL .
+*/
 struct API_UTILITY LogEmitControl {
 	//	Constructor for formatted log lines...
 	LogEmitControl(LogFlag log_flags, LogLevelFlag log_level_screen,
@@ -66,6 +78,12 @@ struct API_UTILITY LogEmitControl {
 	LogEmitControl(LogFlag log_flags, LogLevelFlag log_level_screen,
 		LogLevelFlag log_level_persistent, LogLevel log_level,
 		LogLevelFlag log_level_flag);
+	//	Constructor for log lines with a leader formatted in another thread...
+	LogEmitControl(LogFlag log_flags, LogLevelFlag log_level_screen,
+		LogLevelFlag log_level_persistent, const TimeSpec &line_start_time,
+		LogLevel log_level, LogLevelFlag log_level_flag,
+		const std::string &line_buffer, ThreadId thread_id,
+		const char *line_leader);
 
 	unsigned int       GetLeaderLength() const;
 	const char        *GetLeaderPtr() const;
@@ -78,7 +96,16 @@ struct API_UTILITY LogEmitControl {
 	LogFlag            GetLogFlags() const;
 	const TimeSpec    &GetLogStartTime() const;
 	LogLevel           GetLogLevel() const;
+	ThreadId           GetThreadId() const;
 	const std::string &GetLogMessage() const;
+	bool               HasFields() const;
+
+	static char *FormatLeader(char *leader_buffer, const TimeSpec &line_time,
+		LogLevel log_level, ThreadId thread_id, LogFlag log_flags = Default);
+	static void  FormatLeaderLevelAndThread(char *leader_buffer,
+		LogLevel log_level, ThreadId thread_id);
+	static void  FormatLeaderTime(char *leader_buffer,
+		const TimeSpec &line_time, LogFlag log_flags = Default);
 
 	LogFlag               log_flags_;
 	LogLevelFlag          log_level_screen_;
@@ -86,10 +113,14 @@ struct API_UTILITY LogEmitControl {
 	TimeSpec              line_start_time_;
 	LogLevel              log_level_;
 	LogLevelFlag          log_level_flag_;
+	ThreadId              thread_id_;
 	std::string           line_buffer_empty_;
 	const std::string    &line_buffer_;
 	mutable char          line_leader_[LogLineLeaderLength + 1];
 	mutable unsigned int  this_line_offset_;
+	bool                  leader_is_fixed_;
+	const char           *field_ptr_;
+	std::size_t           field_length_;
 
 private:
 	LogEmitControl(const LogEmitControl &) = delete;
@@ -0,0 +1,117 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogEvent.hpp
+
+   File Description  :  Include file for structured key/value log events.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogEvent_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogEvent_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogBinary.hpp>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	A named field of a structured log event. Usually created by \c LogKV()
+	in the argument list of \c LogStream::Event() , for example:
+
+		LogInfo.Event("order_ack", LogKV("id", order_id), LogKV("px", px));
+
+	The field refers to its value, so it must not outlive the full
+	expression in which it was created. The field name must be a string with
+	static storage duration (usually a literal). Values may be of any type
+	supported by deferred-formatting log statements.
+*/
+template <typename DatumType>
+	struct LogField {
+	const char      *key_;
+	const DatumType &value_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+template <typename DatumType>
+	inline LogField<DatumType> LogKV(const char *key, const DatumType &value)
+{
+	return(LogField<DatumType>{key, value});
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Encodes an event into the buffer using the argument encoding of the
+	deferred-formatting log statements: the event name and then the name and
+	value of each field. No text formatting is performed and, once the buffer
+	has grown to the size of the largest event, no memory is allocated.
+*/
+template <typename... DatumTypes>
+	inline std::string &LogEventEncode(std::string &buffer,
+		const char *event_name, const LogField<DatumTypes> &... fields)
+{
+	buffer.clear();
+
+	LogBinaryEncode(buffer, event_name);
+
+	((LogBinaryEncode(buffer, fields.key_),
+		LogBinaryEncode(buffer, fields.value_)), ...);
+
+	return(buffer);
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Returns \c true if the encoded event is well-formed, in which case it
+	can be rendered without an exception being thrown. Neither throws nor
+	allocates.
+*/
+API_UTILITY bool         LogEventCheckFields(const char *field_ptr,
+	std::size_t field_length);
+
+/**
+	Renders an encoded event in the text layout, as the event name followed
+	by \c name=value pairs. String values which are empty or which contain
+	spaces, quotes or equals signs are quoted.
+*/
+API_UTILITY std::string &LogEventRenderText(const char *field_ptr,
+	std::size_t field_length, std::string &out_string);
+
+/**
+	Renders an event as a single-line JSON object with the members \c time ,
+	\c level , \c tid and \c event followed by the event's fields.
+*/
+API_UTILITY std::string &LogEventRenderJson(const LogEmitControl &emit_control,
+	std::string &out_string);
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogEvent_hpp__HH
+
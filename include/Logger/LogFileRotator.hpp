@@ -0,0 +1,141 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogFileRotator.hpp
+
+   File Description  :  Include file for log file rotation support.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogFileRotator_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogFileRotator_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandler.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <thread>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Specifies when a log file is to be rotated.
+
+	A file is rotated when writing the next line would take it past
+	\c max_file_size_ bytes, or when a wall-clock boundary which is a
+	multiple of \c interval_seconds_ since the epoch is crossed (for example,
+	an interval of 3600 rotates on the hour). Either criterion may be zero
+	to disable it.
+*/
+struct API_UTILITY LogFileRotationSpec {
+	enum Compression {
+		Compression_None = 0,
+		Compression_GZip = 1
+	};
+
+	explicit LogFileRotationSpec(std::uint64_t max_file_size = 0,
+		unsigned int interval_seconds = 0,
+		Compression compression = Compression_GZip);
+
+	bool IsEnabled() const;
+
+	std::uint64_t max_file_size_;
+	unsigned int  interval_seconds_;
+	Compression   compression_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Tracks the size and age of the active log file on behalf of a file log
+	handler, renames the active file to a segment name when it is to be
+	rotated and compresses completed segments on a background thread.
+
+	The owning handler serializes all calls (other than those to
+	\c WaitForCompression() ) with its own lock and performs the cut-over
+	between lines. Segments are named by inserting the time of the rotation
+	before the extension of the active file name, so that
+	\c Server.log becomes \c Server.20261016_143000_123456789.log and then,
+	once compressed, \c Server.20261016_143000_123456789.log.gz .
+*/
+class API_UTILITY LogFileRotator {
+public:
+	explicit LogFileRotator(
+		const LogFileRotationSpec &rotation_spec = LogFileRotationSpec());
+
+	~LogFileRotator();
+
+	const LogFileRotationSpec &GetRotationSpec() const;
+	void                       SetRotationSpec(
+		const LogFileRotationSpec &rotation_spec);
+
+	void          FileOpened(std::uint64_t file_size);
+	void          DeferRotation();
+	bool          CheckRotate(std::size_t pending_length) const;
+	void          AddBytes(std::size_t written_length);
+	std::uint64_t GetFileSize() const;
+	std::string   RenameToSegment(const std::string &file_name);
+	void          SegmentCompleted(const std::string &segment_name);
+
+	void          WaitForCompression();
+
+	std::uint64_t GetRotationCount() const;
+	std::uint64_t GetCompressionFailureCount() const;
+
+	static std::string MakeSegmentName(const std::string &file_name,
+		const TimeSpec &rotation_time);
+	static void        CompressFile(const std::string &src_file_name,
+		const std::string &dst_file_name);
+
+private:
+	LogFileRotationSpec     rotation_spec_;
+	std::uint64_t           file_size_;
+	//	Bytes of the file written before the last deferred rotation.
+	std::uint64_t           deferred_size_;
+	time_t                  next_rotation_time_;
+	std::uint64_t           rotation_count_;
+	std::uint64_t           compression_failure_count_;
+	std::deque<std::string> compress_queue_;
+	bool                    compress_busy_;
+	bool                    compress_stop_;
+	std::thread             compress_thread_;
+	mutable LogLock         compress_lock_;
+	std::condition_variable compress_cond_;
+
+	void SetNextRotationTime(time_t current_time);
+	void CompressThreadProc();
+
+	LogFileRotator(const LogFileRotator &) = delete;
+	LogFileRotator & operator = (const LogFileRotator &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogFileRotator_hpp__HH
+
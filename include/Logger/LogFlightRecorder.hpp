@@ -0,0 +1,208 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogFlightRecorder.hpp
+
+   File Description  :  Include file for the crash-safe log flight recorder.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogFlightRecorder_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogFlightRecorder_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogBinary.hpp>
+#include <Logger/LogLevel.hpp>
+
+#include <Utility/TimeSpec.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Retains the most recent log lines of each thread, at every level, in a
+	memory-mapped file.
+
+	The file holds \e ring_count rings of \e record_count fixed-size records.
+	A thread claims a ring for its exclusive use the first time it records a
+	line and releases it when it exits, so recording a line is a copy into
+	the next record and a single release store of the ring's index: no lock
+	is taken and no memory is allocated. Lines longer than a record are
+	truncated. Should more threads record than there are rings, the lines of
+	the threads without a ring are counted by \c GetDropCount() and
+	otherwise discarded.
+
+	Deferred log statements (see \c LogDeferred() ) and structured events
+	are recorded with their encoded arguments, so that they are rendered as
+	text only when dumped. The format string of each deferred statement is
+	copied to the format area at the end of the file the first time the
+	statement is recorded. Should the format area be full, or the arguments
+	not fit in a record, the statement is rendered when it's recorded.
+
+	Because the mapping is shared, the contents of the file survive the
+	termination of the process by any means (including \c SIGKILL ) and can
+	be read afterwards with \c DumpFile() . So that a restarted process
+	doesn't overwrite them, a recorder constructed on the file of an earlier
+	one first renames it to \e file_name \c . \e pid , where \e pid is
+	that of the process which created it (see \c GetPreviousFileName() ).
+	A live process can write its rings to a file, merged in time order,
+	with \c Dump() , which is async-signal-safe. \c FatalSignalDump() is
+	suitable for use as the fatal signal function of
+	\c CriticalEventHandler :
+
+		LogFlightRecorderPtr recorder_ptr(
+			new LogFlightRecorder("my_app.flight"));
+		MyLogManager.FlightRecorderInstall(recorder_ptr);
+		LogFlightRecorder::SetFatalDump(recorder_ptr.get(), "my_app.crash.log");
+		CriticalEventHandler event_handler(LogFlightRecorder::FatalSignalDump);
+
+	Times in dumps are UTC.
+*/
+class API_UTILITY LogFlightRecorder {
+public:
+	static const unsigned int DefaultRingCount   = 64;
+	static const unsigned int DefaultRecordCount = 1024;
+	static const unsigned int DefaultRecordSize  = 256;
+	static const unsigned int DefaultFormatSize  = 64 * 1024;
+
+	explicit LogFlightRecorder(const std::string &file_name,
+		unsigned int ring_count = DefaultRingCount,
+		unsigned int record_count = DefaultRecordCount,
+		unsigned int record_size = DefaultRecordSize,
+		unsigned int format_size = DefaultFormatSize);
+
+	~LogFlightRecorder();
+
+	void Record(const TimeSpec &line_time, LogLevel log_level,
+		const char *line_ptr, std::size_t line_length);
+	void Record(const TimeSpec &line_time, LogLevel log_level,
+		const std::string &line_buffer) {
+		Record(line_time, log_level, line_buffer.data(), line_buffer.size());
+	}
+
+	/**
+		Records the encoded arguments of a deferred log statement or, if
+		\e format_id is \c LogBinaryFormatId_Event , the encoded fields of a
+		structured event.
+	*/
+	void RecordBinary(const TimeSpec &line_time, LogLevel log_level,
+		LogBinaryFormatId format_id, const char *arg_ptr,
+		std::size_t arg_length);
+
+	/**
+		Writes the retained lines of all rings to the file descriptor in time
+		order. Async-signal-safe. Returns the number of lines written.
+
+		The dump uses buffers allocated when the recorder was constructed
+		(including those into which deferred statements and events are
+		rendered), so calls to Dump() on the same recorder must not overlap.
+	*/
+	std::size_t Dump(int out_fd) const;
+
+	/**
+		Creates (or truncates) the named file and writes the retained lines to
+		it. Async-signal-safe. Returns the number of lines written.
+	*/
+	std::size_t Dump(const char *out_file_name) const;
+
+	const std::string &GetFileName() const;
+	std::uint64_t      GetDropCount() const;
+
+	/**
+		Returns the name to which the rings of an earlier recorder were moved
+		when this one was constructed, or an empty string if there were none.
+	*/
+	const std::string &GetPreviousFileName() const;
+
+	/**
+		Writes the retained lines in a flight recorder file left behind by
+		another (possibly terminated) process. Returns the number of lines
+		written.
+	*/
+	static std::size_t DumpFile(const std::string &file_name, int out_fd);
+
+	/**
+		Specifies the recorder and the file to which \c FatalSignalDump()
+		writes. Pass \c NULL to disable.
+	*/
+	static void SetFatalDump(const LogFlightRecorder *recorder_ptr,
+		const char *out_file_name = NULL);
+	static void FatalSignalDump(int signal_number);
+
+	struct FileHeader;
+	struct RingHeader;
+	struct RecordHeader;
+	struct FormatHeader;
+	struct FormatEntry;
+
+private:
+	std::string                file_name_;
+	std::string                previous_file_name_;
+	std::uint64_t              serial_;
+	unsigned int               ring_count_;
+	unsigned int               record_count_;
+	unsigned int               record_size_;
+	unsigned int               format_size_;
+	std::size_t                ring_size_;
+	std::size_t                format_offset_;
+	std::size_t                map_size_;
+	int                        file_fd_;
+	char                      *map_ptr_;
+	std::atomic<std::uint64_t> drop_count_;
+	//	The formats copied to the format area, by hash of the format id.
+	std::vector<std::atomic<std::uint64_t>> format_slot_list_;
+	//	Pre-allocated so that Dump() needn't allocate.
+	mutable std::vector<std::uint64_t> dump_cursor_list_;
+	mutable std::vector<char>          dump_buffer_;
+	mutable std::vector<char>          dump_format_;
+	mutable std::string                dump_render_;
+
+	void        WriteRecord(const TimeSpec &line_time, LogLevel log_level,
+		LogBinaryFormatId format_id, const char *data_ptr,
+		std::size_t data_length);
+	bool        CopyFormat(LogBinaryFormatId format_id);
+	bool        WriteFormatEntry(LogBinaryFormatId format_id);
+	RingHeader *GetThreadRing();
+	RingHeader *ClaimRing();
+
+	LogFlightRecorder(const LogFlightRecorder &) = delete;
+	LogFlightRecorder & operator = (const LogFlightRecorder &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+typedef std::shared_ptr<LogFlightRecorder> LogFlightRecorderPtr;
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogFlightRecorder_hpp__HH
+
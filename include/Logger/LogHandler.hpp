@@ -29,7 +29,7 @@
 // Required include files...
 // ////////////////////////////////////////////////////////////////////////////
 
-#include <Logger/LogEmitControl.hpp>
+#include <Logger/LogEvent.hpp>
 
 #include <memory>
 #include <mutex>
@@ -64,6 +64,12 @@ public:
 
 	virtual void EmitLineSpecific(const std::string &line_buffer,
 		LogLevel log_level = LogLevel_Info);
+
+	virtual void EmitBinary(const LogEmitControl &emit_control,
+		LogBinaryFormatId format_id, const char *arg_ptr, std::size_t arg_length);
+	virtual void EmitEvent(const LogEmitControl &emit_control);
+
+	virtual void Flush();
 };
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,171 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerAsync.hpp
+
+   File Description  :  Include file for the asynchronous log handler class.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogHandlerAsync_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogHandlerAsync_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandler.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Decorates another log handler so that the threads which produce log lines
+	never perform I/O or contend for the target handler's lock.
+
+	Producers format the line leader and copy the line into a slot of a
+	bounded lock-free queue. A single consumer thread drains the queue and
+	passes each record to the target handler.
+
+	When the queue is full the behavior is determined by the queue-full
+	policy:
+
+	\li	\e Block waits for the consumer to free a slot. No lines are lost.
+
+	\li	\e DropOldest discards the oldest queued record to make room.
+
+	\li	\e DropNewest discards the record being emitted.
+
+	Records discarded under either of the drop policies are counted and the
+	count is available by calling \c GetDropCount() .
+
+	Calling \c Flush() blocks until every record queued before the call has
+	been passed to the target handler and the target handler has itself been
+	flushed. This is done automatically for lines logged at
+	\c LogLevel_Fatal and when the handler is removed or destroyed.
+
+	Removing or destroying the handler waits for producers which are in the
+	midst of queueing a record and emits every queued record. Thereafter,
+	records are passed directly to the target handler.
+*/
+class API_UTILITY LogHandlerAsync : public LogHandler {
+public:
+	enum QueueFullPolicy {
+		Block      = 0,
+		DropOldest = 1,
+		DropNewest = 2,
+		Default    = Block
+	};
+
+	static const std::size_t DefaultQueueSize = 16384;
+
+	explicit LogHandlerAsync(LogHandlerPtr target_handler_ptr,
+		std::size_t queue_size = DefaultQueueSize,
+		QueueFullPolicy full_policy = Default);
+
+	virtual ~LogHandlerAsync() override;
+
+	virtual void InstallHandler() override;
+	virtual void RemoveHandler() override;
+
+	virtual void EmitLine(const LogEmitControl &emit_control) override;
+	virtual void EmitLiteral(unsigned int literal_length,
+		const char *literal_string) override;
+	virtual void EmitLiteral(const LogEmitControl &emit_control,
+		unsigned int literal_length, const char *literal_string) override;
+
+	virtual void EmitBinary(const LogEmitControl &emit_control,
+		LogBinaryFormatId format_id, const char *arg_ptr,
+		std::size_t arg_length) override;
+	virtual void EmitEvent(const LogEmitControl &emit_control) override;
+
+	virtual void Flush() override;
+
+	LogHandlerPtr      GetTargetHandlerPtr() const;
+	QueueFullPolicy    GetQueueFullPolicy() const;
+	std::size_t        GetQueueSize() const;
+	unsigned long long GetDropCount() const;
+
+private:
+	enum RecordType {
+		RecordType_Line           = 0,
+		RecordType_Literal        = 1,
+		RecordType_LiteralControl = 2,
+		RecordType_Binary         = 3,
+		RecordType_Event          = 4
+	};
+
+	struct QueueSlot {
+		QueueSlot();
+
+		std::atomic<std::uint64_t> sequence_;
+		RecordType                 record_type_;
+		LogFlag                    log_flags_;
+		LogLevelFlag               log_level_screen_;
+		LogLevelFlag               log_level_persistent_;
+		TimeSpec                   line_start_time_;
+		LogLevel                   log_level_;
+		LogLevelFlag               log_level_flag_;
+		ThreadId                   thread_id_;
+		LogBinaryFormatId          format_id_;
+		char                       line_leader_[LogLineLeaderLength + 1];
+		std::string                line_buffer_;
+	};
+
+	LogHandlerPtr              target_handler_ptr_;
+	QueueFullPolicy            full_policy_;
+	std::vector<QueueSlot>     queue_;
+	std::uint64_t              queue_mask_;
+	std::atomic<std::uint64_t> enqueue_pos_;
+	std::atomic<std::uint64_t> dequeue_pos_;
+	std::atomic<std::uint64_t> wakeup_count_;
+	std::atomic<std::uint64_t> done_count_;
+	std::atomic<std::uint64_t> drop_count_;
+	std::atomic<std::uint64_t> producer_count_;
+	std::atomic<bool>          stop_flag_;
+	std::thread                consumer_thread_;
+	LogLock                    control_lock_;
+
+	QueueSlot *AcquireEnqueueSlot(std::uint64_t &slot_pos);
+	QueueSlot *AcquireDequeueSlot(std::uint64_t &slot_pos);
+	QueueSlot *AcquireSlot(std::uint64_t &slot_pos);
+	void       CommitEnqueueSlot(QueueSlot *slot_ptr, std::uint64_t slot_pos);
+	void       ReleaseDequeueSlot(QueueSlot *slot_ptr, std::uint64_t slot_pos);
+	void       EmitSlot(const QueueSlot &slot);
+	void       ConsumerThreadProc();
+	void       StartConsumer();
+	void       StopConsumer();
+	void       WaitForDone(std::uint64_t target_count);
+
+	LogHandlerAsync(const LogHandlerAsync &) = delete;
+	LogHandlerAsync & operator = (const LogHandlerAsync &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogHandlerAsync_hpp__HH
+
@@ -0,0 +1,120 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerBinary.hpp
+
+   File Description  :  Include file for the binary log file handler class.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogHandlerBinary_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogHandlerBinary_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerFileBase.hpp>
+
+#include <vector>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Writes compact binary records in the format described in
+	\c LogBinary.hpp rather than text.
+
+	Deferred-formatting records (see the \c LogDeferred() macro) are written
+	with their encoded arguments and are never formatted by the producer.
+	Lines formatted as text by the producer are written using the reserved
+	text format id, and structured events with their encoded fields using the
+	reserved event format id. No leader is formatted for either, except for
+	output to the console.
+
+	Records with more than \c LogBinaryMaxDataLength bytes of data are not
+	written, but are counted by \c GetWriteFailureCount() .
+
+	The \c LogBinaryDecode program renders binary log files as text.
+*/
+class API_UTILITY LogHandlerBinary : public LogHandlerFileBase {
+public:
+	static const std::size_t DefaultBufferSize = 1 << 16;
+
+	LogHandlerBinary();
+	explicit LogHandlerBinary(const char *file_name,
+		LogHandlerFileBaseFlag flags = Default);
+	explicit LogHandlerBinary(const std::string &file_name,
+		LogHandlerFileBaseFlag flags = Default);
+
+	virtual ~LogHandlerBinary() override;
+
+	virtual void EmitLine(const LogEmitControl &emit_control) override;
+	virtual void EmitBinary(const LogEmitControl &emit_control,
+		LogBinaryFormatId format_id, const char *arg_ptr,
+		std::size_t arg_length) override;
+	virtual void EmitEvent(const LogEmitControl &emit_control) override;
+
+	/**
+		Returns the number of writes which failed. The data of a failed write
+		is discarded rather than an exception thrown into the logging thread.
+	*/
+	std::uint64_t GetWriteFailureCount() const;
+
+protected:
+	virtual void InstallHandlerImpl() override;
+	virtual void RemoveHandlerImpl() override;
+	virtual void OpenFileImpl(const char *file_name) override;
+	virtual void FlushImpl() override;
+	virtual void EmitLineImpl(const LogEmitControl &emit_control) override;
+	virtual void EmitLiteralImpl(unsigned int literal_length,
+		const char *literal_string) override;
+
+private:
+	int               file_fd_;
+	std::vector<char> out_buffer_;
+	std::size_t       out_buffer_used_;
+	std::vector<bool> format_written_list_;
+	std::uint64_t     write_failure_count_;
+	std::uint64_t     file_size_;
+
+	void WriteRecord(LogBinaryRecordType record_type, LogLevel log_level,
+		const TimeSpec &record_time, ThreadId thread_id,
+		LogBinaryFormatId format_id, const char *data_ptr_1,
+		std::size_t data_length_1, const char *data_ptr_2 = NULL,
+		std::size_t data_length_2 = 0);
+	void WriteFormatRecord(LogBinaryFormatId format_id);
+	void BufferData(const void *data_ptr, std::size_t data_length);
+	bool WriteOut(const char *data_ptr, std::size_t data_length);
+	void DiscardFailedWrite();
+	void FlushBuffer();
+	void CloseFile();
+
+	LogHandlerBinary(const LogHandlerBinary &) = delete;
+	LogHandlerBinary & operator = (const LogHandlerBinary &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogHandlerBinary_hpp__HH
+
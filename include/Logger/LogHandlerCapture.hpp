@@ -0,0 +1,187 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerCapture.hpp
+
+   File Description  :  Include file for the in-process log capture handler.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogHandlerCapture_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogHandlerCapture_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandler.hpp>
+
+#include <functional>
+#include <limits>
+#include <string_view>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	A view of a captured record. The leader and message refer to the storage
+	of the capture ring and are valid only during the call to which the
+	record is passed. Literals have an empty leader. The message of a
+	multi-line record contains all of its lines.
+*/
+struct API_UTILITY LogCaptureRecord {
+	std::uint64_t    sequence_;
+	LogLevel         log_level_;
+	ThreadId         thread_id_;
+	TimeSpec         line_time_;
+	std::string_view leader_;
+	std::string_view message_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+using LogCaptureFunc = std::function<void (const LogCaptureRecord &)>;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Receives the records captured by a \c LogHandlerCapture after the
+	subscriber was created, at the levels in its mask. A subscriber is used
+	by one thread at a time.
+
+	Records which were overwritten in the ring before the subscriber polled
+	for them are counted by \c GetDroppedCount() .
+*/
+class API_UTILITY LogCaptureSubscriber {
+public:
+	struct Ring;
+
+	LogCaptureSubscriber(LogSPtr<Ring> ring_sptr, LogLevelFlag level_mask,
+		bool use_event_fd);
+	~LogCaptureSubscriber();
+
+	/**
+		Passes the records which have arrived since the last poll to the
+		function, oldest first, and returns the number passed. The function
+		must not log through the capture handler.
+	*/
+	std::size_t   Poll(const LogCaptureFunc &record_func,
+		std::size_t max_records = std::numeric_limits<std::size_t>::max());
+
+	/**
+		Waits for the event file descriptor to be signalled, which happens
+		when a record in the mask arrives after a poll returned every
+		available record. Returns \c false on a time-out. A negative
+		\e timeout_ms waits indefinitely.
+	*/
+	bool          Wait(int timeout_ms = -1);
+
+	//	Returns -1 if the subscriber was created without an eventfd.
+	int           GetEventFd() const;
+	LogLevelFlag  GetLevelMask() const;
+	std::uint64_t GetDroppedCount() const;
+
+private:
+	friend class LogHandlerCapture;
+
+	LogSPtr<Ring> ring_sptr_;
+	LogLevelFlag  level_mask_;
+	int           event_fd_;
+	std::uint64_t next_sequence_;
+	std::uint64_t dropped_count_;
+	bool          armed_flag_;
+
+	LogCaptureSubscriber(const LogCaptureSubscriber &) = delete;
+	LogCaptureSubscriber & operator = (const LogCaptureSubscriber &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+using LogCaptureSubscriberPtr = LogSPtr<LogCaptureSubscriber>;
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Retains the most recent \e record_count log records in memory so that
+	they can be examined in-process, either by subscribers (for example, to
+	forward errors to a monitoring service) or by tests which would otherwise
+	need to re-read and parse a log file.
+
+	Each slot of the ring keeps its storage, so once the slots have grown to
+	the size of the records logged, capturing a record doesn't allocate.
+	Records are passed to subscribers and visitors as views of that storage
+	under a shared lock; capture waits only for visitors which are in
+	progress.
+
+	Lines are captured if they would be written to either the screen or the
+	persistent store. Typically the handler is added as a sink of a
+	\c LogHandlerFanOut alongside the file and console handlers.
+*/
+class API_UTILITY LogHandlerCapture : public LogHandler {
+public:
+	static const std::size_t DefaultRecordCount = 4096;
+
+	explicit LogHandlerCapture(std::size_t record_count = DefaultRecordCount);
+
+	virtual ~LogHandlerCapture() override;
+
+	virtual void EmitLine(const LogEmitControl &emit_control) override;
+	virtual void EmitLiteral(unsigned int literal_length,
+		const char *literal_string) override;
+	virtual void EmitLiteral(const LogEmitControl &emit_control,
+		unsigned int literal_length, const char *literal_string) override;
+
+	LogCaptureSubscriberPtr Subscribe(LogLevelFlag level_mask = LogFlag_Mask,
+		bool use_event_fd = true);
+
+	/**
+		Passes the retained records in the mask to the function, oldest first,
+		and returns the number passed. The function must not log through the
+		capture handler.
+	*/
+	std::size_t   Visit(const LogCaptureFunc &record_func,
+		LogLevelFlag level_mask = LogFlag_Mask) const;
+	//	Returns the number of retained records whose message contains the text.
+	std::size_t   Count(const std::string &message_text,
+		LogLevelFlag level_mask = LogFlag_Mask) const;
+	//	Discards the retained records. Subscribers are unaffected.
+	void          Clear();
+	std::size_t   GetRecordCapacity() const;
+	std::uint64_t GetCaptureCount() const;
+
+private:
+	LogSPtr<LogCaptureSubscriber::Ring> ring_sptr_;
+
+	void Capture(LogLevel log_level, ThreadId thread_id,
+		const TimeSpec &line_time, const char *leader_ptr,
+		std::size_t leader_length, const char *message_ptr,
+		std::size_t message_length);
+
+	LogHandlerCapture(const LogHandlerCapture &) = delete;
+	LogHandlerCapture & operator = (const LogHandlerCapture &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogHandlerCapture_hpp__HH
+
@@ -0,0 +1,122 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerFanOut.hpp
+
+   File Description  :  Include file for the fan-out log handler class.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogHandlerFanOut_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogHandlerFanOut_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerAsync.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Passes each log record to a number of sink handlers.
+
+	Each sink has its own level mask: a record is passed to a sink only if
+	the flag for its level is set in the sink's mask. The usual screen and
+	persistent masks continue to apply within each sink handler.
+
+	A sink added with its own thread is wrapped in a \c LogHandlerAsync so
+	that the sink is fed from its own queue by its own consumer thread. A
+	slow sink (such as the console on a congested terminal session) then
+	delays only its own output. Note that a sink with the \e Block queue-full
+	policy will still hold up the producers once its queue fills, so slow
+	sinks should generally use one of the drop policies.
+
+	Sinks may be added and removed at any time. Emitting threads use an
+	immutable snapshot of the sink list and take no lock to do so.
+*/
+class API_UTILITY LogHandlerFanOut : public LogHandler {
+public:
+	LogHandlerFanOut();
+
+	virtual ~LogHandlerFanOut() override;
+
+	virtual void InstallHandler() override;
+	virtual void RemoveHandler() override;
+
+	virtual void EmitLine(const LogEmitControl &emit_control) override;
+	virtual void EmitLiteral(unsigned int literal_length,
+		const char *literal_string) override;
+	virtual void EmitLiteral(const LogEmitControl &emit_control,
+		unsigned int literal_length, const char *literal_string) override;
+
+	virtual void EmitBinary(const LogEmitControl &emit_control,
+		LogBinaryFormatId format_id, const char *arg_ptr,
+		std::size_t arg_length) override;
+	virtual void EmitEvent(const LogEmitControl &emit_control) override;
+
+	virtual void Flush() override;
+
+	void         AddSink(LogHandlerPtr handler_ptr,
+		LogLevelFlag level_mask = LogFlag_Mask, bool own_thread = true,
+		std::size_t queue_size = LogHandlerAsync::DefaultQueueSize,
+		LogHandlerAsync::QueueFullPolicy full_policy =
+		LogHandlerAsync::Default);
+	bool         RemoveSink(LogHandlerPtr handler_ptr);
+	bool         SetSinkLevelMask(LogHandlerPtr handler_ptr,
+		LogLevelFlag level_mask);
+	LogLevelFlag GetSinkLevelMask(LogHandlerPtr handler_ptr) const;
+	std::size_t  GetSinkCount() const;
+
+private:
+	struct Sink {
+		Sink(LogHandlerPtr handler_ptr, LogHandlerPtr emit_handler_ptr,
+			LogLevelFlag level_mask);
+
+		LogHandlerPtr handler_ptr_;
+		LogHandlerPtr emit_handler_ptr_;
+		LogLevelFlag  level_mask_;
+	};
+
+	using SinkList     = std::vector<Sink>;
+	using SinkListSPtr = LogSPtr<const SinkList>;
+
+	std::atomic<SinkListSPtr> sink_list_sptr_;
+	bool                      installed_flag_;
+	mutable LogLock           control_lock_;
+
+	SinkListSPtr GetSinkList() const;
+
+	LogHandlerFanOut(const LogHandlerFanOut &) = delete;
+	LogHandlerFanOut & operator = (const LogHandlerFanOut &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogHandlerFanOut_hpp__HH
+
@@ -32,6 +32,15 @@
 // ////////////////////////////////////////////////////////////////////////////
 
 #include <Logger/LogHandlerFileBase.hpp>
+#include <Logger/LogFileRotator.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+struct iovec;
 
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -95,11 +104,23 @@ public:
 	LogHandlerFileFlag SetFlags(LogHandlerFileFlag new_flags);
 	std::string        GetFileName() const;
 
+	LogFileRotationSpec GetRotationSpec() const;
+	void                SetRotationSpec(
+		const LogFileRotationSpec &rotation_spec);
+	std::uint64_t       GetRotationCount() const;
+	std::uint64_t       GetReopenFailureCount() const;
+	void                WaitForCompression();
+
 protected:
 	std::string            out_file_name_;
 	LogSPtr<std::ofstream> out_file_ptr_;
 	LogHandlerFileFlag     my_flags_;
 	mutable LogLock        the_lock_;
+	LogFileRotator         rotator_;
+	std::uint64_t          reopen_failure_count_;
+
+	void RotateIfNeeded(std::size_t pending_length);
+	void RotateFile();
 
 private:
 
@@ -109,13 +130,53 @@ private:
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
+/**
+	Specifies when the records batched by a \c LogHandlerXFile are written to
+	the file.
+
+	Records are accumulated in a buffer of \c flush_bytes_ bytes, which is
+	written when the next record won't fit. A buffer size of zero writes each
+	record as it is emitted. The buffer is also written when it has held data
+	for \c flush_micros_ microseconds (zero disables the timer) and whenever
+	a line at or above \c flush_level_ is emitted.
+
+	Lines at \c LogLevel_Fatal are always written before the call which
+	emitted them returns, regardless of the policy.
+*/
+struct API_UTILITY LogFlushPolicy {
+	static const std::size_t  DefaultFlushBytes  = 1 << 20;
+	static const unsigned int DefaultFlushMicros = 100000;
+
+	explicit LogFlushPolicy(std::size_t flush_bytes = DefaultFlushBytes,
+		unsigned int flush_micros = DefaultFlushMicros,
+		LogLevel flush_level = LogLevel_Error);
+
+	std::size_t  flush_bytes_;
+	unsigned int flush_micros_;
+	LogLevel     flush_level_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Writes log lines to a file, batching records into a large page-aligned
+	buffer which is written with a single system call as determined by the
+	handler's \c LogFlushPolicy . Records too large for the space remaining
+	in the buffer are written together with the buffer contents by a single
+	\c writev() call, without being copied.
+
+	A background thread, started on first use, writes buffers which have
+	been held for longer than the flush interval.
+*/
 class API_UTILITY LogHandlerXFile : public LogHandlerFileBase {
 public:
 	LogHandlerXFile();
 	explicit LogHandlerXFile(const char *file_name,
-		LogHandlerFileBaseFlag flags = Default);
+		LogHandlerFileBaseFlag flags = Default,
+		const LogFlushPolicy &flush_policy = LogFlushPolicy());
 	explicit LogHandlerXFile(const std::string &file_name,
-		LogHandlerFileBaseFlag flags = Default);
+		LogHandlerFileBaseFlag flags = Default,
+		const LogFlushPolicy &flush_policy = LogFlushPolicy());
 /* 
 	CODE NOTE: Decide whether to remove the elaborate instances of the OpenFile() overload.
 	LogHandlerXFile(const char *base_name, const char *dir_name,
@@ -132,6 +193,18 @@ public:
 
 	virtual ~LogHandlerXFile();
 
+	LogFileRotationSpec GetRotationSpec() const;
+	void                SetRotationSpec(
+		const LogFileRotationSpec &rotation_spec);
+	std::uint64_t       GetRotationCount() const;
+	std::uint64_t       GetReopenFailureCount() const;
+	void                WaitForCompression();
+
+	LogFlushPolicy      GetFlushPolicy() const;
+	void                SetFlushPolicy(const LogFlushPolicy &flush_policy);
+	std::uint64_t       GetWriteCallCount() const;
+	std::uint64_t       GetWriteFailureCount() const;
+
 protected:
 	virtual void InstallHandlerImpl();
 	virtual void RemoveHandlerImpl();
@@ -141,9 +214,60 @@ protected:
 	virtual void EmitLiteralImpl(unsigned int literal_length,
 		const char *literal_string);
 
-	LogSPtr<std::ofstream> out_file_ptr_;
+	/**
+		Writes the data described by the I/O vector to the file. Called with
+		the lock held. Returns \c false if the data could not be written.
+	*/
+	virtual bool WriteOut(struct iovec *iov_list, int iov_count);
+
+	/**
+		Called with the lock held before the file is closed (including when it
+		is rotated) so that a subclass which writes asynchronously can wait
+		until its writes have completed.
+	*/
+	virtual void WaitForWrites();
+
+	/**
+		Stops and joins the thread which writes batches after the flush
+		interval. A subclass which overrides \c WriteOut() must call this
+		first in its destructor, because the thread would otherwise call
+		\c WriteOut() while the subclass is being destroyed.
+	*/
+	void StopFlushThread();
+
+	int                    file_fd_;
+	LogFileRotator         rotator_;
+	std::uint64_t          reopen_failure_count_;
+
+	void RotateIfNeeded(std::size_t pending_length);
+	void RotateFile();
 
 private:
+	typedef std::chrono::steady_clock MyClock;
+
+	struct BatchFree {
+		void operator () (char *batch_ptr) const;
+	};
+
+	LogFlushPolicy                   flush_policy_;
+	std::unique_ptr<char, BatchFree> batch_ptr_;
+	std::size_t                      batch_used_;
+	MyClock::time_point              batch_time_;
+	std::uint64_t                    write_call_count_;
+	std::uint64_t                    write_failure_count_;
+	bool                             flush_stop_;
+	std::condition_variable          flush_cond_;
+	std::thread                      flush_thread_;
+
+	void EmitRecord(LogLevel log_level, const char *data_ptr_1,
+		std::size_t data_length_1, const char *data_ptr_2 = NULL,
+		std::size_t data_length_2 = 0);
+	void FlushBatch();
+	void AllocateBatch();
+	void CloseFile();
+	void FlushThreadProc();
+
+	static int OpenXFile(const char *file_name, bool do_not_append);
 
 	LogHandlerXFile(const LogHandlerXFile &) = delete;
 	LogHandlerXFile & operator = (const LogHandlerXFile &) = delete;
@@ -72,7 +72,7 @@ public:
 		const MLB::Utility::TimeT &start_time);
 */
 
-	void Flush();
+	virtual void Flush() override;
 
 	LogHandlerFileBaseFlag GetFlags() const;
 	LogHandlerFileBaseFlag SetFlags(LogHandlerFileBaseFlag new_flags);
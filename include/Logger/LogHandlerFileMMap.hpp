@@ -14,8 +14,11 @@
                            Michael L. Brock
                         2023-01-05 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- Lock-free space reservation with
+                                       chunks mapped ahead of the writers.
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 2005 - 2023.
+      Copyright Michael L. Brock 2005 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -34,17 +37,9 @@
 
 #include <Logger/LogHandlerFileBase.hpp>
 
-#ifdef _Windows
-#pragma warning(push)
-#pragma warning(disable:4061 4365)
-#endif // #ifdef _Windows
-
-#include <boost/interprocess/file_mapping.hpp>
-#include <boost/interprocess/mapped_region.hpp>
-
-#ifdef _Windows
-#pragma warning(pop)
-#endif // #ifdef _Windows
+#include <atomic>
+#include <cstdint>
+#include <thread>
 
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -53,69 +48,111 @@ namespace MLB {
 namespace Utility {
 
 // ////////////////////////////////////////////////////////////////////////////
+/**
+	Writes log lines to a file through a sequence of memory-mapped chunks.
+
+	Each line reserves its place in the file with a single atomic fetch-add
+	on \c write_offset_ and is then copied into the mapped chunk (or chunks)
+	which it spans, so writers to the file never take a lock.
+
+	A helper thread extends the file, maps and pre-faults the chunks ahead of
+	the current write offset and unmaps chunks once every byte in them has
+	been written. Writers only wait if they get more than
+	\c ChunkLookAhead chunks ahead of the helper thread; the number of times
+	that has happened is available from \c GetStallCount() .
+
+	The file is truncated to the last byte written when it is closed. Should
+	the process fail before that, the ASCII NUL padding at the end of the file
+	is skipped when the file is next opened for appending.
+*/
 class API_UTILITY LogHandlerFileMMap : public LogHandlerFileBase {
-	typedef unsigned long long                 MyMappingValue;
-	typedef boost::interprocess::file_mapping  MyFileMapping;
-	typedef boost::interprocess::mapped_region MyMappedRegion;
-	typedef LogSPtr<MyFileMapping>             MyFileMappingSPtr;
-	typedef LogSPtr<MyMappedRegion>            MyMappedRegionSPtr;
 public:
-	LogHandlerFileMMap();
+	static const std::size_t   DefaultChunkSize = 1 << 20;
+	static const unsigned int  ChunkSlotCount   = 4;
+	static const unsigned int  ChunkLookAhead   = 2;
+
+	explicit LogHandlerFileMMap(std::size_t chunk_size = DefaultChunkSize);
 	explicit LogHandlerFileMMap(const char *file_name,
-										 LogHandlerFileBaseFlag flags = Default);
+		LogHandlerFileBaseFlag flags = Default,
+		std::size_t chunk_size = DefaultChunkSize);
 	explicit LogHandlerFileMMap(const std::string &file_name,
-										 LogHandlerFileBaseFlag flags = Default);
-/* 
-	CODE NOTE: Decide whether to remove the elaborate instances of the OpenFile() overload.
-	LogHandlerFileMMap(const char *base_name, const char *dir_name,
-		LogHandlerFileBaseFlag flags = Default);
-	LogHandlerFileMMap(const std::string &base_name, const std::string &dir_name,
-		LogHandlerFileBaseFlag flags = Default);
-	LogHandlerFileMMap(const char *base_name, const char *dir_name,
-		const MLB::Utility::TimeT &start_time,
-		LogHandlerFileBaseFlag flags = Default);
-	LogHandlerFileMMap(const std::string &base_name, const std::string &dir_name,
-		const MLB::Utility::TimeT &start_time,
-		LogHandlerFileBaseFlag flags = Default);
-*/
+		LogHandlerFileBaseFlag flags = Default,
+		std::size_t chunk_size = DefaultChunkSize);
 
-	virtual ~LogHandlerFileMMap();
+	virtual ~LogHandlerFileMMap() override;
+
+	virtual void EmitLine(const LogEmitControl &emit_control) override;
+	virtual void EmitLiteral(unsigned int literal_length,
+		const char *literal_string) override;
+	virtual void EmitLiteral(const LogEmitControl &emit_control,
+		unsigned int literal_length, const char *literal_string) override;
+
+	std::size_t   GetChunkSize() const;
+	std::uint64_t GetStallCount() const;
+	std::uint64_t GetMapFailureCount() const;
 
 protected:
-	virtual void InstallHandlerImpl();
-	virtual void RemoveHandlerImpl();
-	virtual void OpenFileImpl(const char *file_name);
-	virtual void FlushImpl();
-	virtual void EmitLineImpl(const LogEmitControl &emit_control);
+	virtual void InstallHandlerImpl() override;
+	virtual void RemoveHandlerImpl() override;
+	virtual void OpenFileImpl(const char *file_name) override;
+	virtual void FlushImpl() override;
+	virtual void EmitLineImpl(const LogEmitControl &emit_control) override;
 	virtual void EmitLiteralImpl(unsigned int literal_length,
-										  const char *literal_string);
-
-	std::string        eol_string_;
-	std::size_t        eol_string_length_;
-	std::size_t        page_alloc_size_;
-	std::size_t        chunk_alloc_size_;
-#if defined(_Windows) && !defined(__MINGW32__)
-#pragma warning(push)
-#pragma warning(disable:4251)
-#endif // #if defined(_Windows) && !defined(__MINGW32__)
-	MyFileMappingSPtr  mapping_sptr_;
-	MyMappedRegionSPtr region_sptr_;
-#if defined(_Windows) && !defined(__MINGW32__)
-#pragma warning(pop)
-#endif // #if defined(_Windows) && !defined(__MINGW32__)
-	unsigned int       mapping_size_;
-	MyMappingValue     mapping_offset_;
-	MyMappingValue     write_offset_;
+		const char *literal_string) override;
 
 private:
-	void* GetCurrentPtr();
-
-	void AddToOffset(std::size_t added_offset);
-
-	void EnsureNeededSpace(std::size_t needed_length);
-
-	LogHandlerFileMMap(const LogHandlerFileMMap&) = delete;
-	LogHandlerFileMMap& operator=(const LogHandlerFileMMap&) = delete;
+	/*
+		The chunk with index 'n' lives in slot 'n % ChunkSlotCount'. The
+		helper thread publishes a chunk by storing its index last; writers
+		into a chunk add the number of bytes they've copied into it to
+		'bytes_done_', and the chunk is retired when that reaches the chunk
+		size.
+	*/
+	struct alignas(64) ChunkSlot {
+		std::atomic<std::uint64_t> chunk_index_;
+		std::atomic<char *>        chunk_ptr_;
+		std::atomic<std::size_t>   bytes_done_;
+	};
+
+	static const std::uint64_t NoChunkIndex = ~static_cast<std::uint64_t>(0);
+	static const std::uint64_t ClosedFlag   =
+		static_cast<std::uint64_t>(1) << 63;
+
+	std::string                eol_string_;
+	std::size_t                eol_string_length_;
+	std::size_t                page_alloc_size_;
+	std::size_t                chunk_alloc_size_;
+	int                        file_fd_;
+	std::uint64_t              file_size_;
+	std::uint64_t              first_chunk_index_;
+	std::size_t                first_chunk_done_;
+	std::uint64_t              next_map_index_;
+	std::atomic<std::uint64_t> next_retire_index_;
+	ChunkSlot                  chunk_slot_list_[ChunkSlotCount];
+	std::atomic<std::uint64_t> stall_count_;
+	std::atomic<std::uint64_t> map_failure_count_;
+	std::atomic<bool>          map_stop_;
+	std::atomic<std::uint32_t> map_signal_;
+	std::thread                map_thread_;
+	LogLock                    chunk_lock_;
+	alignas(64)
+	std::atomic<std::uint64_t> write_offset_;
+
+	bool          ReserveSpace(std::size_t length, std::uint64_t &offset);
+	std::uint64_t CopyToFile(std::uint64_t offset, const char *data_ptr,
+		std::size_t data_length);
+	ChunkSlot    &GetChunkSlot(std::uint64_t chunk_index);
+	void          WakeMapThread();
+	void          MapThreadProc();
+	void          RetireChunks();
+	void          MapChunks();
+	void          WaitForWriters(std::uint64_t final_offset);
+	void          CloseFile();
+
+	static std::uint64_t FindEndOfData(int file_fd, std::uint64_t file_size);
+
+	LogHandlerFileMMap(const LogHandlerFileMMap &) = delete;
+	LogHandlerFileMMap & operator = (const LogHandlerFileMMap &) = delete;
 };
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,145 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerFileShard.hpp
+
+   File Description  :  Include file for the per-thread sharded file log
+                        handler.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogHandlerFileShard_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogHandlerFileShard_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerFile.hpp>
+
+#include <atomic>
+#include <iosfwd>
+#include <vector>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Writes the lines of each thread to a file of its own (a shard), so that
+	threads which log share no lock and no file offset.
+
+	The shard of a thread is obtained the first time the thread logs through
+	the handler. Its name is that given to \c OpenFile() followed by a
+	four-digit shard number (\c GetShardFileName() ). Each shard batches its
+	lines as specified by the handler's \c LogFlushPolicy ; a background
+	thread writes the shards which have been held for longer than the flush
+	interval. When its thread exits a shard is written, closed and its
+	buffer freed; it's then reused by the next thread which needs a shard,
+	so that the number of shards is that of the threads which have logged
+	concurrently.
+
+	The \e DoNotAppend flag truncates each shard as it's opened. Unless the
+	\e NoConsoleOutput flag is set, lines at the console levels are also
+	written to the standard output, which is serialized by the handler's
+	lock; set it for the lock-free path.
+
+	Use \c LogShardMerge() (or the \c LogShardMerge program) to combine the
+	shards into a single log ordered by the times in the line leaders.
+*/
+class API_UTILITY LogHandlerFileShard : public LogHandlerFileBase {
+public:
+	static const std::size_t DefaultFlushBytes = 64 * 1024;
+
+	explicit LogHandlerFileShard(const char *file_name,
+		LogHandlerFileBaseFlag flags = Default,
+		const LogFlushPolicy &flush_policy = LogFlushPolicy(DefaultFlushBytes));
+	explicit LogHandlerFileShard(const std::string &file_name,
+		LogHandlerFileBaseFlag flags = Default,
+		const LogFlushPolicy &flush_policy = LogFlushPolicy(DefaultFlushBytes));
+
+	virtual ~LogHandlerFileShard() override;
+
+	//	Overridden so that the shard path doesn't take the handler's lock.
+	virtual void EmitLine(const LogEmitControl &emit_control) override;
+	virtual void EmitLiteral(unsigned int literal_length,
+		const char *literal_string) override;
+	virtual void EmitLiteral(const LogEmitControl &emit_control,
+		unsigned int literal_length, const char *literal_string) override;
+
+	std::vector<std::string> GetShardFileNameList() const;
+	std::uint64_t            GetWriteFailureCount() const;
+
+	static std::string GetShardFileName(const std::string &file_name,
+		unsigned int shard_number);
+
+	struct Shard;
+
+protected:
+	virtual void InstallHandlerImpl() override;
+	virtual void RemoveHandlerImpl() override;
+	virtual void OpenFileImpl(const char *file_name) override;
+	virtual void FlushImpl() override;
+	virtual void EmitLineImpl(const LogEmitControl &emit_control) override;
+	virtual void EmitLiteralImpl(unsigned int literal_length,
+		const char *literal_string) override;
+
+private:
+	typedef std::shared_ptr<Shard> ShardPtr;
+
+	std::uint64_t              handler_serial_;
+	LogFlushPolicy             flush_policy_;
+	std::atomic<std::uint64_t> file_generation_;
+	std::atomic<std::uint64_t> write_failure_count_;
+	std::vector<ShardPtr>      shard_list_;
+	bool                       flush_stop_;
+	std::condition_variable    flush_cond_;
+	std::thread                flush_thread_;
+
+	ShardPtr  ClaimShard();
+	Shard    *GetThreadShard();
+	void      EmitRecord(LogLevel log_level, const char *data_ptr_1,
+		std::size_t data_length_1, const char *data_ptr_2 = NULL,
+		std::size_t data_length_2 = 0);
+	void      FlushThreadProc();
+
+	LogHandlerFileShard(const LogHandlerFileShard &) = delete;
+	LogHandlerFileShard & operator = (const LogHandlerFileShard &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Merges text log files (typically the shards written by a
+	\c LogHandlerFileShard ) into a single log ordered by the times in the
+	line leaders. Lines without a leader (literals and the continuation of
+	multi-line records) stay with the line which precedes them. Lines with
+	the same time are taken from the files in the order given. Returns the
+	number of lines written.
+*/
+API_UTILITY std::size_t LogShardMerge(
+	const std::vector<std::string> &file_name_list, std::ostream &out_stream);
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogHandlerFileShard_hpp__HH
+
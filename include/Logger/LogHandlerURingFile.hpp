@@ -0,0 +1,154 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogHandlerURingFile.hpp
+
+   File Description  :  Include file for the io_uring file log handler.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogHandlerURingFile_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogHandlerURingFile_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogHandlerFile.hpp>
+
+#include <vector>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Specifies the operation which \c LogHandlerURingFile::Flush() submits
+	after the writes which precede it.
+*/
+enum LogURingSync {
+	LogURingSync_None      = 0,
+	LogURingSync_FDataSync = 1,
+	LogURingSync_FSync     = 2
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	A \c LogHandlerXFile which writes its batches through an io_uring
+	instance rather than with \c writev() , so that the thread which logs
+	doesn't wait for the write to complete.
+
+	Each batch is copied to one of \e buffer_count buffers of
+	\c DefaultBufferBytes bytes which are registered with the ring and
+	written with \c IORING_OP_WRITE_FIXED to a second descriptor for the log
+	file (registered as a fixed file) at an offset maintained by the handler.
+	Up to \e buffer_count writes may be in flight; the logging thread waits
+	only when all of the buffers are in use. Lines are written in order
+	regardless of the order in which the writes complete.
+
+	\c Flush() writes the batch and, if \e sync_mode is not
+	\c LogURingSync_None , submits an \c fdatasync() or \c fsync() which the
+	ring runs once the preceding writes have completed. It then waits for
+	all outstanding operations. A fatal line is likewise on the file when
+	\c EmitLine() returns. The writes in flight are also completed before
+	the file is closed or rotated.
+
+	If the ring can't be created (the kernel doesn't support io_uring or
+	\e buffer_count is zero) the handler behaves exactly as a
+	\c LogHandlerXFile . Failed or partial completions are re-written with
+	\c pwrite() .
+*/
+class API_UTILITY LogHandlerURingFile : public LogHandlerXFile {
+public:
+	static const std::size_t  DefaultBufferBytes = 256 * 1024;
+	static const unsigned int DefaultBufferCount = 8;
+
+	explicit LogHandlerURingFile(const char *file_name,
+		LogHandlerFileBaseFlag flags = Default,
+		const LogFlushPolicy &flush_policy = LogFlushPolicy(DefaultBufferBytes),
+		LogURingSync sync_mode = LogURingSync_None,
+		unsigned int buffer_count = DefaultBufferCount);
+	explicit LogHandlerURingFile(const std::string &file_name,
+		LogHandlerFileBaseFlag flags = Default,
+		const LogFlushPolicy &flush_policy = LogFlushPolicy(DefaultBufferBytes),
+		LogURingSync sync_mode = LogURingSync_None,
+		unsigned int buffer_count = DefaultBufferCount);
+
+	virtual ~LogHandlerURingFile() override;
+
+	/**
+		Returns \c true if writes are submitted through io_uring, \c false if
+		the handler has fallen back to the \c LogHandlerXFile behaviour.
+	*/
+	bool          IsURingActive() const;
+	std::uint64_t GetSubmitCount() const;
+	std::uint64_t GetBufferWaitCount() const;
+	std::uint64_t GetCompletionFailureCount() const;
+
+	struct Ring;
+
+protected:
+	virtual void FlushImpl() override;
+	virtual void EmitLineImpl(const LogEmitControl &emit_control) override;
+	virtual bool WriteOut(struct iovec *iov_list, int iov_count) override;
+	virtual void WaitForWrites() override;
+
+private:
+	struct Slot {
+		Slot();
+
+		char          *buffer_ptr_;
+		std::size_t    data_length_;
+		std::uint64_t  file_offset_;
+	};
+
+	LogURingSync          sync_mode_;
+	std::unique_ptr<Ring> ring_ptr_;
+	std::vector<Slot>     slot_list_;
+	std::vector<unsigned> free_slot_list_;
+	unsigned int          in_flight_count_;
+	int                   source_fd_;
+	int                   writer_fd_;
+	bool                  fixed_file_flag_;
+	std::uint64_t         file_offset_;
+	std::uint64_t         submit_count_;
+	std::uint64_t         buffer_wait_count_;
+	std::uint64_t         completion_failure_count_;
+
+	void CreateRing(unsigned int buffer_count);
+	void AttachFile();
+	void DetachFile();
+	void Submit(unsigned char op_code, unsigned int slot_index,
+		unsigned char sqe_flags = 0, unsigned int op_flags = 0);
+	void Reap(unsigned int wait_count);
+	void Complete(std::uint64_t user_data, int result);
+	void WaitForAll();
+
+	LogHandlerURingFile(const LogHandlerURingFile &) = delete;
+	LogHandlerURingFile & operator = (const LogHandlerURingFile &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogHandlerURingFile_hpp__HH
+
@@ -11,8 +11,10 @@
                            Michael L. Brock
                         2023-01-05 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- Added ConvertTextToLogLevel().
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 2005 - 2023.
+      Copyright Michael L. Brock 2005 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -92,6 +94,32 @@ const LogLevel LogLevel_Maximum = LogLevel_Fatal;
 const LogLevel LogLevel_Invalid = static_cast<LogLevel>(-1);
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+/*
+	Log statements written with the LogIf...() macros at a level below
+	MLB_LOGGER_MIN_LEVEL are removed by the compiler. For example, building
+	with '-DMLB_LOGGER_MIN_LEVEL=3' strips the Spam and Minutiae statements.
+
+	Literal statements are never stripped.
+*/
+#ifndef MLB_LOGGER_MIN_LEVEL
+# define MLB_LOGGER_MIN_LEVEL  0
+#endif // #ifndef MLB_LOGGER_MIN_LEVEL
+
+constexpr LogLevel LogLevel_CompiledMinimum =
+	static_cast<LogLevel>(MLB_LOGGER_MIN_LEVEL);
+
+static_assert((LogLevel_CompiledMinimum >= LogLevel_Minimum) &&
+	(LogLevel_CompiledMinimum <= LogLevel_Maximum),
+	"MLB_LOGGER_MIN_LEVEL must be in the range of the LogLevel enumeration.");
+
+constexpr bool LogLevelIsCompiled(LogLevel log_level)
+{
+	return((log_level == LogLevel_Literal) ||
+		(log_level >= LogLevel_CompiledMinimum));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
 #if 0
 // ////////////////////////////////////////////////////////////////////////////
 enum class LogLevel {
@@ -165,6 +193,9 @@ API_UTILITY std::string  &ConvertLogLevelToTextSimple(LogLevel log_level,
 	std::string &out_string);
 API_UTILITY std::string   ConvertLogLevelToTextSimple(LogLevel log_level);
 
+//	Accepts the simple name of a level (case-insensitive) or its number.
+API_UTILITY LogLevel      ConvertTextToLogLevel(const std::string &level_text);
+
 API_UTILITY LogLevel      CheckLogLevel(LogLevel log_level);
 
 API_UTILITY LogLevelPair  LogLevelFlagsToLevels(LogLevelFlag log_level_flags);
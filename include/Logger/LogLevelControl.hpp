@@ -0,0 +1,122 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogLevelControl.hpp
+
+   File Description  :  Include file for the run-time control of log levels
+                        from a configuration file.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogLevelControl_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogLevelControl_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogManager.hpp>
+
+#include <condition_variable>
+#include <csignal>
+#include <thread>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Applies the log levels in a configuration file to a log manager and to
+	log tags while the process runs. The file is read when the control is
+	constructed and again whenever its modification time or size changes
+	(checked every \e poll_ms milliseconds) or the signal installed by
+	\c InstallSignalReload() is received. For example:
+
+		# Levels are a minimum ("debug") or a range ("debug-error"), given
+		# by name or by number.
+		console             = info
+		file                = debug
+		# Tag overrides. "default" removes the override.
+		console.mfstore.io  = spam
+		file.mfstore.io     = spam
+
+	A tag with only one of its two entries takes the other level from the
+	log manager. The console and file levels of the log manager revert to
+	those in effect when the control was constructed if their entries are
+	removed from the file, as do tag overrides.
+
+	A file which can't be parsed is rejected in its entirety: a warning is
+	logged and the levels are left as they were.
+
+	The log manager and the tags read their levels without a lock, so a
+	reload doesn't delay the threads which are logging.
+*/
+class API_UTILITY LogLevelControl {
+public:
+	static const unsigned int DefaultPollMilliseconds = 1000;
+
+	LogLevelControl(LogManager &manager_ref, const std::string &file_name,
+		unsigned int poll_ms = DefaultPollMilliseconds);
+	~LogLevelControl();
+
+	/**
+		Reads the file and applies its levels. Returns false (and logs a
+		warning) if the file couldn't be read or parsed.
+	*/
+	bool Reload();
+
+	const std::string &GetFileName() const;
+	std::string        GetLastError() const;
+	unsigned int       GetReloadCount() const;
+
+	/**
+		Installs a handler for the specified signal which causes every
+		LogLevelControl to reload its file.
+	*/
+	static void InstallSignalReload(int signal_number = SIGUSR1);
+
+private:
+	struct FileState;
+
+	LogManager                &manager_ref_;
+	std::string                file_name_;
+	unsigned int               poll_ms_;
+	LogLevelPair               initial_console_;
+	LogLevelPair               initial_file_;
+	std::set<std::string>      tag_name_set_;
+	std::string                last_error_;
+	unsigned int               reload_count_;
+	mutable LogLock            control_lock_;
+	std::condition_variable    stop_condition_;
+	bool                       stop_flag_;
+	std::thread                watcher_thread_;
+
+	void WatcherThreadProc(unsigned int signal_count, FileState file_state);
+
+	LogLevelControl(const LogLevelControl &) = delete;
+	LogLevelControl & operator = (const LogLevelControl &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogLevelControl_hpp__HH
+
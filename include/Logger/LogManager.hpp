@@ -13,8 +13,20 @@
                            Michael L. Brock
                         2023-01-05 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- ThreadStreamBuffer put area and bulk
+                                       appends.
+                           Michael L. Brock
+                        2026-10-16 --- Rate-limited log statements.
+                           Michael L. Brock
+                        2026-10-16 --- Flight recorder support.
+                           Michael L. Brock
+                        2026-10-16 --- Lock-free level masks and log tags.
+                           Michael L. Brock
+                        2026-10-16 --- Handlers are called without the
+                                       log manager lock.
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 1993 - 2023.
+      Copyright Michael L. Brock 1993 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -39,14 +51,21 @@
 // Required include files...
 // ////////////////////////////////////////////////////////////////////////////
 
+#include <Logger/LogClock.hpp>
+#include <Logger/LogFlightRecorder.hpp>
 #include <Logger/LogHandlerConsole.hpp>
+#include <Logger/LogRateLimit.hpp>
+#include <Logger/LogTag.hpp>
 
 #include <Utility/ThreadId.hpp>        // CODE NOTE: Needed by LogStream.hpp ONLY.
 
+#include <atomic>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <map>
 #include <set>
+#include <vector>
 
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -72,9 +91,17 @@ public:
 
 	~LogManager();
 
+	/*
+		Emitting threads take a reference to the installed handler and call
+		it without holding any log manager lock, so handlers must be safe
+		for concurrent calls (those in this library are). When a handler is
+		replaced or removed, HandlerInstall() waits until no thread is still
+		emitting to it before calling its RemoveHandler(), so a handler must
+		not itself install or remove the handler of its log manager.
+	*/
 	LogHandlerPtr HandlerInstall(LogHandlerPtr log_handler_ptr);
 	LogHandlerPtr HandlerRemove();
-	LogHandlerPtr GetHandlerPtr();
+	LogHandlerPtr GetHandlerPtr() const;
 
 	LogLevelPair GetLogLevelConsole() const;
 	LogLevelPair GetLogLevelFile() const;
@@ -87,8 +114,43 @@ public:
 	void SetLogLevelConsoleAll();
 	void SetLogLevelFileAll();
 
+	/*
+		Lines at the specified levels are given to the flight recorder in
+		addition to (and without regard to the level settings of) the
+		handler. Lines which go only to the flight recorder aren't given to
+		the handler at all.
+
+		Threads which are recording into a flight recorder when it's replaced
+		or removed hold a reference to it until they have finished, so it's
+		destroyed once they and the caller have released it.
+	*/
+	LogFlightRecorderPtr FlightRecorderInstall(
+		LogFlightRecorderPtr recorder_ptr,
+		LogLevel min_log_level = LogLevel_Minimum,
+		LogLevel max_log_level = LogLevel_Maximum);
+	LogFlightRecorderPtr FlightRecorderRemove();
+
+	//	Lock-free test of whether a line at the specified level would be
+	//	emitted to the console, the persistent store or the flight recorder.
+	bool IsLevelEnabled(LogLevel log_level) const {
+		return((log_level_enabled_.load(std::memory_order_relaxed) &
+			(1U << static_cast<unsigned int>(log_level))) != 0);
+	}
+	//	As above, but subject to the override of the tag (if any).
+	bool IsLevelEnabled(LogLevel log_level, const LogTag &log_tag) const {
+		LogTagOverride tag_override = log_tag.GetOverride();
+		if (!(tag_override & LogTagOverride_Active))
+			return(IsLevelEnabled(log_level));
+		unsigned int log_level_flag = 1U << static_cast<unsigned int>(log_level);
+		return(((static_cast<unsigned int>(LogTagGetScreen(tag_override)) |
+			static_cast<unsigned int>(LogTagGetPersistent(tag_override)) |
+			log_level_recorder_.load(std::memory_order_relaxed)) &
+			log_level_flag) != 0);
+	}
+
 	void EmitLine(const TimeSpec &line_start_time, LogLevel log_level,
-		const std::string &line_buffer);
+		const std::string &line_buffer,
+		LogTagOverride tag_override = LogTagOverride_None);
 	void EmitLine(const std::string &line_buffer,
 		LogLevel log_level = LogLevel_Info);
 	void EmitLiteral(const std::string &literal_string);
@@ -96,6 +158,10 @@ public:
 	void EmitLiteral(LogLevel log_level, const std::string &literal_string);
 	void EmitLiteral(LogLevel log_level, unsigned int literal_length,
 		const char *literal_ptr);
+	void EmitBinary(const TimeSpec &line_start_time, LogLevel log_level,
+		LogBinaryFormatId format_id, const std::string &arg_buffer);
+	void EmitEvent(const TimeSpec &line_start_time, LogLevel log_level,
+		const std::string &field_buffer);
 
 	//	Public to provide speed by permitting access to a pointer to will be
 	//	const memory on most systems. Don't ever try to write through the
@@ -109,11 +175,71 @@ public:
 	}
 
 private:
-	LogHandlerPtr log_handler_ptr_;
-	LogFlag       log_flags_;
-	LogLevelFlag  log_level_screen_;
-	LogLevelFlag  log_level_persistent_;
-	LogLock       the_lock_;
+	/*
+		Emitting threads hold a reference to the entry through which the
+		handler was published while they call it. Once the entry has been
+		replaced, the handler is in use only while that count exceeds one.
+	*/
+	struct HandlerEntry {
+		explicit HandlerEntry(LogHandlerPtr log_handler_ptr)
+			:log_handler_ptr_(log_handler_ptr)
+		{
+		}
+
+		LogHandlerPtr log_handler_ptr_;
+	};
+
+	using HandlerEntryPtr = LogSPtr<const HandlerEntry>;
+
+	std::atomic<HandlerEntryPtr>      handler_entry_ptr_;
+	LogFlag                           log_flags_;
+	//	Serializes changes to the handler and the flight recorder.
+	LogLock                           the_lock_;
+	//	Serializes changes to the level masks, which are read without it.
+	LogLock                           level_lock_;
+
+	std::atomic<LogLevelFlag>         log_level_screen_;
+	std::atomic<LogLevelFlag>         log_level_persistent_;
+
+	//	The union of the screen, persistent and flight recorder masks.
+	std::atomic<unsigned int>         log_level_enabled_;
+	std::atomic<unsigned int>         log_level_recorder_;
+	std::atomic<LogFlightRecorderPtr> flight_recorder_ptr_;
+
+	/*
+		Gets the screen and persistent masks which apply to a line: those of
+		the tag override if it's active, otherwise those of the log manager.
+		Returns true if the line is to be given to the handler.
+	*/
+	bool GetHandlerLevels(LogLevelFlag log_level_flag,
+		LogTagOverride tag_override, LogLevelFlag &level_screen,
+		LogLevelFlag &level_persistent) const {
+		if (tag_override & LogTagOverride_Active) {
+			level_screen     = LogTagGetScreen(tag_override);
+			level_persistent = LogTagGetPersistent(tag_override);
+		}
+		else {
+			level_screen     = log_level_screen_.load(std::memory_order_relaxed);
+			level_persistent =
+				log_level_persistent_.load(std::memory_order_relaxed);
+		}
+		return(((static_cast<unsigned int>(level_screen) |
+			static_cast<unsigned int>(level_persistent)) &
+			static_cast<unsigned int>(log_level_flag)) != 0);
+	}
+	LogFlightRecorderPtr GetFlightRecorder(LogLevelFlag log_level_flag)
+		const {
+		return((log_level_recorder_.load(std::memory_order_relaxed) &
+			static_cast<unsigned int>(log_level_flag)) ?
+			flight_recorder_ptr_.load(std::memory_order_acquire) :
+			LogFlightRecorderPtr());
+	}
+
+	HandlerEntryPtr GetHandlerEntryPtr() const {
+		return(handler_entry_ptr_.load(std::memory_order_acquire));
+	}
+
+	void UpdateLevelEnabled();
 
 	static LogLevelFlag GetLogLevelMask(LogLevel min_level, LogLevel max_level);
 
@@ -123,19 +249,37 @@ private:
 // ////////////////////////////////////////////////////////////////////////////
 
 // ////////////////////////////////////////////////////////////////////////////
+/**
+	Assembles the text written to a thread's log stream into lines.
+
+	Characters written one at a time go into a put area without a virtual
+	call. Blocks of text (the result of almost all stream insertions) are
+	appended directly to the line buffer by \c xsputn , which locates line
+	ends with \c memchr .
+
+	The put area is empty between lines, so the first character of each
+	line causes a call to \c overflow . That is where the line start time
+	is taken from \c LogClockNow() , once per line. It's used for the line
+	leader, so the leader reflects the time at which the line was started
+	rather than the time at which a handler got around to emitting it.
+*/
 class API_UTILITY ThreadStreamBuffer : public std::streambuf {
 public:
+	static const std::size_t PutAreaSize = 256;
+
 	ThreadStreamBuffer(LogManager &manager_ref, LogLevel log_level)
 		:std::streambuf()
-		,last_used_time_()
 		,manager_ref_(manager_ref)
 		,log_level_(log_level)
 		,line_start_time_()
+		,line_active_(false)
+		,tag_override_(LogTagOverride_None)
 		,line_buffer_()
 		,sep_buffer_()
 	 {
 		setp(0, 0);
       setg(0, 0, 0);
+		line_buffer_.reserve(PutAreaSize);
 	}
 
 	~ThreadStreamBuffer() {
@@ -146,18 +290,26 @@ public:
 		sync(force_line_flag);
 	}
 	void PutChar(int datum) {
-		put_char(datum);
+		sputc(static_cast<char>(datum));
 	}
 	void PutString(const std::string &datum) {
-		std::string::size_type string_length = datum.size();
-		std::string::size_type string_index  = 0;
-		while (string_index < string_length)
-         put_char(datum[string_index++]);
+		sputn(datum.data(), static_cast<std::streamsize>(datum.size()));
 	}
 	void PutLiteral(unsigned int literal_length, const char *literal_string) {
 		Synchronize();
 		manager_ref_.EmitLiteral(log_level_, literal_length, literal_string);
 	}
+	//	Discards any partial line without emitting it.
+	void Abandon() {
+		setp(0, 0);
+		line_buffer_.clear();
+		line_active_  = false;
+		tag_override_ = LogTagOverride_None;
+	}
+	//	The override applies to the current line only.
+	void SetTagOverride(LogTagOverride tag_override) {
+		tag_override_ = tag_override;
+	}
 
 	void LogSeparator(char sep_char = '*', unsigned int sep_length = 80)
 	{
@@ -175,49 +327,94 @@ public:
 	}
 
 protected:
-	std::streambuf::int_type overflow(int c) {
-      if (c != EOF)
-  			put_char(c);
-		return(0);
+	std::streambuf::int_type overflow(std::streambuf::int_type c) {
+		drain_put_area();
+		if (traits_type::eq_int_type(c, traits_type::eof()))
+			return(traits_type::not_eof(c));
+		if (traits_type::to_char_type(c) == '\n')
+			put_buffer(true);
+		else {
+			begin_line();
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return(c);
+	}
+
+	std::streamsize xsputn(const char *datum, std::streamsize datum_length) {
+		drain_put_area();
+		append_text(datum, static_cast<std::size_t>(datum_length));
+		return(datum_length);
 	}
 
 	int sync() {
 		return(sync(false));
 	}
 	int sync(bool force_line_flag) {
+		drain_put_area();
 		put_buffer(force_line_flag);
 		return(0);
 	}
 
 private:
+	LogManager     &manager_ref_;
+	LogLevel        log_level_;
+	TimeSpec        line_start_time_;
+	bool            line_active_;
+	LogTagOverride  tag_override_;
+	std::string     line_buffer_;
+	std::string     sep_buffer_;
+	char            put_area_[PutAreaSize];
+
+	void begin_line() {
+		if (!line_active_) {
+			line_start_time_ = LogClockNow();
+			line_active_     = true;
+			setp(put_area_, put_area_ + PutAreaSize);
+		}
+	}
 
-	TimeVal      last_used_time_;
-	LogManager  &manager_ref_;
-	LogLevel     log_level_;
-	TimeSpec     line_start_time_;
-	std::string  line_buffer_;
-	std::string  sep_buffer_;
-
-	void put_char(int chr) {
-		if (line_buffer_.empty())
-			line_start_time_ = TimeSpec();
-		if (chr == '\n')
+	//	Moves the contents of the put area to the line buffer.
+	void drain_put_area() {
+		if (pptr() != pbase()) {
+			std::size_t put_length = static_cast<std::size_t>(pptr() - pbase());
+			setp(put_area_, put_area_ + PutAreaSize);
+			append_text(put_area_, put_length);
+		}
+	}
+
+	void append_text(const char *text_ptr, std::size_t text_length) {
+		while (text_length) {
+			const char *eol_ptr = static_cast<const char *>(
+				::memchr(text_ptr, '\n', text_length));
+			std::size_t segment_length = (eol_ptr == NULL) ? text_length :
+				static_cast<std::size_t>(eol_ptr - text_ptr);
+			if (segment_length) {
+				begin_line();
+				line_buffer_.append(text_ptr, segment_length);
+			}
+			if (eol_ptr == NULL)
+				break;
 			put_buffer(true);
-		else {
-			line_buffer_    += static_cast<char>(chr);
-			last_used_time_  = TimeVal();
+			text_ptr    += segment_length + 1;
+			text_length -= segment_length + 1;
 		}
 	}
 
 	void put_buffer(bool force_flag) {
 		if (force_flag || (!line_buffer_.empty())) {
+			if (!line_active_)
+				line_start_time_ = LogClockNow();
 			if (log_level_ == LogLevel_Literal)
 				manager_ref_.EmitLiteral(log_level_, line_buffer_);
 			else
-				manager_ref_.EmitLine(line_start_time_, log_level_, line_buffer_);
+				manager_ref_.EmitLine(line_start_time_, log_level_, line_buffer_,
+					tag_override_);
 			line_buffer_.clear();
+			tag_override_ = LogTagOverride_None;
 		}
-		last_used_time_ = TimeVal();
+		line_active_ = false;
+		setp(0, 0);
 	}
 
 	ThreadStreamBuffer(const ThreadStreamBuffer &) = delete;
@@ -285,6 +482,9 @@ public:
 	ThreadStreamBufferPtr  GetBufferPtrRef() {
 		return(buffer_ptr_);
 	}
+	void SetTagOverride(LogTagOverride tag_override) {
+		buffer_ptr_->SetTagOverride(tag_override);
+	}
 
 	//	Not truly necessary to keep a local copy of of the manager reference and
 	//	the log level, but they were useful during debugging...
@@ -301,33 +501,40 @@ private:
 // ////////////////////////////////////////////////////////////////////////////
 class API_UTILITY LogStream : public std::ostream {
 public:
-	LogStream(LogManager &manager_ref, LogLevel log_level)
-		:std::ostream(new ThreadStreamBuffer(manager_ref, log_level))
-		,manager_ref_(manager_ref)
-		,log_level_(log_level)
-		,thread_stream_map_() {
-	}
+	LogStream(LogManager &manager_ref, LogLevel log_level);
 	~LogStream();
 
+	/*
+		Formatting is skipped for levels which are currently disabled. Note
+		that the arguments themselves have already been evaluated by the time
+		these operators are called; use the LogIf...() macros to avoid that.
+
+		Stream format flag manipulators (std::hex, std::fixed, et cetera) are
+		always applied so that their effect doesn't depend upon the level
+		settings at the time of the call.
+	*/
 	LogStream & operator << (std::ostream & (*pfn)(std::ostream &)) {
-		*GetThreadStream() << pfn;
+		if (IsEnabled())
+			GetThreadStream() << pfn;
 		return(*this);
 	}
 	LogStream & operator << (std::ios_base & (*pfn)(std::ios_base &)) {
-		*GetThreadStream() << pfn;
+		GetThreadStream() << pfn;
 		return(*this);
 	}
 	LogStream & operator << (std::ios & (*pfn)(std::ios &)) {
-		*GetThreadStream() << pfn;
+		GetThreadStream() << pfn;
 		return(*this);
 	}
 	template <typename DataType> LogStream & operator << (
 		const DataType &datum) {
-		*GetThreadStream() << datum;
+		if (IsEnabled())
+			GetThreadStream() << datum;
 		return(*this);
 	}
 	LogStream & operator << (const std::string &datum) {
-		*GetThreadStream() << datum.c_str();
+		if (IsEnabled())
+			GetThreadStream() << datum.c_str();
 		return(*this);
 	}
 /*
@@ -352,11 +559,79 @@ public:
 			static_cast<unsigned int>(strlen(literal_string)), literal_string);
 	}
 	void LogLiteral(unsigned int literal_length, const char *literal_string) {
-		GetThreadStream()->GetBufferPtrRef()->PutLiteral(literal_length,
+		GetThreadStream().GetBufferPtrRef()->PutLiteral(literal_length,
 			literal_string);
 	}
 	void LogSeparator(char sep_char = '*', unsigned int text_length = 80);
 
+	bool IsEnabled() const {
+		return(manager_ref_.IsLevelEnabled(log_level_));
+	}
+	bool IsEnabled(const LogTag &log_tag) const {
+		return(manager_ref_.IsLevelEnabled(log_level_, log_tag));
+	}
+	//	Used by LogIfTag: the line written is subject to the tag's override.
+	std::ostream &GetTaggedStream(const LogTag &log_tag) {
+		ThreadStream &thread_stream(GetThreadStream());
+		thread_stream.SetTagOverride(log_tag.GetOverride());
+		return(thread_stream);
+	}
+	LogLevel GetLogLevel() const {
+		return(log_level_);
+	}
+
+	/*
+		Emits a deferred-formatting record. The arguments are encoded in
+		binary form; formatting is left to the handler (or to an offline
+		decoder). Usually invoked through the LogDeferred() macro.
+	*/
+	template <typename... ArgTypes>
+		void EmitBinary(LogBinaryFormatId format_id, const ArgTypes &... args) {
+		if (IsEnabled()) {
+			std::string &arg_buffer(LogBinaryGetThreadBuffer());
+			arg_buffer.clear();
+			(LogBinaryEncode(arg_buffer, args), ...);
+			manager_ref_.EmitBinary(LogClockNow(), log_level_, format_id, arg_buffer);
+		}
+	}
+
+	/*
+		As EmitBinary(), but subject to the rate limit and the duplicate
+		suppression of the call site. Usually invoked through the
+		LogDeferredLimited() macro.
+	*/
+	template <typename... ArgTypes>
+		void EmitBinaryLimited(LogRateLimiter &rate_limiter,
+		LogBinaryFormatId format_id, const ArgTypes &... args) {
+		if (IsEnabled()) {
+			std::string &arg_buffer(LogBinaryGetThreadBuffer());
+			arg_buffer.clear();
+			(LogBinaryEncode(arg_buffer, args), ...);
+			if (rate_limiter.Admit(arg_buffer))
+				manager_ref_.EmitBinary(LogClockNow(), log_level_, format_id,
+					arg_buffer);
+		}
+	}
+
+	/*
+		Emits a structured event with the specified name and fields. For
+		example:
+
+			LogInfo.Event("order_ack", LogKV("id", order_id), LogKV("px", px));
+
+		The fields are encoded in binary form; formatting is left to the
+		handler. See LogEvent.hpp.
+	*/
+	template <typename... DatumTypes>
+		void Event(const char *event_name,
+		const LogField<DatumTypes> &... fields) {
+		if (IsEnabled()) {
+			std::string &field_buffer(LogBinaryGetThreadBuffer());
+			LogEventEncode(field_buffer, event_name, fields...);
+			manager_ref_.EmitEvent(LogClockNow(), log_level_, field_buffer);
+		}
+	}
+
 	void LogToLevel(LogLevel log_level, const std::string &log_text) {
 		ThreadStreamBufferPtr buffer_ptr(
 									new ThreadStreamBuffer(manager_ref_, log_level));
@@ -373,8 +648,15 @@ private:
 	LogLevel         log_level_;
 	ThreadStreamMap  thread_stream_map_;
 	LogLock          the_lock_;
+#ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
+	std::uint64_t    stream_serial_;
+	LogSPtr<int>     life_token_;
+
+	ThreadStream &GetThreadStreamLocal();
+#endif // #ifndef MLB_LOGGER_DO_NOT_USE_THREAD_LOCAL
 
-	ThreadStreamPtr GetThreadStream();
+	ThreadStream &GetThreadStream();
+	ThreadStream &GetThreadStreamMapped();
 
 	LogStream(const LogStream &) = delete;
 	LogStream & operator = (const LogStream &) = delete;
@@ -431,5 +713,153 @@ private:
 	extern import_spec MLB::Utility::LogStream  LogFatal;
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+	/**
+		Guarded log statements: no argument to the right of the macro is
+		evaluated unless the level is enabled. For example:
+
+			LogIfSpam << "State: " << expensive_to_format() << std::endl;
+
+		Statements at levels below MLB_LOGGER_MIN_LEVEL are discarded at
+		compile time. Otherwise the run-time test is a single relaxed atomic
+		load of the log manager's enabled level mask.
+
+		The expansion is a complete if/else chain so that the macros are safe
+		to use as the body of an unbraced \c if statement.
+	*/
+#define LogIfLevel(log_level, log_stream)										\
+	if (!MLB::Utility::LogLevelIsCompiled(log_level))							\
+		;																				\
+	else if (!(log_stream).IsEnabled())											\
+		;																				\
+	else																				\
+		(log_stream)
+
+#define LogIfLiteral    LogIfLevel(MLB::Utility::LogLevel_Literal,   LogLiteral)
+#define LogIfSpam       LogIfLevel(MLB::Utility::LogLevel_Spam,      LogSpam)
+#define LogIfMinutiae   LogIfLevel(MLB::Utility::LogLevel_Minutiae,  LogMinutiae)
+#define LogIfDebug      LogIfLevel(MLB::Utility::LogLevel_Debug,     LogDebug)
+#define LogIfDetail     LogIfLevel(MLB::Utility::LogLevel_Detail,    LogDetail)
+#define LogIfInfo       LogIfLevel(MLB::Utility::LogLevel_Info,      LogInfo)
+#define LogIfNotice     LogIfLevel(MLB::Utility::LogLevel_Notice,    LogNotice)
+#define LogIfWarning    LogIfLevel(MLB::Utility::LogLevel_Warning,   LogWarning)
+#define LogIfError      LogIfLevel(MLB::Utility::LogLevel_Error,     LogError)
+#define LogIfCritical   LogIfLevel(MLB::Utility::LogLevel_Critical,  LogCritical)
+#define LogIfAlert      LogIfLevel(MLB::Utility::LogLevel_Alert,     LogAlert)
+#define LogIfEmergency  LogIfLevel(MLB::Utility::LogLevel_Emergency, LogEmergency)
+#define LogIfFatal      LogIfLevel(MLB::Utility::LogLevel_Fatal,     LogFatal)
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+	/**
+		Tagged log statement. For example:
+
+			static MLB::Utility::LogTag MyTag("mfstore.writer");
+
+			LogIfTag(MyTag, MLB::Utility::LogLevel_Debug, LogDebug) <<
+				"Segment " << segment_id << std::endl;
+
+		The line is subject to the levels of the tag's override if it has one,
+		otherwise to those of the log manager. See LogTag. As with
+		LogIfLevel(), \e log_level must be a constant which matches the level
+		of \e log_stream .
+	*/
+#define LogIfTag(log_tag, log_level, log_stream)								\
+	if (!MLB::Utility::LogLevelIsCompiled(log_level))							\
+		;																				\
+	else if (!(log_stream).IsEnabled(log_tag))								\
+		;																				\
+	else																				\
+		(log_stream).GetTaggedStream(log_tag)
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+	/**
+		Deferred-formatting log statement. For example:
+
+			LogDeferred(MLB::Utility::LogLevel_Info, LogInfo,
+				"Order {} filled {} @ {}", order_id, qty, px);
+
+		The format string must be a string literal (or otherwise have static
+		storage duration). It is registered once per call site; thereafter
+		the statement encodes its arguments in binary form without any text
+		formatting. Handlers such as LogHandlerBinary persist the encoded
+		arguments as-is, others render the text at the time of emission.
+
+		As with LogIfLevel(), \e log_level must be a constant which matches
+		the level of \e log_stream so that statements at levels below
+		MLB_LOGGER_MIN_LEVEL are discarded at compile time.
+	*/
+#define LogDeferred(log_level, log_stream, format_string, ...)				\
+	do {																					\
+		if (MLB::Utility::LogLevelIsCompiled(log_level) &&						\
+			(log_stream).IsEnabled()) {												\
+			static const MLB::Utility::LogBinaryFormatId							\
+				LogDeferred_format_id = MLB::Utility::LogBinaryFormatRegister(	\
+					__FILE__, __LINE__, format_string);								\
+			(log_stream).EmitBinary(LogDeferred_format_id						\
+				__VA_OPT__(,) __VA_ARGS__);											\
+		}																					\
+	} while (false)
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+	/**
+		Rate-limited log statements for code which may log in a tight loop
+		(for example, a reconnect or a failing check). For example:
+
+			LogIfLimited(MLB::Utility::LogLevel_Warning, LogWarning, 5, 1.0) <<
+				"Reconnect failed: " << error_text << std::endl;
+
+			LogDeferredLimited(MLB::Utility::LogLevel_Error, LogError, 5, 1.0,
+				"Check {} failed: {}", check_name, error_code);
+
+		Each call site admits a burst of up to \e burst_count statements and
+		thereafter no more than \e per_second statements per second. The
+		state of the call site is a static LogRateLimiter, so a suppressed
+		statement costs a few relaxed atomic operations: its arguments are not
+		formatted and no lock is taken. Counts of suppressed statements are
+		logged periodically; see LogRateLimiter and LogRateLimitReport().
+
+		Only the deferred form collapses consecutive statements with identical
+		arguments into a single "last message repeated N times" line, as its
+		arguments are encoded before admission. The stream form decides
+		before its arguments are formatted, so it applies the rate limit
+		alone: identical lines within the limit are all emitted.
+
+		As with LogIfLevel(), \e log_level must be a constant which matches
+		the level of \e log_stream . The burst count and rate are fixed by
+		the first execution of the statement.
+	*/
+#define LogIfLimited(log_level, log_stream, burst_count, per_second)		\
+	if (!MLB::Utility::LogLevelIsCompiled(log_level))							\
+		;																				\
+	else if (!(log_stream).IsEnabled())											\
+		;																				\
+	else if (![&]() -> MLB::Utility::LogRateLimiter & {						\
+			static MLB::Utility::LogRateLimiter LogIfLimited_limiter(			\
+				(log_stream), __FILE__, __LINE__, (burst_count), (per_second));\
+			return(LogIfLimited_limiter);												\
+		}().Admit())																	\
+		;																				\
+	else																				\
+		(log_stream)
+
+#define LogDeferredLimited(log_level, log_stream, burst_count, per_second,	\
+	format_string, ...)																\
+	do {																					\
+		if (MLB::Utility::LogLevelIsCompiled(log_level) &&						\
+			(log_stream).IsEnabled()) {												\
+			static const MLB::Utility::LogBinaryFormatId							\
+				LogDeferred_format_id = MLB::Utility::LogBinaryFormatRegister(	\
+					__FILE__, __LINE__, format_string);								\
+			static MLB::Utility::LogRateLimiter LogDeferred_limiter(			\
+				(log_stream), __FILE__, __LINE__, (burst_count), (per_second));\
+			(log_stream).EmitBinaryLimited(LogDeferred_limiter,				\
+				LogDeferred_format_id __VA_OPT__(,) __VA_ARGS__);				\
+		}																					\
+	} while (false)
+// ////////////////////////////////////////////////////////////////////////////
+
 #endif // #ifndef HH__MLB__Utility__LogManager_hpp__HH
 
@@ -0,0 +1,214 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogRateLimit.hpp
+
+   File Description  :  Include file for per-call-site rate limiting and
+                        duplicate suppression of log statements.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogRateLimit_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogRateLimit_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogLevel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+class LogStream;
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	The state of a rate-limited log statement. One instance exists per call
+	site, in static storage created by the LogIfLimited() or
+	LogDeferredLimited() macros.
+
+	Admission is governed by a token bucket which holds up to \e burst_count
+	tokens and is refilled at \e per_second tokens per second. The bucket is
+	kept as a single theoretical arrival time (the generic cell rate
+	algorithm), so admitting a statement costs one compare-and-swap and
+	rejecting it a load and an increment. No lock is taken on either path.
+
+	Call sites which supply their encoded arguments (see
+	LogDeferredLimited()) also suppress consecutive duplicates. When a
+	different message arrives, "last message repeated N times" is logged
+	ahead of it. LogIfLimited() call sites are admitted before their text is
+	formatted, so they are subject to the rate limit only.
+
+	Suppressed counts are logged to the call site's stream at most once per
+	report interval while a storm continues, at the next admitted statement
+	after it ends, or whenever LogRateLimitReport() is called.
+*/
+class API_UTILITY LogRateLimiter {
+public:
+	LogRateLimiter(LogStream &log_stream, const char *file_name,
+		int line_number, unsigned int burst_count, double per_second,
+		double report_seconds = 10.0);
+
+	/**
+		Returns \c true if the statement is to be emitted.
+	*/
+	bool Admit() {
+		std::int64_t now_ns = GetNowNanoseconds();
+
+		if (!TakeToken(now_ns))
+			return(false);
+
+		ReportIfPending(now_ns, false);
+
+		return(true);
+	}
+
+	/**
+		As Admit(), but also suppresses a statement with the same encoded
+		arguments as the most recent one from this call site.
+	*/
+	bool Admit(std::string_view arg_data) {
+		std::int64_t  now_ns    = GetNowNanoseconds();
+		std::uint64_t arg_hash  = HashArgs(arg_data);
+
+		if (last_hash_.load(std::memory_order_relaxed) == arg_hash) {
+			repeat_count_.fetch_add(1, std::memory_order_relaxed);
+			ReportIfDue(now_ns);
+			return(false);
+		}
+
+		last_hash_.store(arg_hash, std::memory_order_relaxed);
+
+		bool repeat_flag = repeat_count_.load(std::memory_order_relaxed) != 0;
+
+		if (!TakeToken(now_ns))
+			return(false);
+
+		ReportIfPending(now_ns, repeat_flag);
+
+		return(true);
+	}
+
+	/**
+		Logs the suppressed counts, if any. Unless \e force_flag is \c true,
+		nothing is logged until the report interval has elapsed since the last
+		report. Returns \c true if anything was logged.
+	*/
+	bool ReportIfPending(std::int64_t now_ns, bool force_flag);
+
+	std::uint64_t GetLimitedCount() const {
+		return(limited_count_.load(std::memory_order_relaxed));
+	}
+	std::uint64_t GetRepeatCount() const {
+		return(repeat_count_.load(std::memory_order_relaxed));
+	}
+	const char *GetFileName() const {
+		return(file_name_);
+	}
+	int GetLineNumber() const {
+		return(line_number_);
+	}
+
+	static std::int64_t GetNowNanoseconds() {
+		return(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	/**
+		Returns the first call site in the list of all rate-limited call sites
+		in the process. Use GetNext() to traverse the list.
+	*/
+	static LogRateLimiter *GetFirst();
+
+	LogRateLimiter *GetNext() const {
+		return(next_ptr_);
+	}
+
+private:
+	LogStream                  &log_stream_;
+	const char                 *file_name_;
+	int                         line_number_;
+	std::int64_t                interval_ns_;
+	std::int64_t                tolerance_ns_;
+	std::int64_t                report_ns_;
+	std::atomic<std::int64_t>   arrival_ns_;
+	std::atomic<std::int64_t>   next_report_ns_;
+	std::atomic<std::uint64_t>  last_hash_;
+	std::atomic<std::uint64_t>  limited_count_;
+	std::atomic<std::uint64_t>  repeat_count_;
+	LogRateLimiter             *next_ptr_;
+
+	bool TakeToken(std::int64_t now_ns) {
+		std::int64_t arrival_ns = arrival_ns_.load(std::memory_order_relaxed);
+
+		for ( ; ; ) {
+			if (now_ns < (arrival_ns - tolerance_ns_)) {
+				limited_count_.fetch_add(1, std::memory_order_relaxed);
+				ReportIfDue(now_ns);
+				return(false);
+			}
+			if (arrival_ns_.compare_exchange_weak(arrival_ns,
+				std::max(arrival_ns, now_ns) + interval_ns_,
+				std::memory_order_relaxed))
+				return(true);
+		}
+	}
+
+	void ReportIfDue(std::int64_t now_ns) {
+		if (now_ns >= next_report_ns_.load(std::memory_order_relaxed))
+			ReportIfPending(now_ns, false);
+	}
+
+	static std::uint64_t HashArgs(std::string_view arg_data) {
+		std::uint64_t hash_value = 14695981039346656037ULL;
+
+		for (unsigned char this_char : arg_data)
+			hash_value = (hash_value ^ this_char) * 1099511628211ULL;
+
+		return(hash_value);
+	}
+
+	LogRateLimiter(const LogRateLimiter &) = delete;
+	LogRateLimiter & operator = (const LogRateLimiter &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Logs the suppressed counts of every rate-limited call site which has
+	any. Intended to be called periodically (for example, from a housekeeping
+	timer) so that the counts from a storm which has ended are not held until
+	the call site is next admitted. Returns the number of call sites reported.
+*/
+API_UTILITY std::size_t LogRateLimitReport(bool force_flag = true);
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogRateLimit_hpp__HH
+
@@ -0,0 +1,122 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB Utility Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  LogTag.hpp
+
+   File Description  :  Include file for log tags, which permit the log levels
+                        of a module to be overridden at run-time.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__Utility__Utility__LogTag_hpp__HH
+
+#define HH__MLB__Utility__Utility__LogTag_hpp__HH  1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <Logger/LogLevel.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace Utility {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	The level masks of a tag override. The console mask is in the low 16
+	bits and the file mask in the next 15; the high bit is set if the
+	override is in effect.
+*/
+typedef std::uint32_t LogTagOverride;
+
+const LogTagOverride LogTagOverride_None   = 0;
+const LogTagOverride LogTagOverride_Active = 0x80000000U;
+
+inline LogTagOverride LogTagMakeOverride(LogLevelFlag level_screen,
+	LogLevelFlag level_persistent)
+{
+	return(LogTagOverride_Active |
+		(static_cast<std::uint32_t>(level_screen) & LogFlag_Mask) |
+		((static_cast<std::uint32_t>(level_persistent) & LogFlag_Mask) << 16));
+}
+
+inline LogLevelFlag LogTagGetScreen(LogTagOverride tag_override)
+{
+	return(static_cast<LogLevelFlag>(tag_override & LogFlag_Mask));
+}
+
+inline LogLevelFlag LogTagGetPersistent(LogTagOverride tag_override)
+{
+	return(static_cast<LogLevelFlag>((tag_override >> 16) & LogFlag_Mask));
+}
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Names a module (or any other group of log statements) so that its log
+	levels may be changed independently of those of the log manager, for
+	example by LogLevelControl. Instances are intended to have static storage
+	duration:
+
+		static MLB::Utility::LogTag MyTag("mfstore.writer");
+
+		LogIfTag(MyTag, MLB::Utility::LogLevel_Debug, LogDebug) <<
+			"Segment " << segment_id << std::endl;
+
+	While a tag has no override, its statements are subject to the levels of
+	the log manager. An override replaces the console and file levels of the
+	log manager for the tagged statements, making them more or less verbose.
+
+	Overrides may be set by name before the tag has been constructed; they
+	take effect when it is. Testing a tag is one relaxed atomic load.
+*/
+class API_UTILITY LogTag {
+public:
+	explicit LogTag(const char *tag_name);
+	~LogTag();
+
+	const char *GetName() const {
+		return(tag_name_);
+	}
+
+	LogTagOverride GetOverride() const {
+		return(override_.load(std::memory_order_relaxed));
+	}
+
+	static void SetOverride(const char *tag_name, LogTagOverride tag_override);
+	static void ClearOverride(const char *tag_name);
+	static void ClearOverrideAll();
+
+private:
+	const char                  *tag_name_;
+	std::atomic<LogTagOverride>  override_;
+
+	LogTag(const LogTag &) = delete;
+	LogTag & operator = (const LogTag &) = delete;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace Utility
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__Utility__Utility__LogTag_hpp__HH
+
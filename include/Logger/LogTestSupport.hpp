@@ -38,7 +38,9 @@
 // Required include files...
 // ////////////////////////////////////////////////////////////////////////////
 
-#include <Logger/LogHandler.hpp>
+#include <Logger/LogHandlerCapture.hpp>
+
+#include <vector>
 
 // ////////////////////////////////////////////////////////////////////////////
 
@@ -63,6 +65,13 @@ API_UTILITY void TEST_TestControl(LogHandlerPtr my_log_handler,
 	std::size_t stress_count_2 = 0, std::size_t stress_length_2 = 2000000);
 // ////////////////////////////////////////////////////////////////////////////
 
+// ////////////////////////////////////////////////////////////////////////////
+API_UTILITY void TEST_ExpectCount(const char *test_name, std::size_t actual,
+	std::size_t expected);
+API_UTILITY std::vector<std::string> TEST_GetCapturedMessages(
+	const LogHandlerCapture &capture_handler);
+// ////////////////////////////////////////////////////////////////////////////
+
 } // namespace Utility
 
 } // namespace MLB
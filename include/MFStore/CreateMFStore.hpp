@@ -50,6 +50,19 @@ MFStoreControl CreateMFStore(const std::string &file_name,
 	MFStoreLen storage_gran = MFStoreAllocGran);
 MFStoreControl CreateMFStoreAdjusted(const std::string &file_name,
 	MFStoreLen &file_size, MFStoreLen &mmap_size, MFStoreLen &storage_gran);
+
+/**
+	Creates a file with an \c MFStoreHeader and section table followed by the
+	sections in \e section_list , whose offsets and lengths are calculated.
+	The file size is the size required by the sections. If \e mmap_size is
+	less than the file size the file size is used.
+
+	The file can subsequently be opened with the \c MFStoreControl
+	constructor which takes only the file name.
+*/
+MFStoreControl CreateMFStore(const std::string &file_name,
+	const MFStoreSectionList &section_list, MFStoreLen mmap_size = 0,
+	MFStoreLen storage_gran = MFStoreAllocGran);
 // ////////////////////////////////////////////////////////////////////////////
 
 } // namespace MFStore
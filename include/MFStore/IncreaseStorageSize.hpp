@@ -0,0 +1,80 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  IncreaseStorageSize.hpp
+
+   File Description  :  Include file for the IncreaseStorageSize() function.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__MFStore__IncreaseStorageSize_hpp__HH
+
+#define HH__MLB__MFStore__IncreaseStorageSize_hpp__HH 1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+/**
+   \file IncreaseStorageSize.hpp
+
+   \brief   Declaration of the IncreaseStorageSize() function.
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/MFStoreControl.hpp>
+
+#include <atomic>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Increases the size of the file of a writer to \e desired_file_size , which
+	may not exceed the mmap size of \e mfstore_ctl .
+
+	The \e file_size and \e file_size_pending values are those stored in the
+	file. The pending file size is set to the desired size before the backing
+	store is allocated and the file size is published (with release semantics)
+	only once the allocation has succeeded, so that a writer which fails part
+	way through can be recovered with \c FixUpFileSizePending() .
+
+	Readers in other processes pick up the new size with
+	\c MFStoreControl::RefreshFileSize() ; because each maps the whole of its
+	mmap size, their existing pointers remain valid.
+
+	Returns the new file size.
+*/
+MFStoreLen IncreaseStorageSize(MFStoreControl &mfstore_ctl,
+	std::atomic<MFStoreLen> &file_size, MFStoreLen &file_size_pending,
+	MFStoreLen desired_file_size, MFStoreLen storage_gran);
+
+//	Uses the file size members of the header of a file created with one.
+MFStoreLen IncreaseStorageSize(MFStoreControl &mfstore_ctl,
+	MFStoreLen desired_file_size);
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__MFStore__IncreaseStorageSize_hpp__HH
+
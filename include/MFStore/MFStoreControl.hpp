@@ -9,6 +9,13 @@
 
    Revision History  :  2021-02-14 --- Creation.
                            Michael L. Brock
+                        2026-10-16 --- Online file growth.
+                           Michael L. Brock
+                        2026-10-16 --- Files opened from a persisted header
+                                       and section table.
+                           Michael L. Brock
+                        2026-10-16 --- Section lookup by index or description.
+                           Michael L. Brock
 
       Copyright Michael L. Brock 2021 - 2024.
       Distributed under the Boost Software License, Version 1.0.
@@ -36,7 +43,7 @@
 // Required include files...
 // ////////////////////////////////////////////////////////////////////////////
 
-#include <MFStore/MFStoreSection.hpp>
+#include <MFStore/MFStoreHeader.hpp>
 
 #ifdef _Windows
 # pragma warning(push)
@@ -59,6 +66,7 @@
 # pragma warning(pop)
 #endif // #ifdef _Windows
 
+#include <atomic>
 #include <memory>
 
 // ////////////////////////////////////////////////////////////////////////////
@@ -86,6 +94,17 @@ public:
 	MFStoreControl(const std::string &file_name, bool is_writer,
 		MFStoreLen file_size, MFStoreLen mmap_size, MFStoreLen alloc_gran,
 		const MFStoreSectionList &section_list = MFStoreSectionList());
+	/**
+		Opens an existing file created with a section list (see
+		\c CreateMFStore() ), taking the allocation granularity, file size and
+		section list from its header. If \e mmap_size is zero the mmap size
+		stored in the header is used.
+
+		A writer completes any interrupted increase of the file size (see
+		\c FixUpFileSizePending() ).
+	*/
+	MFStoreControl(const std::string &file_name, bool is_writer,
+		MFStoreLen mmap_size = 0);
 
 	template <typename DatumType>
 		DatumType *GetPtr(MFStoreOff datum_offset)
@@ -115,6 +134,23 @@ public:
 	MappedRegionSPtr          GetRegionSPtr() const;
 	const MFStoreSectionList &GetSectionList() const;
 	void                      SetSectionList(const MFStoreSectionList &src);
+	const MFStoreSection     &GetSection(std::size_t section_index) const;
+	const MFStoreSection     &GetSection(const std::string &description) const;
+
+	/*
+		The whole of the mmap size is mapped when the instance is constructed,
+		even if the file is smaller, so that the file can grow up to the mmap
+		size without remapping and pointers into the mapping remain valid.
+		Pages beyond the end of the file must not be touched until the file
+		size has been increased to include them.
+	*/
+	void                      SetFileSize(MFStoreLen file_size);
+	MFStoreLen                RefreshFileSize(
+		const std::atomic<MFStoreLen> &file_size);
+	MFStoreLen                RefreshFileSize();
+
+	//	Throws if the file wasn't created with a header.
+	MFStoreHeader            *GetHeaderPtr() const;
 
 	void CheckSectionList() const;
 	void CheckSectionList(const MFStoreSectionList &section_list) const;
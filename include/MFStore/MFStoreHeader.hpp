@@ -0,0 +1,103 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  MFStoreHeader.hpp
+
+   File Description  :  Include file for the persistent MFStore file header.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__MFStore__MFStoreHeader_hpp__HH
+
+#define HH__MLB__MFStore__MFStoreHeader_hpp__HH 1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+/**
+   \file MFStoreHeader.hpp
+
+   \brief   Definition of the persistent MFStore file header.
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/MFStoreSection.hpp>
+
+#include <atomic>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	The header at offset zero of an MFStore file created with a section list.
+
+	The header occupies the first section (\c HeaderSectionIndex ) and the
+	section table the second (\c SectionListSectionIndex ), followed by the
+	sections of the application. The checksum covers the members which
+	precede it and the section table; the file size members which follow it
+	are updated in place as the file grows (see \c IncreaseStorageSize() ).
+
+	The magic number is stored last when the file is created so that a
+	reader doesn't see a partially initialised header.
+*/
+struct MFStoreHeader {
+	static const uint64_t Magic                   = 0x65726F7453464D4DULL;
+	static const uint32_t VersionCurrent          = 1;
+	static const uint64_t HeaderSectionIndex      = 0;
+	static const uint64_t SectionListSectionIndex = 1;
+	static const uint64_t FirstUserSectionIndex   = 2;
+
+	void Initialize(MFStoreLen alloc_gran, MFStoreLen mmap_size,
+		const MFStoreSectionList &section_list);
+
+	void     CheckHeader(MFStoreLen actual_file_size) const;
+	void     CheckChecksum(const MFStoreSection *section_ptr) const;
+	void     SetChecksum(const MFStoreSection *section_ptr);
+	uint64_t CalcChecksum(const MFStoreSection *section_ptr) const;
+
+	uint64_t                magic_;
+	uint32_t                version_;
+	uint32_t                header_size_;
+	uint64_t                section_size_;
+	uint64_t                alloc_gran_;
+	uint64_t                mmap_size_;
+	uint64_t                section_count_;
+	uint64_t                section_list_offset_;
+	uint64_t                reserved_[8];
+	uint64_t                checksum_;
+	std::atomic<MFStoreLen> file_size_;
+	MFStoreLen              file_size_pending_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+static_assert(std::atomic<MFStoreLen>::is_always_lock_free,
+	"The file size must be updated in place without a lock as it is shared "
+	"between processes.");
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__MFStore__MFStoreHeader_hpp__HH
+
@@ -0,0 +1,219 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  MFStoreJournal.hpp
+
+   File Description  :  Include file for the MFStoreJournal class.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__MFStore__MFStoreJournal_hpp__HH
+
+#define HH__MLB__MFStore__MFStoreJournal_hpp__HH 1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+/**
+   \file MFStoreJournal.hpp
+
+   \brief   Include file for the MFStoreJournal class.
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/MFStoreControl.hpp>
+
+#include <limits>
+#include <span>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	The control block at the start of a journal section. The records follow
+	it.
+
+	The committed tail is the offset (from the end of the control block) of
+	the end of the last committed record. The commit sequence is odd while
+	the record count and the committed tail are being stored, and is
+	advanced to the next even value after each commit; it is the word upon
+	which readers wait. Readers don't write to the control block, as they
+	map the file read-only.
+*/
+struct MFStoreJournalControl {
+	std::atomic<uint64_t> committed_tail_;
+	std::atomic<uint64_t> record_count_;
+	std::atomic<uint32_t> commit_sequence_;
+	uint32_t              reserved_1_;
+	uint64_t              reserved_2_[5];
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+//	Precedes each record; the record data is padded to a multiple of 8 bytes.
+struct MFStoreJournalRecordHeader {
+	uint32_t record_length_;
+	uint32_t record_type_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	A view of a committed record. The data refers to the mapping and remains
+	valid while the journal is bound.
+*/
+struct MFStoreJournalRecord {
+	uint64_t               record_offset_;
+	uint32_t               record_type_;
+	std::span<const char>  record_data_;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	An append-only log of variable-length records in a section which has the
+	\c MFStoreSection::SectionFlag_Journal flag set (see \c MakeSection() ).
+
+	The single writer appends records with \c Append() . A record becomes
+	visible to readers, in any process, when the committed tail is stored
+	(with release semantics) by \c Append() or \c Commit() . Readers keep
+	their own read offset, starting at zero, and consume records with
+	\c GetNextRecord() or \c Poll() . \c Wait() blocks on a futex in the
+	control block until a record is committed. Because readers can't
+	register themselves in the read-only mapping, each commit makes a
+	futex wake system call; commit batches of records where the rate is
+	high.
+
+	If the section is the last in the file, the writer grows the file (see
+	\c IncreaseStorageSize() ) when the journal is full, up to the mmap size
+	of its \c MFStoreControl . Otherwise, and beyond that, \c Append()
+	throws. A reader must have an mmap size which covers the records it
+	reads. The growth is recorded only in the file size; the length of the
+	journal in the section table isn't authoritative for a journal which is
+	the last section, which extends to the end of the file.
+
+	The \c MFStoreControl instance must outlive the journal. Records which
+	were appended but not committed when the writer stopped are discarded
+	when the journal is next bound by a writer.
+*/
+class MFStoreJournal
+{
+public:
+	static const std::size_t RecordAlign = sizeof(uint64_t);
+	static const std::size_t MaxRecordLength =
+		std::numeric_limits<uint32_t>::max();
+
+	MFStoreJournal();
+	MFStoreJournal(MFStoreControl &mfstore_ctl, const MFStoreSection &section);
+	MFStoreJournal(MFStoreControl &mfstore_ctl, std::size_t section_index);
+	MFStoreJournal(MFStoreControl &mfstore_ctl, const std::string &description);
+
+	/**
+		Returns a section, with room for \e capacity bytes of records,
+		suitable for inclusion in the list passed to \c CreateMFStore() .
+	*/
+	static MFStoreSection MakeSection(uint64_t capacity,
+		const std::string &description);
+
+	/**
+		Appends a record and returns its offset. If \e commit_flag is
+		\c false the record isn't visible to readers until \c Commit() is
+		called, so that a batch of records can be committed at once.
+	*/
+	uint64_t Append(const void *data_ptr, std::size_t data_length,
+		uint32_t record_type = 0, bool commit_flag = true);
+	void     Commit();
+
+	/**
+		If a record has been committed at \e read_offset , places it in
+		\e record , advances \e read_offset to the next record and returns
+		\c true . Throws if the length in the record header would take the
+		record beyond the committed tail.
+	*/
+	bool     GetNextRecord(uint64_t &read_offset,
+		MFStoreJournalRecord &record) const;
+
+	/**
+		Passes the committed records from \e read_offset onwards to the
+		function, advancing \e read_offset , and returns the number passed.
+	*/
+	template <typename RecordFunc>
+		std::size_t Poll(uint64_t &read_offset, RecordFunc &&record_func,
+			std::size_t max_records = std::numeric_limits<std::size_t>::max())
+			const
+	{
+		MFStoreJournalRecord record;
+		std::size_t          record_count = 0;
+
+		while ((record_count < max_records) &&
+			GetNextRecord(read_offset, record)) {
+			record_func(record);
+			++record_count;
+		}
+
+		return(record_count);
+	}
+
+	/**
+		Waits until a record has been committed at \e read_offset . Returns
+		\c false on a time-out. A negative \e timeout_ms waits indefinitely.
+	*/
+	bool     Wait(uint64_t read_offset, int timeout_ms = -1) const;
+
+	uint64_t GetCommittedTail() const;
+	uint64_t GetRecordCount() const;
+
+	/**
+		Returns the number of committed records together with the committed
+		tail at which they end.
+	*/
+	uint64_t GetRecordCount(uint64_t &committed_tail) const;
+
+	uint64_t GetCapacity() const;
+	bool     IsBound() const;
+
+private:
+	static const unsigned int SpinCount = 64;
+
+	MFStoreControl        *mfstore_ctl_ptr_;
+	MFStoreJournalControl *control_ptr_;
+	char                  *data_ptr_;
+	uint64_t               data_offset_;
+	uint64_t               capacity_;
+	uint64_t               map_limit_;
+	uint64_t               pending_tail_;
+	uint64_t               pending_count_;
+	bool                   is_writer_flag_;
+	bool                   can_grow_flag_;
+
+	void Grow(uint64_t required_tail);
+	void RecoverCommit();
+	void CheckIsBound() const;
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__MFStore__MFStoreJournal_hpp__HH
+
@@ -9,6 +9,8 @@
 
    Revision History  :  2021-02-14 --- Creation.
                            Michael L. Brock
+                        2026-10-16 --- Seqlock and journal section flags.
+                           Michael L. Brock
 
       Copyright Michael L. Brock 2021 - 2024.
       Distributed under the Boost Software License, Version 1.0.
@@ -57,6 +59,15 @@ public:
 	static const uint64_t MaxElementValue      = 1000000000ULL;
 	static const uint64_t MaxDescriptionLength = 63ULL;
 
+	/**
+		Values for \c section_flags_ . A seqlock section contains
+		\c MFStoreSeqLockRecord elements (see \c MFStoreSeqLockView ). A
+		journal section contains an append-only log of variable-length
+		records (see \c MFStoreJournal ).
+	*/
+	static const uint64_t SectionFlag_SeqLock  = 0x0001ULL;
+	static const uint64_t SectionFlag_Journal  = 0x0002ULL;
+
 	MFStoreSection();
 
 	MFStoreSection(
@@ -76,6 +87,7 @@ public:
 
 	void CheckElementInfo() const;
 	void CheckElementInfo(uint64_t section_idx) const;
+	void CheckSectionFlags(uint64_t required_flags) const;
 
 	uint64_t section_index_;
 	uint64_t element_size_;
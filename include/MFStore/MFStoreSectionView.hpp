@@ -0,0 +1,189 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  MFStoreSectionView.hpp
+
+   File Description  :  Include file for the MFStoreSectionView class.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__MFStore__MFStoreSectionView_hpp__HH
+
+#define HH__MLB__MFStore__MFStoreSectionView_hpp__HH 1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+/**
+   \file MFStoreSectionView.hpp
+
+   \brief   Include file for the MFStoreSectionView class.
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/MFStoreControl.hpp>
+
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Checks that the elements of \e section can be accessed as objects of the
+	specified size and alignment, that the section lies within the file and,
+	if \e is_mutable is \c true , that the file is open for writing.
+*/
+void CheckSectionViewBind(const MFStoreControl &mfstore_ctl,
+	const MFStoreSection &section, std::size_t element_size,
+	std::size_t element_align, bool is_mutable);
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Provides typed access to the elements of a section.
+
+	The section is checked once, when the view is bound; thereafter access to
+	an element is a pointer offset. Use a \c const \e DatumType to bind to
+	the sections of a file opened for reading.
+
+	The view shares ownership of the mapped region, so it remains valid if
+	the \c MFStoreControl instance from which it was bound is destroyed.
+	The member names of the container interface follow the standard library
+	so that views can be used with range-based \c for and the algorithms.
+*/
+template <typename DatumType>
+	class MFStoreSectionView
+{
+	using ValueType = std::remove_const_t<DatumType>;
+
+	static_assert(std::is_trivially_copyable_v<ValueType>,
+		"The elements of an MFStore section must be trivially copyable.");
+
+public:
+	using value_type     = DatumType;
+	using iterator       = DatumType *;
+	using const_iterator = const DatumType *;
+
+	MFStoreSectionView()
+		:region_sptr_()
+		,data_ptr_(nullptr)
+		,element_count_(0)
+	{
+	}
+
+	MFStoreSectionView(const MFStoreControl &mfstore_ctl,
+		const MFStoreSection &section)
+		:region_sptr_(mfstore_ctl.GetRegionSPtr())
+		,data_ptr_(Bind(mfstore_ctl, section))
+		,element_count_(static_cast<std::size_t>(section.element_count_))
+	{
+	}
+
+	MFStoreSectionView(const MFStoreControl &mfstore_ctl,
+		std::size_t section_index)
+		:MFStoreSectionView(mfstore_ctl, mfstore_ctl.GetSection(section_index))
+	{
+	}
+
+	MFStoreSectionView(const MFStoreControl &mfstore_ctl,
+		const std::string &description)
+		:MFStoreSectionView(mfstore_ctl, mfstore_ctl.GetSection(description))
+	{
+	}
+
+	DatumType &operator [] (std::size_t element_index) const
+	{
+		return(data_ptr_[element_index]);
+	}
+
+	DatumType &at(std::size_t element_index) const
+	{
+		if (element_index >= element_count_)
+			throw std::out_of_range("The element index (" +
+				std::to_string(element_index) + ") is not less than the number "
+				"of elements in the section (" + std::to_string(element_count_) +
+				").");
+
+		return(data_ptr_[element_index]);
+	}
+
+	DatumType   *data() const
+	{
+		return(data_ptr_);
+	}
+
+	std::size_t  size() const
+	{
+		return(element_count_);
+	}
+
+	bool         empty() const
+	{
+		return(!element_count_);
+	}
+
+	iterator     begin() const
+	{
+		return(data_ptr_);
+	}
+
+	iterator     end() const
+	{
+		return(data_ptr_ + element_count_);
+	}
+
+	std::span<DatumType> GetSpan() const
+	{
+		return(std::span<DatumType>(data_ptr_, element_count_));
+	}
+
+	bool         IsBound() const
+	{
+		return(data_ptr_ != nullptr);
+	}
+
+private:
+	MappedRegionSPtr  region_sptr_;
+	DatumType        *data_ptr_;
+	std::size_t       element_count_;
+
+	static DatumType *Bind(const MFStoreControl &mfstore_ctl,
+		const MFStoreSection &section)
+	{
+		CheckSectionViewBind(mfstore_ctl, section, sizeof(ValueType),
+			alignof(ValueType), !std::is_const_v<DatumType>);
+
+		return(reinterpret_cast<DatumType *>(
+			static_cast<char *>(mfstore_ctl.GetMmapAddress()) +
+			section.section_offset_));
+	}
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__MFStore__MFStoreSectionView_hpp__HH
+
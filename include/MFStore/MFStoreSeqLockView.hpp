@@ -0,0 +1,274 @@
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// MLB MFStore Library Include File
+// ////////////////////////////////////////////////////////////////////////////
+/*
+   File Name         :  MFStoreSeqLockView.hpp
+
+   File Description  :  Include file for the MFStoreSeqLockView class.
+
+   Revision History  :  2026-10-16 --- Creation.
+                           Michael L. Brock
+
+      Copyright Michael L. Brock 2026.
+      Distributed under the Boost Software License, Version 1.0.
+      (See accompanying file LICENSE_1_0.txt or copy at
+      http://www.boost.org/LICENSE_1_0.txt)
+
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+#ifndef HH__MLB__MFStore__MFStoreSeqLockView_hpp__HH
+
+#define HH__MLB__MFStore__MFStoreSeqLockView_hpp__HH 1
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+/**
+   \file MFStoreSeqLockView.hpp
+
+   \brief   Include file for the MFStoreSeqLockView class.
+*/
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+// ////////////////////////////////////////////////////////////////////////////
+// Required include files...
+// ////////////////////////////////////////////////////////////////////////////
+
+#include <MFStore/MFStoreSectionView.hpp>
+
+#include <bit>
+#include <cstring>
+#include <thread>
+
+// ////////////////////////////////////////////////////////////////////////////
+
+namespace MLB {
+
+namespace MFStore {
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	An element of a seqlock section. The datum is held as words which are
+	loaded and stored atomically (with relaxed ordering, so that they compile
+	to ordinary moves) so that a reader which races with the writer copies
+	an inconsistent datum, which it then discards, rather than having a data
+	race.
+
+	The sequence number is odd while the writer is updating the datum.
+*/
+template <typename DatumType>
+	struct MFStoreSeqLockRecord
+{
+	static constexpr std::size_t WordCount =
+		(sizeof(DatumType) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+	std::atomic<uint64_t> sequence_;
+	std::atomic<uint64_t> datum_words_[WordCount];
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Checks that \e section can be bound to an \c MFStoreSeqLockView whose
+	records are of the specified size. See \c CheckSectionViewBind() .
+*/
+void CheckSeqLockViewBind(const MFStoreControl &mfstore_ctl,
+	const MFStoreSection &section, std::size_t record_size,
+	std::size_t record_align, bool is_mutable);
+// ////////////////////////////////////////////////////////////////////////////
+
+// ////////////////////////////////////////////////////////////////////////////
+/**
+	Provides access to the elements of a section which has the
+	\c MFStoreSection::SectionFlag_SeqLock flag set (see \c MakeSection() ).
+
+	The single writer (see \c GetWriterAdvisoryLock() ) updates an element
+	with \c Write() . Readers, in any number of processes, obtain a
+	consistent copy of an element with \c Read() or \c TryRead() without
+	locks or system calls. Use a \c const \e DatumType to bind to the
+	sections of a file opened for reading.
+
+	If the writer dies part way through a \c Write() the record remains
+	odd, and \c Read() will wait, until the record is written again.
+*/
+template <typename DatumType>
+	class MFStoreSeqLockView
+{
+	using ValueType = std::remove_const_t<DatumType>;
+
+	static_assert(std::is_trivially_copyable_v<ValueType>,
+		"The elements of an MFStore section must be trivially copyable.");
+
+public:
+	using RecordType = std::conditional_t<std::is_const_v<DatumType>,
+		const MFStoreSeqLockRecord<ValueType>, MFStoreSeqLockRecord<ValueType>>;
+
+	static constexpr std::size_t WordCount =
+		MFStoreSeqLockRecord<ValueType>::WordCount;
+
+	MFStoreSeqLockView()
+		:region_sptr_()
+		,record_ptr_(nullptr)
+		,element_count_(0)
+	{
+	}
+
+	MFStoreSeqLockView(const MFStoreControl &mfstore_ctl,
+		const MFStoreSection &section)
+		:region_sptr_(mfstore_ctl.GetRegionSPtr())
+		,record_ptr_(Bind(mfstore_ctl, section))
+		,element_count_(static_cast<std::size_t>(section.element_count_))
+	{
+	}
+
+	MFStoreSeqLockView(const MFStoreControl &mfstore_ctl,
+		std::size_t section_index)
+		:MFStoreSeqLockView(mfstore_ctl, mfstore_ctl.GetSection(section_index))
+	{
+	}
+
+	MFStoreSeqLockView(const MFStoreControl &mfstore_ctl,
+		const std::string &description)
+		:MFStoreSeqLockView(mfstore_ctl, mfstore_ctl.GetSection(description))
+	{
+	}
+
+	/**
+		Returns a section suitable for inclusion in the list passed to
+		\c CreateMFStore() .
+	*/
+	static MFStoreSection MakeSection(uint64_t element_count,
+		const std::string &description)
+	{
+		return(MFStoreSection(0, sizeof(MFStoreSeqLockRecord<ValueType>),
+			element_count, 0, 0, 0, MFStoreSection::SectionFlag_SeqLock, 0,
+			description));
+	}
+
+	void Write(std::size_t element_index, const ValueType &datum) const
+		requires (!std::is_const_v<DatumType>)
+	{
+		uint64_t    datum_words[WordCount] = { };
+		RecordType &record                 = record_ptr_[element_index];
+		uint64_t    sequence               =
+			record.sequence_.load(std::memory_order_relaxed);
+
+		::memcpy(datum_words, &datum, sizeof(datum));
+
+		record.sequence_.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		for (std::size_t count_1 = 0; count_1 < WordCount; ++count_1)
+			record.datum_words_[count_1].store(datum_words[count_1],
+				std::memory_order_relaxed);
+
+		record.sequence_.store(sequence + 2, std::memory_order_release);
+	}
+
+	/**
+		Makes one attempt to copy the element, returning \c false if the
+		writer was updating it.
+	*/
+	bool TryRead(std::size_t element_index, ValueType &datum) const
+	{
+		uint64_t datum_words[WordCount];
+
+		if (!TryReadWords(element_index, datum_words))
+			return(false);
+
+		::memcpy(&datum, datum_words, sizeof(datum));
+
+		return(true);
+	}
+
+	/**
+		Waits until a consistent copy of the element is obtained. The copy is
+		made into raw storage, so \e DatumType needn't be
+		default-constructible.
+	*/
+	ValueType Read(std::size_t element_index) const
+	{
+		uint64_t     datum_words[WordCount];
+		unsigned int attempt_count = 0;
+
+		while (!TryReadWords(element_index, datum_words)) {
+			if (++attempt_count >= SpinCount) {
+				std::this_thread::yield();
+				attempt_count = 0;
+			}
+		}
+
+		DatumBytes datum_bytes;
+
+		::memcpy(datum_bytes.bytes_, datum_words, sizeof(datum_bytes.bytes_));
+
+		return(std::bit_cast<ValueType>(datum_bytes));
+	}
+
+	//	Returns the number of times the element has been written.
+	uint64_t GetWriteCount(std::size_t element_index) const
+	{
+		return(record_ptr_[element_index].sequence_.load(
+			std::memory_order_acquire) / 2);
+	}
+
+	std::size_t size() const
+	{
+		return(element_count_);
+	}
+
+	bool        IsBound() const
+	{
+		return(record_ptr_ != nullptr);
+	}
+
+private:
+	static const unsigned int SpinCount = 64;
+
+	struct DatumBytes {
+		unsigned char bytes_[sizeof(ValueType)];
+	};
+
+	MappedRegionSPtr  region_sptr_;
+	RecordType       *record_ptr_;
+	std::size_t       element_count_;
+
+	bool TryReadWords(std::size_t element_index, uint64_t *datum_words) const
+	{
+		const RecordType &record   = record_ptr_[element_index];
+		uint64_t          sequence =
+			record.sequence_.load(std::memory_order_acquire);
+
+		if (sequence & 1)
+			return(false);
+
+		for (std::size_t count_1 = 0; count_1 < WordCount; ++count_1)
+			datum_words[count_1] =
+				record.datum_words_[count_1].load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		return(record.sequence_.load(std::memory_order_relaxed) == sequence);
+	}
+
+	static RecordType *Bind(const MFStoreControl &mfstore_ctl,
+		const MFStoreSection &section)
+	{
+		CheckSeqLockViewBind(mfstore_ctl, section, sizeof(RecordType),
+			alignof(RecordType), !std::is_const_v<DatumType>);
+
+		return(reinterpret_cast<RecordType *>(
+			static_cast<char *>(mfstore_ctl.GetMmapAddress()) +
+			section.section_offset_));
+	}
+};
+// ////////////////////////////////////////////////////////////////////////////
+
+} // namespace MFStore
+
+} // namespace MLB
+
+#endif // #ifndef HH__MLB__MFStore__MFStoreSeqLockView_hpp__HH
+
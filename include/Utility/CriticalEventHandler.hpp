@@ -13,8 +13,10 @@
                            Michael L. Brock
                         2024-08-10 --- Migration to C++ MlbDev2/Utility.
                            Michael L. Brock
+                        2026-10-16 --- Optional fatal signal function.
+                           Michael L. Brock
 
-      Copyright Michael L. Brock 1994 - 2024.
+      Copyright Michael L. Brock 1994 - 2026.
       Distributed under the Boost Software License, Version 1.0.
       (See accompanying file LICENSE_1_0.txt or copy at
       http://www.boost.org/LICENSE_1_0.txt)
@@ -56,10 +58,29 @@ namespace MLB {
 namespace Utility {
 
 // ////////////////////////////////////////////////////////////////////////////
+/**
+	Sets a flag on receipt of \c SIGINT or \c SIGTERM .
+
+	If constructed with a fatal signal function, also catches the signals
+	which indicate a crash (\c SIGSEGV , \c SIGBUS , \c SIGFPE , \c SIGILL
+	and \c SIGABRT ). The function is called once, from the signal handler,
+	after which the default action of the signal is restored and the signal
+	re-raised so that the process terminates (and dumps core) as it would
+	have otherwise. The function must therefore confine itself to
+	async-signal-safe operations.
+
+	Only the most recently constructed instance's fatal signal function is
+	called. When that instance is destroyed, the function of the instance
+	(if any) which it superseded is restored. An instance destroyed out of
+	that order leaves the current function in place.
+*/
 class CriticalEventHandler
 {
 public:
+	using FatalSignalFunc = void (*)(int signal_number);
+
 	CriticalEventHandler();
+	explicit CriticalEventHandler(FatalSignalFunc fatal_signal_func);
 
 	~CriticalEventHandler();
 
@@ -77,13 +98,22 @@ private:
 	using SignalHandlerItem     = std::pair<int, SignalFuncType>;
 	using SignalHandlerItemList = std::vector<SignalHandlerItem>;
 
-	SignalHandlerItemList handlers_list_;
+	SignalHandlerItemList       handlers_list_;
+	FatalSignalFunc             previous_func_;
+	const CriticalEventHandler *previous_owner_;
 
 	alignas(64) static std::atomic_bool event_flag_;
 
-	void InstallHandlers(std::set<int> &signal_list);
+	static std::atomic<FatalSignalFunc>              fatal_signal_func_;
+	static std::atomic<const CriticalEventHandler *> fatal_signal_owner_;
+
+	void ReleaseFatalSignalFunc();
+
+	void InstallHandlers(std::set<int> &signal_list,
+		SignalFuncType handler_func);
 
 	static void SignalHandler(int signal);
+	static void FatalSignalHandler(int signal);
 };
 // ////////////////////////////////////////////////////////////////////////////
 